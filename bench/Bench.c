@@ -0,0 +1,402 @@
+/**
+ * \file Bench.c
+ * \brief Banc d'essai du générateur de coups et de la recherche de l'IA (`make bench`).
+ *
+ * \details
+ * Pour un jeu de positions fixes :
+ * - compte les feuilles de l'arbre des coups (perft) jusqu'à une profondeur
+ *   donnée, captures comprises via rules_make_move(), et compare aux totaux de
+ *   référence ;
+ * - vérifie sur les premiers niveaux que le générateur de l'IA rend autant de
+ *   coups que can_move() (sur l'état global du jeu) et que rules_unmake_move() restaure
+ *   exactement la position (hachage compris) ;
+ * - mesure les nœuds par seconde de la génération, du couple jouer/annuler et
+ *   de la recherche complète à profondeur fixe (statistiques de
+ *   ia_get_search_stats()) ;
+ * - mesure les positions évaluées par seconde par chaque variante disponible
+ *   du noyau d'évaluation (eval_kernel.h), en lot, sur les positions à deux
+ *   plies des positions de référence.
+ *
+ * Un total différent de la référence signale un changement de comportement
+ * du générateur ou des captures : le programme rend alors 1.
+ *
+ * \author valentin.leray@uha.fr
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "app.h"
+#include "eval_kernel.h"
+#include "game.h"
+#include "ia.h"
+#include "tt.h"
+
+#define BENCH_MAX_DEPTH   5   // profondeur perft maximale d'une position
+#define BENCH_CHECK_DEPTH 2   // niveaux vérifiés coup par coup contre game.c
+#define BENCH_EVAL_POOL   8192 // positions du lot d'évaluation
+#define BENCH_EVAL_ROUNDS 200  // passes sur le lot par variante
+
+/**
+ * @brief Position de référence du banc d'essai
+ *
+ * Le plateau se lit ligne par ligne depuis la ligne 0 : `K`/`P` roi et soldat
+ * bleus, `k`/`p` roi et soldat rouges, `+` et `-` cases vides contrôlées par
+ * les bleus et les rouges, `.` case neutre. Une pièce contrôle sa case.
+ */
+typedef struct {
+    const char* name;                              /**< Nom affiché */
+    const char* board[9];                          /**< Plateau (9 lignes de 9 cases) */
+    char player;                                   /**< Joueur au trait ('B' ou 'R') */
+    int turn;                                      /**< Numéro de tour */
+    int depth;                                     /**< Profondeur perft */
+    int search_depth;                              /**< Profondeur de la recherche chronométrée */
+    unsigned long long expected[BENCH_MAX_DEPTH + 1]; /**< Feuilles attendues par profondeur */
+} BenchPosition;
+
+static const BenchPosition bench_positions[] = {
+    { "depart", {
+        "..PP.....",
+        ".KPP.....",
+        "PPP......",
+        "PP.......",
+        ".........",
+        ".......pp",
+        "......ppp",
+        ".....ppk.",
+        ".....pp..",
+      }, 'B', 1, 4, 6, { 1, 52, 2624, 153308, 8740372, 0 } },
+    { "milieu", {
+        "..P+..P..",
+        ".+KP..pp.",
+        "PP+.+....",
+        "PP.+.....",
+        "......-..",
+        ".......-p",
+        "....p.--p",
+        ".....p-k.",
+        "..-.p-p..",
+      }, 'B', 15, 4, 6, { 1, 57, 4702, 290473, 23715822, 0 } },
+    { "finale", {
+        "..P+..+..",
+        ".+++-..-.",
+        "+++...++.",
+        "++++.-...",
+        "+....p--.",
+        ".P.....kp",
+        "....-.---",
+        ".....---.",
+        "..KPp--..",
+      }, 'B', 41, 5, 8, { 1, 46, 2234, 102112, 5001911, 232671290ULL } },
+};
+
+#define BENCH_POSITION_COUNT ((int)(sizeof(bench_positions) / sizeof(bench_positions[0])))
+
+/**
+ * \fn static double bench_now(void)
+ * \brief Horloge monotone en secondes.
+ *
+ * \return Temps écoulé depuis une origine arbitraire.
+ */
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \fn static void bench_load(const BenchPosition* bp, GameState* s)
+ * \brief Charge une position de référence dans `s` et dans l'état global du jeu.
+ *
+ * \param bp Position de référence.
+ * \param s État de l'IA à remplir.
+ */
+static void bench_load(const BenchPosition* bp, GameState* s) {
+    Piece arr[RULES_MAX_PIECES];
+    int control[9][9], count = 0;
+    for (int r = 0; r < 9; ++r) {
+        for (int c = 0; c < 9; ++c) {
+            char ch = bp->board[r][c];
+            int blue = (ch == 'K' || ch == 'P' || ch == '+');
+            int red  = (ch == 'k' || ch == 'p' || ch == '-');
+            control[r][c] = blue ? 1 : red ? 2 : 0;
+            if (ch == 'K' || ch == 'P' || ch == 'k' || ch == 'p') {
+                if (count == RULES_MAX_PIECES) continue;
+                arr[count++] = (Piece){ .row = r, .col = c, .color = blue ? 'B' : 'R',
+                                        .type = (ch == 'K' || ch == 'k') ? 'K' : 'P' };
+            }
+        }
+    }
+    rules_state_load(s, arr, count, (const int (*)[9])control, bp->player, bp->turn);
+    rules_state_store(s, pieces, &piece_count, cell_control);
+    current_turn = bp->player;
+    turn_number = bp->turn;
+    game_over = 0;
+}
+
+/**
+ * \fn static unsigned long long bench_perft(GameState* s, int depth)
+ * \brief Nombre de feuilles de l'arbre des coups, le dernier niveau compté sans être joué.
+ *
+ * \param s État du jeu (bitboards à jour), restauré au retour.
+ * \param depth Profondeur (>= 1).
+ * \return Nombre de feuilles.
+ */
+static unsigned long long bench_perft(GameState* s, int depth) {
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(s, moves);
+    if (depth == 1) return (unsigned long long)n;
+    unsigned long long total = 0;
+    for (int i = 0; i < n; ++i) {
+        MoveUndo undo;
+        rules_make_move(s, &moves[i], &undo);
+        total += bench_perft(s, depth - 1);
+        rules_unmake_move(s, &undo);
+    }
+    return total;
+}
+
+/**
+ * \fn static unsigned long long bench_make_unmake(GameState* s, int depth)
+ * \brief Comme bench_perft(), mais chaque feuille est jouée puis annulée.
+ *
+ * \param s État du jeu (bitboards à jour), restauré au retour.
+ * \param depth Profondeur (>= 1).
+ * \return Nombre de coups joués.
+ */
+static unsigned long long bench_make_unmake(GameState* s, int depth) {
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(s, moves);
+    unsigned long long total = 0;
+    for (int i = 0; i < n; ++i) {
+        MoveUndo undo;
+        rules_make_move(s, &moves[i], &undo);
+        total += (depth == 1) ? 1 : bench_make_unmake(s, depth - 1);
+        rules_unmake_move(s, &undo);
+    }
+    return total;
+}
+
+/** @brief Positions du lot d'évaluation et leur nombre. */
+static GameState bench_eval_states[BENCH_EVAL_POOL];
+static int bench_eval_count = 0;
+
+/**
+ * \fn static void bench_eval_collect(GameState* s, int depth)
+ * \brief Ajoute au lot d'évaluation les positions atteintes en `depth` plies.
+ *
+ * \param s État du jeu (bitboards à jour), restauré au retour.
+ * \param depth Profondeur (>= 1).
+ */
+static void bench_eval_collect(GameState* s, int depth) {
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(s, moves);
+    for (int i = 0; i < n && bench_eval_count < BENCH_EVAL_POOL; ++i) {
+        MoveUndo undo;
+        rules_make_move(s, &moves[i], &undo);
+        if (depth == 1) bench_eval_states[bench_eval_count++] = *s;
+        else bench_eval_collect(s, depth - 1);
+        rules_unmake_move(s, &undo);
+    }
+}
+
+/**
+ * \fn static int bench_rules_move_count(const GameState* s)
+ * \brief Nombre de coups du joueur au trait selon les règles de game.c.
+ *
+ * Recopie la position dans l'état global puis essaie toutes les cases avec
+ * can_move(). La partie est finie si un roi manque ou a atteint la cité adverse.
+ *
+ * \param s État du jeu.
+ * \return Nombre de coups autorisés.
+ */
+static int bench_rules_move_count(const GameState* s) {
+    rules_state_store(s, pieces, &piece_count, cell_control);
+    int blue_king = 0, red_king = 0;
+    for (int i = 0; i < piece_count; ++i) {
+        if (pieces[i].type != 'K') continue;
+        if (pieces[i].color == 'B') {
+            if (pieces[i].row == 8 && pieces[i].col == 8) return 0;
+            blue_king = 1;
+        } else {
+            if (pieces[i].row == 0 && pieces[i].col == 0) return 0;
+            red_king = 1;
+        }
+    }
+    if (!blue_king || !red_king) return 0;
+
+    int count = 0;
+    for (int i = 0; i < piece_count; ++i) {
+        if (pieces[i].color != s->current_player) continue;
+        for (int sq = 0; sq < 81; ++sq) count += can_move(i, sq / 9, sq % 9);
+    }
+    return count;
+}
+
+/**
+ * \fn static int bench_same_state(const GameState* a, const GameState* b)
+ * \brief Compare deux positions champ par champ (sans les octets de remplissage).
+ *
+ * \param a Première position.
+ * \param b Seconde position.
+ * \return 1 si elles sont identiques, 0 sinon.
+ */
+static int bench_same_state(const GameState* a, const GameState* b) {
+    if (a->occ[0] != b->occ[0] || a->occ[1] != b->occ[1]) return 0;
+    if (a->control[0] != b->control[0] || a->control[1] != b->control[1]) return 0;
+    if (a->hash != b->hash || a->piece_count != b->piece_count) return 0;
+    if (a->current_player != b->current_player || a->turn_number != b->turn_number) return 0;
+    for (int c = 0; c < 2; ++c)
+        if (a->pawn_count[c] != b->pawn_count[c] || a->king_sq[c] != b->king_sq[c]) return 0;
+    for (int i = 0; i < a->piece_count; ++i) {
+        const StatePiece* pa = &a->pieces[i];
+        const StatePiece* pb = &b->pieces[i];
+        if (pa->sq != pb->sq || pa->color != pb->color || pa->type != pb->type) return 0;
+    }
+    return 1;
+}
+
+/**
+ * \fn static int bench_check(GameState* s, int depth)
+ * \brief Vérifie le générateur et jouer/annuler sur tous les nœuds jusqu'à `depth`.
+ *
+ * \param s État du jeu (bitboards à jour), restauré au retour.
+ * \param depth Niveaux à vérifier.
+ * \return 1 si tout concorde, 0 sinon (le premier écart est affiché).
+ */
+static int bench_check(GameState* s, int depth) {
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(s, moves);
+    int expected = bench_rules_move_count(s);
+    if (n != expected) {
+        printf("  ecart generateur : %d coups (IA) contre %d (game.c), tour %d\n", n, expected, s->turn_number);
+        return 0;
+    }
+    if (depth == 0) return 1;
+    for (int i = 0; i < n; ++i) {
+        GameState before = *s;
+        MoveUndo undo;
+        rules_make_move(s, &moves[i], &undo);
+
+        GameState fresh = *s;
+        rules_sync(&fresh);
+        if (fresh.hash != s->hash || fresh.occ[0] != s->occ[0] || fresh.occ[1] != s->occ[1]) {
+            printf("  ecart incremental apres (%d,%d)->(%d,%d)\n",
+                   moves[i].from_row, moves[i].from_col, moves[i].to_row, moves[i].to_col);
+            return 0;
+        }
+        int ok = bench_check(s, depth - 1);
+        rules_unmake_move(s, &undo);
+        if (!ok) return 0;
+        if (!bench_same_state(&before, s)) {
+            printf("  rules_unmake_move ne restaure pas la position apres (%d,%d)->(%d,%d)\n",
+                   moves[i].from_row, moves[i].from_col, moves[i].to_row, moves[i].to_col);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \fn static void bench_rate(const char* label, unsigned long long nodes, double seconds)
+ * \brief Affiche un débit en nœuds par seconde.
+ *
+ * \param label Mesure.
+ * \param nodes Nœuds comptés.
+ * \param seconds Durée.
+ */
+static void bench_rate(const char* label, unsigned long long nodes, double seconds) {
+    double nps = seconds > 0 ? nodes / seconds : 0;
+    printf("  %-22s %12llu noeuds %8.3f s %10.2f Mn/s\n", label, nodes, seconds, nps / 1e6);
+}
+
+/**
+ * \fn int main(void)
+ * \brief Lance le banc d'essai sur toutes les positions de référence.
+ *
+ * \return 0 si tous les totaux concordent, 1 sinon.
+ */
+int main(void) {
+    int failures = 0;
+    unsigned long long gen_nodes = 0, mu_nodes = 0, search_nodes = 0;
+    double gen_time = 0, mu_time = 0, search_time = 0;
+    tt_init(0);
+
+    for (int p = 0; p < BENCH_POSITION_COUNT; ++p) {
+        const BenchPosition* bp = &bench_positions[p];
+        GameState s;
+        bench_load(bp, &s);
+        printf("\n=== Position %s (trait %c, tour %d) ===\n", bp->name, bp->player, bp->turn);
+
+        if (!bench_check(&s, BENCH_CHECK_DEPTH)) {
+            printf("  verification : ECHEC\n");
+            ++failures;
+        } else {
+            printf("  verification game.c et jouer/annuler (%d plies) : OK\n", BENCH_CHECK_DEPTH + 1);
+        }
+
+        for (int d = 1; d <= bp->depth; ++d) {
+            double t0 = bench_now();
+            unsigned long long n = bench_perft(&s, d);
+            double dt = bench_now() - t0;
+            int known = bp->expected[d] != 0;
+            int ok = !known || n == bp->expected[d];
+            printf("  perft(%d) = %12llu  %s\n", d, n, !known ? "(sans reference)" : ok ? "OK" : "ECHEC");
+            if (!ok) {
+                printf("    attendu %llu\n", bp->expected[d]);
+                ++failures;
+            }
+            if (d == bp->depth) { gen_nodes += n; gen_time += dt; }
+        }
+        bench_eval_collect(&s, 2);
+
+        double t0 = bench_now();
+        unsigned long long n = bench_make_unmake(&s, bp->depth - 1);
+        mu_time += bench_now() - t0;
+        mu_nodes += n;
+
+        // Recherche complète : table vide et sans historique pour des mesures reproductibles
+        tt_clear();
+        bench_load(bp, &s);
+        reset_move_history();
+        Move mv;
+        t0 = bench_now();
+        trouverMeilleurCoupIA(&s, &mv, bp->search_depth);
+        double dt = bench_now() - t0;
+        IaSearchStats stats;
+        ia_get_search_stats(&stats);
+        printf("  recherche profondeur %d :\n", bp->search_depth);
+        ia_print_search_stats(&stats);
+        search_nodes += stats.nodes;
+        search_time += dt;
+    }
+
+    printf("\n=== Debits ===\n");
+    bench_rate("generation (perft)", gen_nodes, gen_time);
+    bench_rate("jouer/annuler", mu_nodes, mu_time);
+    bench_rate("recherche", search_nodes, search_time);
+
+    // Noyau d'évaluation : chaque variante disponible sur le même lot
+    static const GameState* eval_ptr[BENCH_EVAL_POOL];
+    static EvalFeatures eval_out[BENCH_EVAL_POOL];
+    for (int i = 0; i < bench_eval_count; ++i) eval_ptr[i] = &bench_eval_states[i];
+    EvalKernel best = eval_get_kernel();
+    for (EvalKernel k = EVAL_KERNEL_SCALAR; k <= EVAL_KERNEL_NEON; ++k) {
+        if (eval_set_kernel(k) != 0) continue;
+        char label[32];
+        snprintf(label, sizeof(label), "evaluation (%s)", eval_kernel_name(k));
+        double t0 = bench_now();
+        for (int r = 0; r < BENCH_EVAL_ROUNDS; ++r) eval_features_batch(eval_ptr, bench_eval_count, eval_out);
+        bench_rate(label, (unsigned long long)bench_eval_count * BENCH_EVAL_ROUNDS, bench_now() - t0);
+    }
+    eval_set_kernel(best);
+    printf("  variante retenue : %s\n", eval_kernel_name(best));
+
+    if (failures) {
+        printf("\n%d ecart(s) avec les references\n", failures);
+        return 1;
+    }
+    printf("\nToutes les references concordent\n");
+    return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+#include "app.h"
+#include "ia.h"
+
+/**
+ * @file analysis.h
+ * @brief Analyse en continu de la position affichée : meilleurs coups, scores et profondeur sur le plateau.
+ *
+ * Un thread d'analyse approfondit sans fin la position courante avec
+ * ia_analyse() et rend, à chaque profondeur terminée, les meilleurs coups
+ * (multi-PV) avec leur score. Les résultats passent au thread GTK au plus
+ * une fois toutes les ANALYSIS_INTERVAL_MS millisecondes : seul le dernier
+ * compte, les précédents sont remplacés sans être rendus. draw_cb() les
+ * dessine en flèches par-dessus le plateau, le score à côté de la case
+ * d'arrivée.
+ *
+ * Quand la position change (coup joué, reset, coup reçu du réseau),
+ * analysis_set_position() interrompt la profondeur en cours et relance le
+ * même thread sur la nouvelle position. La table de transposition n'est
+ * pas vidée : la position atteinte a souvent été vue dans l'arbre de la
+ * précédente, et ses premières profondeurs sont immédiates.
+ *
+ * ```bash
+ * ./game -l --analyse 3          # deux joueurs, trois meilleurs coups affichés
+ * ./game -l -ia --analyse 1 -j 2 # contre l'IA, meilleur coup du joueur au trait
+ * ```
+ */
+
+/** Intervalle minimal entre deux résultats rendus au thread GTK (ms). */
+#define ANALYSIS_INTERVAL_MS 100
+
+/** Lignes affichées en mode analyse (`--analyse N`, 0 = pas d'analyse). */
+extern int analysis_multipv;
+
+/**
+ * @brief Démarre le thread d'analyse (sans position : voir analysis_set_position()).
+ * @param lines nombre de lignes (borné à 1..IA_MAX_MULTIPV)
+ * @return 0 si succès (ou déjà démarré), -1 sinon
+ */
+int analysis_start(int lines);
+
+/** @brief Indique si le thread d'analyse tourne. */
+int analysis_running(void);
+
+/**
+ * @brief Analyse désormais `state` (sans effet si c'est déjà la position analysée).
+ *
+ * Les lignes de la position précédente ne sont plus rendues. Une position
+ * terminée n'a aucune ligne.
+ * @param state position (copiée, hachage à jour)
+ */
+void analysis_set_position(const GameState *state);
+
+/**
+ * @brief Récupère sur le thread GTK le dernier résultat du thread d'analyse.
+ *
+ * Appelée par le rappel programmé par le thread d'analyse ; marque le
+ * plateau à redessiner (UI_DIRTY_BOARD) si un résultat est arrivé.
+ * @return 1 si un nouveau résultat a été récupéré, 0 sinon
+ */
+int analysis_poll(void);
+
+/**
+ * @brief Dernier résultat récupéré pour la position analysée.
+ * @param out analyse (retour)
+ * @return 1 s'il y a au moins une ligne, 0 sinon
+ */
+int analysis_get(IaAnalysis *out);
+
+/** @brief Arrête le thread d'analyse et attend sa fin (fermeture de la fenêtre). */
+void analysis_shutdown(void);
+
+#endif // ANALYSIS_H
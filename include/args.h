@@ -1,5 +1,9 @@
 #ifndef ARGS_H
 #define ARGS_H
+#include "selfplay.h"
+#include "tablebase.h"
+#include "server.h"
+#include "log.h"
 
 /**
  * @file args.h
@@ -30,9 +34,29 @@
  * ./game --client 192.168.1.10:12345  # Connexion à une IP spécifique
  * ```
  *
+ * Parties IA contre IA sans interface (voir selfplay.h) :
+ * ```bash
+ * ./game --selfplay 100 --engine-a t100 --engine-b d4 --workers 4 --out res.csv
+ * ```
+ *
+ * Serveur de parties contre l'IA sans interface (voir server.h) :
+ * ```bash
+ * ./game --serve 5555 --max-matches 32 --search-workers 4 -t 250
+ * ```
+ *
+ * Table de finales de l'IA (voir tablebase.h) :
+ * ```bash
+ * ./game --tb-gen krojanty.tb --tb-pawns 2  # Génération hors ligne
+ * ./game -l -ia --tb krojanty.tb            # Partie avec la table
+ * ```
+ *
  * Aide et diagnostic :
  * ```bash
  * ./game --help     # Affiche l'aide
+ * ./game -l -ia -v  # Statistiques de recherche après chaque coup de l'IA
+ * ./game -s 5555 --log-level warn  # Journal réduit aux erreurs et avertissements (voir log.h)
+ * ./game -c host:5555 --ping-interval 500  # Aller-retour mesuré deux fois par seconde (voir net.h)
+ * ./game -l --analyse 3  # Trois meilleurs coups affichés sur le plateau (voir analysis.h)
  * ```
  *
  * @see app.h pour la description générale des modes de jeu
@@ -40,6 +64,21 @@
  * @see ia.h pour les options de l'IA
  */
 
+/** Temps de réflexion maximal accepté pour `-t` (ms). */
+#define ARGS_MAX_TIME_MS 600000
+/** Nombre maximal de threads de recherche accepté pour `-j` (IA_MAX_THREADS). */
+#define ARGS_MAX_THREADS 64
+/** Nombre maximal de parties accepté pour `--selfplay`. */
+#define ARGS_MAX_GAMES 1000000
+/** Échantillonnage maximal accepté pour `--log-sample`. */
+#define ARGS_MAX_LOG_SAMPLE 1000000
+/** Intervalle maximal accepté pour `--ping-interval` (ms). */
+#define ARGS_MAX_PING_MS 60000
+/** Nombre maximal de lignes accepté pour `--analyse` (IA_MAX_MULTIPV). */
+#define ARGS_MAX_ANALYSE 8
+/** Soldats par camp de la table générée par `--tb-gen` sans `--tb-pawns`. */
+#define ARGS_DEFAULT_TB_PAWNS 2
+
 /**
  * @brief Mode de jeu sélectionné via les arguments
  * 
@@ -64,6 +103,20 @@
  * - Envoie les mouvements au serveur
  * - Reçoit les mises à jour de l'état
  * 
+ * @var game_mode_t::MODE_SELFPLAY
+ * Série de parties IA contre IA sans interface (`--selfplay N`)
+ * - Aucune fenêtre GTK, aucun délai entre les coups
+ * - Résultats en CSV ou JSON
+ * 
+ * @var game_mode_t::MODE_TBGEN
+ * Génération de la table de finales (`--tb-gen FICHIER`)
+ * - Aucune fenêtre GTK, le programme s'arrête une fois le fichier écrit
+ * 
+ * @var game_mode_t::MODE_SERVE
+ * Serveur de parties contre l'IA sans interface (`--serve PORT`)
+ * - Aucune fenêtre GTK, une partie par client connecté
+ * - S'arrête sur SIGINT ou SIGTERM
+ * 
  * @var game_mode_t::MODE_NONE
  * Aucun mode sélectionné (état par défaut)
  */
@@ -71,6 +124,9 @@ typedef enum {
     MODE_LOCAL,  /**< Jeu en local */
     MODE_SERVER, /**< Mode serveur réseau */
     MODE_CLIENT, /**< Mode client réseau */
+    MODE_SELFPLAY, /**< Parties IA contre IA sans interface */
+    MODE_TBGEN,  /**< Génération de la table de finales */
+    MODE_SERVE,  /**< Serveur de parties sans interface */
     MODE_NONE    /**< Mode non défini */
 } game_mode_t;
 
@@ -153,6 +209,120 @@ typedef enum {
  * - 0 : Port non spécifié
  * - 1024-65535 : Port valide pour client/serveur
  * 
+ * @var args_t::tt_mb
+ * Taille de la table de transposition de l'IA (`-tt MO`) :
+ * - 0 : Taille par défaut (TT_DEFAULT_MB)
+ * - 1-TT_MAX_MB : Taille demandée en mégaoctets
+ * 
+ * @var args_t::time_ms
+ * Temps de réflexion de l'IA par coup (`-t MS`) :
+ * - 0 : Temps par défaut (IA_DEFAULT_TIME_MS)
+ * - 1-ARGS_MAX_TIME_MS : Budget en millisecondes, tenu par l'approfondissement itératif
+ * 
+ * @var args_t::threads
+ * Nombre de threads de recherche de l'IA (`-j N`) :
+ * - 0 : Valeur par défaut (1 thread)
+ * - 1-ARGS_MAX_THREADS : Recherche parallèle Lazy SMP sur N threads
+ * 
+ * @var args_t::ponder
+ * Réflexion anticipée de l'IA (`-p`) :
+ * - 0 : L'IA ne calcule que pendant son tour
+ * - 1 : L'IA approfondit aussi pendant le tour de l'adversaire
+ * 
+ * @var args_t::verbose
+ * Statistiques de recherche de l'IA (`-v`) :
+ * - 0 : Seul le coup joué est affiché
+ * - 1 : Chaque coup de l'IA est suivi de ses statistiques (ia_print_search_stats())
+ * 
+ * @var args_t::games
+ * Nombre de parties en mode `--selfplay N` (1-ARGS_MAX_GAMES)
+ * 
+ * @var args_t::engine_a
+ * @var args_t::engine_b
+ * Moteurs A et B du mode selfplay (`--engine-a`, `--engine-b`) :
+ * - `dN` : profondeur fixe N
+ * - `tMS` : MS millisecondes par coup (défaut t100)
+ * 
+ * @var args_t::workers
+ * Processus de parties du mode selfplay (`--workers N`, défaut 1, option
+ * refusée hors `--selfplay`) : chaque processus joue ses parties l'une après
+ * l'autre.
+ * 
+ * @var args_t::search_workers
+ * Threads de recherche du mode `--serve` (`--search-workers N`, défaut 1,
+ * option refusée hors `--serve`) : recherches de l'IA menées en même temps,
+ * une par partie au plus. Chacune compte `-j` threads (Lazy SMP).
+ * 
+ * @var args_t::max_matches
+ * Parties simultanées du mode `--serve` (`--max-matches N`) :
+ * - 0 : Valeur par défaut (SERVER_DEFAULT_MATCHES)
+ * - 1-SERVER_MAX_MATCHES : clients refusés au-delà (option refusée hors `--serve`)
+ * 
+ * @var args_t::out
+ * Fichier de résultats du mode selfplay (`--out FICHIER`) :
+ * - NULL : CSV sur la sortie standard
+ * - `*.json` : JSON, sinon CSV
+ * @note Alloué dynamiquement, libérer avec free_args()
+ * 
+ * @var args_t::book
+ * Livre d'ouverture de l'IA (`--book FICHIER`, voir book.h) :
+ * - NULL : toutes les positions sont cherchées
+ * - Chaîne : fichier projeté en mémoire au démarrage
+ * @note Alloué dynamiquement, libérer avec free_args()
+ * 
+ * @var args_t::book_out
+ * Livre d'ouverture construit par le mode selfplay (`--book-out FICHIER`) :
+ * - NULL : aucun livre écrit
+ * - Chaîne : fichier écrit après la série (option refusée hors selfplay)
+ * @note Alloué dynamiquement, libérer avec free_args()
+ * 
+ * @var args_t::record
+ * Fichier de parties complété par `--selfplay` ou `--serve` (`--record FICHIER`, voir record.h) :
+ * - NULL : aucune partie enregistrée
+ * - Chaîne : créé s'il n'existe pas, sinon rouvert en ajout (option refusée dans les autres modes)
+ * @note Alloué dynamiquement, libérer avec free_args()
+ * 
+ * @var args_t::record_every
+ * Coups entre deux instantanés d'un nouveau fichier de parties (`--record-every K`) :
+ * - 0 : Valeur par défaut (RECORD_DEFAULT_SNAP_EVERY)
+ * - 1-RECORD_MAX_SNAP_EVERY : un instantané tous les K coups (sans effet sur un fichier existant)
+ * 
+ * @var args_t::tb
+ * Table de finales de l'IA (`--tb FICHIER`, voir tablebase.h) :
+ * - NULL : aucune table
+ * - Chaîne : fichier projeté en mémoire au démarrage
+ * @note Alloué dynamiquement, libérer avec free_args()
+ * 
+ * @var args_t::tb_gen
+ * Table de finales à générer (`--tb-gen FICHIER`, mode MODE_TBGEN)
+ * @note Alloué dynamiquement, libérer avec free_args()
+ * 
+ * @var args_t::tb_pawns
+ * Soldats par camp au plus de la table générée (`--tb-pawns N`) :
+ * - 0 : Valeur par défaut (ARGS_DEFAULT_TB_PAWNS)
+ * - 1-TB_GEN_MAX_PAWNS : Classes jusqu'à N soldats d'un côté (roi contre roi,
+ *   roi et 2 soldats contre roi et l'inverse ; jamais 2 soldats de chaque côté)
+ * 
+ * @var args_t::log_level
+ * Seuil du journal (`--log-level off|error|warn|info|debug`, défaut info)
+ * 
+ * @var args_t::log_sample
+ * Échantillonnage du journal (`--log-sample N`) :
+ * - 0 : Tous les messages
+ * - 1-ARGS_MAX_LOG_SAMPLE : un message INFO ou DEBUG sur N
+ * 
+ * @var args_t::ping_ms
+ * PING du canal de contrôle en partie réseau (`--ping-interval MS`, `--no-ping`) :
+ * - 0 : Intervalle par défaut (NET_PING_INTERVAL_MS)
+ * - 1-ARGS_MAX_PING_MS : un PING toutes les MS millisecondes
+ * - -1 : Aucun PING (`--no-ping`), ceux de l'adversaire reçoivent leur réponse
+ * 
+ * @var args_t::analyse
+ * Mode analyse de l'interface (`--analyse N`, voir analysis.h) :
+ * - 0 : Aucune analyse
+ * - 1-ARGS_MAX_ANALYSE : les N meilleurs coups du joueur au trait sont
+ *   affichés sur le plateau (option refusée dans les modes sans fenêtre)
+ * 
  * @var args_t::help
  * Demande d'aide :
  * - 0 : Exécution normale
@@ -189,6 +359,29 @@ typedef struct {
     int is_ia_both;   /**< Active le mode IA vs IA */
     char *host;       /**< Adresse du serveur pour client */
     int port;         /**< Port pour connexion réseau */
+    int tt_mb;        /**< Taille de la table de transposition en Mo (0 = défaut) */
+    int time_ms;      /**< Temps de réflexion de l'IA par coup en ms (0 = défaut) */
+    int threads;      /**< Nombre de threads de recherche de l'IA (0 = défaut) */
+    int ponder;       /**< Active la réflexion anticipée de l'IA */
+    int verbose;      /**< Affiche les statistiques de recherche de l'IA */
+    int games;        /**< Nombre de parties du mode selfplay */
+    EngineConfig engine_a; /**< Moteur A du mode selfplay */
+    EngineConfig engine_b; /**< Moteur B du mode selfplay */
+    int workers;      /**< Processus de parties du mode selfplay (0 = défaut) */
+    int search_workers; /**< Threads de recherche du mode --serve (0 = défaut) */
+    int max_matches;  /**< Parties simultanées du mode --serve (0 = défaut) */
+    char *out;        /**< Fichier de résultats du mode selfplay (NULL = stdout) */
+    char *book;       /**< Livre d'ouverture de l'IA (NULL = aucun) */
+    char *book_out;   /**< Livre d'ouverture à construire en mode selfplay (NULL = aucun) */
+    char *record;     /**< Fichier de parties de --selfplay ou --serve (NULL = aucun) */
+    int record_every; /**< Coups entre deux instantanés du fichier de parties (0 = défaut) */
+    char *tb;         /**< Table de finales de l'IA (NULL = aucune) */
+    char *tb_gen;     /**< Table de finales à générer (mode MODE_TBGEN) */
+    int tb_pawns;     /**< Soldats par camp de la table générée (0 = défaut) */
+    LogLevel log_level; /**< Seuil du journal */
+    int log_sample;   /**< Un message INFO/DEBUG sur N (0 = tous) */
+    int ping_ms;      /**< Intervalle des PING en ms (0 = défaut, -1 = aucun) */
+    int analyse;      /**< Lignes du mode analyse (0 = aucune analyse) */
     int help;         /**< Demande d'affichage de l'aide */
     int error;        /**< Indicateur d'erreur de parsing */
 } args_t;
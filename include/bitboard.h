@@ -0,0 +1,108 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+/**
+ * @file bitboard.h
+ * @brief Représentation binaire (bitboard) du plateau 9x9 utilisée par l'IA.
+ *
+ * Les 81 cases du plateau tiennent dans un entier de 128 bits. La case
+ * (row, col) correspond au bit `row * 9 + col` :
+ * - bit 0  : case (0,0), cité bleue
+ * - bit 80 : case (8,8), cité rouge
+ *
+ * Les décalages d'une case vers l'est/ouest se font par `<< 1` / `>> 1`
+ * (avec masquage des colonnes de bord pour ne pas changer de rangée),
+ * vers le sud/nord par `<< 9` / `>> 9`. Les déplacements en ligne droite
+ * sont obtenus par remplissage (« fill ») case par case jusqu'au premier
+ * obstacle, ce qui permet de calculer les coups et la mobilité de toutes
+ * les pièces d'une couleur en quelques opérations.
+ *
+ * Toutes les fonctions sont `static inline` : ce fichier n'a pas de .c.
+ */
+
+/** @brief Ensemble de cases du plateau (bits 0 à 80 utilisés). */
+typedef unsigned __int128 Bitboard;
+
+/** @brief Numéro de case (0-80) à partir d'une ligne et d'une colonne. */
+#define BB_SQ(r, c) ((r) * 9 + (c))
+
+/** @brief Les 81 cases du plateau. */
+#define BB_FULL   ((((Bitboard)1) << 81) - 1)
+
+/** @brief Colonne A (col = 0). */
+#define BB_FILE_A ((Bitboard)0x8040201008040201ULL | (((Bitboard)1) << 72))
+
+/** @brief Colonne I (col = 8). */
+#define BB_FILE_I ((Bitboard)0x4020100804020100ULL | (((Bitboard)0x10080ULL) << 64))
+
+/** @brief Bitboard ne contenant que la case `sq`. */
+static inline Bitboard bb_bit(int sq) { return ((Bitboard)1) << sq; }
+
+/** @brief Retourne 1 si la case `sq` appartient à `b`. */
+static inline int bb_test(Bitboard b, int sq) { return (int)((b >> sq) & 1); }
+
+/** @brief Nombre de cases présentes dans `b`. */
+static inline int bb_popcount(Bitboard b) {
+    return __builtin_popcountll((uint64_t)b) + __builtin_popcountll((uint64_t)(b >> 64));
+}
+
+/** @brief Case de plus petit indice de `b` (b doit être non vide). */
+static inline int bb_lsb(Bitboard b) {
+    uint64_t lo = (uint64_t)b;
+    return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll((uint64_t)(b >> 64));
+}
+
+/** @brief Case de plus grand indice de `b` (b doit être non vide). */
+static inline int bb_msb(Bitboard b) {
+    uint64_t hi = (uint64_t)(b >> 64);
+    return hi ? 127 - __builtin_clzll(hi) : 63 - __builtin_clzll((uint64_t)b);
+}
+
+/* Décalages d'une case dans chaque direction */
+static inline Bitboard bb_east(Bitboard b)  { return (b << 1) & ~BB_FILE_A & BB_FULL; }
+static inline Bitboard bb_west(Bitboard b)  { return (b >> 1) & ~BB_FILE_I; }
+static inline Bitboard bb_south(Bitboard b) { return (b << 9) & BB_FULL; }
+static inline Bitboard bb_north(Bitboard b) { return b >> 9; }
+
+/*
+ * Remplissages : cases atteignables depuis les pièces de `gen` en glissant
+ * dans une direction sur les cases de `empty`, jusqu'au premier obstacle.
+ * Une case vide ne peut être atteinte dans une direction donnée que par une
+ * seule pièce (la plus proche), ce qui rend la somme des popcounts exacte.
+ */
+static inline Bitboard bb_fill_east(Bitboard gen, Bitboard empty) {
+    Bitboard r = 0;
+    for (gen = bb_east(gen) & empty; gen; gen = bb_east(gen) & empty) r |= gen;
+    return r;
+}
+static inline Bitboard bb_fill_west(Bitboard gen, Bitboard empty) {
+    Bitboard r = 0;
+    for (gen = bb_west(gen) & empty; gen; gen = bb_west(gen) & empty) r |= gen;
+    return r;
+}
+static inline Bitboard bb_fill_south(Bitboard gen, Bitboard empty) {
+    Bitboard r = 0;
+    for (gen = bb_south(gen) & empty; gen; gen = bb_south(gen) & empty) r |= gen;
+    return r;
+}
+static inline Bitboard bb_fill_north(Bitboard gen, Bitboard empty) {
+    Bitboard r = 0;
+    for (gen = bb_north(gen) & empty; gen; gen = bb_north(gen) & empty) r |= gen;
+    return r;
+}
+
+/** @brief Union des cases atteignables en ligne droite depuis `gen`. */
+static inline Bitboard bb_rook_reach(Bitboard gen, Bitboard empty) {
+    return bb_fill_east(gen, empty) | bb_fill_west(gen, empty) |
+           bb_fill_south(gen, empty) | bb_fill_north(gen, empty);
+}
+
+/** @brief Nombre total de déplacements (pièce, destination) depuis `gen`. */
+static inline int bb_rook_mobility(Bitboard gen, Bitboard empty) {
+    return bb_popcount(bb_fill_east(gen, empty)) + bb_popcount(bb_fill_west(gen, empty)) +
+           bb_popcount(bb_fill_south(gen, empty)) + bb_popcount(bb_fill_north(gen, empty));
+}
+
+#endif // BITBOARD_H
@@ -0,0 +1,138 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "rules.h" /* GameState, Move */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file book.h
+ * @brief Livre d'ouverture de l'IA : fichier trié de positions → coups pondérés.
+ *
+ * Le fichier commence par un en-tête (BookHeader), suivi de `count` entrées
+ * de 16 octets (BookEntry) triées par clé de Zobrist de la position puis
+ * par poids décroissant. Une position a une entrée par coup connu. Les
+ * entiers sont dans l'ordre d'octets de la machine qui a construit le
+ * livre ; les champs `magic` et `version` permettent de rejeter un fichier
+ * d'un autre format.
+ *
+ * Le livre est projeté en mémoire au démarrage (book_open(), `--book`) et
+ * consulté par dichotomie avant chaque recherche de l'IA : un coup trouvé
+ * est joué sans chercher. Les coups tirés sont vérifiés contre les règles,
+ * ce qui écarte les collisions de clé.
+ *
+ * Il est construit à partir de parties IA contre IA (`--selfplay N
+ * --book-out FICHIER`, voir selfplay_write_book()) : les
+ * SELFPLAY_OPENING_PLIES premiers coups de chaque partie sont comptés 2
+ * pour le camp gagnant et 1 en cas d'égalité, les coups du perdant ne sont
+ * pas retenus.
+ *
+ * ```bash
+ * ./game --selfplay 500 --engine-a d5 --engine-b d5 --workers 4 --book-out krojanty.book
+ * ./game -l -ia --book krojanty.book
+ * ```
+ */
+
+/** Signature du fichier. */
+#define BOOK_MAGIC       "KROBOOK"
+/** Version du format. */
+#define BOOK_VERSION     1
+/** Coups candidats au plus pour une position. */
+#define BOOK_MAX_MOVES   32
+
+/** @brief En-tête du fichier (16 octets). */
+typedef struct {
+    char     magic[8];  /**< BOOK_MAGIC, complété par '\0' */
+    uint32_t version;   /**< BOOK_VERSION */
+    uint32_t count;     /**< Nombre d'entrées */
+} BookHeader;
+
+/** @brief Entrée du livre (16 octets) : un coup d'une position. */
+typedef struct {
+    uint64_t key;       /**< Clé de Zobrist de la position (GameState::hash) */
+    uint8_t  from_sq;   /**< Case de départ (0-80) */
+    uint8_t  to_sq;     /**< Case d'arrivée (0-80) */
+    uint16_t weight;    /**< Poids du coup (> 0) */
+    uint32_t reserved;  /**< Zéro */
+} BookEntry;
+
+/**
+ * @brief Projette un livre en mémoire ; remplace le livre courant.
+ * @param path fichier du livre
+ * @return 0 si succès, -1 si le fichier est absent ou invalide (livre courant fermé)
+ */
+int book_open(const char *path);
+
+/** @brief Ferme le livre courant (sans effet si aucun). */
+void book_close(void);
+
+/** @brief Nombre d'entrées du livre courant (0 si aucun). */
+size_t book_size(void);
+
+/**
+ * @brief Coups du livre pour une position, vérifiés contre les règles.
+ * @param s état du jeu (synchronisé)
+ * @param moves coups trouvés (retour, au plus `max`, par poids décroissant)
+ * @param weights poids des coups (retour, peut être NULL)
+ * @param max taille des tableaux
+ * @return nombre de coups
+ */
+int book_probe_moves(const GameState *s, Move *moves, int *weights, int max);
+
+/** Graine utilisée par book_probe() quand l'état du tirage est nul. */
+#define BOOK_DEFAULT_SEED 0x424F4F4B4B524F4AULL
+
+/**
+ * @brief Tire un coup du livre au hasard, proportionnellement aux poids.
+ *
+ * Aucun état global : chaque appelant (partie, recherche) tient le sien,
+ * et une même graine donne les mêmes tirages.
+ * @param s état du jeu (synchronisé)
+ * @param rng état du tirage, avancé à chaque tirage (0 : BOOK_DEFAULT_SEED)
+ * @param out coup tiré (retour)
+ * @return 1 si la position est dans le livre, 0 sinon
+ */
+int book_probe(const GameState *s, uint64_t *rng, Move *out);
+
+/**
+ * @brief Accumulateur de coups avant écriture d'un livre
+ */
+typedef struct {
+    BookEntry *entries; /**< Coups ajoutés (non triés, doublons possibles) */
+    size_t count;       /**< Entrées utilisées */
+    size_t cap;         /**< Entrées allouées */
+} BookBuilder;
+
+/** @brief Prépare un accumulateur vide. */
+void book_builder_init(BookBuilder *b);
+
+/**
+ * @brief Ajoute un coup joué depuis une position.
+ * @param b accumulateur
+ * @param s position avant le coup (hachage à jour)
+ * @param mv coup joué
+ * @param weight poids à ajouter (ignoré si <= 0)
+ * @return 0 si succès, -1 si la mémoire manque
+ */
+int book_builder_add(BookBuilder *b, const GameState *s, const Move *mv, int weight);
+
+/**
+ * @brief Trie, fusionne les doublons (poids additionnés, plafonnés à 65535) et écrit le livre.
+ * @param b accumulateur (trié au retour)
+ * @param path fichier à écrire
+ * @return nombre d'entrées écrites, -1 en cas d'erreur d'écriture
+ */
+long book_builder_write(BookBuilder *b, const char *path);
+
+/** @brief Libère un accumulateur. */
+void book_builder_free(BookBuilder *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOK_H
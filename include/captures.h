@@ -10,9 +10,10 @@
  * (encadrement) et Seltou (arrière vide), ainsi que la règle
  * d'auto-défaite spécifique au jeu.
  *
- * Ces fonctions mettent à jour l'état global (tableau `pieces[]`,
- * `cell_control`, scores) et appellent le module `status` pour afficher
- * des messages de victoire si nécessaire.
+ * Les règles sont évaluées par rules.h sur une copie de l'état ; ces
+ * fonctions reportent ensuite le résultat sur l'état global (tableau
+ * `pieces[]`, `cell_control`, scores) et appellent le module `status` pour
+ * afficher des messages de victoire si nécessaire.
  */
 
 /**
@@ -1,5 +1,6 @@
 #ifndef DRAWING_H
 #define DRAWING_H
+#include <stdint.h>
 #include "app.h"
 
 /**
@@ -8,6 +9,13 @@
  *
  * Contient la callback de dessin utilisée par GTK et des helpers pour
  * convertir un clic en indices de cellule (row/col).
+ *
+ * GTK 4 redessine toujours toute la zone : draw_cb() garde donc son propre
+ * rendu du plateau d'un dessin à l'autre. La grille, les repères et les
+ * logos mis à l'échelle forment une couche fixe, refaite quand la taille de
+ * la zone ou des cases change. Une signature par case (voir
+ * drawing_board_signature()) dit quelles cases un coup a changées : seules
+ * celles-là sont redessinées avant la copie du rendu sur la zone.
  */
 
 /**
@@ -24,6 +32,19 @@
  */
 void draw_cb(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data);
 
+/**
+ * @brief Signature de chaque case : ce que draw_cb() doit y montrer.
+ *
+ * Contrôle, point jouable, pièce (couleur, type, sélection) ; deux cases
+ * de même signature se dessinent de la même façon.
+ *
+ * @param sig signatures des cases `row * 9 + col` (retour)
+ */
+void drawing_board_signature(uint16_t sig[81]);
+
+/** @brief Libère les couches et les logos mis en cache par draw_cb() (refaits au prochain dessin). */
+void drawing_cache_clear(void);
+
 /**
  * @brief Convertit des coordonnées x,y (pixels) en indices de cellule.
  *
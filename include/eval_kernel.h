@@ -0,0 +1,83 @@
+#ifndef EVAL_KERNEL_H
+#define EVAL_KERNEL_H
+
+#include "rules.h" /* GameState */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file eval_kernel.h
+ * @brief Noyau vectoriel des termes de l'évaluation (contrôle, occupation, mobilité).
+ *
+ * Calcule en une passe, pour les deux couleurs d'une position :
+ * - le nombre de pièces (popcount de `occ`) ;
+ * - le nombre de cases contrôlées (popcount de `control`) ;
+ * - la mobilité en ligne droite : nombre de couples (pièce, destination),
+ *   comme bb_rook_mobility().
+ *
+ * Les remplissages des quatre directions sont faits sans boucle dépendant
+ * des données (remplissage Kogge-Stone en trois pas : 1, 2 puis 4 cases,
+ * puis un dernier décalage). Chaque bitboard de 81 cases est coupé en deux
+ * mots de 64 bits ; un registre vectoriel traite une couleur par mot de
+ * 64 bits :
+ * - SSE2 et NEON : bleu et rouge d'une position par registre ;
+ * - AVX2 : deux positions par registre (lot d'au moins deux positions) ;
+ * - scalaire : le même calcul sur `unsigned __int128`.
+ *
+ * La variante est choisie au premier appel selon le processeur (AVX2 testé
+ * à l'exécution, SSE2/NEON selon la cible de compilation) et peut être
+ * forcée avec eval_set_kernel(). Toutes les variantes rendent exactement
+ * les mêmes valeurs.
+ */
+
+/** @brief Variante du noyau. */
+typedef enum {
+    EVAL_KERNEL_AUTO,   /**< Meilleure variante disponible */
+    EVAL_KERNEL_SCALAR, /**< C portable (`unsigned __int128`) */
+    EVAL_KERNEL_SSE2,   /**< x86-64, 2 couleurs par registre */
+    EVAL_KERNEL_AVX2,   /**< x86-64 avec AVX2, 2 positions par registre */
+    EVAL_KERNEL_NEON    /**< ARM (AArch64 / NEON), 2 couleurs par registre */
+} EvalKernel;
+
+/** @brief Termes de l'évaluation d'une position, par couleur ([0] bleu, [1] rouge). */
+typedef struct {
+    int pieces[2];    /**< Pièces sur le plateau */
+    int control[2];   /**< Cases contrôlées */
+    int mobility[2];  /**< Déplacements en ligne droite (pièce, destination) */
+} EvalFeatures;
+
+/**
+ * @brief Termes de l'évaluation d'une position.
+ * @param s état du jeu (bitboards à jour)
+ * @param out termes calculés (retour)
+ */
+void eval_features(const GameState* s, EvalFeatures* out);
+
+/**
+ * @brief Termes de l'évaluation d'un lot de positions (feuilles d'un même nœud, par exemple).
+ * @param states positions (bitboards à jour)
+ * @param n nombre de positions
+ * @param out `n` résultats, dans l'ordre de `states` (retour)
+ */
+void eval_features_batch(const GameState* const* states, int n, EvalFeatures* out);
+
+/**
+ * @brief Choisit la variante du noyau.
+ * @param k variante (EVAL_KERNEL_AUTO = détection)
+ * @return 0 si la variante est disponible sur ce processeur, -1 sinon (variante inchangée)
+ */
+int eval_set_kernel(EvalKernel k);
+
+/** @brief Variante utilisée (jamais EVAL_KERNEL_AUTO). */
+EvalKernel eval_get_kernel(void);
+
+/** @brief Nom court d'une variante ("scalaire", "sse2", "avx2", "neon" ou "auto"). */
+const char* eval_kernel_name(EvalKernel k);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVAL_KERNEL_H
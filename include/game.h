@@ -3,6 +3,7 @@
 #include "app.h"
 #include <gtk/gtk.h>  /* gboolean */
 #include "ia.h"       /* GameState, Move */
+#include "sync.h"     /* SyncState */
 
 /**
  * @file game.h
@@ -141,6 +142,41 @@ extern char ia_color;
  */
 extern int ia_both_active;
 
+/**
+ * @brief Réflexion anticipée de l'IA (option `-p`)
+ * 
+ * Pendant le tour de l'adversaire humain (local ou réseau), l'IA approfondit
+ * la position issue du coup qu'elle prévoit, ou à défaut la position courante.
+ * La recherche suivante réutilise ce travail via la table de transposition.
+ * - 0 : Désactivée (l'IA attend sans calculer)
+ * - 1 : Activée
+ * 
+ * @note Sans effet en mode IA vs IA
+ */
+extern int ia_pondering;
+
+/**
+ * @brief Active ou désactive la réflexion anticipée (option `-p`).
+ * @param on 1 pour l'activer, 0 pour la couper
+ */
+void ia_set_pondering(int on);
+
+/**
+ * @brief Statistiques de recherche de l'IA (option `-v`)
+ * 
+ * Après chaque coup de l'IA, affiche les statistiques de la recherche
+ * (ia_get_search_stats(), ia_print_search_stats()).
+ * - 0 : Désactivées
+ * - 1 : Activées
+ */
+extern int ia_verbose;
+
+/**
+ * @brief Active ou désactive les statistiques de recherche après chaque coup (option `-v`).
+ * @param on 1 pour les afficher, 0 pour les masquer
+ */
+void ia_set_verbose(int on);
+
 /**
  * @brief Profondeur de recherche de l'algorithme Minimax
  * 
@@ -153,6 +189,9 @@ extern int ia_both_active;
  * Une profondeur de N examine environ 20^N positions.
  * 
  * @note Une profondeur > 6 peut causer des ralentissements
+ * @note Utilisée par trouverMeilleurCoupIA() à profondeur fixe ; en partie,
+ *       trigger_ia_move() cherche aussi profond que le permet le temps par
+ *       coup (option `-t`, voir ia_set_time_budget())
  */
 extern int ia_search_depth;
 
@@ -162,6 +201,12 @@ extern int ia_search_depth;
 /** @brief Charge la configuration par défaut des pièces sur le plateau. */
 void game_setup_default(void);
 
+/**
+ * @brief Position de départ : trait aux bleus, tour 1, partie en cours ; globales de game.c mises à jour.
+ * @return état synchronisé (hachage compris) de la position initiale
+ */
+GameState game_start_state(void);
+
 /**
  * @brief Définit la position courante à partir d'un tableau de pièces.
  * @param arr tableau de `Piece` contenant la position
@@ -220,8 +265,36 @@ void snapshot_initial_state(void);
 /** Restaure l'état initial précédemment sauvegardé. */
 void restore_initial_state(void);
 
+/**
+ * @brief Copie la partie courante (`pieces[]`, `cell_control`, trait, tour) dans un GameState.
+ * @return état synchronisé, prêt pour rules.h et la recherche de l'IA
+ */
+GameState createGameStateFromCurrent(void);
+
+/**
+ * @brief Instantané de la partie courante (`pieces[]`, `cell_control`, trait, tour, scores).
+ * @param out instantané (retour)
+ */
+void game_sync_store(SyncState *out);
+
+/**
+ * @brief Remplace la partie courante par un instantané (reprise après reconnexion).
+ *
+ * Les scores sont recalculés, la sélection effacée, l'historique des
+ * répétitions de l'IA repart de la position chargée. La recherche de l'IA en
+ * cours est annulée (ia_job_cancel()) ; `game_over` et le résultat affiché
+ * sont recalculés depuis la position (fin de partie ou limite de tours).
+ * @param in instantané reçu
+ * @return 0 si succès, -1 si l'instantané est invalide (partie inchangée)
+ */
+int game_sync_load(const SyncState *in);
+
 /* Fonctions IA */
-/** Callback GTK pour déclencher un mouvement de l'IA (utilisé par un timer). */
+/** Vide l'historique des positions de l'IA puis y place la position courante. */
+void reset_move_history(void);
+
+/** Callback GTK pour déclencher un mouvement de l'IA (utilisé par un timer).
+ *  La recherche est lancée en arrière-plan (ia_job.h) et le coup joué à son retour. */
 gboolean trigger_ia_move(gpointer user_data);
 
 #endif // GAME_H
@@ -0,0 +1,80 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "bitboard.h"
+
+/**
+ * @file geometry.h
+ * @brief Tables géométriques précalculées du plateau 9x9.
+ *
+ * Les tables sont générées à la compilation (macros dans geometry.c) et
+ * remplacent les boucles `dr[4]/dc[4]` + tests de limites des règles et de
+ * la recherche. Les cases sont indexées comme les bitboards (`sq = row * 9 + col`)
+ * et les directions dans l'ordre historique du code :
+ * - 0 : haut   (ligne - 1)
+ * - 1 : bas    (ligne + 1)
+ * - 2 : gauche (colonne - 1)
+ * - 3 : droite (colonne + 1)
+ *
+ * La direction opposée à `d` est `d ^ 1`. Une case hors plateau vaut -1.
+ */
+
+/** Nombre de directions orthogonales. */
+#define GEO_DIRS 4
+/** Longueur maximale d'un rayon (bord à bord). */
+#define GEO_RAY_MAX 8
+
+/**
+ * @struct GeoPair
+ * @brief Les deux cases qui suivent une case dans une direction
+ *
+ * - Linca : `near` est la pièce encadrée, `far` l'alliée qui ferme l'encadrement.
+ * - Seltou : `near` est l'ennemi poussé par le coup, `far` la case qui le protège.
+ */
+typedef struct {
+    signed char near; /**< Case voisine (-1 hors plateau) */
+    signed char far;  /**< Case à deux pas (-1 hors plateau) */
+} GeoPair;
+
+/** Cases voisine et suivante pour chaque [case][direction]. */
+extern const GeoPair geo_pair[81][GEO_DIRS];
+
+/** Cases d'un rayon, de la plus proche au bord, complétées par -1 : [case][direction][pas - 1]. */
+extern const signed char geo_ray_sq[81][GEO_DIRS][GEO_RAY_MAX];
+
+/** Rayon sous forme de bitboard (case de départ exclue) : [case][direction]. */
+extern const Bitboard geo_ray[81][GEO_DIRS];
+
+/**
+ * @brief Direction d'un déplacement orthogonal.
+ * @param from case de départ
+ * @param to case d'arrivée
+ * @return direction 0-3, ou -1 si le déplacement n'est pas orthogonal
+ */
+static inline int geo_dir(int from, int to) {
+    int fr = from / 9, fc = from % 9, tr = to / 9, tc = to % 9;
+    if (fc == tc && tr != fr) return (tr < fr) ? 0 : 1;
+    if (fr == tr && tc != fc) return (tc < fc) ? 2 : 3;
+    return -1;
+}
+
+/**
+ * @brief Cases atteignables en glissant depuis `sq` dans une direction.
+ *
+ * Le rayon est coupé à la première case occupée (exclue) : la plus proche
+ * est le bit de poids faible pour les directions croissantes (bas, droite),
+ * le bit de poids fort sinon.
+ * @param sq case de départ
+ * @param d direction
+ * @param occ cases occupées
+ * @return bitboard des destinations
+ */
+static inline Bitboard geo_slide(int sq, int d, Bitboard occ) {
+    Bitboard ray = geo_ray[sq][d];
+    Bitboard blockers = ray & occ;
+    if (!blockers) return ray;
+    int first = (d & 1) ? bb_lsb(blockers) : bb_msb(blockers);
+    return ray & ~(geo_ray[first][d] | bb_bit(first));
+}
+
+#endif // GEOMETRY_H
@@ -2,6 +2,8 @@
 #define IA_H
 
 #include "app.h"  /* définit Piece, pieces[], piece_count */
+#include "bitboard.h"
+#include "rules.h" /* GameState, Move, MoveUndo */
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,11 +48,13 @@ extern "C" {
  * - Structure défensive (40 points par pièce protégée)
  *
  * \subsection move_order Ordonnancement des Coups
- * Les coups sont examinés dans cet ordre :
- * 1. Captures (priorité maximale)
- * 2. Mouvements vers le centre
- * 3. Mouvements défensifs
- * 4. Autres mouvements
+ * Les coups sont classés par tranches puis sélectionnés un à un (sans tri
+ * complet, une coupure arrivant souvent dès les premiers coups) :
+ * 1. Coup mémorisé dans la table de transposition
+ * 2. Captures et arrivée du roi dans la cité adverse
+ * 3. Coups tueurs (coups calmes ayant provoqué une coupure au même ply)
+ * 4. Coups calmes, selon l'historique des coupures puis vers le centre
+ * 5. Coups exposant le roi (vérifié seulement aux deux premiers plies)
  *
  * \section ai_optimize Optimisations
  * - Table de transposition (cache des positions)
@@ -58,190 +62,268 @@ extern "C" {
  * - Killer moves (coups qui causent des coupures)
  * - Fenêtre Alpha-Beta adaptative
  *
- * Fournit des structures légères (GameState, Move) et des fonctions
- * pour calculer un coup via minimax avec alpha-bêta.
+ * L'état (GameState, Move) et les règles (coups, captures, fins de partie)
+ * viennent de rules.h ; ce module calcule un coup via minimax avec alpha-bêta.
  */
 
+
 /**
- * @brief Structure représentant un mouvement de pièce dans le jeu Krojanty
- * 
- * Cette structure encode un mouvement complet d'une pièce, comprenant
- * son identifiant unique et ses coordonnées de départ et d'arrivée.
- * Elle est utilisée pour :
- * - Valider les mouvements selon les règles
- * - Transmettre les coups en mode réseau
- * - Analyser les positions par l'IA
- * - Enregistrer l'historique des coups
- *
- * La structure garantit qu'un mouvement est complètement spécifié
- * avec toutes les informations nécessaires pour le valider et
- * l'appliquer de manière cohérente.
- *
- * Exemple d'utilisation :
- * @code
- * Move best_move;
- * trouverMeilleurCoupIA(game_state, &best_move, 3);
- * if (is_move_valid(&best_move)) {
- *     apply_move(&best_move);
- * }
- * @endcode
+ * @brief Remplit `best_move` avec le meilleur coup trouvé par l'IA.
  *
- * @var Move::piece_index
- * Identifiant unique de la pièce :
- * - 0-9 : Pièces bleues (0=roi, 1-9=soldats)
- * - 10-19 : Pièces rouges (10=roi, 11-19=soldats)
- * 
- * @var Move::from_row
- * Ligne de départ :
- * - 0-8 : Position valide sur le plateau
- * - -1 : Pièce capturée ou invalide
- * 
- * @var Move::from_col
- * Colonne de départ :
- * - 0-8 : Position valide sur le plateau
- * - -1 : Pièce capturée ou invalide
- * 
- * @var Move::to_row
- * Ligne d'arrivée :
- * - 0-8 : Position valide sur le plateau
- * Doit respecter les règles de déplacement (orthogonal)
- * 
- * @var Move::to_col
- * Colonne d'arrivée :
- * - 0-8 : Position valide sur le plateau
- * Doit respecter les règles de déplacement (orthogonal)
- * 
- * @see GameState
- * @see trouverMeilleurCoupIA()
- * @note Un mouvement peut déclencher des captures Linca ou Seultou
- * @warning Vérifiez la validité du mouvement avant de l'appliquer
+ * Si un livre d'ouverture est ouvert (book_open()) et contient la position,
+ * son coup est rendu sans recherche ; de même pour les recherches limitées
+ * en temps.
+ * @param jeu état du jeu (modifié localement pendant la recherche)
+ * @param best_move sortie contenant le coup choisi
+ * @param profondeur profondeur de recherche (0 = heuristique immédiate)
  */
+void trouverMeilleurCoupIA(GameState* jeu, Move* best_move, int profondeur);
+
+/** Longueur maximale de la variante principale rapportée dans IaSearchStats. */
+#define IA_MAX_PV 16
+
 /**
- * @struct Move
- * @brief Structure représentant un mouvement de pièce dans le jeu Krojanty
+ * @brief Statistiques de la dernière recherche terminée (thread principal)
  *
- * Cette structure est l'unité fondamentale de mouvement du jeu. Elle encode
- * complètement un déplacement de pièce en stockant :
- * - L'identifiant unique de la pièce déplacée
- * - Sa position de départ sur le plateau
- * - Sa position d'arrivée sur le plateau
- *
- * Elle est utilisée par plusieurs composants du jeu :
- * - Le module de règles pour valider les mouvements
- * - L'IA pour analyser et évaluer les coups possibles
- * - Le module réseau pour synchroniser les mouvements
- * - L'interface graphique pour afficher les coups
+ * Remplies par trouverMeilleurCoupIA() et les recherches limitées en temps,
+ * y compris la réflexion anticipée. Les compteurs sont ceux du thread
+ * appelant ; les threads auxiliaires Lazy SMP ne sont comptés que dans
+ * `threads`.
  */
 typedef struct {
-    int piece_index;        /**< Index dans le tableau pieces[] */
-    int from_row, from_col; /**< Position de départ */
-    int to_row,   to_col;   /**< Position d'arrivée */
-} Move;
+    unsigned long long nodes;         /**< Nœuds visités (quiescence comprise) */
+    unsigned long long qnodes;        /**< Nœuds de quiescence */
+    unsigned long long cutoffs;       /**< Coupures beta hors quiescence */
+    unsigned long long first_cutoffs; /**< Coupures obtenues dès le premier coup essayé */
+    unsigned long long tt_probes;     /**< Consultations de la table de transposition */
+    unsigned long long tt_hits;       /**< Consultations ayant trouvé la position */
+    unsigned long long tb_hits;       /**< Positions résolues par la table de finales */
+    int depth;                        /**< Dernière profondeur terminée */
+    int score;                        /**< Score du coup rendu, pour le joueur au trait */
+    long long elapsed_us;             /**< Durée de la recherche (µs) */
+    int threads;                      /**< Threads de recherche utilisés */
+    int book;                         /**< 1 si le coup vient du livre d'ouverture (aucune recherche) */
+    int pv_length;                    /**< Nombre de coups dans `pv` */
+    Move pv[IA_MAX_PV];               /**< Variante principale (coup rendu en tête) */
+} IaSearchStats;
 
 /**
- * @brief Structure représentant l'état complet d'une partie de Krojanty
- * 
- * Cette structure fondamentale encapsule l'intégralité de l'état du jeu
- * à un instant donné. Elle inclut toutes les informations nécessaires pour :
- * - Représenter la position des pièces sur le plateau
- * - Gérer le contrôle territorial des cases
- * - Suivre l'état du tour et le compteur de coups
- * - Permettre à l'IA de simuler et évaluer des positions
- * - Sauvegarder/restaurer l'état du jeu
- *
- * C'est la structure de données centrale du jeu, utilisée par tous
- * les modules (interface graphique, réseau, IA) pour maintenir une
- * vue cohérente de la partie en cours.
- *
- * Exemple d'utilisation :
- * @code
- * GameState state = createGameStateFromCurrent();
- * if (isGameOver(&state)) {
- *     return evaluation(&state, 'B');
- * }
- * // Continuer l'analyse...
- * @endcode
- *
- * @var GameState::pieces
- * Tableau de toutes les pièces :
- * - [0-9] : Pièces bleues (0=roi, 1-9=soldats)
- * - [10-19] : Pièces rouges (10=roi, 11-19=soldats)
- * Chaque pièce inclut sa position et son type
+ * @brief Copie les statistiques de la dernière recherche terminée.
+ * @param out statistiques (retour ; tout à zéro avant la première recherche)
+ */
+void ia_get_search_stats(IaSearchStats* out);
+
+/**
+ * @brief Affiche des statistiques sur la sortie standard (une ligne, puis la variante).
  *
- * @var GameState::piece_count
- * Nombre de pièces encore en jeu :
- * - Initial : 20 (10 par camp)
- * - Mise à jour après chaque capture
- * - Utilisé pour la condition de victoire par extermination
+ * Nœuds par seconde, taux de coupure au premier coup et taux de réussite de
+ * la table de transposition sont déduits des compteurs. Les coups sont notés
+ * comme sur le réseau (colonne A-I, ligne 9-1 : `C7-C5`).
+ * @param st statistiques à afficher
+ */
+void ia_print_search_stats(const IaSearchStats* st);
+
+/** Temps de réflexion par coup par défaut (ms), voir ia_set_time_budget(). */
+#define IA_DEFAULT_TIME_MS 1000
+/** Plafond de temps de trouverMeilleurCoupIA_Rapide() (ms). */
+#define IA_RAPIDE_TIME_MS  150
+/** Profondeur maximale de l'approfondissement itératif. */
+#define IA_MAX_DEPTH       32
+/** Nombre maximal de threads de recherche (option `-j`). */
+#define IA_MAX_THREADS     64
+
+/**
+ * @brief Approfondissement itératif limité par un temps de réflexion.
  *
- * @var GameState::cell_control
- * Tableau de contrôle territorial [9][9] :
- * - 0 : Case neutre
- * - 1 : Case contrôlée par Bleu
- * - 2 : Case contrôlée par Rouge
- * Utilisé pour le calcul du score final si limite de tours atteinte
+ * Cherche aux profondeurs 1, 2, 3... en commençant chaque itération par le
+ * meilleur coup de la précédente, et s'interrompt proprement à l'échéance.
+ * Le coup rendu est celui de la dernière profondeur entièrement terminée.
+ * @param jeu état du jeu (modifié localement pendant la recherche)
+ * @param best_move sortie contenant le coup choisi
+ * @param budget_ms temps de réflexion en millisecondes
+ */
+void trouverMeilleurCoupIA_Temps(GameState* jeu, Move* best_move, int budget_ms);
+
+/**
+ * @brief trouverMeilleurCoupIA_Temps() interruptible depuis un autre thread.
  *
- * @var GameState::current_player
- * Indique le joueur actif :
- * - 'B' : Tour du joueur Bleu
- * - 'R' : Tour du joueur Rouge
+ * Utilisée par les recherches en arrière-plan (voir ia_job.h).
+ * @param jeu état du jeu (modifié localement pendant la recherche)
+ * @param best_move sortie contenant le coup choisi (piece_index = -1 si annulée)
+ * @param budget_ms temps de réflexion en millisecondes
+ * @param stop drapeau d'annulation lu atomiquement (NULL si aucun)
+ */
+void trouverMeilleurCoupIA_Annulable(GameState* jeu, Move* best_move, int budget_ms, const int* stop);
+
+/**
+ * @brief Réflexion anticipée (pondering) : approfondit `jeu` jusqu'à `*stop`.
  *
- * @var GameState::turn_number
- * Compteur de tours :
- * - Maximum 64 tours (32 par joueur)
- * - Utilisé pour la détection de boucles et fin de partie
+ * Ne rend aucun coup et ne touche pas à l'historique des coups joués ; la
+ * recherche suivante réutilise ce travail via la table de transposition.
+ * @param jeu position à approfondir (modifiée localement)
+ * @param stop drapeau d'arrêt lu atomiquement
+ */
+void ia_ponder(GameState* jeu, const int* stop);
+
+/** Nombre maximal de lignes d'une analyse (voir ia_analyse()). */
+#define IA_MAX_MULTIPV 8
+
+/** @brief Une ligne d'analyse : un coup de la racine, son score et la suite attendue */
+typedef struct {
+    int score;            /**< Score pour le joueur au trait */
+    int forced;           /**< 1 gain forcé, -1 perte forcée, 0 sinon */
+    int pv_length;        /**< Nombre de coups dans `pv` */
+    Move pv[IA_MAX_PV];   /**< Variante (coup de la racine en tête) */
+} IaAnalysisLine;
+
+/** @brief Analyse d'une position à une profondeur terminée */
+typedef struct {
+    uint64_t hash;              /**< Clé de Zobrist de la position analysée */
+    int depth;                  /**< Profondeur terminée */
+    int count;                  /**< Lignes, de la meilleure à la moins bonne */
+    unsigned long long nodes;   /**< Nœuds visités depuis le début de l'analyse */
+    long long elapsed_us;       /**< Durée depuis le début de l'analyse (µs) */
+    IaAnalysisLine lines[IA_MAX_MULTIPV]; /**< Lignes */
+} IaAnalysis;
+
+/**
+ * @brief Callback d'analyse, appelé sur le thread de l'analyse à chaque profondeur terminée.
+ * @param an analyse (valable pendant l'appel seulement)
+ * @param user_data donnée passée à ia_analyse()
+ */
+typedef void (*ia_analysis_cb)(const IaAnalysis* an, void* user_data);
+
+/**
+ * @brief Analyse à plusieurs variantes (multi-PV) par approfondissement itératif.
  *
- * @see Move
- * @see evaluation()
- * @see isGameOver()
- * @note Les cités ne sont pas comptabilisées dans le contrôle territorial
- * @warning Utilisez createGameStateFromCurrent() pour une copie valide
+ * À chaque profondeur, les `multipv` meilleurs coups de la racine sont
+ * cherchés l'un après l'autre, chaque recherche excluant les coups déjà
+ * classés ; `cb` reçoit alors les lignes triées. Une profondeur interrompue
+ * n'est pas rendue. Ni coup ni statistiques (ia_get_search_stats()) ne sont
+ * publiés : seul reste le contenu de la table de transposition, qu'une
+ * analyse ou une recherche suivante réutilise.
+ * @param jeu position à analyser (modifiée localement)
+ * @param multipv nombre de lignes (borné à 1..IA_MAX_MULTIPV)
+ * @param max_depth profondeur maximale (<= 0 : IA_MAX_DEPTH)
+ * @param stop drapeau d'arrêt lu atomiquement (NULL si aucun)
+ * @param cb callback de chaque profondeur terminée
+ * @param user_data donnée transmise au callback
  */
+void ia_analyse(GameState* jeu, int multipv, int max_depth, const int* stop, ia_analysis_cb cb, void* user_data);
+
 /**
- * @struct GameState
- * @brief Structure principale représentant l'état complet d'une partie de Krojanty
+ * @brief Coup attendu du joueur au trait d'après la table de transposition.
+ * @param jeu position (bitboards resynchronisés)
+ * @param reply sortie : coup prévu, légal dans `jeu`
+ * @return 1 si un coup est prévu, 0 sinon
+ */
+int ia_predict_reply(GameState* jeu, Move* reply);
+
+/** Approfondissement itératif avec le temps par coup configuré (ia_set_time_budget()). */
+void trouverMeilleurCoupIA_Adaptatif(GameState* jeu, Move* best_move);
+
+/** Approfondissement itératif en temps réduit (au plus IA_RAPIDE_TIME_MS). */
+void trouverMeilleurCoupIA_Rapide(GameState* jeu, Move* best_move);
+
+/**
+ * @brief Règle le temps de réflexion par coup (option `-t MS`).
+ * @param ms millisecondes par coup (<= 0 : IA_DEFAULT_TIME_MS)
+ */
+void ia_set_time_budget(int ms);
+
+/** @brief Temps de réflexion par coup courant, en millisecondes. */
+int ia_get_time_budget(void);
+
+/**
+ * @brief Règle le nombre de threads de recherche (option `-j N`).
  *
- * Cette structure est le cœur du jeu Krojanty, contenant toutes les informations
- * nécessaires pour représenter et manipuler une partie en cours. Elle inclut :
- * - La position et l'état de toutes les pièces
- * - Le contrôle territorial de chaque case
- * - Le joueur actif et le numéro du tour
+ * Avec N > 1, trouverMeilleurCoupIA() et trouverMeilleurCoupIA_Temps()
+ * lancent N - 1 threads auxiliaires (Lazy SMP) : chacun cherche sa propre
+ * copie de la position avec ses propres heuristiques d'ordonnancement, et
+ * tous partagent la table de transposition. Le coup rendu reste celui du
+ * thread appelant.
+ * @param n nombre de threads (borné à 1..IA_MAX_THREADS)
+ */
+void ia_set_threads(int n);
+
+/** @brief Nombre de threads de recherche courant (1 par défaut). */
+int ia_get_threads(void);
+
+/** Positions au plus d'un IaHistory (partie puis chemin de recherche). */
+#define IA_HISTORY_POSITIONS 256
+/** Cases du filtre de comptage d'un IaHistory. */
+#define IA_HISTORY_FILTER    1024
+
+/**
+ * @brief Positions d'une partie (hachages de Zobrist), de la plus ancienne à la plus récente
  *
- * Elle est utilisée pour :
- * - Gérer l'état du jeu en temps réel
- * - Permettre à l'IA de simuler des positions
- * - Sauvegarder/charger des parties
- * - Synchroniser l'état en mode réseau
- * - Valider les règles du jeu
+ * La recherche en prend une copie qu'elle prolonge avec son propre chemin.
+ * `filter[h & (IA_HISTORY_FILTER - 1)]` compte les positions qui tombent
+ * dans cette case : une case vide prouve l'absence de répétition sans
+ * parcourir la pile, qui n'est relue que pour confirmer l'égalité exacte.
  *
- * C'est la structure la plus importante du jeu car elle maintient
- * la cohérence de l'état entre tous les modules (GUI, IA, réseau).
+ * La partie de l'interface a son historique dans ia.c
+ * (ia_record_position()) ; une partie jouée ailleurs (selfplay, serveur,
+ * plusieurs parties dans un même processus) tient le sien et le passe à
+ * ia_search_game().
  */
 typedef struct {
-    Piece pieces[128];      /**< État des pièces */
-    int   piece_count;      /**< Nombre de pièces actives */
-    int   cell_control[9][9];/**< Contrôle des cases */
-    char  current_player;   /**< 'B' ou 'R' */
-    int   turn_number;      /**< Numéro du tour */
-} GameState;
-
-/* API publique utilisée par la GUI */
+    uint64_t hash[IA_HISTORY_POSITIONS];    /**< Hachages des positions */
+    int      count;                         /**< Nombre de positions */
+    uint16_t filter[IA_HISTORY_FILTER];     /**< Filtre de comptage */
+} IaHistory;
+
 /**
- * @brief Construit un `GameState` à partir de l'état global courant.
- * @return GameState copié (passage par valeur).
+ * @brief Vide un historique puis y place la position de départ.
+ * @param h historique (retour)
+ * @param start position de départ (hachage à jour)
  */
-GameState createGameStateFromCurrent(void);
+void ia_history_reset(IaHistory* h, const GameState* start);
 
 /**
- * @brief Remplit `best_move` avec le meilleur coup trouvé par l'IA.
+ * @brief Ajoute une position jouée à un historique (sans effet si c'est déjà la dernière).
+ * @param h historique
+ * @param s position atteinte (hachage à jour)
+ */
+void ia_history_record(IaHistory* h, const GameState* s);
+
+/**
+ * @brief Coup d'une partie qui tient son propre historique (selfplay, serveur).
+ *
+ * Comme trouverMeilleurCoupIA() (`profondeur` > 0) ou
+ * trouverMeilleurCoupIA_Annulable() (`profondeur` <= 0), mais les
+ * répétitions sont cherchées dans `history` et non dans l'historique de la
+ * partie de l'interface, et la table de finales compte avec `turn_limit`
+ * plutôt qu'avec max_turn. Le livre d'ouverture tire avec `book_rng`,
+ * propre à la partie, et non avec l'état des parties de l'interface.
  * @param jeu état du jeu (modifié localement pendant la recherche)
  * @param best_move sortie contenant le coup choisi
- * @param profondeur profondeur de recherche (0 = heuristique immédiate)
+ * @param profondeur profondeur fixe, ou <= 0 pour une recherche limitée en temps
+ * @param budget_ms temps de réflexion en millisecondes (si `profondeur` <= 0)
+ * @param stop drapeau d'annulation lu atomiquement (NULL si aucun)
+ * @param history positions de la partie jusqu'à `jeu` compris
+ * @param book_rng état du tirage du livre de la partie (voir book_probe() ; NULL : celui de l'interface)
+ * @param turn_limit limite de tours de la partie (0 = aucune), comme pour rules_play()
  */
-void trouverMeilleurCoupIA(GameState* jeu, Move* best_move, int profondeur);
-void trouverMeilleurCoupIA_Adaptatif(GameState* jeu, Move* best_move);
-void trouverMeilleurCoupIA_Rapide(GameState* jeu, Move* best_move);
-void reset_move_history(void);
+void ia_search_game(GameState* jeu, Move* best_move, int profondeur, int budget_ms, const int* stop,
+                    const IaHistory* history, uint64_t* book_rng, int turn_limit);
+
+/**
+ * @brief Enregistre une position atteinte dans la partie (détection des répétitions)
+ *
+ * Appelée par move_piece() après chaque coup joué. La recherche part de ces
+ * positions et y ajoute son propre chemin : une position déjà rencontrée,
+ * dans la partie ou plus haut dans l'arbre, est reconnue en O(1) par son
+ * hachage de Zobrist (pièces, contrôle et trait).
+ * @param s position atteinte
+ */
+void ia_record_position(const GameState* s);
+
+/**
+ * @brief Vide l'historique des positions puis y place une position de départ
+ * @param start position de départ (hachage à jour)
+ */
+void ia_reset_history(const GameState* start);
 
 /* Algorithmes/supports (utiles pour tests) */
 /** Minimax alpha-bêta, retourne une valeur d'évaluation. */
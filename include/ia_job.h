@@ -0,0 +1,68 @@
+#ifndef IA_JOB_H
+#define IA_JOB_H
+#include "app.h"
+#include "ia.h"
+
+/**
+ * @file ia_job.h
+ * @brief Recherche de l'IA en arrière-plan, sans bloquer la boucle GTK.
+ *
+ * Une tâche copie la position, la cherche sur un thread dédié avec
+ * trouverMeilleurCoupIA_Annulable() puis rend le coup sur le thread GTK via
+ * `g_idle_add`. Une seule tâche existe à la fois : en lancer une nouvelle
+ * annule la précédente. Une tâche annulée (reset de la partie, fermeture de
+ * la fenêtre) ne rappelle jamais son callback.
+ *
+ * Une tâche de réflexion anticipée (ia_job_ponder()) approfondit une position
+ * pendant le tour de l'adversaire sans rendre de coup ; elle est annulée par
+ * la recherche suivante, qui réutilise son travail via la table de
+ * transposition.
+ *
+ * @see trigger_ia_move() dans game.c
+ */
+
+/**
+ * @brief Callback de fin de tâche, appelé sur le thread GTK.
+ * @param root position cherchée (telle qu'au lancement de la tâche)
+ * @param best_move coup trouvé (piece_index = -1 si aucun)
+ * @param user_data donnée passée à ia_job_start()
+ */
+typedef void (*ia_job_done_cb)(const GameState *root, const Move *best_move, gpointer user_data);
+
+/**
+ * @brief Lance la recherche de `state` en arrière-plan (annule la tâche en cours).
+ * @param state position à chercher (copiée)
+ * @param budget_ms temps de réflexion en millisecondes
+ * @param done callback de fin, appelé depuis la boucle GTK
+ * @param user_data donnée transmise au callback
+ * @return 0 si la tâche est lancée, -1 sinon
+ */
+int ia_job_start(const GameState *state, int budget_ms, ia_job_done_cb done, gpointer user_data);
+
+/**
+ * @brief Lance une réflexion anticipée sur `state` (annule la tâche en cours).
+ *
+ * La tâche tourne jusqu'à son annulation par ia_job_start(), ia_job_cancel()
+ * ou ia_job_shutdown().
+ * @param state position à approfondir (copiée)
+ * @return 0 si la tâche est lancée, -1 sinon
+ */
+int ia_job_ponder(const GameState *state);
+
+/** @brief Annule la tâche en cours (son callback ne sera pas appelé). */
+void ia_job_cancel(void);
+
+/** @brief Indique si une tâche est en cours de recherche. */
+int ia_job_busy(void);
+
+/**
+ * @brief Attend la fin de la tâche en cours sans passer par la boucle GTK.
+ * @param best_move coup trouvé (retour, peut être NULL)
+ * @return 0 si une tâche a été attendue, -1 s'il n'y en avait pas
+ */
+int ia_job_wait(Move *best_move);
+
+/** @brief Annule la tâche en cours et attend l'arrêt de son thread (fermeture). */
+void ia_job_shutdown(void);
+
+#endif // IA_JOB_H
@@ -0,0 +1,113 @@
+#ifndef LOG_H
+#define LOG_H
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @file log.h
+ * @brief Journal asynchrone : enregistrements de taille fixe dans un anneau sans verrou, écrits par un thread.
+ *
+ * Les coups envoyés et reçus, les déplacements et les captures sont
+ * journalisés sur le thread de l'interface (ou du réseau) : un `printf`
+ * bloquant sur une sortie redirigée y ralentirait la partie. Ici, un appel
+ * formate son message dans un enregistrement de LOG_RECORD_TEXT octets
+ * d'un anneau de LOG_RING_SIZE cases, réservé par compare-and-swap (plusieurs
+ * threads peuvent écrire) ; un thread d'écriture vide l'anneau vers la
+ * sortie toutes les LOG_FLUSH_MS millisecondes. Anneau plein : le message
+ * est perdu et compté, l'appelant n'attend jamais.
+ *
+ * Chaque enregistrement porte son niveau et un horodatage monotone
+ * (secondes depuis log_start(), insensibles aux changements d'heure). Les
+ * macros LOG_ERROR() à LOG_DEBUG() testent le niveau avant tout formatage :
+ * un niveau coupé ne coûte qu'une comparaison. L'échantillonnage
+ * (log_set_sampling()) ne garde qu'un message INFO ou DEBUG sur N ; les
+ * erreurs et avertissements sont toujours gardés.
+ *
+ * Avant log_start() (tests, outils), et dans un processus fils créé par
+ * fork() (mode selfplay), les messages sont écrits directement sur la
+ * sortie, dans le même format.
+ *
+ * ```bash
+ * ./game -s -ia 5555 --log-level warn   # seuls les coups refusés et les erreurs
+ * ./game -l -ia -ia --log-sample 10     # un déplacement journalisé sur dix
+ * ```
+ */
+
+/** Cases de l'anneau (puissance de 2). */
+#define LOG_RING_SIZE   1024
+/** Texte d'un enregistrement, '\0' compris (au-delà : tronqué). */
+#define LOG_RECORD_TEXT 112
+/** Période d'écriture du thread du journal (ms). */
+#define LOG_FLUSH_MS    10
+
+/** @brief Niveau d'un message (et seuil du journal) */
+typedef enum {
+    LOG_LEVEL_OFF = 0, /**< Journal coupé (seuil seulement) */
+    LOG_LEVEL_ERROR,   /**< Erreur réseau ou de l'IA */
+    LOG_LEVEL_WARN,    /**< Coup refusé, déconnexion */
+    LOG_LEVEL_INFO,    /**< Coups, captures, connexions (seuil par défaut) */
+    LOG_LEVEL_DEBUG    /**< Détails */
+} LogLevel;
+
+/** @brief Compteurs du journal depuis le démarrage du programme */
+typedef struct {
+    long written; /**< Messages écrits sur la sortie */
+    long dropped; /**< Messages perdus, anneau plein */
+    long sampled; /**< Messages écartés par l'échantillonnage */
+} LogStats;
+
+/** Seuil courant (lu sans verrou par les macros ; voir log_set_level()). */
+extern int log_threshold;
+
+/** Un message de niveau `lvl` serait-il gardé ? */
+#define LOG_ENABLED(lvl) ((int)(lvl) <= __atomic_load_n(&log_threshold, __ATOMIC_RELAXED))
+
+/** Journalise au niveau `lvl`, sans rien formater si le niveau est coupé. */
+#define LOG_AT(lvl, ...) do { if (LOG_ENABLED(lvl)) log_write((lvl), __VA_ARGS__); } while (0)
+/** Message d'erreur. */
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+/** Message d'avertissement. */
+#define LOG_WARN(...)  LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+/** Message d'information. */
+#define LOG_INFO(...)  LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+/** Message de détail. */
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/**
+ * @brief Démarre le thread d'écriture du journal.
+ * @param out sortie du journal (NULL = stdout)
+ * @return 0 si succès (ou déjà démarré), -1 si le thread n'a pas pu être créé
+ */
+int log_start(FILE *out);
+
+/** @brief Arrête le thread d'écriture après avoir vidé l'anneau (sans effet s'il est arrêté). */
+void log_stop(void);
+
+/** @brief Change le seuil du journal. */
+void log_set_level(LogLevel level);
+
+/**
+ * @brief Échantillonnage des messages INFO et DEBUG.
+ * @param every un message sur `every` est gardé (<= 1 : tous)
+ */
+void log_set_sampling(int every);
+
+/**
+ * @brief Lit un nom de niveau : off, error, warn, info, debug.
+ * @param name texte à analyser
+ * @param out niveau (retour)
+ * @return 0 si succès, -1 si le nom est inconnu
+ */
+int log_parse_level(const char *name, LogLevel *out);
+
+/**
+ * @brief Ajoute un message au journal (utiliser les macros LOG_INFO()...).
+ * @param level niveau du message
+ * @param fmt format printf
+ */
+void log_write(LogLevel level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/** @brief Compteurs du journal. */
+void log_get_stats(LogStats *out);
+
+#endif
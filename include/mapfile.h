@@ -0,0 +1,39 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mapfile.h
+ * @brief Projection d'un fichier en lecture seule, commune au livre, à la table de finales et aux parties.
+ *
+ * Le fichier est projeté en lecture seule (mmap) ; sous Windows il est lu
+ * en mémoire d'un bloc. Dans les deux cas la zone se libère par
+ * unmap_file() avec la longueur rendue par map_file().
+ */
+
+/**
+ * @brief Projette un fichier non vide en mémoire.
+ * @param path fichier à lire
+ * @param data début de la zone (retour)
+ * @param len taille du fichier en octets (retour)
+ * @return 0 si succès, -1 si le fichier est absent, vide ou illisible (`*data` et `*len` inchangés)
+ */
+int map_file(const char *path, void **data, size_t *len);
+
+/**
+ * @brief Libère une zone rendue par map_file() (sans effet sur NULL).
+ * @param data début de la zone
+ * @param len taille rendue par map_file()
+ */
+void unmap_file(void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAPFILE_H
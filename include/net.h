@@ -1,6 +1,7 @@
 #ifndef NET_H
 #define NET_H
 #include <args.h>
+#include <stddef.h>
 
 /**
  * @file net.h
@@ -77,7 +78,7 @@
  * \subsection net_notes Notes Importantes
  * - Le serveur doit être lancé avant le client
  * - Le port doit être le même des deux côtés
- * - En cas de déconnexion, la partie est sauvegardée
+ * - En cas de déconnexion, la partie reprend à la reconnexion du client
  * - Le serveur valide tous les mouvements
  * - Les messages d'erreur réseau sont affichés dans la GUI
  * 
@@ -105,14 +106,46 @@
  * - DRAW_DECLINE
  *
  * \subsection sync_protocol Synchronisation
- * - SYNC_REQUEST
- * - SYNC_STATE <état_complet>
- * - PING
- * - PONG
+ * Trames de contrôle, charge au format SyncState (voir sync.h) :
+ * - SYNC_REQUEST (NET_CTRL_SYNC_REQUEST) : le client demande la position,
+ *   à chaque connexion et après une désynchronisation
+ * - SYNC_STATE (NET_CTRL_SYNC_STATE) : réponse du serveur, l'instantané de
+ *   SYNC_STATE_SIZE octets ; le client remplace sa partie par celle-ci
+ * - CHECK (NET_CTRL_CHECK) : après chaque coup envoyé, les 4 octets de la
+ *   somme de contrôle de la position obtenue ; une différence avec la
+ *   position locale déclenche une resynchronisation
+ *
+ * La partie du serveur fait foi. Tant que le client attend SYNC_STATE, il
+ * ignore les coups et CHECK reçus (déjà compris dans l'instantané) et
+ * net_waiting() reste vrai. Le serveur `--serve` répond à SYNC_REQUEST
+ * mais n'envoie jamais CHECK.
+ *
+ * \subsection reconnect_protocol Reconnexion
+ * Une connexion perdue en cours de partie (fermeture ou adversaire muet)
+ * ne la termine plus : le serveur rouvre son écoute, gardée ouverte pendant
+ * la partie, et le client retente sa connexion NET_RECONNECT_ATTEMPTS fois,
+ * toutes les NET_RECONNECT_DELAY_MS ms. La reprise passe par un seul
+ * SYNC_STATE ; un coup joué par l'IA pendant la coupure y est compris.
+ *
+ * \subsection ctrl_protocol Canal de contrôle
+ * Entre les coups, des trames de contrôle commencent par NET_CTRL_MARK
+ * (jamais une colonne) : la marque, un type, la longueur de la charge sur
+ * deux octets (poids faible d'abord) puis la charge. Un type inconnu est
+ * ignoré.
+ * - PING (NET_CTRL_PING) : 8 octets opaques, renvoyés tels quels
+ * - PONG (NET_CTRL_PONG) : la charge du PING reçu
+ *
+ * Chaque côté de `--server` / `--client` envoie un PING toutes les
+ * `--ping-interval` ms (NET_PING_INTERVAL_MS par défaut) et mesure le temps
+ * d'aller-retour à son PONG ; les percentiles s'affichent dans la barre de
+ * statut et le journal. Sans aucun octet reçu pendant NET_PEER_TIMEOUT_PINGS
+ * intervalles, l'adversaire est déclaré perdu. `--no-ping` coupe l'envoi
+ * (adversaire d'une version sans canal de contrôle) ; les PING reçus ont
+ * toujours leur réponse.
  *
  * \section error_handling Gestion des Erreurs
  * - Timeout de connexion : 30 secondes
- * - Retry sur perte de connexion : 3 tentatives
+ * - Retry sur perte de connexion : NET_RECONNECT_ATTEMPTS tentatives du client
  * - Validation des messages
  * - Détection de déconnexion
  *
@@ -153,7 +186,214 @@ extern SOCKET g_socket;
  */
 extern char my_color;
 
+/** Longueur d'un coup sur le réseau ("A1B2" : départ puis arrivée). */
+#define NET_MOVE_LEN 4
+/** Taille du tampon de réception d'une connexion (une trame de contrôle complète y tient). */
+#define NET_RECV_BUFFER 256
+/** Taille de la file d'envoi d'une connexion (plusieurs trames de contrôle complètes). */
+#define NET_SEND_BUFFER 1024
+
+/** Premier octet d'une trame de contrôle (ni 'A'-'I' ni 'a'-'i' : jamais le début d'un coup). */
+#define NET_CTRL_MARK '#'
+/** En-tête d'une trame de contrôle : marque, type, longueur de la charge (2 octets). */
+#define NET_CTRL_HEADER 4
+/** Charge maximale d'une trame de contrôle. */
+#define NET_CTRL_MAX_PAYLOAD 192
+/** Type de trame : demande d'écho. */
+#define NET_CTRL_PING 'P'
+/** Type de trame : écho d'un PING. */
+#define NET_CTRL_PONG 'O'
+/** Type de trame : demande de la position (client vers serveur). */
+#define NET_CTRL_SYNC_REQUEST 'Q'
+/** Type de trame : instantané de la position (SyncState). */
+#define NET_CTRL_SYNC_STATE 'S'
+/** Type de trame : somme de contrôle de la position après un coup. */
+#define NET_CTRL_CHECK 'C'
+/** Tentatives de reconnexion du client après une connexion perdue. */
+#define NET_RECONNECT_ATTEMPTS 3
+/** Délai avant chaque tentative de reconnexion (ms). */
+#define NET_RECONNECT_DELAY_MS 1000
+/** Intervalle par défaut entre deux PING (ms). */
+#define NET_PING_INTERVAL_MS 2000
+/** Intervalles de PING sans rien recevoir avant de déclarer l'adversaire perdu. */
+#define NET_PEER_TIMEOUT_PINGS 5
+/** Mesures d'aller-retour conservées pour les percentiles. */
+#define NET_RTT_SAMPLES 128
+/** Une ligne de percentiles dans le journal toutes les N mesures. */
+#define NET_RTT_LOG_EVERY 30
+
+/**
+ * @brief Tampon de réception réutilisé pour toute la connexion
+ *
+ * Les octets reçus s'accumulent dans `data` ; les coups complets en sont
+ * extraits sans copie ni allocation, un coup coupé en deux lectures
+ * attend la suite. Le reste non lu est ramené en tête avant chaque lecture.
+ */
+typedef struct {
+    char   data[NET_RECV_BUFFER]; /**< Octets reçus */
+    size_t start;                 /**< Premier octet non traité */
+    size_t len;                   /**< Fin des octets reçus */
+} NetRecvBuffer;
+
+/**
+ * @brief File d'envoi d'une socket non bloquante
+ *
+ * Les octets que la socket ne prend pas tout de suite y attendent qu'elle
+ * redevienne inscriptible ; l'ordre des trames est conservé. Le reste non
+ * envoyé est ramené en tête avant chaque ajout.
+ */
+typedef struct {
+    unsigned char data[NET_SEND_BUFFER]; /**< Octets à envoyer */
+    size_t start;                        /**< Premier octet pas encore envoyé */
+    size_t len;                          /**< Fin des octets en attente */
+} NetSendBuffer;
+
+/**
+ * @brief Trame extraite du tampon de réception : un coup, ou une trame de contrôle.
+ */
+typedef struct {
+    char type;                                   /**< 0 pour un coup, sinon type de contrôle (NET_CTRL_PING...) */
+    char move[NET_MOVE_LEN + 1];                 /**< Coup, si `type` vaut 0 */
+    size_t len;                                  /**< Longueur de la charge */
+    unsigned char payload[NET_CTRL_MAX_PAYLOAD]; /**< Charge d'une trame de contrôle */
+} NetFrame;
+
+/**
+ * @brief Temps d'aller-retour mesurés par PING / PONG (NET_RTT_SAMPLES dernières mesures).
+ */
+typedef struct {
+    int count;      /**< Mesures conservées (0 = aucune) */
+    double last_ms; /**< Dernière mesure */
+    double p50_ms;  /**< Médiane */
+    double p90_ms;  /**< 90e percentile */
+    double p99_ms;  /**< 99e percentile */
+} NetRttStats;
+
+/** Vide un tampon de réception. */
+void net_recv_reset(NetRecvBuffer* rb);
+
+/** Lit ce que la socket a de disponible dans le tampon (un seul recv, à appeler quand la socket est lisible).
+ * @param rb tampon de réception
+ * @param s socket connectée
+ * @return octets lus, 0 si la connexion est fermée, négatif en cas d'erreur
+ */
+int net_recv_fill(NetRecvBuffer* rb, SOCKET s);
+
+/** Extrait la prochaine trame complète du tampon.
+ * @param rb tampon de réception
+ * @param frame trame extraite (retour)
+ * @return 1 si une trame a été extraite, 0 s'il faut attendre d'autres octets,
+ *         -1 si la trame de contrôle annonce une charge trop longue (connexion à fermer)
+ */
+int net_recv_frame(NetRecvBuffer* rb, NetFrame* frame);
+
+/** Extrait le prochain coup complet du tampon, en sautant les trames de contrôle.
+ * @param rb tampon de réception
+ * @param move coup extrait (retour, NET_MOVE_LEN caractères et '\0')
+ * @return 1 si un coup a été extrait, 0 s'il faut attendre d'autres octets
+ */
+int net_recv_next(NetRecvBuffer* rb, char move[NET_MOVE_LEN + 1]);
+
+/** Vide une file d'envoi. */
+void net_send_reset(NetSendBuffer* sb);
+
+/** Ajoute des octets en fin de file d'envoi, d'un bloc.
+ * @param sb file d'envoi
+ * @param data octets à envoyer
+ * @param len nombre d'octets
+ * @return 0 si succès, -1 si la file n'a pas la place (rien n'est ajouté)
+ */
+int net_send_queue(NetSendBuffer* sb, const void* data, size_t len);
+
+/** Ajoute une trame de contrôle en fin de file d'envoi.
+ * @param sb file d'envoi
+ * @param type type de la trame (NET_CTRL_PING...)
+ * @param payload charge (peut être NULL si `len` vaut 0)
+ * @param len longueur de la charge (au plus NET_CTRL_MAX_PAYLOAD)
+ * @return 0 si succès, -1 si la charge est trop longue ou la file pleine
+ */
+int net_send_queue_control(NetSendBuffer* sb, char type, const void* payload, size_t len);
+
+/** Envoie ce que la socket non bloquante accepte de la file, sans attendre.
+ * @param sb file d'envoi
+ * @param s socket connectée (non bloquante)
+ * @return octets encore en attente (0 = file vide), -1 si la connexion est perdue
+ */
+int net_send_flush(NetSendBuffer* sb, SOCKET s);
+
+/** Envoie une trame de contrôle.
+ * @param s socket connectée
+ * @param type type de la trame (NET_CTRL_PING...)
+ * @param payload charge (peut être NULL si `len` vaut 0)
+ * @param len longueur de la charge (au plus NET_CTRL_MAX_PAYLOAD)
+ * @return 0 si succès, -1 sinon
+ */
+int net_send_control(SOCKET s, char type, const void* payload, size_t len);
+
+/** Envoie un coup joué localement sur la connexion de la partie, suivi
+ *  de la somme de contrôle de la position courante (NET_CTRL_CHECK).
+ *  À appeler après move_piece(). Les octets passent par la file d'envoi
+ *  de la connexion : l'appel ne bloque jamais l'interface.
+ * @param from_row ligne de départ
+ * @param from_col colonne de départ
+ * @param to_row ligne d'arrivée
+ * @param to_col colonne d'arrivée
+ * @return 0 si succès, -1 sinon (pas de connexion, envoi impossible)
+ */
+int net_send_move(int from_row, int from_col, int to_row, int to_col);
+
+/** Options de faible latence d'une socket de partie : TCP_NODELAY (pas
+ *  d'attente de Nagle derrière les coups de 4 octets) et, si le système le
+ *  permet, IPTOS_LOWDELAY.
+ * @param s socket connectée
+ * @return 0 si TCP_NODELAY est actif, -1 sinon
+ */
+int net_set_low_latency(SOCKET s);
+
+/** Intervalle entre deux PING des modes `--server` / `--client`.
+ * @param ms millisecondes (0 = aucun PING ni détection d'adversaire perdu)
+ */
+void net_set_ping_interval(int ms);
+
+/** Ajoute une mesure d'aller-retour (appelé à chaque PONG). */
+void net_rtt_add(double ms);
+
+/** Percentiles des dernières mesures d'aller-retour. */
+void net_get_rtt(NetRttStats* out);
+
+/** Efface les mesures d'aller-retour. */
+void net_rtt_reset(void);
+
+/** Écrit un coup au format réseau : colonne 'A'-'I' puis rangée '1'-'9' (rangée 9 en haut), départ puis arrivée.
+ * @param from_row ligne de départ (0-8)
+ * @param from_col colonne de départ (0-8)
+ * @param to_row ligne d'arrivée
+ * @param to_col colonne d'arrivée
+ * @param out coup (retour, NET_MOVE_LEN caractères et '\0')
+ */
+void net_move_encode(int from_row, int from_col, int to_row, int to_col, char out[NET_MOVE_LEN + 1]);
+
+/** Lit un coup au format réseau (lettres en minuscules acceptées).
+ * @param msg coup de NET_MOVE_LEN caractères
+ * @param from_row ligne de départ (retour)
+ * @param from_col colonne de départ (retour)
+ * @param to_row ligne d'arrivée (retour)
+ * @param to_col colonne d'arrivée (retour)
+ * @return 1 si les deux cases sont sur le plateau, 0 sinon
+ */
+int net_move_decode(const char* msg, int* from_row, int* from_col, int* to_row, int* to_col);
+
+/** Partie réseau en attente de son adversaire (connexion, acceptation,
+ * reconnexion ou SYNC_STATE en attente).
+ * Les clics et l'IA attendent ; la fenêtre est déjà ouverte.
+ * @return 1 si l'adversaire n'est pas encore connecté, 0 sinon (ou hors réseau)
+ */
+int net_waiting(void);
+
 /** Démarre un serveur TCP pour une partie réseau.
+ *
+ * L'écoute est surveillée par la boucle GLib : la fenêtre s'ouvre tout de
+ * suite et la connexion du client est acceptée quand elle arrive.
  * @param port port à écouter
  * @param mode mode (utilisé pour ajustements spécifiques)
  * @return 0 si succès, négatif sinon
@@ -161,6 +401,10 @@ extern char my_color;
 int run_server(short port, game_mode_t mode);
 
 /** Se connecte à un serveur distant.
+ *
+ * La connexion est lancée sans attendre et achevée par la boucle GLib ;
+ * un refus immédiat (adresse invalide, port fermé en local) est signalé
+ * avant l'ouverture de la fenêtre.
  * @param addr adresse du serveur (IP ou nom)
  * @param port port du serveur
  * @param mode mode de jeu
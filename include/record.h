@@ -0,0 +1,187 @@
+#ifndef RECORD_H
+#define RECORD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "sync.h"  /* SyncState */
+#include "rules.h" /* GameState, Move */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file record.h
+ * @brief Enregistrement des parties : fichier en ajout seul, instantanés tous les K coups, index final.
+ *
+ * Le fichier commence par un en-tête (RecordHeader), suivi des parties
+ * mises bout à bout, chacune d'un bloc, puis d'un index (une RecordIndexEntry
+ * par partie, aligné sur 8 octets) et d'un pied (RecordTrailer) qui en
+ * donne la position. Une partie s'écrit en enregistrements de 4 octets :
+ *
+ * - `G` : début de partie ;
+ * - `S` suivi d'un SyncState (voir sync.h) : la position avant le coup 0,
+ *   puis avant les coups K, 2K... ;
+ * - `M` case de départ, case d'arrivée (0-80) : un coup ;
+ * - `E` gagnant, fin (RulesEnd) : fin de partie.
+ *
+ * La disposition d'un bloc ne dépend que de son nombre de coups : la
+ * position après `ply` coups se lit dans un instantané trouvé par calcul
+ * (record_seek()), puis au plus K coups sont rejoués ; rien n'est resimulé
+ * depuis le premier coup. Le lecteur projette le fichier en mémoire et lit
+ * l'index sur place. Sans pied (écriture interrompue), il reconstruit l'index
+ * en parcourant les blocs et ignore une partie incomplète.
+ *
+ * Un fichier existant est rouvert en ajout (record_writer_open()) : l'ancien
+ * index est repris puis réécrit à la fermeture, après les nouvelles parties.
+ * Les entiers sont dans l'ordre d'octets de la machine qui a écrit le
+ * fichier, sauf dans les instantanés (petit-boutistes).
+ *
+ * Les parties de `--selfplay` et du serveur `--serve` sont enregistrées
+ * avec `--record FICHIER` (`--record-every K`).
+ *
+ * ```bash
+ * ./game --selfplay 1000 --engine-a d3 --engine-b d3 --workers 8 --record parties.krec
+ * ./game --serve 5555 --record serveur.krec --record-every 8
+ * ```
+ */
+
+/** Signature du fichier. */
+#define RECORD_MAGIC        "KROGAME"
+/** Signature du pied de fichier. */
+#define RECORD_INDEX_MAGIC  "KROINDX"
+/** Version du format. */
+#define RECORD_VERSION      1
+/** Coups entre deux instantanés par défaut. */
+#define RECORD_DEFAULT_SNAP_EVERY 16
+/** Coups au plus entre deux instantanés (`--record-every`). */
+#define RECORD_MAX_SNAP_EVERY 256
+/** Coups au plus d'une partie enregistrée. */
+#define RECORD_MAX_PLIES    1024
+
+/** Enregistrement : début de partie. */
+#define RECORD_TAG_GAME     'G'
+/** Enregistrement : instantané (suivi d'un SyncState). */
+#define RECORD_TAG_SNAPSHOT 'S'
+/** Enregistrement : coup. */
+#define RECORD_TAG_MOVE     'M'
+/** Enregistrement : fin de partie. */
+#define RECORD_TAG_END      'E'
+
+/** @brief En-tête du fichier (16 octets). */
+typedef struct {
+    char     magic[8];   /**< RECORD_MAGIC, complété par '\0' */
+    uint32_t version;    /**< RECORD_VERSION */
+    uint32_t snap_every; /**< K : coups entre deux instantanés */
+} RecordHeader;
+
+/** @brief Entrée de l'index (16 octets) : une partie. */
+typedef struct {
+    uint64_t offset;     /**< Position du bloc de la partie dans le fichier */
+    uint32_t plies;      /**< Coups joués */
+    char     winner;     /**< 'B', 'R', 'D', ou 0 pour une partie interrompue */
+    uint8_t  end;        /**< RulesEnd de la fin de partie */
+    uint16_t reserved;   /**< Zéro */
+} RecordIndexEntry;
+
+/** @brief Pied du fichier (24 octets) : position de l'index. */
+typedef struct {
+    char     magic[8];      /**< RECORD_INDEX_MAGIC, complété par '\0' */
+    uint64_t index_offset;  /**< Position de la première RecordIndexEntry */
+    uint64_t games;         /**< Entrées de l'index */
+} RecordTrailer;
+
+/** @brief Écriture d'un fichier de parties */
+typedef struct {
+    FILE *f;                 /**< Fichier ouvert, positionné après la dernière partie */
+    uint32_t snap_every;     /**< K du fichier */
+    uint64_t end;            /**< Fin de la dernière partie */
+    RecordIndexEntry *index; /**< Index, écrit à la fermeture */
+    size_t count;            /**< Parties */
+    size_t cap;              /**< Entrées allouées */
+} RecordWriter;
+
+/** @brief Lecture d'un fichier de parties projeté en mémoire */
+typedef struct {
+    const unsigned char *map;       /**< Fichier projeté */
+    size_t len;                     /**< Taille du fichier */
+    uint32_t snap_every;            /**< K du fichier */
+    const RecordIndexEntry *index;  /**< Index (dans le fichier, ou reconstruit) */
+    size_t games;                   /**< Parties */
+    uint64_t data_end;              /**< Fin de la dernière partie complète */
+    RecordIndexEntry *rebuilt;      /**< Index reconstruit sans pied (NULL sinon) */
+} RecordReader;
+
+/**
+ * @brief Crée un fichier de parties, ou rouvre un fichier existant pour y ajouter des parties.
+ *
+ * Un fichier existant garde son K ; une partie incomplète en fin de
+ * fichier (écriture interrompue) est effacée.
+ * @param w écriture (retour)
+ * @param path fichier
+ * @param snap_every K d'un nouveau fichier (1..RECORD_MAX_SNAP_EVERY, 0 = RECORD_DEFAULT_SNAP_EVERY)
+ * @return 0 si succès, -1 sinon (fichier invalide, écriture impossible)
+ */
+int record_writer_open(RecordWriter *w, const char *path, int snap_every);
+
+/**
+ * @brief Ajoute une partie complète d'un bloc.
+ *
+ * Les coups sont rejoués depuis `start` avec rules_play() pour écrire les
+ * instantanés ; un coup refusé par les règles annule l'ajout.
+ * @param w écriture
+ * @param start position de départ (synchronisée)
+ * @param moves coups : case de départ, case d'arrivée (0-80)
+ * @param plies nombre de coups (0..RECORD_MAX_PLIES)
+ * @param winner 'B', 'R', 'D', ou 0 si la partie a été interrompue
+ * @param end RulesEnd de la fin de partie
+ * @return 0 si succès, -1 sinon (rien n'est écrit)
+ */
+int record_writer_append(RecordWriter *w, const GameState *start, const uint8_t (*moves)[2], int plies,
+                         char winner, int end);
+
+/**
+ * @brief Écrit l'index et le pied, puis ferme le fichier.
+ * @param w écriture
+ * @return 0 si succès, -1 en cas d'erreur d'écriture
+ */
+int record_writer_close(RecordWriter *w);
+
+/**
+ * @brief Projette un fichier de parties en mémoire.
+ * @param r lecture (retour)
+ * @param path fichier
+ * @return 0 si succès, -1 si le fichier est absent ou invalide
+ */
+int record_reader_open(RecordReader *r, const char *path);
+
+/** @brief Libère la projection (sans effet sur une lecture déjà fermée). */
+void record_reader_close(RecordReader *r);
+
+/**
+ * @brief Position d'une partie après `ply` coups : un instantané, puis au plus K coups rejoués.
+ * @param r lecture
+ * @param game numéro de la partie (0..games-1)
+ * @param ply coups joués (0..plies de la partie)
+ * @param out position (retour, synchronisée)
+ * @return 0 si succès, -1 sinon (hors bornes, fichier altéré)
+ */
+int record_seek(const RecordReader *r, size_t game, int ply, GameState *out);
+
+/**
+ * @brief Coup numéro `ply` d'une partie (0 = premier coup).
+ * @param r lecture
+ * @param game numéro de la partie
+ * @param ply numéro du coup (0..plies-1)
+ * @param from_sq case de départ (retour)
+ * @param to_sq case d'arrivée (retour)
+ * @return 0 si succès, -1 sinon
+ */
+int record_move(const RecordReader *r, size_t game, int ply, int *from_sq, int *to_sq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RECORD_H
@@ -0,0 +1,502 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include "app.h"  /* définit Piece */
+#include "bitboard.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file rules.h
+ * @brief Règles du Krojanty sur un état explicite (`GameState`).
+ *
+ * Seule implémentation des règles du jeu, partagée par l'interface
+ * (game.c, capture.c), le réseau, le mode selfplay et l'IA :
+ * - déplacements orthogonaux sans saut (rules_can_move(), rules_legal_moves()) ;
+ * - captures Linca et Seltou, contrôle des cases ;
+ * - fins de partie : roi capturé, roi dans la cité adverse, auto-défaite
+ *   (roi et un seul soldat), limite de tours (rules_play()).
+ *
+ * Les fonctions ne travaillent que sur l'état reçu en paramètre : aucune
+ * variable globale, aucun appel à GTK ni aux messages de status.c. Deux
+ * threads peuvent donc jouer sur deux états différents en même temps. Les
+ * captures et l'issue d'un coup sont rendues sous forme de données
+ * (`RulesResult`), que l'appelant affiche comme il l'entend.
+ *
+ * L'état tient un plateau case → pièce (`GameState::board`) en plus des
+ * bitboards : retrouver la pièce d'une case se fait en O(1) (rules_piece_at()).
+ */
+
+/**
+ * @brief Structure représentant un mouvement de pièce dans le jeu Krojanty
+ * 
+ * Cette structure encode un mouvement complet d'une pièce, comprenant
+ * son identifiant unique et ses coordonnées de départ et d'arrivée.
+ * Elle est utilisée pour :
+ * - Valider les mouvements selon les règles
+ * - Transmettre les coups en mode réseau
+ * - Analyser les positions par l'IA
+ * - Enregistrer l'historique des coups
+ *
+ * La structure garantit qu'un mouvement est complètement spécifié
+ * avec toutes les informations nécessaires pour le valider et
+ * l'appliquer de manière cohérente.
+ *
+ * Exemple d'utilisation :
+ * @code
+ * Move best_move;
+ * trouverMeilleurCoupIA(game_state, &best_move, 3);
+ * if (is_move_valid(&best_move)) {
+ *     apply_move(&best_move);
+ * }
+ * @endcode
+ *
+ * @var Move::piece_index
+ * Identifiant unique de la pièce :
+ * - 0-9 : Pièces bleues (0=roi, 1-9=soldats)
+ * - 10-19 : Pièces rouges (10=roi, 11-19=soldats)
+ * 
+ * @var Move::from_row
+ * Ligne de départ :
+ * - 0-8 : Position valide sur le plateau
+ * - -1 : Pièce capturée ou invalide
+ * 
+ * @var Move::from_col
+ * Colonne de départ :
+ * - 0-8 : Position valide sur le plateau
+ * - -1 : Pièce capturée ou invalide
+ * 
+ * @var Move::to_row
+ * Ligne d'arrivée :
+ * - 0-8 : Position valide sur le plateau
+ * Doit respecter les règles de déplacement (orthogonal)
+ * 
+ * @var Move::to_col
+ * Colonne d'arrivée :
+ * - 0-8 : Position valide sur le plateau
+ * Doit respecter les règles de déplacement (orthogonal)
+ * 
+ * @see GameState
+ * @see trouverMeilleurCoupIA()
+ * @note Un mouvement peut déclencher des captures Linca ou Seultou
+ * @warning Vérifiez la validité du mouvement avant de l'appliquer
+ */
+/**
+ * @struct Move
+ * @brief Structure représentant un mouvement de pièce dans le jeu Krojanty
+ *
+ * Cette structure est l'unité fondamentale de mouvement du jeu. Elle encode
+ * complètement un déplacement de pièce en stockant :
+ * - L'identifiant unique de la pièce déplacée
+ * - Sa position de départ sur le plateau
+ * - Sa position d'arrivée sur le plateau
+ *
+ * Elle est utilisée par plusieurs composants du jeu :
+ * - Le module de règles pour valider les mouvements
+ * - L'IA pour analyser et évaluer les coups possibles
+ * - Le module réseau pour synchroniser les mouvements
+ * - L'interface graphique pour afficher les coups
+ */
+typedef struct {
+    int piece_index;        /**< Index dans le tableau pieces[] */
+    int from_row, from_col; /**< Position de départ */
+    int to_row,   to_col;   /**< Position d'arrivée */
+} Move;
+
+/** Nombre maximal de pièces d'une partie (taille de `pieces[]` dans game.c). */
+#define RULES_MAX_PIECES 20
+/** Case d'une `StatePiece` hors du plateau (ignorée par les bitboards). */
+#define RULES_NO_SQ 0xFF
+
+/**
+ * @struct StatePiece
+ * @brief Pièce compacte d'un `GameState` (3 octets)
+ *
+ * Équivalent de `Piece` où la ligne et la colonne sont fusionnées en une
+ * case `sq = row * 9 + col`, l'indexation des bitboards (voir BB_SQ()).
+ */
+typedef struct {
+    uint8_t sq;     /**< Case (0-80, RULES_NO_SQ hors plateau) */
+    char    color;  /**< 'B' ou 'R' */
+    char    type;   /**< 'K' ou 'P' */
+} StatePiece;
+
+/** Taille d'un GameState en octets (vérifiée à la compilation). */
+#define RULES_STATE_SIZE 224
+
+/**
+ * @brief Structure représentant l'état complet d'une partie de Krojanty
+ * 
+ * Cette structure fondamentale encapsule l'intégralité de l'état du jeu
+ * à un instant donné. Elle inclut toutes les informations nécessaires pour :
+ * - Représenter la position des pièces sur le plateau
+ * - Gérer le contrôle territorial des cases
+ * - Suivre l'état du tour et le compteur de coups
+ * - Permettre à l'IA de simuler et évaluer des positions
+ * - Sauvegarder/restaurer l'état du jeu
+ *
+ * C'est la structure de données centrale du jeu, utilisée par tous
+ * les modules (interface graphique, réseau, IA) pour maintenir une
+ * vue cohérente de la partie en cours.
+ *
+ * Exemple d'utilisation :
+ * @code
+ * GameState state = createGameStateFromCurrent();
+ * if (isGameOver(&state)) {
+ *     return evaluation(&state, 'B');
+ * }
+ * // Continuer l'analyse...
+ * @endcode
+ *
+ * @var GameState::occ
+ * Bitboards d'occupation par couleur (voir bitboard.h) :
+ * - [0] : cases occupées par Bleu
+ * - [1] : cases occupées par Rouge
+ * Tenus à jour par rules_make_move() ; reconstruits par rules_sync()
+ *
+ * @var GameState::control
+ * Plans de contrôle territorial, un bitboard par couleur :
+ * - [0] : cases valant 1 dans `cell_control` (Bleu)
+ * - [1] : cases valant 2 dans `cell_control` (Rouge)
+ * Une case neutre n'appartient à aucun des deux plans. Utilisés pour le
+ * score final si la limite de tours est atteinte ; voir rules_state_control()
+ *
+ * @var GameState::hash
+ * Clé de Zobrist de la position (voir tt.h) :
+ * - pièces par couleur, type et case
+ * - cases contrôlées (`control`), qui entrent dans l'évaluation
+ * - joueur au trait
+ * Tenue à jour par rules_make_move() ; recalculée par rules_sync()
+ *
+ * @var GameState::pieces
+ * Liste des pièces en jeu, dans le même ordre que `pieces[]` (game.c) :
+ * un `Move::piece_index` désigne la même pièce dans les deux tableaux.
+ * Compactée après chaque capture, comme le tableau global
+ *
+ * @var GameState::board
+ * Plateau case → pièce : `board[sq]` est l'index dans `pieces` de la pièce
+ * posée sur `sq`, -1 pour une case vide. Tenu à jour avec `pieces` (y compris
+ * le décalage des index après une capture), voir rules_piece_at()
+ *
+ * @var GameState::piece_count
+ * Nombre de pièces encore en jeu :
+ * - Initial : 20 (10 par camp)
+ * - Mise à jour après chaque capture
+ * - Utilisé pour la condition de victoire par extermination
+ *
+ * @var GameState::pawn_count
+ * Nombre de soldats par couleur ([0] bleu, [1] rouge), terme matériel de l'évaluation
+ *
+ * @var GameState::king_sq
+ * Case (0-80) du roi de chaque couleur, -1 si le roi a été capturé
+ *
+ * @var GameState::current_player
+ * Indique le joueur actif :
+ * - 'B' : Tour du joueur Bleu
+ * - 'R' : Tour du joueur Rouge
+ *
+ * @var GameState::turn_number
+ * Compteur de tours :
+ * - Maximum 64 tours (32 par joueur)
+ * - Utilisé pour la détection de boucles et fin de partie
+ *
+ * Les compteurs de l'évaluation (`pawn_count`, popcount des plans `control`)
+ * sont tenus à jour par rules_make_move() / rules_unmake_move() : l'évaluation des
+ * feuilles n'a pas à parcourir les pièces ni les 81 cases.
+ *
+ * @see Move
+ * @see evaluation()
+ * @see isGameOver()
+ * @note Les cités ne sont pas comptabilisées dans le contrôle territorial
+ * @warning Utilisez createGameStateFromCurrent() ou rules_state_load() pour une copie valide
+ */
+/**
+ * @struct GameState
+ * @brief Structure principale représentant l'état complet d'une partie de Krojanty
+ *
+ * Cette structure est le cœur du jeu Krojanty, contenant toutes les informations
+ * nécessaires pour représenter et manipuler une partie en cours. Elle inclut :
+ * - La position et l'état de toutes les pièces
+ * - Le contrôle territorial de chaque case
+ * - Le joueur actif et le numéro du tour
+ *
+ * Elle est utilisée pour :
+ * - Gérer l'état du jeu en temps réel
+ * - Permettre à l'IA de simuler des positions
+ * - Sauvegarder/charger des parties
+ * - Synchroniser l'état en mode réseau
+ * - Valider les règles du jeu
+ *
+ * La recherche en copie beaucoup (threads, tâches en arrière-plan, tests) :
+ * la disposition est compacte (RULES_STATE_SIZE, 224 octets, vérifié à la
+ * compilation) — bitboards en tête pour l'alignement, cases et index sur un
+ * octet, 20 pièces au plus, index des cases `board[]` compris. Les conversions vers
+ * et depuis `pieces[]` / `cell_control` de l'interface passent par
+ * rules_state_load() et rules_state_store().
+ */
+typedef struct {
+    Bitboard occ[2];        /**< Occupation par couleur ([0] bleu, [1] rouge) */
+    Bitboard control[2];    /**< Cases contrôlées par couleur ([0] bleu, [1] rouge) */
+    uint64_t hash;          /**< Clé de Zobrist (pièces, contrôle, trait) */
+    StatePiece pieces[RULES_MAX_PIECES]; /**< Pièces en jeu */
+    int8_t   board[81];     /**< Index de la pièce de chaque case (-1 = vide) */
+    uint8_t  piece_count;   /**< Nombre de pièces actives */
+    uint8_t  pawn_count[2]; /**< Soldats par couleur */
+    signed char king_sq[2]; /**< Case du roi par couleur (-1 si capturé) */
+    char     current_player;/**< 'B' ou 'R' */
+    uint16_t turn_number;   /**< Numéro du tour */
+} GameState;
+
+/** Nombre maximal de pièces capturées mémorisées par coup (Linca en chaîne + Seltou). */
+#define RULES_MAX_CAPTURES 8
+
+/**
+ * @struct MoveUndo
+ * @brief Informations nécessaires pour annuler un coup joué par rules_make_move()
+ *
+ * Plutôt que de copier tout le GameState avant chaque nœud de la recherche,
+ * l'IA ne mémorise que ce que le coup a modifié :
+ * - la pièce déplacée et sa case de départ
+ * - les pièces capturées et l'index qu'elles occupaient dans `pieces[]`
+ * - les bitboards (occupation et contrôle), les compteurs d'évaluation,
+ *   le joueur actif et le numéro de tour d'avant le coup
+ */
+typedef struct {
+    int   moved_index;                          /**< Index de la pièce jouée (-1 si coup invalide) */
+    int   from_sq;                              /**< Case de départ de la pièce jouée */
+    int   capture_count;                        /**< Nombre de pièces capturées */
+    int   captured_slot[RULES_MAX_CAPTURES];    /**< Index dans pieces[] au moment de la capture */
+    StatePiece captured[RULES_MAX_CAPTURES];    /**< Pièces capturées, dans l'ordre des captures */
+    Bitboard occ[2];                            /**< Bitboards d'occupation avant le coup */
+    Bitboard control[2];                        /**< Plans de contrôle avant le coup */
+    signed char king_sq[2];                     /**< Cases des rois avant le coup */
+    uint8_t pawn_count[2];                      /**< Soldats par couleur avant le coup */
+    uint64_t hash;                              /**< Clé de Zobrist avant le coup */
+    char  current_player;                       /**< Joueur actif avant le coup */
+    int   turn_number;                          /**< Numéro de tour avant le coup */
+} MoveUndo;
+
+/**
+ * @brief Construit un `GameState` à partir de tableaux au format de l'interface.
+ *
+ * Les pièces gardent leur ordre (mêmes `piece_index`) ; une pièce hors du
+ * plateau est conservée mais ignorée par les bitboards. Les bitboards, les
+ * compteurs et la clé `hash` sont calculés (voir rules_sync()).
+ *
+ * @param s État à remplir
+ * @param arr Pièces au format `Piece` (au plus RULES_MAX_PIECES utilisées)
+ * @param count Nombre de pièces dans `arr`
+ * @param control Contrôle des cases au format `cell_control` (0, 1 ou 2), NULL pour un plateau neutre
+ * @param player Joueur au trait ('B' ou 'R')
+ * @param turn Numéro du tour
+ */
+void rules_state_load(GameState* s, const Piece* arr, int count, const int control[9][9], char player, int turn);
+
+/**
+ * @brief Recopie un `GameState` au format de l'interface (`pieces[]`, `cell_control`).
+ *
+ * @param s État source
+ * @param arr Tableau de sortie (au moins RULES_MAX_PIECES éléments), NULL pour l'ignorer
+ * @param count Nombre de pièces écrites (retour), NULL pour l'ignorer
+ * @param control Contrôle des cases (0, 1 ou 2), NULL pour l'ignorer
+ */
+void rules_state_store(const GameState* s, Piece* arr, int* count, int control[9][9]);
+
+/**
+ * @brief Pièce d'indice `index` au format `Piece` (ligne, colonne).
+ * @param s État du jeu
+ * @param index Indice dans `s->pieces` (0 à piece_count - 1)
+ * @return Pièce convertie (row = col = -1 si hors plateau)
+ */
+Piece rules_state_piece(const GameState* s, int index);
+
+/**
+ * @brief Valeur de contrôle d'une case, au format de `cell_control`.
+ * @return 0 (neutre), 1 (Bleu) ou 2 (Rouge)
+ */
+int rules_state_control(const GameState* s, int row, int col);
+
+/**
+ * @brief Reconstruit les bitboards d'occupation (`occ`, `king_sq`), le compteur
+ *        `pawn_count` et la clé `hash` à partir de `pieces[]` et des plans `control`.
+ *
+ * À appeler après avoir modifié `pieces[]` à la main. Les fonctions
+ * publiques de l'IA l'appellent elles-mêmes à leur entrée.
+ */
+void rules_sync(GameState* jeu);
+
+/**
+ * @brief Joue un coup sur `jeu` (captures comprises) et passe la main.
+ *
+ * Les bitboards de `jeu` doivent être à jour (voir rules_sync()).
+ * @param jeu état du jeu, modifié en place
+ * @param mv coup à jouer
+ * @param undo entrée d'annulation remplie pour rules_unmake_move()
+ */
+void rules_make_move(GameState* jeu, const Move* mv, MoveUndo* undo);
+
+/**
+ * @brief Annule un coup joué par rules_make_move() et restaure exactement l'état précédent.
+ * @param jeu état du jeu
+ * @param undo entrée remplie par rules_make_move()
+ */
+void rules_unmake_move(GameState* jeu, const MoveUndo* undo);
+
+/** Taille suffisante pour la liste de coups d'une position (voir rules_legal_moves()). */
+#define RULES_MAX_MOVES 300
+
+/**
+ * @brief Coups légaux du joueur au trait (ordre : pièces, puis est, ouest, sud, nord).
+ *
+ * Aucun coup si la partie est finie (roi capturé ou arrivé dans la cité
+ * adverse, auto-défaite). Les bitboards de `jeu` doivent être à jour.
+ * @param jeu état du jeu
+ * @param out tableau d'au moins RULES_MAX_MOVES coups
+ * @return nombre de coups écrits dans `out`
+ */
+int rules_legal_moves(const GameState* jeu, Move* out);
+
+/** Cases des cités : (0,0) pour les bleus, (8,8) pour les rouges. */
+#define RULES_BLUE_CITY 0
+#define RULES_RED_CITY  80
+
+/**
+ * @brief Raison de la fin d'une partie (voir rules_play())
+ */
+typedef enum {
+    RULES_END_NONE,          /**< Partie en cours */
+    RULES_END_KING_CAPTURED, /**< Roi capturé (Linca ou Seltou) */
+    RULES_END_KING_IN_CITY,  /**< Roi arrivé dans la cité adverse */
+    RULES_END_AUTO_DEFEAT,   /**< Un camp n'a plus qu'un roi et un soldat */
+    RULES_END_TURN_LIMIT     /**< Limite de tours atteinte, décision aux scores */
+} RulesEnd;
+
+/**
+ * @brief Pièce capturée par un coup
+ */
+typedef struct {
+    uint8_t sq;    /**< Case de la pièce capturée */
+    uint8_t slot;  /**< Index de la pièce dans `pieces` au moment de la capture */
+    char color;    /**< Couleur de la pièce capturée */
+    char type;     /**< 'K' ou 'P' */
+    char rule;     /**< 'L' (Linca) ou 'S' (Seltou) */
+} RulesCapture;
+
+/**
+ * @brief Effets d'un coup joué par rules_play()
+ *
+ * `winner` vaut 'B' ou 'R' (vainqueur), 'D' (égalité à la limite de tours)
+ * ou 0 si la partie continue ; `end` en donne la raison.
+ */
+typedef struct {
+    int capture_count;                        /**< Nombre de pièces capturées */
+    RulesCapture captures[RULES_MAX_CAPTURES]; /**< Captures, dans l'ordre */
+    char winner;                               /**< 'B', 'R', 'D' ou 0 */
+    RulesEnd end;                              /**< Raison de la fin de partie */
+    int score_blue;                            /**< Score des bleus après le coup */
+    int score_red;                             /**< Score des rouges après le coup */
+} RulesResult;
+
+/**
+ * @brief Indice de couleur des tableaux `occ[]`, `control[]`, `king_sq[]`...
+ * @return 0 pour Bleu, 1 pour Rouge
+ */
+static inline int rules_color_idx(char color) { return color == 'R'; }
+
+/** Cases occupées par les deux couleurs. */
+static inline Bitboard rules_occupied(const GameState* s) { return s->occ[0] | s->occ[1]; }
+
+/**
+ * @brief Pièce occupant une case, en O(1).
+ * @param s état du jeu (synchronisé)
+ * @param sq case (0-80)
+ * @return index dans `s->pieces`, -1 si la case est vide
+ */
+static inline int rules_piece_at(const GameState* s, int sq) { return s->board[sq]; }
+
+/**
+ * @brief Vérifie qu'une pièce peut aller sur une case (ligne droite, sans saut).
+ * @param s état du jeu
+ * @param index index de la pièce dans `s->pieces`
+ * @param to_row ligne d'arrivée
+ * @param to_col colonne d'arrivée
+ * @return 1 si le déplacement est autorisé, 0 sinon
+ */
+int rules_can_move(const GameState* s, int index, int to_row, int to_col);
+
+/**
+ * @brief Cases atteignables par une pièce.
+ * @param s état du jeu
+ * @param index index de la pièce dans `s->pieces`
+ * @return bitboard des destinations (vide si la pièce n'est pas sur le plateau)
+ */
+Bitboard rules_destinations(const GameState* s, int index);
+
+/**
+ * @brief Applique les captures Linca provoquées par la pièce `moved_index`.
+ *
+ * Les captures s'enchaînent tant qu'un soldat ennemi est encadré ; la capture
+ * d'un roi arrête la recherche.
+ * @param s état du jeu, modifié en place
+ * @param moved_index pièce qui vient d'arriver
+ * @param undo entrée d'annulation à compléter (NULL si le coup ne sera pas annulé)
+ * @param res captures constatées (NULL pour les ignorer)
+ */
+void rules_linca(GameState* s, int moved_index, MoveUndo* undo, RulesResult* res);
+
+/**
+ * @brief Applique la capture Seltou de la pièce `moved_index`, venue de `from_sq`.
+ * @param s état du jeu, modifié en place
+ * @param moved_index pièce qui vient d'arriver
+ * @param from_sq case de départ du coup
+ * @param undo entrée d'annulation à compléter (NULL si le coup ne sera pas annulé)
+ * @param res captures constatées (NULL pour les ignorer)
+ */
+void rules_seltou(GameState* s, int moved_index, int from_sq, MoveUndo* undo, RulesResult* res);
+
+/**
+ * @brief Camp battu par auto-défaite (un roi et un seul soldat).
+ * @return 'B' ou 'R' (le perdant, les bleus d'abord), 0 sinon
+ */
+char rules_auto_defeat(const GameState* s);
+
+/**
+ * @brief Vainqueur d'une position, hors limite de tours.
+ *
+ * Roi capturé, roi dans la cité adverse ou auto-défaite. Une position
+ * sans aucun roi (diagramme) n'est jamais terminale.
+ * @param s état du jeu
+ * @param end raison (retour, NULL pour l'ignorer)
+ * @return 'B' ou 'R', 0 si la partie continue
+ */
+char rules_winner(const GameState* s, RulesEnd* end);
+
+/**
+ * @brief Scores du jeu : pièces + cases contrôlées - 1, par couleur.
+ */
+void rules_scores(const GameState* s, int* blue, int* red);
+
+/**
+ * @brief Joue un coup de partie : vérification, captures, issue.
+ *
+ * Version complète de rules_make_move() pour l'interface, le réseau et le
+ * mode selfplay : le coup est refusé s'il est illégal ou si la partie est déjà
+ * finie. Sur un coup qui termine la partie (roi capturé, roi dans la cité,
+ * auto-défaite), le trait et le numéro de tour ne changent pas ; sinon ils
+ * avancent et la limite de tours est vérifiée.
+ *
+ * @param s état du jeu, modifié en place
+ * @param mv coup (`piece_index`, `to_row`, `to_col` font foi)
+ * @param max_turn limite de tours (0 = aucune)
+ * @param res captures et issue du coup (retour)
+ * @return 1 si le coup a été joué, 0 s'il est refusé (`s` inchangé)
+ */
+int rules_play(GameState* s, const Move* mv, int max_turn, RulesResult* res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RULES_H
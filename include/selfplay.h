@@ -0,0 +1,145 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @file selfplay.h
+ * @brief Parties IA contre IA sans interface (option `--selfplay`).
+ *
+ * Joue N parties entre deux configurations de moteur A et B, sans fenêtre
+ * ni délai entre les coups, avec les règles de rules.h (rules_play()). Les
+ * couleurs alternent d'une partie à l'autre et les SELFPLAY_RANDOM_PLIES
+ * premiers coups sont tirés au hasard (graine dérivée du numéro de partie)
+ * pour varier les ouvertures de façon reproductible.
+ *
+ * Les parties sont réparties sur plusieurs processus (`--workers`), chacun
+ * avec sa propre copie de l'état du jeu et de la table de transposition ;
+ * dans une partie, les deux camps partagent la table, vidée avant chaque
+ * partie. Les résultats sont écrits en CSV, ou en JSON si le fichier de
+ * sortie se termine par `.json`. Avec `--book-out`, les premiers coups des
+ * parties servent aussi à construire un livre d'ouverture (book.h) ; avec
+ * `--record`, les parties entières sont ajoutées à un fichier de parties
+ * (record.h).
+ *
+ * ```bash
+ * ./game --selfplay 200 --engine-a t100 --engine-b d4 --workers 4 --out resultats.csv
+ * ```
+ */
+
+/** Premiers coups joués au hasard dans chaque partie. */
+#define SELFPLAY_RANDOM_PLIES 2
+/** Nombre maximal de processus de parties. */
+#define SELFPLAY_MAX_WORKERS  64
+/** Premiers coups de chaque partie conservés pour le livre d'ouverture (`--book-out`). */
+#define SELFPLAY_OPENING_PLIES 12
+/** Partie interrompue au-delà de ce nombre de coups (sécurité, max_turn termine avant ; au plus RECORD_MAX_PLIES). */
+#define SELFPLAY_MAX_PLIES 1000
+
+/**
+ * @brief Configuration d'un moteur
+ *
+ * Une profondeur non nulle donne une recherche à profondeur fixe, sinon
+ * l'approfondissement itératif est limité à `time_ms` par coup
+ * (ia_search_game()).
+ */
+typedef struct {
+    int depth;   /**< Profondeur fixe (0 = limite de temps) */
+    int time_ms; /**< Temps par coup en ms si `depth` vaut 0 */
+} EngineConfig;
+
+/**
+ * @brief Paramètres d'une série de parties
+ */
+typedef struct {
+    int games;               /**< Nombre de parties */
+    int workers;             /**< Processus de parties (1..SELFPLAY_MAX_WORKERS) */
+    EngineConfig engine[2];  /**< Moteurs A (0) et B (1) */
+    const char *out_path;    /**< Fichier de résultats (NULL = sortie standard, en CSV) */
+    const char *book_out;    /**< Livre d'ouverture à construire (NULL = aucun) */
+    const char *record_path; /**< Fichier de parties à compléter (NULL = aucun) */
+    int record_every;        /**< Coups entre deux instantanés d'un nouveau fichier (0 = défaut) */
+} SelfPlayConfig;
+
+/**
+ * @brief Résultat d'une partie
+ *
+ * `winner` vaut 'A' ou 'B' (moteur gagnant) ou 'D' (égalité).
+ */
+typedef struct {
+    int index;           /**< Numéro de la partie (0..games-1) */
+    char a_color;        /**< Couleur du moteur A ('B' ou 'R') */
+    char winner;         /**< 'A', 'B' ou 'D' */
+    int plies;           /**< Coups joués */
+    int score_blue;      /**< Score final des bleus */
+    int score_red;       /**< Score final des rouges */
+    double seconds;      /**< Durée de la partie */
+    char reason[160];    /**< Raison de la fin de partie */
+    int opening_len;     /**< Coups dans `opening` */
+    unsigned char opening[SELFPLAY_OPENING_PLIES][2]; /**< Premiers coups : cases de départ et d'arrivée (0-80) */
+    int end;             /**< RulesEnd de la fin de partie (RULES_END_NONE si elle vient du banc) */
+    uint8_t moves[SELFPLAY_MAX_PLIES][2]; /**< Tous les coups joués (`plies`), pour `--record` */
+} SelfPlayResult;
+
+/**
+ * @brief Lit une configuration de moteur : `dN` (profondeur N) ou `tMS` (MS ms par coup).
+ * @param spec texte à analyser
+ * @param out configuration (retour)
+ * @return 0 si succès, -1 si le texte est invalide
+ */
+int selfplay_parse_engine(const char *spec, EngineConfig *out);
+
+/**
+ * @brief Joue une partie dans le processus courant, sur un état local.
+ * @param cfg paramètres de la série
+ * @param index numéro de la partie (couleurs et ouverture en dépendent)
+ * @param out résultat (retour)
+ */
+void selfplay_play_game(const SelfPlayConfig *cfg, int index, SelfPlayResult *out);
+
+/**
+ * @brief Écrit des résultats en CSV (une ligne d'en-tête, une ligne par partie).
+ * @param f flux de sortie
+ * @param results résultats
+ * @param count nombre de résultats
+ */
+void selfplay_write_csv(FILE *f, const SelfPlayResult *results, int count);
+
+/**
+ * @brief Écrit des résultats en JSON (tableau d'objets, un par partie).
+ * @param f flux de sortie
+ * @param results résultats
+ * @param count nombre de résultats
+ */
+void selfplay_write_json(FILE *f, const SelfPlayResult *results, int count);
+
+/**
+ * @brief Construit un livre d'ouverture à partir des premiers coups des parties.
+ *
+ * Chaque coup compte 2 pour le camp qui a gagné la partie, 1 en cas
+ * d'égalité ; les coups du perdant ne sont pas retenus.
+ * @param path fichier du livre
+ * @param results résultats (avec `opening`)
+ * @param count nombre de résultats
+ * @return nombre d'entrées écrites, -1 en cas d'erreur
+ */
+long selfplay_write_book(const char *path, const SelfPlayResult *results, int count);
+
+/**
+ * @brief Ajoute les parties à un fichier de parties (créé s'il n'existe pas).
+ * @param path fichier de parties
+ * @param snap_every coups entre deux instantanés d'un nouveau fichier (0 = RECORD_DEFAULT_SNAP_EVERY)
+ * @param results résultats (avec `moves`)
+ * @param count nombre de résultats
+ * @return nombre de parties ajoutées, -1 en cas d'erreur
+ */
+long selfplay_write_record(const char *path, int snap_every, const SelfPlayResult *results, int count);
+
+/**
+ * @brief Joue toute la série, écrit les résultats et affiche le bilan sur stderr.
+ * @param cfg paramètres de la série
+ * @return 0 si succès, 1 en cas d'erreur (processus, fichier de sortie)
+ */
+int run_selfplay(const SelfPlayConfig *cfg);
+
+#endif // SELFPLAY_H
@@ -0,0 +1,106 @@
+#ifndef SERVER_H
+#define SERVER_H
+#include <stdio.h>
+#include "selfplay.h" /* EngineConfig */
+
+/**
+ * @file server.h
+ * @brief Serveur de parties sans interface : une partie contre l'IA par client connecté (`--serve PORT`).
+ *
+ * Contrairement à `--server`, qui ouvre une fenêtre pour une seule partie,
+ * le serveur garde son écoute ouverte et tient jusqu'à `max_matches`
+ * parties à la fois sur un seul thread : l'écoute, chaque connexion et le
+ * tube de réveil des recherches sont surveillés par epoll sous Linux (poll()
+ * ailleurs). Le protocole est celui de TCP_Send_Message() : des coups de
+ * NET_MOVE_LEN caractères ("A1B2"), sans poignée de main, si bien qu'un
+ * client existant (`./game -c adresse:port`) joue sans changement. Le
+ * client a les bleus et commence ; l'IA du serveur a les rouges. Le
+ * serveur répond aux PING et aux SYNC_REQUEST (instantané de la partie
+ * du client) du canal de contrôle (voir net.h), mais n'envoie rien de
+ * lui-même. Une connexion perdue termine sa partie : chaque connexion est
+ * une nouvelle partie.
+ *
+ * Chaque partie a son propre GameState, avancé par rules_play(). Un coup
+ * hors du tour du client, illégal ou hors du plateau ferme la connexion ;
+ * une fin de partie aussi, après l'envoi du dernier coup. Les recherches de
+ * l'IA sont confiées à un groupe de `workers` threads (`--search-workers`)
+ * qui partagent la table de transposition ; le coup trouvé revient à la
+ * boucle par le tube de réveil. Chaque partie tient son propre historique des répétitions
+ * (IaHistory), copié dans la tâche de recherche : les positions déjà jouées
+ * de la partie comptent comme répétitions, celles des autres parties non.
+ *
+ * Avec `record`, chaque partie terminée (ou interrompue après au moins un
+ * coup) est ajoutée à un fichier de parties (record.h), d'un bloc, au
+ * moment où elle se termine ; l'index est écrit par server_close().
+ *
+ * ```bash
+ * ./game --serve 5555 --max-matches 32 --search-workers 4 -t 250 --record serveur.krec
+ * ```
+ */
+
+/** Parties simultanées par défaut. */
+#define SERVER_DEFAULT_MATCHES 64
+/** Parties simultanées au plus (`--max-matches`). */
+#define SERVER_MAX_MATCHES     1024
+/** Threads de recherche au plus. */
+#define SERVER_MAX_WORKERS     64
+
+/**
+ * @brief Paramètres du serveur
+ */
+typedef struct {
+    int port;            /**< Port d'écoute (0 = choisi par le système, voir server_port()) */
+    int max_matches;     /**< Parties simultanées (1..SERVER_MAX_MATCHES), clients refusés au-delà */
+    int workers;         /**< Threads de recherche (1..SERVER_MAX_WORKERS) */
+    EngineConfig engine; /**< Moteur de l'IA du serveur */
+    FILE *log;           /**< Journal des connexions et des fins de partie (NULL = aucun) */
+    const char *record;  /**< Fichier de parties à compléter (NULL = aucun) */
+    int record_every;    /**< Coups entre deux instantanés d'un nouveau fichier (0 = défaut) */
+} ServerConfig;
+
+/**
+ * @brief Compteurs du serveur depuis server_open()
+ */
+typedef struct {
+    int active;   /**< Parties en cours */
+    int finished; /**< Parties terminées (fin de partie, coup refusé ou déconnexion) */
+    int rejected; /**< Clients refusés faute de place */
+    long searches;/**< Recherches de l'IA terminées */
+} ServerStats;
+
+/**
+ * @brief Ouvre l'écoute et démarre les threads de recherche.
+ * @param cfg paramètres (copiés)
+ * @return 0 si succès, -1 sinon (serveur déjà ouvert, socket, threads)
+ */
+int server_open(const ServerConfig *cfg);
+
+/** @brief Port d'écoute effectif (0 si le serveur est fermé). */
+int server_port(void);
+
+/**
+ * @brief Attend et traite les événements : connexions, coups reçus, coups trouvés par l'IA.
+ * @param timeout_ms attente maximale (0 = aucune, négatif = illimitée)
+ * @return nombre d'événements traités, -1 en cas d'erreur (serveur fermé)
+ */
+int server_poll(int timeout_ms);
+
+/** @brief Compteurs courants du serveur. */
+void server_get_stats(ServerStats *out);
+
+/**
+ * @brief Ferme toutes les parties et l'écoute, puis arrête les threads de recherche.
+ *
+ * Les recherches en cours sont interrompues (moteur limité en temps) ou
+ * attendues (profondeur fixe).
+ */
+void server_close(void);
+
+/**
+ * @brief Mode `--serve` : server_open() puis server_poll() jusqu'à SIGINT ou SIGTERM.
+ * @param cfg paramètres
+ * @return 0 à l'arrêt, 1 si le serveur n'a pas pu démarrer
+ */
+int run_match_server(const ServerConfig *cfg);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef STATUS_H
 #define STATUS_H
 #include "app.h"
+#include "rules.h"  /* RulesResult */
  
 /**
  * @file status.h
@@ -29,6 +30,28 @@ void set_draw_message(const char *reason);
  */
 void set_victory_message(gboolean blue_won, const char *reason);
  
+/** Issue de la partie terminée : 'B' ou 'R' (vainqueur), 'D' (égalité), 0 si elle est en cours.
+ *  Enregistrée par set_victory_message() / set_draw_message(), même sans widgets. */
+char status_result(void);
+
+/** Raison de la fin de partie ("" si elle est en cours). */
+const char *status_result_reason(void);
+
+/** Efface l'issue enregistrée (nouvelle partie). */
+void status_clear_result(void);
+
+/** Raison d'une fin de partie décrite par rules_play() (roi capturé, cité, auto-défaite, limite de tours).
+ * @param res issue du coup
+ * @param buf tampon de sortie
+ * @param len taille du tampon
+ */
+void status_end_reason(const RulesResult *res, char *buf, size_t len);
+
+/** Affiche la fin de partie décrite par rules_play() via set_victory_message() / set_draw_message().
+ * @param res issue du coup (sans effet si `res->winner` est nul)
+ */
+void status_report_end(const RulesResult *res);
+
 /** Met à jour le label décrivant l'état courant du jeu. */
 void refresh_game_status(void);
  
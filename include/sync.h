@@ -0,0 +1,92 @@
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <stdint.h>
+#include "rules.h" /* GameState, StatePiece */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file sync.h
+ * @brief Instantané binaire de la position (SYNC_STATE) : taille fixe, versionné, avec somme de contrôle.
+ *
+ * Toute la position tient dans SYNC_STATE_SIZE octets sans pointeur ni
+ * champ de longueur variable : les pièces au format `StatePiece` (case,
+ * couleur, type), le contrôle des 81 cases au format de `cell_control`, le
+ * trait, le numéro du tour et les scores. L'instantané se copie tel quel
+ * dans une trame de contrôle (voir net.h) ou un fichier ; le relire ne
+ * demande que des vérifications de bornes. Les entiers sont en petit-boutiste
+ * (sans conversion sur les machines petit-boutistes).
+ *
+ * La somme de contrôle (FNV-1a 32 bits des octets qui la précèdent) sert
+ * aussi d'empreinte de la position : deux programmes qui ont la même
+ * empreinte après un coup ont la même partie. Le réseau l'envoie après
+ * chaque coup (NET_CTRL_CHECK) pour détecter une désynchronisation.
+ *
+ * Les conversions depuis et vers un `GameState` sont ici ; celles des
+ * variables globales de l'interface (`pieces[]`, `cell_control`...) sont
+ * game_sync_store() et game_sync_load() dans game.h.
+ */
+
+/** Signature de l'instantané. */
+#define SYNC_MAGIC     "KS"
+/** Version du format (à changer avec la disposition de SyncState). */
+#define SYNC_VERSION   1
+/** Taille de l'instantané (octets). */
+#define SYNC_STATE_SIZE 160
+
+/** @brief Instantané de la position (SYNC_STATE_SIZE octets, sans remplissage) */
+typedef struct {
+    char       magic[2];                   /**< SYNC_MAGIC (sans '\0') */
+    uint8_t    version;                    /**< SYNC_VERSION */
+    uint8_t    piece_count;                /**< Pièces utilisées dans `pieces` (au plus RULES_MAX_PIECES) */
+    char       current_turn;               /**< 'B' ou 'R' */
+    uint8_t    reserved0;                  /**< Zéro */
+    uint16_t   turn_number;                /**< Numéro du tour */
+    uint16_t   score_blue;                 /**< Score des bleus */
+    uint16_t   score_red;                  /**< Score des rouges */
+    StatePiece pieces[RULES_MAX_PIECES];   /**< Pièces, même ordre que `pieces[]` ; cases libres à RULES_NO_SQ */
+    uint8_t    control[81];                /**< Contrôle des cases `row * 9 + col` (0, 1 bleu, 2 rouge) */
+    uint8_t    reserved[3];                /**< Zéro */
+    uint32_t   checksum;                   /**< FNV-1a 32 bits des octets précédents (voir sync_checksum()) */
+} SyncState;
+
+/**
+ * @brief Instantané d'un état (scores calculés par rules_scores()).
+ * @param s état source (synchronisé)
+ * @param out instantané (retour)
+ */
+void sync_from_state(const GameState* s, SyncState* out);
+
+/**
+ * @brief Reconstruit un état depuis un instantané.
+ *
+ * Signature, version, somme de contrôle, bornes, cases en double et scores
+ * sont vérifiés : un instantané refusé laisse `s` inchangé.
+ * @param in instantané
+ * @param s état (retour, bitboards et clé de Zobrist calculés)
+ * @return 0 si succès, -1 si l'instantané est invalide
+ */
+int sync_to_state(const SyncState* in, GameState* s);
+
+/**
+ * @brief Somme de contrôle d'un instantané (FNV-1a 32 bits jusqu'au champ `checksum` exclu).
+ * @param in instantané
+ * @return somme de contrôle, dans l'ordre de la machine
+ */
+uint32_t sync_checksum(const SyncState* in);
+
+/**
+ * @brief Empreinte d'une position : somme de contrôle de son instantané.
+ * @param s état (synchronisé)
+ * @return empreinte, dans l'ordre de la machine
+ */
+uint32_t sync_state_digest(const GameState* s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
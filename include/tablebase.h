@@ -0,0 +1,141 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "rules.h" /* GameState */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tablebase.h
+ * @brief Table de finales : issue exacte (gain, perte, nul) et distance des positions à peu de pièces.
+ *
+ * Une classe de matériel réunit les positions avec les deux rois, `b`
+ * soldats bleus et `r` soldats rouges (0 ou 2 à TB_MAX_PAWNS : un camp
+ * réduit à un soldat a perdu, voir rules_auto_defeat()). Chaque position de
+ * la classe a un octet, à l'index rendu par le trait, les cases des rois et
+ * le rang combinatoire de chaque ensemble de soldats.
+ *
+ * La table est produite hors ligne par analyse rétrograde (`--tb-gen
+ * FICHIER`) : les positions finies sont perdues en 0 pour le joueur au
+ * trait, puis les issues remontent coup par coup vers les prédécesseurs (un
+ * gain si un coup mène à une perte adverse, une perte quand tous les coups
+ * mènent à un gain adverse). Les captures font sortir de la classe ; leur
+ * issue est lue dans les classes plus petites, générées d'abord. Ce qui
+ * n'est jamais résolu est nul. La limite de tours est ignorée pendant la
+ * génération : le contrôle des cases n'intervient qu'au score final.
+ *
+ * À l'usage (`--tb FICHIER`), le fichier est projeté en mémoire et l'IA le
+ * consulte dans la recherche. Un gain ou une perte n'est retenu que si sa
+ * distance tient dans les coups restants avant max_turn ; sinon, comme pour
+ * un nul, le score final (contrôle compris) décide et la recherche continue.
+ *
+ * La taille d'une classe est 2 × 81 × 81 × C(81, b) × C(81, r) octets.
+ * Seules les classes d'au plus TB_MAX_CLASS_POSITIONS positions sont
+ * générées : roi contre roi, roi et 2 soldats contre roi, et l'inverse
+ * (TB_GEN_MAX_PAWNS). Avec 3 soldats (1,1e9) ou 2 soldats de chaque côté
+ * (1,4e11), l'index ne tient plus en mémoire ; le format accepte
+ * néanmoins jusqu'à TB_MAX_PAWNS soldats par camp.
+ */
+
+/** Signature du fichier. */
+#define TB_MAGIC                "KROTB"
+/** Version du format. */
+#define TB_VERSION              1
+/** Soldats par camp au plus dans une classe du format. */
+#define TB_MAX_PAWNS            3
+/** Soldats par camp au plus que tb_generate() sait produire (classes d'au plus TB_MAX_CLASS_POSITIONS). */
+#define TB_GEN_MAX_PAWNS        2
+/** Nombre maximal de classes d'un fichier. */
+#define TB_MAX_CLASSES          ((TB_MAX_PAWNS + 1) * (TB_MAX_PAWNS + 1))
+/** Distance maximale mémorisée, en coups (au-delà : nul). */
+#define TB_MAX_DIST             126
+/** Taille maximale d'une classe générée, en positions. */
+#define TB_MAX_CLASS_POSITIONS  (1ULL << 27)
+
+/** @brief Issue d'une position pour le joueur au trait. */
+typedef enum {
+    TB_UNKNOWN = 0, /**< Position hors de la table */
+    TB_DRAW,        /**< Aucun camp ne force le gain */
+    TB_WIN,         /**< Gain forcé en `dist` coups au plus */
+    TB_LOSS         /**< Perte en `dist` coups au plus */
+} TbResult;
+
+/** @brief En-tête du fichier (16 octets), suivi de `class_count` TbClass puis des données. */
+typedef struct {
+    char     magic[8];     /**< TB_MAGIC, complété par '\0' */
+    uint32_t version;      /**< TB_VERSION */
+    uint32_t class_count;  /**< Nombre de classes */
+} TbHeader;
+
+/** @brief Description d'une classe dans le fichier (24 octets). */
+typedef struct {
+    uint8_t  pawns[2];     /**< Soldats bleus et rouges */
+    uint8_t  reserved[6];  /**< Zéro */
+    uint64_t offset;       /**< Position des données depuis le début du fichier */
+    uint64_t size;         /**< Nombre de positions (tb_class_size()) */
+} TbClass;
+
+/**
+ * @brief Nombre de positions (octets) d'une classe.
+ * @param blue_pawns soldats bleus (0..TB_MAX_PAWNS)
+ * @param red_pawns soldats rouges (0..TB_MAX_PAWNS)
+ * @return taille de la classe, 0 si les nombres sont hors limites
+ */
+uint64_t tb_class_size(int blue_pawns, int red_pawns);
+
+/**
+ * @brief Index d'une position dans sa classe.
+ * @param s état du jeu (deux rois, soldats de la classe)
+ * @return index (< tb_class_size(pawn_count[0], pawn_count[1]))
+ */
+uint64_t tb_index(const GameState *s);
+
+/**
+ * @brief Position d'un index (tour 1, sans contrôle).
+ * @param idx index dans la classe
+ * @param blue_pawns soldats bleus
+ * @param red_pawns soldats rouges
+ * @param out position (retour, synchronisée)
+ * @return 1 si l'index désigne une position (pièces sur des cases distinctes), 0 sinon
+ */
+int tb_decode(uint64_t idx, int blue_pawns, int red_pawns, GameState *out);
+
+/**
+ * @brief Génère les classes jusqu'à `max_pawns` soldats par camp et écrit le fichier.
+ * @param path fichier à écrire
+ * @param max_pawns soldats par camp au plus (0..TB_GEN_MAX_PAWNS)
+ * @param log progression (NULL = aucune)
+ * @return nombre de classes écrites, -1 si `max_pawns` est hors limites ou en cas d'erreur (mémoire, écriture)
+ */
+int tb_generate(const char *path, int max_pawns, FILE *log);
+
+/**
+ * @brief Projette une table en mémoire ; remplace la table courante.
+ * @param path fichier de la table
+ * @return 0 si succès, -1 si le fichier est absent ou invalide (table courante fermée)
+ */
+int tb_open(const char *path);
+
+/** @brief Ferme la table courante (sans effet si aucune). */
+void tb_close(void);
+
+/** @brief Nombre de classes de la table courante (0 si aucune). */
+int tb_class_count(void);
+
+/**
+ * @brief Issue d'une position, sans tenir compte de la limite de tours.
+ * @param s état du jeu (synchronisé, partie en cours)
+ * @param dist distance en coups pour TB_WIN et TB_LOSS (retour, peut être NULL)
+ * @return issue pour le joueur au trait, TB_UNKNOWN si la classe n'est pas dans la table
+ */
+TbResult tb_probe(const GameState *s, int *dist);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TABLEBASE_H
@@ -0,0 +1,154 @@
+#ifndef TT_H
+#define TT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tt.h
+ * @brief Hachage de Zobrist et table de transposition de l'IA.
+ *
+ * Chaque position est résumée par une clé de 64 bits obtenue par XOR de
+ * valeurs pseudo-aléatoires :
+ * - une valeur par (couleur, type de pièce, case)
+ * - une valeur par (valeur de contrôle 1 ou 2, case) pour `cell_control`,
+ *   qui intervient dans l'évaluation
+ * - une valeur lorsque c'est au Rouge de jouer
+ *
+ * L'IA met cette clé à jour de façon incrémentale (voir rules_make_move()).
+ *
+ * La table de transposition est un tableau de seaux de 64 octets (une ligne
+ * de cache) contenant chacun TT_BUCKET_SIZE entrées. Une entrée mémorise la
+ * profondeur, le type de borne, le score et le meilleur coup (cases de départ
+ * et d'arrivée, indépendantes de l'ordre de `pieces[]`).
+ *
+ * La taille est réglable en ligne de commande (`--tt MO`, voir args.h).
+ *
+ * La table est partagée sans verrou par les threads de recherche : chaque
+ * emplacement stocke les données sur 64 bits et la clé XOR ces données
+ * (accès atomiques de 64 bits). Une entrée à moitié écrite par un autre
+ * thread ne correspond plus à sa clé et est simplement ignorée.
+ */
+
+/** Taille par défaut de la table de transposition, en mégaoctets. */
+#define TT_DEFAULT_MB  16
+/** Taille maximale acceptée, en mégaoctets. */
+#define TT_MAX_MB      4096
+/** Nombre d'entrées par seau (64 octets / 16 octets). */
+#define TT_BUCKET_SIZE 4
+
+/** @brief Type de borne d'un score mémorisé (vu du joueur au trait). */
+typedef enum {
+    TT_NONE  = 0, /**< Entrée vide */
+    TT_EXACT = 1, /**< Score exact */
+    TT_LOWER = 2, /**< Borne inférieure (coupure bêta) */
+    TT_UPPER = 3  /**< Borne supérieure (aucun coup n'a dépassé alpha) */
+} tt_bound_t;
+
+/**
+ * @struct TTEntry
+ * @brief Entrée de la table de transposition (forme décodée de TTSlot)
+ */
+typedef struct {
+    uint64_t key;       /**< Clé de Zobrist complète de la position */
+    int32_t  score;     /**< Score, du point de vue du joueur au trait */
+    uint8_t  from_sq;   /**< Case de départ du meilleur coup (0-80, 255 si aucun) */
+    uint8_t  to_sq;     /**< Case d'arrivée du meilleur coup */
+    int8_t   depth;     /**< Profondeur restante de la recherche ayant produit l'entrée */
+    uint8_t  bound_gen; /**< Type de borne (2 bits) et génération de recherche (6 bits) */
+} TTEntry;
+
+/**
+ * @struct TTSlot
+ * @brief Emplacement de la table : entrée sous forme empaquetée
+ */
+typedef struct {
+    uint64_t lock; /**< Clé XOR données */
+    uint64_t data; /**< Score, coup, profondeur, borne et génération */
+} TTSlot;
+
+/**
+ * @struct TTBucket
+ * @brief Seau aligné sur une ligne de cache
+ */
+typedef struct {
+    TTSlot e[TT_BUCKET_SIZE]; /**< Emplacements du seau */
+} __attribute__((aligned(64))) TTBucket;
+
+/** Valeurs de Zobrist par [couleur][type (0 = pion, 1 = roi)][case]. */
+extern uint64_t zobrist_piece[2][2][81];
+/** Valeurs de Zobrist par [contrôle - 1][case]. */
+extern uint64_t zobrist_control[2][81];
+/** Valeur de Zobrist ajoutée quand c'est au Rouge de jouer. */
+extern uint64_t zobrist_side;
+
+/**
+ * @brief Initialise les valeurs de Zobrist (idempotent, déterministe, sûr entre threads).
+ */
+void tt_init_zobrist(void);
+
+/**
+ * @brief Initialise les valeurs de Zobrist et alloue la table.
+ *
+ * À appeler une fois au démarrage, avant tout thread (interface, analyse,
+ * serveur, selfplay) : la table n'est jamais allouée à la demande. Sans
+ * table, les recherches tournent sans transpositions.
+ * @param mb taille souhaitée (1 à TT_MAX_MB, 0 = TT_DEFAULT_MB)
+ * @return 0 si succès, -1 si taille invalide ou allocation impossible
+ */
+int tt_init(size_t mb);
+
+/**
+ * @brief (Ré)alloue la table avec au plus `mb` mégaoctets et la vide.
+ *
+ * Libère l'ancienne table : aucune recherche ne doit tourner.
+ * @param mb taille souhaitée (1 à TT_MAX_MB)
+ * @return 0 si succès, -1 si taille invalide ou allocation impossible
+ */
+int tt_resize(size_t mb);
+
+/** @brief Taille actuelle de la table en mégaoctets (0 si non allouée). */
+size_t tt_size_mb(void);
+
+/** @brief Vide la table sans changer sa taille. */
+void tt_clear(void);
+
+/**
+ * @brief Signale le début d'une nouvelle recherche.
+ *
+ * Incrémente la génération, ce qui rend les entrées des recherches
+ * précédentes prioritaires au remplacement.
+ */
+void tt_new_search(void);
+
+/**
+ * @brief Cherche une position dans la table.
+ * @param key clé de Zobrist
+ * @param out entrée trouvée (copiée)
+ * @return 1 si la position est présente, 0 sinon
+ */
+int tt_probe(uint64_t key, TTEntry* out);
+
+/**
+ * @brief Mémorise le résultat de la recherche d'une position.
+ * @param key clé de Zobrist
+ * @param depth profondeur restante
+ * @param bound type de borne (tt_bound_t)
+ * @param score score du point de vue du joueur au trait
+ * @param from_sq case de départ du meilleur coup (-1 si aucun)
+ * @param to_sq case d'arrivée du meilleur coup (-1 si aucun)
+ */
+void tt_store(uint64_t key, int depth, int bound, int score, int from_sq, int to_sq);
+
+/** @brief Type de borne d'une entrée. */
+static inline int tt_entry_bound(const TTEntry* e) { return e->bound_gen & 3; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TT_H
@@ -0,0 +1,72 @@
+#ifndef UI_H
+#define UI_H
+#include "app.h"
+
+/**
+ * @file ui.h
+ * @brief Mises à jour de l'interface regroupées par image (drapeaux de changement).
+ *
+ * Le jeu, les règles et le réseau ne touchent plus aux widgets après un
+ * coup : ils marquent ce qui a changé (ui_mark()). Au premier marquage, un
+ * rappel de l'horloge d'images de GTK (`gtk_widget_add_tick_callback`) est
+ * posé sur la zone de dessin ; à l'image suivante, il applique une seule
+ * fois chaque mise à jour marquée (ui_flush()) puis se retire. Un coup avec
+ * captures, qui recalcule les scores plusieurs fois, ne réécrit donc les
+ * labels qu'une fois, et une partie IA contre IA rapide ne met pas plus
+ * d'une mise à jour par image dans la boucle GTK.
+ *
+ * Sans zone de dessin (ui_attach() pas appelé : modes sans fenêtre, tests),
+ * les marques s'accumulent sans effet jusqu'à ui_flush(). Toutes ces
+ * fonctions s'appellent depuis le thread GTK.
+ */
+
+/** Plateau à redessiner. */
+#define UI_DIRTY_BOARD  0x1u
+/** Labels des scores à réécrire. */
+#define UI_DIRTY_SCORES 0x2u
+/** Label de l'état de la partie à réécrire. */
+#define UI_DIRTY_STATUS 0x4u
+/** Toutes les mises à jour. */
+#define UI_DIRTY_ALL    (UI_DIRTY_BOARD | UI_DIRTY_SCORES | UI_DIRTY_STATUS)
+
+/** @brief Compteurs des mises à jour de l'interface */
+typedef struct {
+    long marks;   /**< Appels à ui_mark() */
+    long flushes; /**< Mises à jour appliquées (une par image au plus avec une zone de dessin) */
+} UiStats;
+
+/**
+ * @brief Rattache la zone de dessin dont l'horloge d'images applique les mises à jour.
+ *
+ * Les marques déjà posées sont appliquées à la première image.
+ * @param area zone de dessin (NULL = détacher, voir ui_detach())
+ */
+void ui_attach(GtkWidget *area);
+
+/** @brief Retire le rappel d'image en attente et détache la zone de dessin. */
+void ui_detach(void);
+
+/**
+ * @brief Marque des mises à jour à faire à la prochaine image.
+ * @param flags combinaison de UI_DIRTY_BOARD, UI_DIRTY_SCORES, UI_DIRTY_STATUS
+ */
+void ui_mark(unsigned flags);
+
+/** @brief Mises à jour marquées pas encore appliquées. */
+unsigned ui_pending(void);
+
+/**
+ * @brief Applique tout de suite les mises à jour marquées, chacune une fois.
+ *
+ * Scores (status_on_scores_changed()), puis état (refresh_game_status()),
+ * puis plateau (`gtk_widget_queue_draw`).
+ */
+void ui_flush(void);
+
+/**
+ * @brief Compteurs depuis le démarrage.
+ * @param out compteurs (retour)
+ */
+void ui_get_stats(UiStats *out);
+
+#endif // UI_H
@@ -0,0 +1,216 @@
+/**
+ * \file analysis.c
+ * \brief Thread d'analyse de la position affichée, résultats rendus au thread GTK à cadence limitée.
+ *
+ * \details
+ * - Un seul thread pour toute la partie : il attend une position, l'analyse
+ *   avec ia_analyse() jusqu'à ce qu'une autre la remplace, puis recommence.
+ * - Chaque position demandée reçoit un numéro : un résultat d'une position
+ *   déjà remplacée est ignoré.
+ * - Le thread ne garde que le dernier résultat et ne programme qu'un rappel
+ *   GTK à la fois, au plus tôt ANALYSIS_INTERVAL_MS après le précédent.
+ * - Le thread GTK garde les lignes affichées (analysis_get()), effacées dès
+ *   que la position change.
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include "analysis.h"
+#include "ui.h"
+
+int analysis_multipv = 0;
+
+/** @brief État de l'analyse (champs partagés protégés par `lock`) */
+typedef struct {
+    pthread_t thread;        /**< Thread d'analyse */
+    int running;             /**< Thread démarré (thread GTK uniquement) */
+    int lines;               /**< Lignes demandées */
+    pthread_mutex_t lock;    /**< Protège les champs partagés */
+    pthread_cond_t wake;     /**< Nouvelle position ou arrêt */
+    GameState request;       /**< Position demandée, pas encore prise par le thread */
+    int has_request;         /**< `request` à prendre */
+    unsigned serial;         /**< Numéro de la dernière position demandée */
+    int stop;                /**< Arrête la profondeur en cours (accès atomiques) */
+    int quit;                /**< Arrêt du thread */
+    IaAnalysis latest;       /**< Dernier résultat du thread */
+    int latest_new;          /**< `latest` pas encore récupéré */
+    unsigned latest_serial;  /**< Position de `latest` */
+    guint source_id;         /**< Rappel GTK programmé (0 = aucun) */
+    gint64 last_poll_us;     /**< Dernière récupération (g_get_monotonic_time()) */
+    int has_position;        /**< Une position est analysée (thread GTK) */
+    uint64_t position_hash;  /**< Clé de la position analysée (thread GTK) */
+    IaAnalysis shown;        /**< Lignes affichées (thread GTK) */
+} AnalysisState;
+
+static AnalysisState an_state = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+/**
+ * \fn static gboolean analysis_deliver(gpointer data)
+ * \brief Rappel GTK programmé par le thread d'analyse.
+ *
+ * \return G_SOURCE_REMOVE.
+ */
+static gboolean analysis_deliver(gpointer data) {
+    (void)data;
+    analysis_poll();
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * \fn static void analysis_on_depth(const IaAnalysis *an, void *user_data)
+ * \brief Profondeur terminée (thread d'analyse) : garde le résultat et programme sa remise.
+ *
+ * \param an Résultat.
+ * \param user_data Numéro de la position analysée.
+ */
+static void analysis_on_depth(const IaAnalysis *an, void *user_data) {
+    unsigned serial = *(const unsigned *)user_data;
+    pthread_mutex_lock(&an_state.lock);
+    if (serial == an_state.serial) {
+        an_state.latest = *an;
+        an_state.latest_serial = serial;
+        an_state.latest_new = 1;
+        if (!an_state.source_id) {
+            gint64 wait_us = an_state.last_poll_us + ANALYSIS_INTERVAL_MS * 1000LL - g_get_monotonic_time();
+            an_state.source_id = g_timeout_add(wait_us > 0 ? (guint)(wait_us / 1000) : 0, analysis_deliver, NULL);
+        }
+    }
+    pthread_mutex_unlock(&an_state.lock);
+}
+
+/**
+ * \fn static void *analysis_thread(void *arg)
+ * \brief Corps du thread : prend la position demandée et l'analyse jusqu'à la suivante.
+ *
+ * \return NULL.
+ */
+static void *analysis_thread(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&an_state.lock);
+    for (;;) {
+        while (!an_state.quit && !an_state.has_request) pthread_cond_wait(&an_state.wake, &an_state.lock);
+        if (an_state.quit) break;
+        GameState pos = an_state.request;
+        unsigned serial = an_state.serial;
+        an_state.has_request = 0;
+        __atomic_store_n(&an_state.stop, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&an_state.lock);
+
+        ia_analyse(&pos, an_state.lines, 0, &an_state.stop, analysis_on_depth, &serial);
+
+        pthread_mutex_lock(&an_state.lock);
+    }
+    pthread_mutex_unlock(&an_state.lock);
+    return NULL;
+}
+
+/**
+ * \fn int analysis_start(int lines)
+ * \brief Démarre le thread d'analyse.
+ *
+ * \param lines Nombre de lignes.
+ * \return 0 si succès ou déjà démarré, -1 si le thread n'a pas pu être créé.
+ */
+int analysis_start(int lines) {
+    if (an_state.running) return 0;
+    if (lines < 1) lines = 1;
+    if (lines > IA_MAX_MULTIPV) lines = IA_MAX_MULTIPV;
+    an_state.lines = lines;
+    an_state.quit = 0;
+    an_state.has_request = 0;
+    an_state.has_position = 0;
+    an_state.shown.count = 0;
+    if (pthread_create(&an_state.thread, NULL, analysis_thread, NULL) != 0) return -1;
+    an_state.running = 1;
+    return 0;
+}
+
+/**
+ * \fn int analysis_running(void)
+ * \brief Indique si le thread d'analyse tourne.
+ */
+int analysis_running(void) {
+    return an_state.running;
+}
+
+/**
+ * \fn void analysis_set_position(const GameState *state)
+ * \brief Remplace la position analysée (interrompt la profondeur en cours).
+ *
+ * \param state Position (copiée), ou NULL pour ne plus rien analyser.
+ */
+void analysis_set_position(const GameState *state) {
+    if (!an_state.running) return;
+    if (state && an_state.has_position && state->hash == an_state.position_hash) return;
+    if (!state && !an_state.has_position) return;
+
+    pthread_mutex_lock(&an_state.lock);
+    an_state.serial++;
+    an_state.latest_new = 0;
+    an_state.has_request = (state != NULL);
+    if (state) an_state.request = *state;
+    __atomic_store_n(&an_state.stop, 1, __ATOMIC_RELAXED);
+    pthread_cond_signal(&an_state.wake);
+    pthread_mutex_unlock(&an_state.lock);
+
+    an_state.has_position = (state != NULL);
+    an_state.position_hash = state ? state->hash : 0;
+    if (an_state.shown.count) {
+        an_state.shown.count = 0;
+        ui_mark(UI_DIRTY_BOARD);
+    }
+}
+
+/**
+ * \fn int analysis_poll(void)
+ * \brief Récupère le dernier résultat du thread d'analyse (thread GTK).
+ *
+ * \return 1 si un nouveau résultat a été récupéré, 0 sinon.
+ */
+int analysis_poll(void) {
+    pthread_mutex_lock(&an_state.lock);
+    int got = an_state.latest_new && an_state.latest_serial == an_state.serial;
+    if (got) an_state.shown = an_state.latest;
+    an_state.latest_new = 0;
+    an_state.source_id = 0;
+    an_state.last_poll_us = g_get_monotonic_time();
+    pthread_mutex_unlock(&an_state.lock);
+    if (got) ui_mark(UI_DIRTY_BOARD);
+    return got;
+}
+
+/**
+ * \fn int analysis_get(IaAnalysis *out)
+ * \brief Lignes affichées pour la position analysée.
+ *
+ * \param out Analyse (retour).
+ * \return 1 s'il y a au moins une ligne, 0 sinon.
+ */
+int analysis_get(IaAnalysis *out) {
+    *out = an_state.shown;
+    return an_state.running && an_state.has_position && out->count > 0;
+}
+
+/**
+ * \fn void analysis_shutdown(void)
+ * \brief Arrête le thread d'analyse, attend sa fin et retire le rappel programmé.
+ */
+void analysis_shutdown(void) {
+    if (!an_state.running) return;
+    pthread_mutex_lock(&an_state.lock);
+    an_state.quit = 1;
+    __atomic_store_n(&an_state.stop, 1, __ATOMIC_RELAXED);
+    pthread_cond_signal(&an_state.wake);
+    pthread_mutex_unlock(&an_state.lock);
+    pthread_join(an_state.thread, NULL);
+
+    if (an_state.source_id) g_source_remove(an_state.source_id);
+    an_state.source_id = 0;
+    an_state.latest_new = 0;
+    an_state.has_position = 0;
+    an_state.shown.count = 0;
+    an_state.running = 0;
+}
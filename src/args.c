@@ -12,6 +12,10 @@
  * - Sélection du mode de jeu (local, serveur, client).
  * - Paramètres IA (zéro, une ou deux IA).
  * - Parsing des adresses et des ports.
+ * - Options du mode selfplay (parties, moteurs, processus, fichier).
+ * - Livre d'ouverture (lecture, construction en mode selfplay).
+ * - Serveur de parties sans interface (port, parties simultanées).
+ * - Journal (seuil, échantillonnage).
  * - Vérification des erreurs et affichage de l’aide.
  */
 
@@ -20,6 +24,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include "args.h"
+#include "tt.h"
+#include "net.h"
+#include "record.h"
 
 
 /**
@@ -36,6 +43,29 @@ static args_t init_args(void) {
         .is_ia_both = 0,
         .host = NULL,
         .port = 0,
+        .tt_mb = 0,
+        .time_ms = 0,
+        .threads = 0,
+        .ponder = 0,
+        .verbose = 0,
+        .games = 0,
+        .engine_a = { .depth = 0, .time_ms = 100 },
+        .engine_b = { .depth = 0, .time_ms = 100 },
+        .workers = 0,
+        .search_workers = 0,
+        .max_matches = 0,
+        .out = NULL,
+        .book = NULL,
+        .book_out = NULL,
+        .record = NULL,
+        .record_every = 0,
+        .tb = NULL,
+        .tb_gen = NULL,
+        .tb_pawns = 0,
+        .log_level = LOG_LEVEL_INFO,
+        .log_sample = 0,
+        .ping_ms = 0,
+        .analyse = 0,
         .help = 0,
         .error = 0
     };
@@ -93,6 +123,25 @@ static int parse_port_token(const char* tok, int* out_port) {
     return 0;
 }
 
+/**
+ * \fn int parse_size_token(const char* tok, int max, int* out)
+ * \brief Analyse un entier strictement positif borné (taille, durée...).
+ * 
+ * \param tok Chaîne contenant la valeur.
+ * \param max Valeur maximale acceptée.
+ * \param out Pointeur pour stocker la valeur convertie.
+ * \return 0 si succès, -1 si erreur.
+ */
+static int parse_size_token(const char* tok, int max, int* out) {
+    if (!tok || !out) return -1;
+    char* end = NULL;
+    long val = strtol(tok, &end, 10);
+    if (*tok == '\0' || (end && *end != '\0')) return -1;
+    if (val <= 0 || val > max) return -1;
+    *out = (int)val;
+    return 0;
+}
+
 /**
  * \fn args_t parse_args(int argc, char **argv)
  * \brief Analyse tous les arguments de la ligne de commande.
@@ -126,10 +175,154 @@ args_t parse_args(int argc, char **argv) {
         } else if (strcmp(tok, "-c") == 0 || strcmp(tok, "--client") == 0) {
             args.mode = MODE_CLIENT;
         }
+        // Serveur de parties sans interface
+        else if (strcmp(tok, "--serve") == 0) {
+            args.mode = MODE_SERVE;
+            if (i + 1 >= argc || parse_port_token(argv[++i], &args.port) != 0) {
+                fprintf(stderr, "Port invalide (1-65535)\n");
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--max-matches") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], SERVER_MAX_MATCHES, &args.max_matches) != 0) {
+                fprintf(stderr, "Nombre de parties invalide (1-%d)\n", SERVER_MAX_MATCHES);
+                args.error = 1;
+                return args;
+            }
+        }
         // IA
         else if (strcmp(tok, "-ia") == 0 || strcmp(tok, "--ia") == 0) {
             ia_count++;
         }
+        // Taille de la table de transposition (Mo)
+        else if (strcmp(tok, "-tt") == 0 || strcmp(tok, "--tt") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], TT_MAX_MB, &args.tt_mb) != 0) {
+                fprintf(stderr, "Taille de table invalide (1-%d Mo)\n", TT_MAX_MB);
+                args.error = 1;
+                return args;
+            }
+        }
+        // Temps de réflexion de l'IA par coup (ms)
+        else if (strcmp(tok, "-t") == 0 || strcmp(tok, "--time") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], ARGS_MAX_TIME_MS, &args.time_ms) != 0) {
+                fprintf(stderr, "Temps par coup invalide (1-%d ms)\n", ARGS_MAX_TIME_MS);
+                args.error = 1;
+                return args;
+            }
+        }
+        // Réflexion anticipée de l'IA
+        else if (strcmp(tok, "-p") == 0 || strcmp(tok, "--ponder") == 0) {
+            args.ponder = 1;
+        }
+        // Statistiques de recherche de l'IA
+        else if (strcmp(tok, "-v") == 0 || strcmp(tok, "--verbose") == 0) {
+            args.verbose = 1;
+        }
+        // Nombre de threads de recherche de l'IA
+        else if (strcmp(tok, "-j") == 0 || strcmp(tok, "--threads") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], ARGS_MAX_THREADS, &args.threads) != 0) {
+                fprintf(stderr, "Nombre de threads invalide (1-%d)\n", ARGS_MAX_THREADS);
+                args.error = 1;
+                return args;
+            }
+        }
+        // Parties IA contre IA sans interface
+        else if (strcmp(tok, "--selfplay") == 0) {
+            args.mode = MODE_SELFPLAY;
+            if (i + 1 >= argc || parse_size_token(argv[++i], ARGS_MAX_GAMES, &args.games) != 0) {
+                fprintf(stderr, "Nombre de parties invalide (1-%d)\n", ARGS_MAX_GAMES);
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--engine-a") == 0 || strcmp(tok, "--engine-b") == 0) {
+            EngineConfig *eng = (tok[9] == 'a') ? &args.engine_a : &args.engine_b;
+            if (i + 1 >= argc || selfplay_parse_engine(argv[++i], eng) != 0) {
+                fprintf(stderr, "Moteur invalide (dN = profondeur N, tMS = MS ms par coup)\n");
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--workers") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], SELFPLAY_MAX_WORKERS, &args.workers) != 0) {
+                fprintf(stderr, "Nombre de processus invalide (1-%d)\n", SELFPLAY_MAX_WORKERS);
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--search-workers") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], SERVER_MAX_WORKERS, &args.search_workers) != 0) {
+                fprintf(stderr, "Nombre de threads de recherche invalide (1-%d)\n", SERVER_MAX_WORKERS);
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--out") == 0) {
+            if (i + 1 >= argc || args.out != NULL) { args.error = 1; return args; }
+            args.out = strdup(argv[++i]);
+            if (!args.out) { args.error = 1; return args; }
+        }
+        // Livre d'ouverture : lecture, ou construction en mode selfplay
+        else if (strcmp(tok, "--book") == 0 || strcmp(tok, "--book-out") == 0) {
+            char **dst = (tok[6] == '\0') ? &args.book : &args.book_out;
+            if (i + 1 >= argc || *dst != NULL) { args.error = 1; return args; }
+            *dst = strdup(argv[++i]);
+            if (!*dst) { args.error = 1; return args; }
+        }
+        // Enregistrement des parties de --selfplay et --serve
+        else if (strcmp(tok, "--record") == 0) {
+            if (i + 1 >= argc || args.record != NULL) { args.error = 1; return args; }
+            args.record = strdup(argv[++i]);
+            if (!args.record) { args.error = 1; return args; }
+        } else if (strcmp(tok, "--record-every") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], RECORD_MAX_SNAP_EVERY, &args.record_every) != 0) {
+                fprintf(stderr, "Intervalle d'instantanes invalide (1-%d coups)\n", RECORD_MAX_SNAP_EVERY);
+                args.error = 1;
+                return args;
+            }
+        }
+        // Table de finales : lecture, ou génération hors ligne
+        else if (strcmp(tok, "--tb") == 0 || strcmp(tok, "--tb-gen") == 0) {
+            char **dst = (tok[4] == '\0') ? &args.tb : &args.tb_gen;
+            if (i + 1 >= argc || *dst != NULL) { args.error = 1; return args; }
+            *dst = strdup(argv[++i]);
+            if (!*dst) { args.error = 1; return args; }
+            if (dst == &args.tb_gen) args.mode = MODE_TBGEN;
+        } else if (strcmp(tok, "--tb-pawns") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], TB_GEN_MAX_PAWNS, &args.tb_pawns) != 0) {
+                fprintf(stderr, "Nombre de soldats invalide (1-%d)\n", TB_GEN_MAX_PAWNS);
+                args.error = 1;
+                return args;
+            }
+        }
+        // Journal : seuil et échantillonnage
+        else if (strcmp(tok, "--log-level") == 0) {
+            if (i + 1 >= argc || log_parse_level(argv[++i], &args.log_level) != 0) {
+                fprintf(stderr, "Niveau de journal invalide (off, error, warn, info, debug)\n");
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--log-sample") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], ARGS_MAX_LOG_SAMPLE, &args.log_sample) != 0) {
+                fprintf(stderr, "Echantillonnage invalide (1-%d)\n", ARGS_MAX_LOG_SAMPLE);
+                args.error = 1;
+                return args;
+            }
+        }
+        // Canal de contrôle réseau
+        else if (strcmp(tok, "--ping-interval") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], ARGS_MAX_PING_MS, &args.ping_ms) != 0) {
+                fprintf(stderr, "Intervalle de PING invalide (1-%d ms)\n", ARGS_MAX_PING_MS);
+                args.error = 1;
+                return args;
+            }
+        } else if (strcmp(tok, "--no-ping") == 0) {
+            args.ping_ms = -1;
+        }
+        // Mode analyse de l'interface
+        else if (strcmp(tok, "--analyse") == 0) {
+            if (i + 1 >= argc || parse_size_token(argv[++i], ARGS_MAX_ANALYSE, &args.analyse) != 0) {
+                fprintf(stderr, "Nombre de lignes d'analyse invalide (1-%d)\n", ARGS_MAX_ANALYSE);
+                args.error = 1;
+                return args;
+            }
+        }
         // Opérandes non option (port ou host:port)
         else if (tok[0] != '-') {
             if (args.mode == MODE_SERVER && args.port == 0) {
@@ -164,6 +357,30 @@ args_t parse_args(int argc, char **argv) {
     if (args.mode == MODE_CLIENT && (args.host == NULL || args.port == 0)) {
         args.error = 1;
     }
+    if (args.book_out && args.mode != MODE_SELFPLAY) {
+        args.error = 1;
+    }
+    if ((args.record || args.record_every) && args.mode != MODE_SELFPLAY && args.mode != MODE_SERVE) {
+        args.error = 1;
+    }
+    if (args.record_every && !args.record) {
+        args.error = 1;
+    }
+    if (args.tb_pawns && args.mode != MODE_TBGEN) {
+        args.error = 1;
+    }
+    if (args.max_matches && args.mode != MODE_SERVE) {
+        args.error = 1;
+    }
+    if (args.workers && args.mode != MODE_SELFPLAY) {
+        args.error = 1;
+    }
+    if (args.search_workers && args.mode != MODE_SERVE) {
+        args.error = 1;
+    }
+    if (args.analyse && (args.mode == MODE_SELFPLAY || args.mode == MODE_SERVE || args.mode == MODE_TBGEN)) {
+        args.error = 1;
+    }
 
     return args;
 }
@@ -180,10 +397,41 @@ void print_usage(const char *program_name) {
     printf("Modes de jeu (obligatoires):\n");
     printf("  -l, --local               #Mode local (2 joueurs sur le même exécutable)\n");
     printf("  -s, --server PORT         #Mode serveur sur le port spécifié\n");
-    printf("  -c, --client HOST:PORT    #Mode client, connexion à HOST:PORT\n\n");
+    printf("  -c, --client HOST:PORT    #Mode client, connexion à HOST:PORT\n");
+    printf("  --serve PORT              #Serveur de parties contre l'IA sans fenetre (une par client)\n\n");
     printf("Options:\n");
     printf("  -ia, --ia                 #Active l'IA (1x = une IA joue votre couleur, 2x = IA vs IA en local)\n");
+    printf("  -tt, --tt MO              #Taille de la table de transposition de l'IA en Mo (defaut %d)\n", TT_DEFAULT_MB);
+    printf("  -t, --time MS             #Temps de reflexion de l'IA par coup en millisecondes (defaut 1000)\n");
+    printf("  -j, --threads N           #Nombre de threads de recherche de l'IA (defaut 1)\n");
+    printf("  -p, --ponder              #L'IA reflechit aussi pendant le tour de l'adversaire\n");
+    printf("  -v, --verbose             #Affiche les statistiques de recherche apres chaque coup de l'IA\n");
+    printf("  --book FICHIER            #Livre d'ouverture de l'IA (construit avec --book-out)\n");
+    printf("  --tb FICHIER              #Table de finales de l'IA (construite avec --tb-gen)\n");
+    printf("  --log-level NIVEAU        #Journal: off, error, warn, info (defaut) ou debug\n");
+    printf("  --log-sample N            #Garde un message d'information sur N (coups, captures)\n");
+    printf("  --ping-interval MS        #Partie reseau: mesure l'aller-retour toutes les MS ms (defaut %d)\n", NET_PING_INTERVAL_MS);
+    printf("  --no-ping                 #Partie reseau: aucun PING (adversaire perdu non detecte)\n");
+    printf("  --analyse N               #Affiche les N meilleurs coups du joueur au trait sur le plateau (1-%d)\n", ARGS_MAX_ANALYSE);
     printf("  -h, --help                #Affiche cette aide\n\n");
+    printf("Parties IA contre IA sans interface:\n");
+    printf("  --selfplay N              #Joue N parties entre les moteurs A et B, sans fenetre\n");
+    printf("  --engine-a, --engine-b S  #Moteur: dN (profondeur N) ou tMS (MS ms par coup), defaut t100\n");
+    printf("  --workers N               #Processus qui jouent les parties en parallele (1-%d, defaut 1)\n", SELFPLAY_MAX_WORKERS);
+    printf("  --out FICHIER             #Resultats en CSV, ou JSON si FICHIER finit par .json (defaut: stdout)\n");
+    printf("  --book-out FICHIER        #Construit un livre d'ouverture avec les premiers coups des parties\n");
+    printf("  --record FICHIER          #Ajoute les parties a un fichier de parties (aussi avec --serve)\n");
+    printf("  --record-every K          #Instantane de la position tous les K coups (1-%d, defaut %d)\n\n",
+           RECORD_MAX_SNAP_EVERY, RECORD_DEFAULT_SNAP_EVERY);
+    printf("Table de finales (analyse retrograde, sans interface):\n");
+    printf("  --tb-gen FICHIER          #Genere la table et l'ecrit dans FICHIER\n");
+    printf("  --tb-pawns N              #Soldats par camp au plus (1-%d, defaut %d)\n", TB_GEN_MAX_PAWNS, ARGS_DEFAULT_TB_PAWNS);
+    printf("                            #Classes generees : roi contre roi, roi et 2 soldats contre roi\n");
+    printf("                            #(et l'inverse) ; 2 soldats de chaque cote ne sont pas couverts\n\n");
+    printf("Serveur de parties (--serve, l'IA joue les rouges contre chaque client):\n");
+    printf("  --max-matches N           #Parties simultanees au plus (1-%d, defaut %d)\n", SERVER_MAX_MATCHES, SERVER_DEFAULT_MATCHES);
+    printf("  --search-workers N        #Recherches de l'IA menees en meme temps, une par partie au plus\n");
+    printf("                            #(1-%d, defaut 1) ; chacune sur -j threads, temps par coup avec -t\n\n", SERVER_MAX_WORKERS);
     printf("Exemples:\n");
     printf("  %s -l                     # Jeu local\n", program_name);
     printf("  %s -s 5555                # Serveur sur le port 5555\n", program_name);
@@ -191,6 +439,20 @@ void print_usage(const char *program_name) {
     printf("  %s -s -ia 5555            # Serveur avec IA (Rouge)\n", program_name);
     printf("  %s -c -ia 127.0.0.1:5555  # Client avec IA (Bleu)\n", program_name);
     printf("  %s -l -ia -ia             # Local IA vs IA (les deux couleurs)\n", program_name);
+    printf("  %s -s -ia -t 250 5555     # Serveur avec IA limitee a 250 ms par coup\n", program_name);
+    printf("  %s -l -ia -j 4            # Local contre IA sur 4 threads\n", program_name);
+    printf("  %s -s -ia -p 5555         # Serveur avec IA qui reflechit pendant votre tour\n", program_name);
+    printf("  %s -l -ia -v              # Local contre IA, statistiques de chaque recherche\n", program_name);
+    printf("  %s --selfplay 100 --engine-a t100 --engine-b d4 --workers 4 --out res.csv\n", program_name);
+    printf("  %s --selfplay 500 --engine-a d5 --engine-b d5 --book-out krojanty.book\n", program_name);
+    printf("  %s -l -ia --book krojanty.book  # Local contre IA avec livre d'ouverture\n", program_name);
+    printf("  %s --tb-gen krojanty.tb --tb-pawns 2\n", program_name);
+    printf("  %s --serve 5555 --max-matches 32 --search-workers 4 -t 250\n", program_name);
+    printf("  %s --selfplay 1000 --workers 8 --record parties.krec  # Parties enregistrees, rejouables coup par coup\n", program_name);
+    printf("  %s -s -ia 5555 --log-level warn  # Serveur, journal reduit aux erreurs\n", program_name);
+    printf("  %s -l -ia --tb krojanty.tb      # Local contre IA avec table de finales\n", program_name);
+    printf("  %s -c 127.0.0.1:5555 --ping-interval 500  # Client, aller-retour mesure toutes les 500 ms\n", program_name);
+    printf("  %s -l --analyse 3         # Local, trois meilleurs coups affiches en continu\n", program_name);
 }
 
 
@@ -200,11 +462,26 @@ void print_usage(const char *program_name) {
  * 
  * \param args Pointeur vers la structure à nettoyer.
  *
- * Libère notamment la chaîne \c host si elle a été allouée.
+ * Libère notamment les chaînes \c host, \c out, \c book, \c book_out, \c record, \c tb et \c tb_gen si elles ont été allouées.
  */
 void free_args(args_t *args) {
-    if (args && args->host) {
+    if (!args) return;
+    if (args->host) {
         free(args->host);
         args->host = NULL;
     }
+    if (args->out) {
+        free(args->out);
+        args->out = NULL;
+    }
+    free(args->book);
+    args->book = NULL;
+    free(args->book_out);
+    args->book_out = NULL;
+    free(args->record);
+    args->record = NULL;
+    free(args->tb);
+    args->tb = NULL;
+    free(args->tb_gen);
+    args->tb_gen = NULL;
 }
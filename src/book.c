@@ -0,0 +1,240 @@
+/**
+ * \file book.c
+ * \brief Livre d'ouverture : projection en mémoire, consultation et construction.
+ *
+ * \details
+ * - Le fichier est projeté en mémoire par map_file() (mapfile.h).
+ * - La consultation cherche par dichotomie la première entrée de la clé,
+ *   puis garde les coups que les règles acceptent pour la position.
+ * - La construction accumule les coups, les trie et additionne les poids
+ *   d'un même couple (position, coup).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "book.h"
+#include "mapfile.h"
+
+/** \brief Livre courant : zone projetée (ou lue) et ses entrées. */
+static void *book_map = NULL;
+static size_t book_map_len = 0;
+static const BookEntry *book_entries = NULL;
+static size_t book_count = 0;
+
+/**
+ * \fn static int book_entry_cmp(const void *a, const void *b)
+ * \brief Ordre du fichier : clé croissante, puis poids décroissant, puis coup.
+ */
+static int book_entry_cmp(const void *a, const void *b) {
+    const BookEntry *x = a, *y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->weight != y->weight) return x->weight > y->weight ? -1 : 1;
+    if (x->from_sq != y->from_sq) return x->from_sq - y->from_sq;
+    return x->to_sq - y->to_sq;
+}
+
+/**
+ * \fn static int book_valid(const void *data, size_t len)
+ * \brief Vérifie l'en-tête, la taille et l'ordre des entrées d'un fichier.
+ */
+static int book_valid(const void *data, size_t len) {
+    if (len < sizeof(BookHeader)) return 0;
+    const BookHeader *h = data;
+    if (memcmp(h->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 || h->version != BOOK_VERSION) return 0;
+    if ((len - sizeof(BookHeader)) / sizeof(BookEntry) != h->count ||
+        (len - sizeof(BookHeader)) % sizeof(BookEntry) != 0) return 0;
+    const BookEntry *e = (const BookEntry *)((const char *)data + sizeof(BookHeader));
+    for (uint32_t i = 0; i < h->count; ++i) {
+        if (e[i].from_sq > 80 || e[i].to_sq > 80 || e[i].weight == 0) return 0;
+        if (i > 0 && e[i - 1].key > e[i].key) return 0;
+    }
+    return 1;
+}
+
+/**
+ * \fn void book_close(void)
+ * \brief Ferme le livre courant.
+ */
+void book_close(void) {
+    unmap_file(book_map, book_map_len);
+    book_map = NULL;
+    book_map_len = 0;
+    book_entries = NULL;
+    book_count = 0;
+}
+
+/**
+ * \fn int book_open(const char *path)
+ * \brief Projette un livre en mémoire.
+ *
+ * \param path Fichier du livre.
+ * \return 0 si succès, -1 sinon.
+ */
+int book_open(const char *path) {
+    book_close();
+    void *data = NULL;
+    size_t len = 0;
+    if (map_file(path, &data, &len) != 0) return -1;
+    book_map = data;
+    book_map_len = len;
+    if (!book_valid(data, len)) {
+        book_close();
+        return -1;
+    }
+    book_entries = (const BookEntry *)((const char *)data + sizeof(BookHeader));
+    book_count = ((const BookHeader *)data)->count;
+    return 0;
+}
+
+/**
+ * \fn size_t book_size(void)
+ * \brief Nombre d'entrées du livre courant.
+ */
+size_t book_size(void) { return book_count; }
+
+/**
+ * \fn int book_probe_moves(const GameState *s, Move *moves, int *weights, int max)
+ * \brief Coups du livre pour une position, vérifiés contre les règles.
+ *
+ * \param s État du jeu (synchronisé).
+ * \param moves Coups trouvés (retour).
+ * \param weights Poids des coups (retour, NULL accepté).
+ * \param max Taille des tableaux.
+ * \return Nombre de coups.
+ */
+int book_probe_moves(const GameState *s, Move *moves, int *weights, int max) {
+    size_t lo = 0, hi = book_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (book_entries[mid].key < s->hash) lo = mid + 1;
+        else hi = mid;
+    }
+    int n = 0;
+    for (size_t i = lo; i < book_count && book_entries[i].key == s->hash && n < max; ++i) {
+        const BookEntry *e = &book_entries[i];
+        int idx = rules_piece_at(s, e->from_sq);
+        if (idx < 0 || s->pieces[idx].color != s->current_player) continue;
+        if (!rules_can_move(s, idx, e->to_sq / 9, e->to_sq % 9)) continue;
+        moves[n] = (Move){ idx, e->from_sq / 9, e->from_sq % 9, e->to_sq / 9, e->to_sq % 9 };
+        if (weights) weights[n] = e->weight;
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * \fn int book_probe(const GameState *s, uint64_t *rng, Move *out)
+ * \brief Tire un coup du livre, proportionnellement aux poids.
+ *
+ * L'état du tirage appartient à l'appelant (une partie, une recherche) :
+ * deux recherches simultanées ne partagent rien, et une même graine rejoue
+ * les mêmes tirages.
+ *
+ * \param s État du jeu (synchronisé).
+ * \param rng État du tirage, avancé à chaque tirage (0 : BOOK_DEFAULT_SEED).
+ * \param out Coup tiré (retour).
+ * \return 1 si un coup a été trouvé, 0 sinon.
+ */
+int book_probe(const GameState *s, uint64_t *rng, Move *out) {
+    if (!book_count) return 0;
+    Move moves[BOOK_MAX_MOVES];
+    int weights[BOOK_MAX_MOVES];
+    int n = book_probe_moves(s, moves, weights, BOOK_MAX_MOVES);
+    if (n == 0) return 0;
+    long total = 0;
+    for (int i = 0; i < n; ++i) total += weights[i];
+    // xorshift64* : tirage dans [0, total) ; l'état nul est un point fixe
+    uint64_t x = *rng ? *rng : BOOK_DEFAULT_SEED;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *rng = x;
+    long pick = (long)((x * 0x2545F4914F6CDD1DULL >> 33) % (uint64_t)total);
+    int i = 0;
+    while (pick >= weights[i]) pick -= weights[i++];
+    *out = moves[i];
+    return 1;
+}
+
+/**
+ * \fn void book_builder_init(BookBuilder *b)
+ * \brief Prépare un accumulateur vide.
+ */
+void book_builder_init(BookBuilder *b) { memset(b, 0, sizeof(*b)); }
+
+/**
+ * \fn int book_builder_add(BookBuilder *b, const GameState *s, const Move *mv, int weight)
+ * \brief Ajoute un coup joué depuis une position.
+ *
+ * \return 0 si succès, -1 si la mémoire manque.
+ */
+int book_builder_add(BookBuilder *b, const GameState *s, const Move *mv, int weight) {
+    if (weight <= 0) return 0;
+    if (b->count == b->cap) {
+        size_t cap = b->cap ? b->cap * 2 : 1024;
+        BookEntry *grown = realloc(b->entries, cap * sizeof(BookEntry));
+        if (!grown) return -1;
+        b->entries = grown;
+        b->cap = cap;
+    }
+    b->entries[b->count++] = (BookEntry){
+        .key = s->hash,
+        .from_sq = (uint8_t)(mv->from_row * 9 + mv->from_col),
+        .to_sq = (uint8_t)(mv->to_row * 9 + mv->to_col),
+        .weight = (uint16_t)(weight > 0xFFFF ? 0xFFFF : weight),
+    };
+    return 0;
+}
+
+/**
+ * \fn static int book_move_cmp(const void *a, const void *b)
+ * \brief Ordre de fusion : clé puis coup (les doublons deviennent voisins).
+ */
+static int book_move_cmp(const void *a, const void *b) {
+    const BookEntry *x = a, *y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->from_sq != y->from_sq) return x->from_sq - y->from_sq;
+    return x->to_sq - y->to_sq;
+}
+
+/**
+ * \fn long book_builder_write(BookBuilder *b, const char *path)
+ * \brief Trie, fusionne et écrit le livre.
+ *
+ * \param b Accumulateur.
+ * \param path Fichier à écrire.
+ * \return Nombre d'entrées écrites, -1 en cas d'erreur.
+ */
+long book_builder_write(BookBuilder *b, const char *path) {
+    qsort(b->entries, b->count, sizeof(BookEntry), book_move_cmp);
+    size_t out = 0;
+    for (size_t i = 0; i < b->count; ++i) {
+        if (out > 0 && book_move_cmp(&b->entries[out - 1], &b->entries[i]) == 0) {
+            unsigned w = b->entries[out - 1].weight + b->entries[i].weight;
+            b->entries[out - 1].weight = (uint16_t)(w > 0xFFFF ? 0xFFFF : w);
+        } else {
+            b->entries[out++] = b->entries[i];
+        }
+    }
+    b->count = out;
+    qsort(b->entries, b->count, sizeof(BookEntry), book_entry_cmp);
+
+    FILE *f = fopen(path, "wb");
+    if (!f) return -1;
+    BookHeader h = { .version = BOOK_VERSION, .count = (uint32_t)b->count };
+    memcpy(h.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+             (b->count == 0 || fwrite(b->entries, sizeof(BookEntry), b->count, f) == b->count);
+    if (fclose(f) != 0) ok = 0;
+    return ok ? (long)b->count : -1;
+}
+
+/**
+ * \fn void book_builder_free(BookBuilder *b)
+ * \brief Libère un accumulateur.
+ */
+void book_builder_free(BookBuilder *b) {
+    free(b->entries);
+    book_builder_init(b);
+}
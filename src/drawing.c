@@ -12,13 +12,26 @@
  * - Dessin du plateau de 9x9 cases.
  * - Mise en évidence des cases contrôlées et des déplacements possibles.
  * - Affichage des pions, rois et bases avec leurs couleurs.
+ * - Couche fixe (grille, repères, logos) et dernier rendu du plateau mis en
+ *   cache ; seules les cases changées sont redessinées.
+ * - Lignes du mode analyse (flèches et scores), dessinées par-dessus le
+ *   rendu à chaque dessin.
  */
 
 
 #include <cairo.h>
 #include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
 #include "drawing.h"
 #include "game.h"
+#include "analysis.h"
+
+/** \brief Côté de la grille (pixels). */
+#define DRAWING_GRID_SIZE 400.0
+/** \brief Au-delà de ce nombre de cases changées, le cadre est redessiné en entier. */
+#define DRAWING_MAX_DIRTY 24
 
 
 /** Logo de la base bleue */
@@ -42,7 +55,7 @@ GdkPixbuf *logo_red = NULL;
 void click_to_cell(double x, double y, int *row, int *col, GtkWidget *drawing_area) {
     int width  = gtk_widget_get_width(drawing_area);
     int height = gtk_widget_get_height(drawing_area);
-    double grid_size = 400.0;
+    double grid_size = DRAWING_GRID_SIZE;
     double cell_size = grid_size / 9.0;
     double offset_x = (width - grid_size) / 2.0;
     double offset_y = (height - grid_size) / 2.0;
@@ -59,154 +72,418 @@ void click_to_cell(double x, double y, int *row, int *col, GtkWidget *drawing_ar
     *row = (int)((y - offset_y) / cell_size);
 }
 
+/** \brief Signature d'une case : contrôle (bits 0-1). */
+#define SQ_CONTROL_MASK 0x03u
+/** \brief Signature d'une case : point jouable. */
+#define SQ_HIGHLIGHT    0x04u
+/** \brief Signature d'une case : pièce présente. */
+#define SQ_PIECE        0x08u
+/** \brief Signature d'une case : pièce rouge. */
+#define SQ_RED          0x10u
+/** \brief Signature d'une case : roi. */
+#define SQ_KING         0x20u
+/** \brief Signature d'une case : pièce sélectionnée. */
+#define SQ_SELECTED     0x40u
+
+/** @brief Géométrie du plateau dans la zone de dessin */
+typedef struct {
+    double cell_size; /**< Côté d'une case */
+    double offset_x;  /**< Bord gauche de la grille */
+    double offset_y;  /**< Bord haut de la grille */
+} BoardGeometry;
+
 /**
- * \fn void draw_cb(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data)
- * \brief Callback de dessin GTK, affiche le plateau et les pièces.
- *
- * \param area Zone de dessin GTK.
- * \param cr Contexte Cairo.
- * \param width Largeur de la zone de dessin.
- * \param height Hauteur de la zone de dessin.
- * \param user_data Donnée utilisateur (non utilisée).
+ * @brief Couches du plateau mises en cache
  *
- * Cette fonction gère :
- * - Le remplissage du fond.
- * - Les cases contrôlées par chaque joueur.
- * - Les coups jouables (points noirs).
- * - Les pièces avec leur couleur, sélection et type.
- * - L’affichage des bases avec logos.
+ * `overlay` (grille, repères, logos sur fond transparent) ne dépend que de
+ * la taille de la zone, de la taille des cases et des logos. `frame` est le
+ * dernier rendu complet ; `sig` dit ce que montre chacune de ses cases.
  */
-void draw_cb(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data) {
-    (void)area; (void)user_data;
-    int rows = 9, cols = 9;
-    double grid_size = 400.0;
-    double cell_size = grid_size / 9.0;
-    double offset_x = (width - grid_size) / 2.0;
-    double offset_y = (height - grid_size) / 2.0;
+typedef struct {
+    int width, height;          /**< Taille de la zone (pixels logiques) */
+    double cell_size;           /**< Taille des cases des couches */
+    double scale_x, scale_y;    /**< Échelle de la cible (écrans haute densité) */
+    const GdkPixbuf *logos[2];  /**< Logos dessinés dans `overlay` */
+    cairo_surface_t *overlay;   /**< Couche fixe, au-dessus des teintes */
+    cairo_surface_t *frame;     /**< Dernier rendu du plateau */
+    uint16_t sig[81];           /**< Signatures des cases de `frame` */
+    GdkPixbuf *scaled[2];       /**< Logos à la taille d'une case */
+    int scaled_size[2];         /**< Taille de `scaled` */
+    const GdkPixbuf *scaled_src[2]; /**< Logo source de `scaled` */
+} BoardCache;
 
-    cairo_set_source_rgb(cr, 1, 1, 1);
-    cairo_paint(cr);
+static BoardCache board_cache;
 
-    // cases contrôlées
-    for (int r = 0; r < 9; ++r) {
-        for (int c = 0; c < 9; ++c) {
-            if (cell_control[r][c] == 1) {
-                cairo_set_source_rgb(cr, 0.8, 0.8, 1);
-                cairo_rectangle(cr, offset_x + c*cell_size, offset_y + r*cell_size, cell_size, cell_size);
-                cairo_fill(cr);
-            } else if (cell_control[r][c] == 2) {
-                cairo_set_source_rgb(cr, 1, 0.8, 0.8);
-                cairo_rectangle(cr, offset_x + c*cell_size, offset_y + r*cell_size, cell_size, cell_size);
-                cairo_fill(cr);
-            }
-        }
-    }
-
-    // points jouables
-    for (int r = 0; r < 9; ++r) {
-        for (int c = 0; c < 9; ++c) {
-            if (highlight_moves[r][c]) {
-                double cx = offset_x + c*cell_size + cell_size/2.0;
-                double cy = offset_y + r*cell_size + cell_size/2.0;
-                cairo_set_source_rgb(cr, 0, 0, 0);
-                cairo_arc(cr, cx, cy, cell_size * 0.1, 0, 2*M_PI);
-                cairo_fill(cr);
-            }
-        }
-    }
-
-    // teintes sous pièces (présence)
+/**
+ * \fn void drawing_board_signature(uint16_t sig[81])
+ * \brief Ce que chaque case doit montrer : contrôle, point jouable, pièce (couleur, type, sélection).
+ *
+ * \param sig Signatures des cases `row * 9 + col` (retour).
+ */
+void drawing_board_signature(uint16_t sig[81]) {
+    for (int r = 0; r < 9; ++r)
+        for (int c = 0; c < 9; ++c)
+            sig[r * 9 + c] = (uint16_t)(((unsigned)cell_control[r][c] & SQ_CONTROL_MASK) |
+                                        (highlight_moves[r][c] ? SQ_HIGHLIGHT : 0u));
     for (int i = 0; i < piece_count; ++i) {
         Piece p = pieces[i];
-        if ((p.row == 0 && p.col == 0) || (p.row == 8 && p.col == 8)) continue;
-        if (p.color == 'R') cairo_set_source_rgb(cr, 1, 0.8, 0.8);
-        else                cairo_set_source_rgb(cr, 0.8, 0.8, 1);
-        cairo_rectangle(cr, offset_x + p.col*cell_size, offset_y + p.row*cell_size, cell_size, cell_size);
-        cairo_fill(cr);
+        if (p.row < 0 || p.row > 8 || p.col < 0 || p.col > 8) continue;
+        uint16_t bits = SQ_PIECE;
+        if (p.color == 'R') bits |= SQ_RED;
+        if (p.type == 'R' || p.type == 'K' || p.type == 'r' || p.type == 'k') bits |= SQ_KING;
+        if (i == selected_piece) bits |= SQ_SELECTED;
+        sig[p.row * 9 + p.col] |= bits;
     }
+}
+
+/**
+ * \fn static GdkPixbuf *drawing_scaled_logo(int which, const GdkPixbuf *src, int size)
+ * \brief Logo à la taille d'une case, mis à l'échelle une fois par taille.
+ */
+static GdkPixbuf *drawing_scaled_logo(int which, const GdkPixbuf *src, int size) {
+    if (!src) return NULL;
+    if (board_cache.scaled[which] && board_cache.scaled_src[which] == src && board_cache.scaled_size[which] == size)
+        return board_cache.scaled[which];
+    if (board_cache.scaled[which]) g_object_unref(board_cache.scaled[which]);
+    board_cache.scaled[which] = gdk_pixbuf_scale_simple(src, size, size, GDK_INTERP_BILINEAR);
+    board_cache.scaled_src[which] = src;
+    board_cache.scaled_size[which] = size;
+    return board_cache.scaled[which];
+}
+
+/**
+ * \fn static cairo_surface_t *drawing_new_layer(int width, int height)
+ * \brief Surface transparente de la taille de la zone, à l'échelle de la cible.
+ */
+static cairo_surface_t *drawing_new_layer(int width, int height) {
+    cairo_surface_t *layer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                        (int)ceil(width * board_cache.scale_x),
+                                                        (int)ceil(height * board_cache.scale_y));
+    cairo_surface_set_device_scale(layer, board_cache.scale_x, board_cache.scale_y);
+    return layer;
+}
+
+/**
+ * \fn static void drawing_render_overlay(const BoardGeometry *g)
+ * \brief Dessine la couche fixe : grille, repères des lignes et colonnes, bases.
+ */
+static void drawing_render_overlay(const BoardGeometry *g) {
+    int rows = 9, cols = 9;
+    double grid_size = DRAWING_GRID_SIZE;
+    cairo_t *cr = cairo_create(board_cache.overlay);
 
     // grille
     cairo_set_source_rgb(cr, 0, 0, 0);
     cairo_set_line_width(cr, 1);
     for (int c = 0; c <= cols; ++c) {
-        double x = offset_x + c*cell_size;
-        cairo_move_to(cr, x, offset_y);
-        cairo_line_to(cr, x, offset_y + grid_size);
+        double x = g->offset_x + c*g->cell_size;
+        cairo_move_to(cr, x, g->offset_y);
+        cairo_line_to(cr, x, g->offset_y + grid_size);
     }
     for (int r = 0; r <= rows; ++r) {
-        double y = offset_y + r*cell_size;
-        cairo_move_to(cr, offset_x, y);
-        cairo_line_to(cr, offset_x + grid_size, y);
+        double y = g->offset_y + r*g->cell_size;
+        cairo_move_to(cr, g->offset_x, y);
+        cairo_line_to(cr, g->offset_x + grid_size, y);
     }
     cairo_stroke(cr);
 
     // labels colonnes
     for (int c = 0; c < cols; ++c) {
         char label[2]; label[0] = 'A' + c; label[1] = '\0';
-        cairo_move_to(cr, offset_x + (c + 0.4)*cell_size, offset_y - 5);
+        cairo_move_to(cr, g->offset_x + (c + 0.4)*g->cell_size, g->offset_y - 5);
         cairo_show_text(cr, label);
     }
     // labels lignes
     for (int r = 0; r < rows; ++r) {
-        char label[3]; 
-        snprintf(label, sizeof(label), "%d", rows - r); 
-        cairo_move_to(cr, offset_x - 15, offset_y + (r + 0.6)*cell_size);
+        char label[3];
+        snprintf(label, sizeof(label), "%d", rows - r);
+        cairo_move_to(cr, g->offset_x - 15, g->offset_y + (r + 0.6)*g->cell_size);
         cairo_show_text(cr, label);
     }
 
-
     // bases
-    if (logo_blue) {
-        GdkPixbuf *scaled = gdk_pixbuf_scale_simple(logo_blue, (int)cell_size, (int)cell_size, GDK_INTERP_BILINEAR);
-        gdk_cairo_set_source_pixbuf(cr, scaled, offset_x + 0*cell_size, offset_y + 0*cell_size);
+    GdkPixbuf *blue = drawing_scaled_logo(0, logo_blue, (int)g->cell_size);
+    GdkPixbuf *red = drawing_scaled_logo(1, logo_red, (int)g->cell_size);
+    if (blue) {
+        gdk_cairo_set_source_pixbuf(cr, blue, g->offset_x + 0*g->cell_size, g->offset_y + 0*g->cell_size);
         cairo_paint(cr);
-        g_object_unref(scaled);
     }
-    if (logo_red) {
-        GdkPixbuf *scaled = gdk_pixbuf_scale_simple(logo_red, (int)cell_size, (int)cell_size, GDK_INTERP_BILINEAR);
-        gdk_cairo_set_source_pixbuf(cr, scaled, offset_x + 8*cell_size, offset_y + 8*cell_size);
+    if (red) {
+        gdk_cairo_set_source_pixbuf(cr, red, g->offset_x + 8*g->cell_size, g->offset_y + 8*g->cell_size);
         cairo_paint(cr);
-        g_object_unref(scaled);
     }
+    cairo_destroy(cr);
+}
 
-    // pièces
-    for (int i = 0; i < piece_count; ++i) {
-        Piece p = pieces[i];
-        double x = offset_x + (p.col + 0.5)*cell_size;
-        double y = offset_y + (p.row + 0.5)*cell_size;
+/**
+ * \fn static void drawing_render_squares(cairo_t *cr, const BoardGeometry *g, const uint16_t sig[81], int r0, int r1, int c0, int c1)
+ * \brief Dessine les cases r0..r1 x c0..c1 d'après leurs signatures, couche par couche.
+ *
+ * L'ordre des couches est celui d'un rendu complet : contrôle, points
+ * jouables, teintes sous les pièces, couche fixe, pièces. Chaque dessin
+ * reste dans sa case : sous une découpe, redessiner les cases qui la
+ * touchent suffit.
+ */
+static void drawing_render_squares(cairo_t *cr, const BoardGeometry *g, const uint16_t sig[81],
+                                   int r0, int r1, int c0, int c1) {
+    double cell_size = g->cell_size;
+
+    cairo_set_source_rgb(cr, 1, 1, 1);
+    cairo_paint(cr);
+
+    // cases contrôlées
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            unsigned control = sig[r * 9 + c] & SQ_CONTROL_MASK;
+            if (control == 1) cairo_set_source_rgb(cr, 0.8, 0.8, 1);
+            else if (control == 2) cairo_set_source_rgb(cr, 1, 0.8, 0.8);
+            else continue;
+            cairo_rectangle(cr, g->offset_x + c*cell_size, g->offset_y + r*cell_size, cell_size, cell_size);
+            cairo_fill(cr);
+        }
+    }
+
+    // points jouables
+    cairo_set_source_rgb(cr, 0, 0, 0);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            if (!(sig[r * 9 + c] & SQ_HIGHLIGHT)) continue;
+            double cx = g->offset_x + c*cell_size + cell_size/2.0;
+            double cy = g->offset_y + r*cell_size + cell_size/2.0;
+            cairo_new_path(cr);
+            cairo_arc(cr, cx, cy, cell_size * 0.1, 0, 2*M_PI);
+            cairo_fill(cr);
+        }
+    }
 
-        // sélection
-        if (i == selected_piece) {
-            cairo_set_source_rgb(cr, 1, 1, 0);
-            cairo_arc(cr, x, y, cell_size * 0.4, 0, 2*M_PI);
+    // teintes sous pièces (présence)
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            uint16_t sq = sig[r * 9 + c];
+            if (!(sq & SQ_PIECE) || (r == 0 && c == 0) || (r == 8 && c == 8)) continue;
+            if (sq & SQ_RED) cairo_set_source_rgb(cr, 1, 0.8, 0.8);
+            else             cairo_set_source_rgb(cr, 0.8, 0.8, 1);
+            cairo_rectangle(cr, g->offset_x + c*cell_size, g->offset_y + r*cell_size, cell_size, cell_size);
             cairo_fill(cr);
         }
+    }
 
-        double radius = cell_size * 0.3;
+    // grille, repères et bases
+    cairo_set_source_surface(cr, board_cache.overlay, 0, 0);
+    cairo_paint(cr);
 
-        // ombre
-        cairo_set_source_rgb(cr, 0, 0, 0);
-        cairo_arc(cr, x, y, radius * 1.1, 0, 2*M_PI);
-        cairo_fill(cr);
+    // pièces
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            uint16_t sq = sig[r * 9 + c];
+            if (!(sq & SQ_PIECE)) continue;
+            double x = g->offset_x + (c + 0.5)*cell_size;
+            double y = g->offset_y + (r + 0.5)*cell_size;
 
-        // pion
-        if (p.color == 'R') cairo_set_source_rgb(cr, 1, 0, 0);
-        else                cairo_set_source_rgb(cr, 0, 0, 1);
-        cairo_arc(cr, x, y, radius, 0, 2*M_PI);
-        cairo_fill(cr);
+            // sélection
+            if (sq & SQ_SELECTED) {
+                cairo_set_source_rgb(cr, 1, 1, 0);
+                cairo_new_path(cr);
+                cairo_arc(cr, x, y, cell_size * 0.4, 0, 2*M_PI);
+                cairo_fill(cr);
+            }
 
-        // signe roi (pastille)
-        if (p.type == 'R' || p.type == 'K' || p.type == 'r' || p.type == 'k') {
-            cairo_save(cr);
-            cairo_new_path(cr);
-            double dot = radius * 0.5;
-            cairo_set_source_rgb(cr, 1, 1, 0);
-            cairo_arc(cr, x, y, dot, 0, 2*M_PI);
-            cairo_fill_preserve(cr);
-            cairo_set_line_width(cr, 1.5);
+            double radius = cell_size * 0.3;
+
+            // ombre
             cairo_set_source_rgb(cr, 0, 0, 0);
-            cairo_stroke(cr);
-            cairo_restore(cr);
+            cairo_new_path(cr);
+            cairo_arc(cr, x, y, radius * 1.1, 0, 2*M_PI);
+            cairo_fill(cr);
+
+            // pion
+            if (sq & SQ_RED) cairo_set_source_rgb(cr, 1, 0, 0);
+            else             cairo_set_source_rgb(cr, 0, 0, 1);
+            cairo_arc(cr, x, y, radius, 0, 2*M_PI);
+            cairo_fill(cr);
+
+            // signe roi (pastille)
+            if (sq & SQ_KING) {
+                cairo_save(cr);
+                cairo_new_path(cr);
+                double dot = radius * 0.5;
+                cairo_set_source_rgb(cr, 1, 1, 0);
+                cairo_arc(cr, x, y, dot, 0, 2*M_PI);
+                cairo_fill_preserve(cr);
+                cairo_set_line_width(cr, 1.5);
+                cairo_set_source_rgb(cr, 0, 0, 0);
+                cairo_stroke(cr);
+                cairo_restore(cr);
+            }
         }
     }
 }
+
+/**
+ * \fn static void drawing_render_dirty(cairo_t *cr, const BoardGeometry *g, const uint16_t sig[81], int r, int c)
+ * \brief Redessine une case changée, découpée sur les pixels qu'elle recouvre.
+ *
+ * La découpe est arrondie au pixel de la cible : les pixels du bord, partagés
+ * avec les cases voisines, sont redessinés avec elles.
+ */
+static void drawing_render_dirty(cairo_t *cr, const BoardGeometry *g, const uint16_t sig[81], int r, int c) {
+    double sx = board_cache.scale_x, sy = board_cache.scale_y;
+    double x0 = floor((g->offset_x + c * g->cell_size) * sx) / sx;
+    double y0 = floor((g->offset_y + r * g->cell_size) * sy) / sy;
+    double x1 = ceil((g->offset_x + (c + 1) * g->cell_size) * sx) / sx;
+    double y1 = ceil((g->offset_y + (r + 1) * g->cell_size) * sy) / sy;
+    cairo_save(cr);
+    cairo_rectangle(cr, x0, y0, x1 - x0, y1 - y0);
+    cairo_clip(cr);
+    drawing_render_squares(cr, g, sig, r > 0 ? r - 1 : 0, r < 8 ? r + 1 : 8, c > 0 ? c - 1 : 0, c < 8 ? c + 1 : 8);
+    cairo_restore(cr);
+}
+
+/**
+ * \fn static void drawing_format_score(const IaAnalysisLine *line, char *buf, size_t size)
+ * \brief Texte du score d'une ligne pour le joueur au trait (gain ou perte forcés en toutes lettres).
+ */
+static void drawing_format_score(const IaAnalysisLine *line, char *buf, size_t size) {
+    if (line->forced > 0)      snprintf(buf, size, "gain");
+    else if (line->forced < 0) snprintf(buf, size, "perte");
+    else                       snprintf(buf, size, "%+d", line->score);
+}
+
+/**
+ * \fn static void drawing_render_analysis(cairo_t *cr, const BoardGeometry *g, const IaAnalysis *an)
+ * \brief Dessine les lignes d'analyse : une flèche par coup, son score près du point d'arrivée.
+ *
+ * La meilleure ligne est la plus marquée et dessinée en dernier ; les scores
+ * de deux lignes qui visent la même case sont décalés l'un sous l'autre. La
+ * profondeur est écrite sous la grille.
+ */
+static void drawing_render_analysis(cairo_t *cr, const BoardGeometry *g, const IaAnalysis *an) {
+    double cs = g->cell_size;
+    int labels[81] = { 0 };
+    cairo_save(cr);
+    cairo_set_line_cap(cr, CAIRO_LINE_CAP_ROUND);
+    cairo_set_font_size(cr, cs * 0.22);
+    for (int i = an->count - 1; i >= 0; --i) {
+        const IaAnalysisLine *line = &an->lines[i];
+        const Move *m = &line->pv[0];
+        double x0 = g->offset_x + (m->from_col + 0.5) * cs, y0 = g->offset_y + (m->from_row + 0.5) * cs;
+        double x1 = g->offset_x + (m->to_col + 0.5) * cs,   y1 = g->offset_y + (m->to_row + 0.5) * cs;
+        double len = hypot(x1 - x0, y1 - y0);
+        if (len <= 0) continue;
+        double ux = (x1 - x0) / len, uy = (y1 - y0) / len;
+        double head = cs * 0.3;
+        double alpha = (i == 0) ? 0.85 : 0.45;
+
+        // flèche
+        cairo_set_source_rgba(cr, 0.1, 0.55, 0.2, alpha);
+        cairo_set_line_width(cr, cs * ((i == 0) ? 0.12 : 0.08));
+        cairo_new_path(cr);
+        cairo_move_to(cr, x0, y0);
+        cairo_line_to(cr, x1 - ux * head * 0.8, y1 - uy * head * 0.8);
+        cairo_stroke(cr);
+        cairo_move_to(cr, x1, y1);
+        cairo_line_to(cr, x1 - ux * head - uy * head * 0.5, y1 - uy * head + ux * head * 0.5);
+        cairo_line_to(cr, x1 - ux * head + uy * head * 0.5, y1 - uy * head - ux * head * 0.5);
+        cairo_close_path(cr);
+        cairo_fill(cr);
+
+        // score, coin haut droit de la case d'arrivée
+        char txt[16];
+        drawing_format_score(line, txt, sizeof(txt));
+        int sq = m->to_row * 9 + m->to_col;
+        cairo_set_source_rgba(cr, 0, 0.3, 0.1, (i == 0) ? 1.0 : 0.7);
+        cairo_move_to(cr, g->offset_x + (m->to_col + 0.55) * cs, g->offset_y + (m->to_row + 0.3 + 0.22 * labels[sq]++) * cs);
+        cairo_show_text(cr, txt);
+    }
+
+    char txt[64];
+    snprintf(txt, sizeof(txt), "Analyse : profondeur %d, %llu noeuds", an->depth, an->nodes);
+    cairo_set_source_rgb(cr, 0, 0, 0);
+    cairo_set_font_size(cr, 12);
+    cairo_move_to(cr, g->offset_x, g->offset_y + DRAWING_GRID_SIZE + 16);
+    cairo_show_text(cr, txt);
+    cairo_restore(cr);
+}
+
+/**
+ * \fn void drawing_cache_clear(void)
+ * \brief Libère les couches et les logos mis en cache (reconstruits au prochain dessin).
+ */
+void drawing_cache_clear(void) {
+    if (board_cache.overlay) cairo_surface_destroy(board_cache.overlay);
+    if (board_cache.frame) cairo_surface_destroy(board_cache.frame);
+    for (int i = 0; i < 2; ++i)
+        if (board_cache.scaled[i]) g_object_unref(board_cache.scaled[i]);
+    memset(&board_cache, 0, sizeof(board_cache));
+}
+
+/**
+ * \fn void draw_cb(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data)
+ * \brief Callback de dessin GTK, affiche le plateau et les pièces.
+ *
+ * \param area Zone de dessin GTK.
+ * \param cr Contexte Cairo.
+ * \param width Largeur de la zone de dessin.
+ * \param height Hauteur de la zone de dessin.
+ * \param user_data Donnée utilisateur (non utilisée).
+ *
+ * Le plateau est rendu dans un cadre gardé d'un dessin à l'autre, puis
+ * copié d'un bloc sur la zone :
+ * - La grille, les repères et les bases (logos mis à l'échelle une fois)
+ *   forment une couche fixe, refaite seulement quand la taille de la zone,
+ *   des cases ou de la cible change.
+ * - Seules les cases dont la signature a changé depuis le dessin précédent
+ *   (cases quittées et atteintes, prises, contrôle, surbrillance, sélection)
+ *   sont redessinées dans le cadre, chacune sous sa propre découpe.
+ * - Les lignes du mode analyse changent sans que le plateau change : elles
+ *   sont dessinées après la copie du cadre, jamais dans le cadre.
+ */
+void draw_cb(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer user_data) {
+    (void)area; (void)user_data;
+    BoardGeometry g;
+    g.cell_size = DRAWING_GRID_SIZE / 9.0;
+    g.offset_x = (width - DRAWING_GRID_SIZE) / 2.0;
+    g.offset_y = (height - DRAWING_GRID_SIZE) / 2.0;
+
+    double sx = 1, sy = 1;
+    cairo_surface_get_device_scale(cairo_get_target(cr), &sx, &sy);
+    int full = 0;
+    if (!board_cache.overlay || board_cache.width != width || board_cache.height != height ||
+        board_cache.cell_size != g.cell_size || board_cache.scale_x != sx || board_cache.scale_y != sy ||
+        board_cache.logos[0] != logo_blue || board_cache.logos[1] != logo_red) {
+        if (board_cache.overlay) cairo_surface_destroy(board_cache.overlay);
+        if (board_cache.frame) cairo_surface_destroy(board_cache.frame);
+        board_cache.width = width;
+        board_cache.height = height;
+        board_cache.cell_size = g.cell_size;
+        board_cache.scale_x = sx;
+        board_cache.scale_y = sy;
+        board_cache.logos[0] = logo_blue;
+        board_cache.logos[1] = logo_red;
+        board_cache.overlay = drawing_new_layer(width, height);
+        board_cache.frame = drawing_new_layer(width, height);
+        drawing_render_overlay(&g);
+        full = 1;
+    }
+
+    uint16_t sig[81];
+    drawing_board_signature(sig);
+    int dirty[81], ndirty = 0;
+    for (int sq = 0; sq < 81 && !full; ++sq) {
+        if (sig[sq] == board_cache.sig[sq]) continue;
+        if (ndirty == DRAWING_MAX_DIRTY) full = 1;
+        else dirty[ndirty++] = sq;
+    }
+
+    cairo_t *fc = cairo_create(board_cache.frame);
+    if (full) drawing_render_squares(fc, &g, sig, 0, 8, 0, 8);
+    else for (int i = 0; i < ndirty; ++i) drawing_render_dirty(fc, &g, sig, dirty[i] / 9, dirty[i] % 9);
+    cairo_destroy(fc);
+    memcpy(board_cache.sig, sig, sizeof(sig));
+
+    cairo_set_source_surface(cr, board_cache.frame, 0, 0);
+    cairo_paint(cr);
+
+    IaAnalysis an;
+    if (analysis_get(&an)) drawing_render_analysis(cr, &g, &an);
+}
@@ -0,0 +1,419 @@
+/**
+ * \file eval_kernel.c
+ * \brief Noyau vectoriel des termes de l'évaluation : variantes scalaire, SSE2, AVX2 et NEON.
+ *
+ * \details
+ * Chaque variante calcule, par couleur, le popcount de l'occupation et du
+ * contrôle et la mobilité en ligne droite. Les rayons sont remplis par la
+ * méthode Kogge-Stone : trois pas de propagation (1, 2 puis 4 cases) sur
+ * les cases vides, puis un dernier décalage, soit les 8 cases d'un rayon
+ * au plus, sans boucle dépendant des données.
+ *
+ * Dans les variantes vectorielles, un bitboard de 81 cases est tenu par
+ * deux registres (mots bas et haut de 64 bits) ; un décalage de k cases
+ * fait passer les k bits de bord d'un mot à l'autre. Les popcounts sont
+ * d'abord faits par octet (SWAR en SSE2, table en AVX2, `vcnt` en NEON),
+ * cumulés, puis sommés une seule fois par mot.
+ */
+
+#include "eval_kernel.h"
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#  define EVAL_HAVE_X86 1
+#  include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#  define EVAL_HAVE_NEON 1
+#  include <arm_neon.h>
+#endif
+
+/** \brief Cases de destination permises vers l'est (pas de passage colonne I → A). */
+#define EVAL_NOT_A (BB_FULL & ~BB_FILE_A)
+/** \brief Cases de destination permises vers l'ouest (pas de passage colonne A → I). */
+#define EVAL_NOT_I (BB_FULL & ~BB_FILE_I)
+
+/** \brief Fonction de calcul d'un lot. */
+typedef void (*EvalBatchFn)(const GameState* const* states, int n, EvalFeatures* out);
+
+/* ====== Variante scalaire ====== */
+
+/**
+ * \brief Remplissage Kogge-Stone d'un rayon dans une direction, en C portable.
+ *
+ * `SH(x, n)` décale x de n pas dans la direction ; `pro` est l'ensemble des
+ * cases vides atteignables dans cette direction (bords masqués).
+ */
+#define EVAL_KS_SCALAR(gen, pro, SH, out) do {      \
+        Bitboard g_ = (gen), p_ = (pro);            \
+        g_ |= p_ & SH(g_, 1); p_ &= SH(p_, 1);       \
+        g_ |= p_ & SH(g_, 2); p_ &= SH(p_, 2);       \
+        g_ |= p_ & SH(g_, 4);                        \
+        (out) = SH(g_, 1) & (pro);                   \
+    } while (0)
+
+#define EVAL_SH_E(x, n) ((x) << (n))
+#define EVAL_SH_W(x, n) ((x) >> (n))
+#define EVAL_SH_S(x, n) (((x) << (9 * (n))) & BB_FULL)
+#define EVAL_SH_N(x, n) ((x) >> (9 * (n)))
+
+/**
+ * \fn static int eval_mobility_scalar(Bitboard gen, Bitboard empty)
+ * \brief Mobilité en ligne droite des pièces de `gen` (égale à bb_rook_mobility()).
+ */
+static int eval_mobility_scalar(Bitboard gen, Bitboard empty) {
+    Bitboard e, w, s, n;
+    EVAL_KS_SCALAR(gen, empty & EVAL_NOT_A, EVAL_SH_E, e);
+    EVAL_KS_SCALAR(gen, empty & EVAL_NOT_I, EVAL_SH_W, w);
+    EVAL_KS_SCALAR(gen, empty, EVAL_SH_S, s);
+    EVAL_KS_SCALAR(gen, empty, EVAL_SH_N, n);
+    return bb_popcount(e) + bb_popcount(w) + bb_popcount(s) + bb_popcount(n);
+}
+
+/**
+ * \fn static void eval_batch_scalar(const GameState* const* states, int n, EvalFeatures* out)
+ * \brief Variante scalaire, une position à la fois.
+ */
+static void eval_batch_scalar(const GameState* const* states, int n, EvalFeatures* out) {
+    for (int i = 0; i < n; ++i) {
+        const GameState* s = states[i];
+        Bitboard empty = ~(s->occ[0] | s->occ[1]) & BB_FULL;
+        for (int c = 0; c < 2; ++c) {
+            out[i].pieces[c] = bb_popcount(s->occ[c]);
+            out[i].control[c] = bb_popcount(s->control[c]);
+            out[i].mobility[c] = eval_mobility_scalar(s->occ[c], empty);
+        }
+    }
+}
+
+/* ====== Variante SSE2 ====== */
+
+#ifdef EVAL_HAVE_X86
+
+/** \brief Bitboard de chaque mot de 64 bits d'un registre : mots bas et hauts. */
+typedef struct { __m128i lo, hi; } EvalV2;
+
+static inline EvalV2 v2_and(EvalV2 a, EvalV2 b) { return (EvalV2){ _mm_and_si128(a.lo, b.lo), _mm_and_si128(a.hi, b.hi) }; }
+static inline EvalV2 v2_or(EvalV2 a, EvalV2 b)  { return (EvalV2){ _mm_or_si128(a.lo, b.lo), _mm_or_si128(a.hi, b.hi) }; }
+
+/** \brief Décalage vers les cases d'indice croissant (k < 64). */
+static inline EvalV2 v2_shl(EvalV2 a, int k) {
+    __m128i ck = _mm_cvtsi32_si128(k), cr = _mm_cvtsi32_si128(64 - k);
+    return (EvalV2){ _mm_sll_epi64(a.lo, ck), _mm_or_si128(_mm_sll_epi64(a.hi, ck), _mm_srl_epi64(a.lo, cr)) };
+}
+
+/** \brief Décalage vers les cases d'indice décroissant (k < 64). */
+static inline EvalV2 v2_shr(EvalV2 a, int k) {
+    __m128i ck = _mm_cvtsi32_si128(k), cr = _mm_cvtsi32_si128(64 - k);
+    return (EvalV2){ _mm_or_si128(_mm_srl_epi64(a.lo, ck), _mm_sll_epi64(a.hi, cr)), _mm_srl_epi64(a.hi, ck) };
+}
+
+/** \brief Les deux mots d'un bitboard, identiques dans les deux colonnes du registre. */
+static inline EvalV2 v2_splat(Bitboard b) {
+    return (EvalV2){ _mm_set1_epi64x((long long)(uint64_t)b), _mm_set1_epi64x((long long)(uint64_t)(b >> 64)) };
+}
+
+/** \brief Bitboards bleu (colonne 0) et rouge (colonne 1). */
+static inline EvalV2 v2_pair(Bitboard blue, Bitboard red) {
+    return (EvalV2){ _mm_set_epi64x((long long)(uint64_t)red, (long long)(uint64_t)blue),
+                     _mm_set_epi64x((long long)(uint64_t)(red >> 64), (long long)(uint64_t)(blue >> 64)) };
+}
+
+/** \brief Popcount de chaque octet (SWAR). */
+static inline __m128i v2_bytecount(__m128i x) {
+    const __m128i m1 = _mm_set1_epi8(0x55), m2 = _mm_set1_epi8(0x33), m4 = _mm_set1_epi8(0x0f);
+    x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+    x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+    return _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);
+}
+
+/** \brief Popcount par octet des deux mots d'un bitboard, cumulés. */
+static inline __m128i v2_count(EvalV2 a) { return _mm_add_epi8(v2_bytecount(a.lo), v2_bytecount(a.hi)); }
+
+/** \brief Somme des octets de chaque colonne : [0] bleu, [1] rouge. */
+static inline void v2_sum(__m128i bytes, int out[2]) {
+    __m128i sad = _mm_sad_epu8(bytes, _mm_setzero_si128());
+    out[0] = _mm_cvtsi128_si32(sad);
+    out[1] = _mm_cvtsi128_si32(_mm_srli_si128(sad, 8));
+}
+
+/** \brief Remplissage Kogge-Stone vectoriel (voir EVAL_KS_SCALAR()). */
+#define EVAL_KS_VEC(gen, pro, SH, K, AND, OR, out) do {                   \
+        __typeof__(gen) g_ = (gen), p_ = (pro);                           \
+        g_ = OR(g_, AND(p_, SH(g_, (K))));     p_ = AND(p_, SH(p_, (K)));       \
+        g_ = OR(g_, AND(p_, SH(g_, 2 * (K)))); p_ = AND(p_, SH(p_, 2 * (K)));   \
+        g_ = OR(g_, AND(p_, SH(g_, 4 * (K))));                            \
+        (out) = AND(SH(g_, (K)), (pro));                                  \
+    } while (0)
+
+/**
+ * \fn static void eval_batch_sse2(const GameState* const* states, int n, EvalFeatures* out)
+ * \brief Variante SSE2 : bleu et rouge d'une position dans un registre.
+ */
+static void eval_batch_sse2(const GameState* const* states, int n, EvalFeatures* out) {
+    const EvalV2 not_a = v2_splat(EVAL_NOT_A), not_i = v2_splat(EVAL_NOT_I), full = v2_splat(BB_FULL);
+    for (int i = 0; i < n; ++i) {
+        const GameState* s = states[i];
+        EvalV2 gen = v2_pair(s->occ[0], s->occ[1]);
+        EvalV2 empty = v2_splat(~(s->occ[0] | s->occ[1]) & BB_FULL);
+        EvalV2 e, w, so, no;
+        EVAL_KS_VEC(gen, v2_and(empty, not_a), v2_shl, 1, v2_and, v2_or, e);
+        EVAL_KS_VEC(gen, v2_and(empty, not_i), v2_shr, 1, v2_and, v2_or, w);
+        EVAL_KS_VEC(gen, v2_and(empty, full),  v2_shl, 9, v2_and, v2_or, so);
+        EVAL_KS_VEC(gen, empty,                v2_shr, 9, v2_and, v2_or, no);
+        __m128i mob = _mm_add_epi8(_mm_add_epi8(v2_count(e), v2_count(w)),
+                                   _mm_add_epi8(v2_count(so), v2_count(no)));
+        v2_sum(mob, out[i].mobility);
+        v2_sum(v2_count(gen), out[i].pieces);
+        v2_sum(v2_count(v2_pair(s->control[0], s->control[1])), out[i].control);
+    }
+}
+
+/* ====== Variante AVX2 ====== */
+
+/** \brief Comme EvalV2, sur quatre mots : [bleu, rouge] de deux positions. */
+typedef struct { __m256i lo, hi; } EvalV4;
+
+#define EVAL_AVX2 __attribute__((target("avx2")))
+
+static inline EVAL_AVX2 EvalV4 v4_and(EvalV4 a, EvalV4 b) { return (EvalV4){ _mm256_and_si256(a.lo, b.lo), _mm256_and_si256(a.hi, b.hi) }; }
+static inline EVAL_AVX2 EvalV4 v4_or(EvalV4 a, EvalV4 b)  { return (EvalV4){ _mm256_or_si256(a.lo, b.lo), _mm256_or_si256(a.hi, b.hi) }; }
+
+static inline EVAL_AVX2 EvalV4 v4_shl(EvalV4 a, int k) {
+    __m128i ck = _mm_cvtsi32_si128(k), cr = _mm_cvtsi32_si128(64 - k);
+    return (EvalV4){ _mm256_sll_epi64(a.lo, ck), _mm256_or_si256(_mm256_sll_epi64(a.hi, ck), _mm256_srl_epi64(a.lo, cr)) };
+}
+
+static inline EVAL_AVX2 EvalV4 v4_shr(EvalV4 a, int k) {
+    __m128i ck = _mm_cvtsi32_si128(k), cr = _mm_cvtsi32_si128(64 - k);
+    return (EvalV4){ _mm256_or_si256(_mm256_srl_epi64(a.lo, ck), _mm256_sll_epi64(a.hi, cr)), _mm256_srl_epi64(a.hi, ck) };
+}
+
+static inline EVAL_AVX2 EvalV4 v4_splat(Bitboard b) {
+    return (EvalV4){ _mm256_set1_epi64x((long long)(uint64_t)b), _mm256_set1_epi64x((long long)(uint64_t)(b >> 64)) };
+}
+
+/** \brief Quatre bitboards, dans l'ordre des mots (a = mot 0). */
+static inline EVAL_AVX2 EvalV4 v4_set(Bitboard a, Bitboard b, Bitboard c, Bitboard d) {
+    return (EvalV4){ _mm256_set_epi64x((long long)(uint64_t)d, (long long)(uint64_t)c,
+                                       (long long)(uint64_t)b, (long long)(uint64_t)a),
+                     _mm256_set_epi64x((long long)(uint64_t)(d >> 64), (long long)(uint64_t)(c >> 64),
+                                       (long long)(uint64_t)(b >> 64), (long long)(uint64_t)(a >> 64)) };
+}
+
+/** \brief Popcount de chaque octet (table de 16 entrées par quartet). */
+static inline EVAL_AVX2 __m256i v4_bytecount(__m256i x) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i m4 = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, m4));
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), m4));
+    return _mm256_add_epi8(lo, hi);
+}
+
+static inline EVAL_AVX2 __m256i v4_count(EvalV4 a) { return _mm256_add_epi8(v4_bytecount(a.lo), v4_bytecount(a.hi)); }
+
+/** \brief Somme des octets de chaque mot : out[0..3]. */
+static inline EVAL_AVX2 void v4_sum(__m256i bytes, int out[4]) {
+    __m256i sad = _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+    out[0] = _mm256_extract_epi32(sad, 0);
+    out[1] = _mm256_extract_epi32(sad, 2);
+    out[2] = _mm256_extract_epi32(sad, 4);
+    out[3] = _mm256_extract_epi32(sad, 6);
+}
+
+/**
+ * \fn static void eval_batch_avx2(const GameState* const* states, int n, EvalFeatures* out)
+ * \brief Variante AVX2 : deux positions par registre, la dernière position impaire en SSE2.
+ */
+static EVAL_AVX2 void eval_batch_avx2(const GameState* const* states, int n, EvalFeatures* out) {
+    const EvalV4 not_a = v4_splat(EVAL_NOT_A), not_i = v4_splat(EVAL_NOT_I), full = v4_splat(BB_FULL);
+    int i = 0;
+    for (; i + 1 < n; i += 2) {
+        const GameState* a = states[i];
+        const GameState* b = states[i + 1];
+        Bitboard ea = ~(a->occ[0] | a->occ[1]) & BB_FULL, eb = ~(b->occ[0] | b->occ[1]) & BB_FULL;
+        EvalV4 gen = v4_set(a->occ[0], a->occ[1], b->occ[0], b->occ[1]);
+        EvalV4 empty = v4_set(ea, ea, eb, eb);
+        EvalV4 e, w, so, no;
+        EVAL_KS_VEC(gen, v4_and(empty, not_a), v4_shl, 1, v4_and, v4_or, e);
+        EVAL_KS_VEC(gen, v4_and(empty, not_i), v4_shr, 1, v4_and, v4_or, w);
+        EVAL_KS_VEC(gen, v4_and(empty, full),  v4_shl, 9, v4_and, v4_or, so);
+        EVAL_KS_VEC(gen, empty,                v4_shr, 9, v4_and, v4_or, no);
+        int mob[4], pcs[4], ctl[4];
+        v4_sum(_mm256_add_epi8(_mm256_add_epi8(v4_count(e), v4_count(w)),
+                               _mm256_add_epi8(v4_count(so), v4_count(no))), mob);
+        v4_sum(v4_count(gen), pcs);
+        v4_sum(v4_count(v4_set(a->control[0], a->control[1], b->control[0], b->control[1])), ctl);
+        for (int c = 0; c < 2; ++c) {
+            out[i].mobility[c] = mob[c];         out[i + 1].mobility[c] = mob[2 + c];
+            out[i].pieces[c] = pcs[c];           out[i + 1].pieces[c] = pcs[2 + c];
+            out[i].control[c] = ctl[c];          out[i + 1].control[c] = ctl[2 + c];
+        }
+    }
+    if (i < n) eval_batch_sse2(states + i, n - i, out + i);
+}
+
+#endif // EVAL_HAVE_X86
+
+/* ====== Variante NEON ====== */
+
+#ifdef EVAL_HAVE_NEON
+
+/** \brief Comme EvalV2, en registres NEON. */
+typedef struct { uint64x2_t lo, hi; } EvalN2;
+
+static inline EvalN2 n2_and(EvalN2 a, EvalN2 b) { return (EvalN2){ vandq_u64(a.lo, b.lo), vandq_u64(a.hi, b.hi) }; }
+static inline EvalN2 n2_or(EvalN2 a, EvalN2 b)  { return (EvalN2){ vorrq_u64(a.lo, b.lo), vorrq_u64(a.hi, b.hi) }; }
+
+/* vshlq_u64 décale à droite pour un compte négatif */
+static inline EvalN2 n2_shl(EvalN2 a, int k) {
+    int64x2_t ck = vdupq_n_s64(k), cr = vdupq_n_s64(k - 64);
+    return (EvalN2){ vshlq_u64(a.lo, ck), vorrq_u64(vshlq_u64(a.hi, ck), vshlq_u64(a.lo, cr)) };
+}
+
+static inline EvalN2 n2_shr(EvalN2 a, int k) {
+    int64x2_t ck = vdupq_n_s64(-k), cr = vdupq_n_s64(64 - k);
+    return (EvalN2){ vorrq_u64(vshlq_u64(a.lo, ck), vshlq_u64(a.hi, cr)), vshlq_u64(a.hi, ck) };
+}
+
+static inline EvalN2 n2_splat(Bitboard b) {
+    return (EvalN2){ vdupq_n_u64((uint64_t)b), vdupq_n_u64((uint64_t)(b >> 64)) };
+}
+
+static inline EvalN2 n2_pair(Bitboard blue, Bitboard red) {
+    uint64_t lo[2] = { (uint64_t)blue, (uint64_t)red };
+    uint64_t hi[2] = { (uint64_t)(blue >> 64), (uint64_t)(red >> 64) };
+    return (EvalN2){ vld1q_u64(lo), vld1q_u64(hi) };
+}
+
+static inline uint8x16_t n2_count(EvalN2 a) {
+    return vaddq_u8(vcntq_u8(vreinterpretq_u8_u64(a.lo)), vcntq_u8(vreinterpretq_u8_u64(a.hi)));
+}
+
+static inline void n2_sum(uint8x16_t bytes, int out[2]) {
+    uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(bytes)));
+    out[0] = (int)vgetq_lane_u64(sum, 0);
+    out[1] = (int)vgetq_lane_u64(sum, 1);
+}
+
+/**
+ * \fn static void eval_batch_neon(const GameState* const* states, int n, EvalFeatures* out)
+ * \brief Variante NEON : bleu et rouge d'une position dans un registre.
+ */
+static void eval_batch_neon(const GameState* const* states, int n, EvalFeatures* out) {
+    const EvalN2 not_a = n2_splat(EVAL_NOT_A), not_i = n2_splat(EVAL_NOT_I), full = n2_splat(BB_FULL);
+    for (int i = 0; i < n; ++i) {
+        const GameState* s = states[i];
+        EvalN2 gen = n2_pair(s->occ[0], s->occ[1]);
+        EvalN2 empty = n2_splat(~(s->occ[0] | s->occ[1]) & BB_FULL);
+        EvalN2 e, w, so, no;
+        EVAL_KS_VEC(gen, n2_and(empty, not_a), n2_shl, 1, n2_and, n2_or, e);
+        EVAL_KS_VEC(gen, n2_and(empty, not_i), n2_shr, 1, n2_and, n2_or, w);
+        EVAL_KS_VEC(gen, n2_and(empty, full),  n2_shl, 9, n2_and, n2_or, so);
+        EVAL_KS_VEC(gen, empty,                n2_shr, 9, n2_and, n2_or, no);
+        n2_sum(vaddq_u8(vaddq_u8(n2_count(e), n2_count(w)), vaddq_u8(n2_count(so), n2_count(no))), out[i].mobility);
+        n2_sum(n2_count(gen), out[i].pieces);
+        n2_sum(n2_count(n2_pair(s->control[0], s->control[1])), out[i].control);
+    }
+}
+
+#endif // EVAL_HAVE_NEON
+
+/* ====== Choix de la variante ====== */
+
+/** \brief Variante courante (EVAL_KERNEL_AUTO tant qu'aucune n'est choisie). */
+static EvalKernel eval_kind = EVAL_KERNEL_AUTO;
+/** \brief Fonction de la variante courante. */
+static EvalBatchFn eval_impl = NULL;
+
+/**
+ * \fn static EvalBatchFn eval_kernel_fn(EvalKernel k)
+ * \brief Fonction d'une variante, NULL si elle n'est pas disponible ici.
+ */
+static EvalBatchFn eval_kernel_fn(EvalKernel k) {
+    switch (k) {
+    case EVAL_KERNEL_SCALAR: return eval_batch_scalar;
+#ifdef EVAL_HAVE_X86
+    case EVAL_KERNEL_SSE2: return eval_batch_sse2;
+    case EVAL_KERNEL_AVX2: return __builtin_cpu_supports("avx2") ? eval_batch_avx2 : NULL;
+#endif
+#ifdef EVAL_HAVE_NEON
+    case EVAL_KERNEL_NEON: return eval_batch_neon;
+#endif
+    default: return NULL;
+    }
+}
+
+/**
+ * \fn int eval_set_kernel(EvalKernel k)
+ * \brief Choisit la variante du noyau (détection si EVAL_KERNEL_AUTO).
+ *
+ * \param k Variante souhaitée.
+ * \return 0 si la variante est disponible, -1 sinon.
+ */
+int eval_set_kernel(EvalKernel k) {
+    if (k == EVAL_KERNEL_AUTO) {
+        static const EvalKernel order[] = { EVAL_KERNEL_AVX2, EVAL_KERNEL_SSE2, EVAL_KERNEL_NEON, EVAL_KERNEL_SCALAR };
+        for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++i)
+            if (eval_kernel_fn(order[i])) { k = order[i]; break; }
+    }
+    EvalBatchFn fn = eval_kernel_fn(k);
+    if (!fn) return -1;
+    __atomic_store_n(&eval_kind, k, __ATOMIC_RELAXED);
+    __atomic_store_n(&eval_impl, fn, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/**
+ * \fn static EvalBatchFn eval_current(void)
+ * \brief Fonction de la variante courante, choisie au premier appel.
+ */
+static inline EvalBatchFn eval_current(void) {
+    EvalBatchFn fn = __atomic_load_n(&eval_impl, __ATOMIC_ACQUIRE);
+    if (!fn) {
+        eval_set_kernel(EVAL_KERNEL_AUTO);
+        fn = __atomic_load_n(&eval_impl, __ATOMIC_ACQUIRE);
+    }
+    return fn;
+}
+
+/**
+ * \fn EvalKernel eval_get_kernel(void)
+ * \brief Variante utilisée.
+ */
+EvalKernel eval_get_kernel(void) {
+    eval_current();
+    return __atomic_load_n(&eval_kind, __ATOMIC_RELAXED);
+}
+
+/**
+ * \fn const char* eval_kernel_name(EvalKernel k)
+ * \brief Nom court d'une variante.
+ */
+const char* eval_kernel_name(EvalKernel k) {
+    switch (k) {
+    case EVAL_KERNEL_SCALAR: return "scalaire";
+    case EVAL_KERNEL_SSE2:   return "sse2";
+    case EVAL_KERNEL_AVX2:   return "avx2";
+    case EVAL_KERNEL_NEON:   return "neon";
+    default:                 return "auto";
+    }
+}
+
+/**
+ * \fn void eval_features(const GameState* s, EvalFeatures* out)
+ * \brief Termes de l'évaluation d'une position.
+ */
+void eval_features(const GameState* s, EvalFeatures* out) {
+    const GameState* one[1] = { s };
+    eval_current()(one, 1, out);
+}
+
+/**
+ * \fn void eval_features_batch(const GameState* const* states, int n, EvalFeatures* out)
+ * \brief Termes de l'évaluation d'un lot de positions.
+ */
+void eval_features_batch(const GameState* const* states, int n, EvalFeatures* out) {
+    if (n > 0) eval_current()(states, n, out);
+}
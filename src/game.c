@@ -12,14 +12,19 @@
  * - Gestion des tours, déplacements et captures.
  * - Calcul des scores et vérification des conditions de victoire.
  * - Intégration avec l'IA et le mode réseau.
+ *
+ * Les règles elles-mêmes (coups, captures, fins de partie) sont celles de
+ * rules.c, appliquées à une copie de l'état global puis recopiées.
  */
 
 #include <string.h>
 #include "game.h"
-#include "captures.h"
 #include "gui.h"
 #include "status.h"
+#include "ui.h"
 #include "net.h"
+#include "ia_job.h"
+#include "log.h"
 
 
 // ====== ÉTAT GLOBAL ======
@@ -56,6 +61,12 @@ char  ia_color = 'R';
 /** Indique si les deux IA jouent */
 int   ia_both_active = 0;
 
+/** Indique si l'IA réfléchit pendant le tour de l'adversaire */
+int   ia_pondering = 0;
+
+/** Indique si les statistiques de recherche sont affichées après chaque coup de l'IA */
+int   ia_verbose = 0;
+
 /** Profondeur de recherche de l'IA */
 int   ia_search_depth = 3;
 
@@ -116,39 +127,93 @@ void game_setup_default(void) {
     {6, 8, 'R', 'P'}, 
 };
 
+    game_set_position(start, (int)(sizeof(start)/sizeof(start[0])));
     initialize_controlled_cells();
     update_scores();
-    game_set_position(start, (int)(sizeof(start)/sizeof(start[0])));
+    status_clear_result();
     reset_move_history(); // Réinitialiser l'historique IA
 }
 
 /**
- * \fn int find_piece_at(int row, int col)
- * \brief Déclenche l'IA pour jouer son coup.
- * 
- * \param user_data Données utilisateur (non utilisées)
- * \return G_SOURCE_REMOVE pour arrêter le timeout
+ * \fn GameState game_start_state(void)
+ * \brief Remet la partie courante à la position de départ et la renvoie.
+ *
+ * Trait aux bleus, tour 1, partie en cours : point de départ commun du
+ * serveur, des parties IA contre IA et des tests.
+ *
+ * \return État synchronisé de la position initiale.
  */
-gboolean trigger_ia_move(gpointer user_data) {
-    (void)user_data; // Supprime le warning unused parameter
-    
-    if (!(ia_active || ia_both_active) || game_over) return G_SOURCE_REMOVE;
-    if (!ia_both_active && current_turn != ia_color) return G_SOURCE_REMOVE;
-    
-    printf("L'IA reflechit...\n");
-    
-    // Créer l'état de jeu pour l'IA
+GameState game_start_state(void) {
+    current_turn = 'B';
+    turn_number = 1;
+    game_setup_default();
+    game_over = 0;
+    return createGameStateFromCurrent();
+}
+
+/**
+ * \fn void ia_set_pondering(int on)
+ * \brief Active ou désactive la réflexion anticipée (option `-p`).
+ *
+ * \param on 1 pour l'activer, 0 pour la couper.
+ */
+void ia_set_pondering(int on) {
+    ia_pondering = on != 0;
+}
+
+/**
+ * \fn void ia_set_verbose(int on)
+ * \brief Active ou désactive les statistiques de recherche après chaque coup (option `-v`).
+ *
+ * \param on 1 pour les afficher, 0 pour les masquer.
+ */
+void ia_set_verbose(int on) {
+    ia_verbose = on != 0;
+}
+
+/**
+ * \fn static void start_pondering(void)
+ * \brief Lance la réflexion anticipée pendant le tour de l'adversaire humain.
+ *
+ * La position approfondie est celle qui suit la réponse prévue par la table
+ * de transposition ; sans prévision, c'est la position courante (toutes les
+ * réponses, dont les positions filles restent dans la table partagée).
+ */
+static void start_pondering(void) {
+    if (!ia_pondering || !ia_active || ia_both_active || game_over) return;
+    if (current_turn == ia_color) return;
+
     GameState state = createGameStateFromCurrent();
-    
-    // Trouver le meilleur coup
-    Move best_move;
-    best_move.piece_index = -1; // Initialiser
-    
-    trouverMeilleurCoupIA(&state, &best_move, ia_search_depth);
-    
+    Move reply;
+    if (ia_predict_reply(&state, &reply)) {
+        MoveUndo undo;
+        rules_make_move(&state, &reply, &undo);
+    }
+    ia_job_ponder(&state);
+}
+
+/**
+ * \fn static void on_ia_move_ready(const GameState *root, const Move *mv, gpointer user_data)
+ * \brief Joue le coup rendu par la recherche en arrière-plan (thread GTK).
+ *
+ * Le coup est ignoré si la partie a changé depuis le lancement de la recherche.
+ *
+ * \param root Position cherchée.
+ * \param mv Coup trouvé.
+ * \param user_data Données utilisateur (non utilisées)
+ */
+static void on_ia_move_ready(const GameState *root, const Move *mv, gpointer user_data) {
+    (void)user_data;
+    if (game_over || root->turn_number != turn_number || root->current_player != current_turn) return;
+    if (!(ia_active || ia_both_active)) return;
+
+    Move best_move = *mv;
+    if (ia_verbose) {
+        IaSearchStats stats;
+        ia_get_search_stats(&stats);
+        ia_print_search_stats(&stats);
+    }
     if (best_move.piece_index >= 0 && best_move.piece_index < piece_count) {
-        
-        
         // Éviter la récursion en désactivant temporairement l'IA
         int temp_ia = ia_active;
         ia_active = 0;
@@ -156,23 +221,44 @@ gboolean trigger_ia_move(gpointer user_data) {
         // Jouer le coup
         if (move_piece(best_move.piece_index, best_move.to_row, best_move.to_col)) {
             // Si en réseau, envoyer le coup joué par l'IA
-            if (g_socket != INVALID_SOCKET) {
-                char msg[5];
-                int N = 9;
-                msg[0] = 'A' + best_move.from_col;
-                msg[1] = '0' + (N - best_move.from_row);
-                msg[2] = 'A' + best_move.to_col;
-                msg[3] = '0' + (N - best_move.to_row);
-                msg[4] = '\0';
-                TCP_Send_Message(g_socket, msg);
-            }
-            if (g_drawing_area) gtk_widget_queue_draw(g_drawing_area);
+            if (g_socket != INVALID_SOCKET)
+                net_send_move(best_move.from_row, best_move.from_col, best_move.to_row, best_move.to_col);
+            ui_mark(UI_DIRTY_BOARD);
         }
         
         // Réactiver l'IA
         ia_active = temp_ia;
+        start_pondering();
     } else {
-        printf("L'IA n'a pas trouvé de coup valide\n");
+        LOG_WARN("L'IA n'a pas trouvé de coup valide");
+    }
+}
+
+/**
+ * \fn gboolean trigger_ia_move(gpointer user_data)
+ * \brief Déclenche l'IA pour jouer son coup.
+ *
+ * La recherche tourne en arrière-plan (voir ia_job.h) : la fenêtre reste
+ * réactive et les coups réseau continuent d'être traités pendant la réflexion.
+ * 
+ * \param user_data Données utilisateur (non utilisées)
+ * \return G_SOURCE_REMOVE pour arrêter le timeout
+ */
+gboolean trigger_ia_move(gpointer user_data) {
+    (void)user_data; // Supprime le warning unused parameter
+    
+    if (!(ia_active || ia_both_active) || game_over) return G_SOURCE_REMOVE;
+    if (!ia_both_active && current_turn != ia_color) return G_SOURCE_REMOVE;
+    if (net_waiting()) return G_SOURCE_REMOVE; // relancé à la connexion (net.c)
+    
+    LOG_INFO("L'IA reflechit...");
+    
+    // Créer l'état de jeu pour l'IA
+    GameState state = createGameStateFromCurrent();
+    
+    // Approfondissement itératif dans le temps par coup configuré (-t)
+    if (ia_job_start(&state, ia_get_time_budget(), on_ia_move_ready, NULL) != 0) {
+        LOG_ERROR("L'IA n'a pas pu lancer sa recherche");
     }
     
     return G_SOURCE_REMOVE;
@@ -195,6 +281,7 @@ void snapshot_initial_state(void) {
  * \brief Restaure l'état initial du plateau.
  */
 void restore_initial_state(void) {
+    ia_job_cancel(); // Le coup en cours de recherche ne concerne plus la partie
     piece_count = initial_piece_count;
     for (int i = 0; i < piece_count; ++i) pieces[i] = initial_pieces[i];
 
@@ -206,6 +293,7 @@ void restore_initial_state(void) {
     clear_highlight();
     initialize_controlled_cells();
     update_scores();
+    status_clear_result();
     reset_move_history(); // Réinitialiser l'historique IA
 }
 
@@ -249,7 +337,7 @@ void update_scores(void) {
     score_blue = pieces_blue + controlled_blue - 1;
     score_red  = pieces_red  + controlled_red  - 1;
 
-    status_on_scores_changed();
+    ui_mark(UI_DIRTY_SCORES);
 }
 
 /**
@@ -291,21 +379,10 @@ int is_cell_free(int row, int col) {
  * \return 1 si le déplacement est possible, 0 sinon
  */
 int can_move(int index, int dest_row, int dest_col) {
-    int sr = pieces[index].row;
-    int sc = pieces[index].col;
-
-    if (sr != dest_row && sc != dest_col) return 0; // pas diagonal
-
-    if (sr == dest_row) {
-        int dir = (dest_col > sc) ? 1 : -1;
-        for (int c = sc + dir; c != dest_col; c += dir)
-            if (!is_cell_free(sr, c)) return 0;
-    } else {
-        int dir = (dest_row > sr) ? 1 : -1;
-        for (int r = sr + dir; r != dest_row; r += dir)
-            if (!is_cell_free(r, sc)) return 0;
-    }
-    return is_cell_free(dest_row, dest_col);
+    if (dest_row < 0 || dest_row > 8 || dest_col < 0 || dest_col > 8) return 0;
+    if (index < 0 || index >= piece_count) return 0;
+    GameState st = createGameStateFromCurrent();
+    return rules_can_move(&st, index, dest_row, dest_col);
 }
 
 /**
@@ -326,13 +403,13 @@ void compute_highlight_for_selected(void) {
     clear_highlight();
     if (selected_piece < 0) return;
 
-    int r = pieces[selected_piece].row;
-    int c = pieces[selected_piece].col;
+    GameState st = createGameStateFromCurrent();
+    Bitboard reach = rules_destinations(&st, selected_piece);
 
-    for (int cc = c + 1; cc < 9; ++cc) { if (!is_cell_free(r, cc)) break; highlight_moves[r][cc] = 1; }
-    for (int cc = c - 1; cc >= 0; --cc){ if (!is_cell_free(r, cc)) break; highlight_moves[r][cc] = 1; }
-    for (int rr = r + 1; rr < 9; ++rr) { if (!is_cell_free(rr, c)) break; highlight_moves[rr][c] = 1; }
-    for (int rr = r - 1; rr >= 0; --rr){ if (!is_cell_free(rr, c)) break; highlight_moves[rr][c] = 1; }
+    for (int sq; reach; reach ^= bb_bit(sq)) {
+        sq = bb_lsb(reach);
+        highlight_moves[sq / 9][sq % 9] = 1;
+    }
 }
 
 
@@ -350,31 +427,73 @@ int find_piece_at(int row, int col) {
 }
 
 /**
- * \fn void check_turn_limit(void)
- * \brief Vérifie si la limite de tours est atteinte et termine la partie si nécessaire.
+ * \fn GameState createGameStateFromCurrent(void)
+ * \brief Crée une copie de l’état actuel du jeu.
+ * 
+ * \return Copie de l’état actuel du jeu.
  */
-static void check_turn_limit(void) {
-    if (game_over) return;
-    if (turn_number >= max_turn) {
-        update_scores();
-        if (score_blue > score_red) {
-            char buf[128];
-            snprintf(buf, sizeof(buf), "Limite de %d tours atteinte — score des bleus supérieur (%d vs %d).",max_turn, score_blue, score_red);
-            set_victory_message(TRUE, buf);
-        } else if (score_red > score_blue) {
-            char buf[128];
-            snprintf(buf, sizeof(buf), "Limite de %d tours atteinte — score des rouges supérieur (%d vs %d).",max_turn, score_red, score_blue);
-            set_victory_message(FALSE, buf);
-        } else {
-            char buf[128];
-            snprintf(buf, sizeof(buf), "Limite de 64 tours atteinte — scores égaux (%d chacun).", score_blue);
-            set_draw_message(buf);
-        }
-        game_over = 1;
-        clear_highlight();
-        selected_piece = -1;
-        if (g_drawing_area) gtk_widget_queue_draw(g_drawing_area);
+GameState createGameStateFromCurrent(void) {
+    GameState st;
+    rules_state_load(&st, pieces, piece_count, (const int (*)[9])cell_control, current_turn, turn_number);
+    return st;
+}
+
+/**
+ * \fn void game_sync_store(SyncState *out)
+ * \brief Instantané de la partie courante.
+ *
+ * \param out Instantané (retour).
+ */
+void game_sync_store(SyncState *out) {
+    GameState st = createGameStateFromCurrent();
+    sync_from_state(&st, out);
+}
+
+/**
+ * \fn int game_sync_load(const SyncState *in)
+ * \brief Remplace la partie courante par un instantané vérifié.
+ *
+ * La recherche en cours (ou la réflexion anticipée) portait sur l'ancienne
+ * partie : elle est annulée, même si l'instantané tombe au même tour et au
+ * même trait. `game_over` et le résultat affiché suivent la position chargée,
+ * comme après un coup de move_piece().
+ *
+ * \param in Instantané reçu.
+ * \return 0 si succès, -1 si l'instantané est invalide.
+ */
+int game_sync_load(const SyncState *in) {
+    GameState st;
+    if (sync_to_state(in, &st) != 0) return -1;
+    ia_job_cancel();
+    rules_state_store(&st, pieces, &piece_count, cell_control);
+    current_turn = st.current_player;
+    turn_number = st.turn_number;
+    update_scores();
+    clear_highlight();
+    selected_piece = -1;
+    ia_reset_history(&st);
+
+    RulesResult res = {0};
+    res.winner = rules_winner(&st, &res.end);
+    rules_scores(&st, &res.score_blue, &res.score_red);
+    if (!res.winner && max_turn > 0 && st.turn_number >= max_turn) {
+        res.end = RULES_END_TURN_LIMIT;
+        res.winner = (res.score_blue > res.score_red) ? 'B'
+                   : (res.score_red > res.score_blue) ? 'R' : 'D';
     }
+    game_over = res.winner != 0;
+    if (game_over) status_report_end(&res);
+    else status_clear_result();
+    return 0;
+}
+
+/**
+ * \fn void reset_move_history(void)
+ * \brief Réinitialise l'historique des positions de l'IA à la seule position courante.
+ */
+void reset_move_history(void) {
+    GameState st = createGameStateFromCurrent();
+    ia_reset_history(&st);
 }
 
 /**
@@ -389,74 +508,49 @@ static void check_turn_limit(void) {
 int move_piece(int piece_idx, int to_row, int to_col) {
     if (piece_idx < 0 || piece_idx >= piece_count) return 0;
 
-    Piece *p = &pieces[piece_idx];
-
-    // Vérifie si le déplacement est autorisé
-    if (!can_move(piece_idx, to_row, to_col)) return 0;
-
-    // Marque l'ancienne case
-    mark_cell_controlled(p->row, p->col, p->color);
-
-    int old_row = p->row;
-    int old_col = p->col;
+    GameState st = createGameStateFromCurrent();
+    Move mv = { piece_idx, pieces[piece_idx].row, pieces[piece_idx].col, to_row, to_col };
+    RulesResult res;
+    char color = pieces[piece_idx].color;
 
-    // Déplace la pièce
-    p->row = to_row;
-    p->col = to_col;
+    // Vérifie si le déplacement est autorisé, puis le joue avec ses captures
+    if (!rules_play(&st, &mv, max_turn, &res)) return 0;
 
-    printf("Tour %d: Deplacement de %c en %c%d\n",turn_number, p->color, 'A'+to_col, 9-to_row);
-
-    mark_cell_controlled(to_row, to_col, p->color);
-
-    // Vérifie captures (Linca peut supprimer une pièce avant l'index de la pièce déplacée,
-    // ce qui décale le tableau et invalide l'index et le pointeur 'p').
-    check_linca_capture(piece_idx);
-    if (game_over) { gtk_widget_queue_draw(g_drawing_area); return 1; }
-
-    // Ré-identifie la pièce déplacée après d'éventuels décalages du tableau
-    int new_idx = find_piece_at(to_row, to_col);
-    if (new_idx >= 0) {
-        piece_idx = new_idx;
-        p = &pieces[piece_idx];
+    LOG_INFO("Tour %d: Deplacement de %c en %c%d", turn_number, color, 'A'+to_col, 9-to_row);
+    for (int i = 0; i < res.capture_count; ++i) {
+        const RulesCapture *cap = &res.captures[i];
+        if (cap->type == 'K') continue;
+        LOG_INFO("Capture de %c en %c%d en %s", cap->color, 'A' + cap->sq % 9, 9 - cap->sq / 9,
+                 cap->rule == 'L' ? "Linca" : "Seltou");
     }
 
-    check_seltou_capture(piece_idx, old_row, old_col);
-    if (game_over) { gtk_widget_queue_draw(g_drawing_area); return 1; }
-
-    // Vérifie conditions de victoire spéciale
-    if ((p->type == 'K' || p->type == 'R') &&
-        ((p->color == 'R' && p->row == 0 && p->col == 0) ||
-         (p->color == 'B' && p->row == 8 && p->col == 8))) {
-
-        set_victory_message(p->color == 'B',
-            (p->color == 'R')
-            ? "Le roi rouge a atteint la base bleue."
-            : "Le roi bleu a atteint la base rouge.");
-        update_scores();
-        clear_highlight();
-        selected_piece = -1;
+    rules_state_store(&st, pieces, &piece_count, cell_control);
+    update_scores();
+    clear_highlight();
+    selected_piece = -1;
+
+    if (res.winner && res.end != RULES_END_TURN_LIMIT) {
+        status_report_end(&res);
         game_over = 1;
-        gtk_widget_queue_draw(g_drawing_area);
+        ui_mark(UI_DIRTY_BOARD);
         return 1;
     }
 
-    update_scores();
-    check_auto_defeat();
-    if (game_over) { 
-        if (g_drawing_area) gtk_widget_queue_draw(g_drawing_area); 
-        return 1; 
-    }
+    current_turn = st.current_player;
+    turn_number = st.turn_number;
 
-    clear_highlight();
-    current_turn = (current_turn == 'B') ? 'R' : 'B';
-    selected_piece = -1;
-    ++turn_number;
+    // Historique des positions de l'IA (répétitions)
+    ia_record_position(&st);
 
-    check_turn_limit();
-    if (game_over) return 1;
+    if (res.winner) {
+        // Limite de tours atteinte
+        status_report_end(&res);
+        game_over = 1;
+        ui_mark(UI_DIRTY_BOARD);
+        return 1;
+    }
 
-    if (g_drawing_area) gtk_widget_queue_draw(g_drawing_area);
-    refresh_game_status();
+    ui_mark(UI_DIRTY_BOARD | UI_DIRTY_STATUS);
     
     // Déclencher l'IA si c'est son tour (ou si IA vs IA active)
     if (!game_over && (ia_both_active || (ia_active && current_turn == ia_color))) {
@@ -0,0 +1,56 @@
+/**
+ * \file geometry.c
+ * \brief Tables géométriques du plateau, générées à la compilation.
+ * \author valentin.leray@uha.fr
+ * \version 0.1
+ * \date 2025-10-08
+ *
+ * \details
+ * Les tables sont des constantes initialisées par macros : aucun calcul au
+ * démarrage, et les boucles des règles et de la recherche n'ont plus de tests
+ * de limites ni d'arithmétique de coordonnées.
+ */
+
+#include "geometry.h"
+
+/* Déplacement élémentaire de la direction d (ordre haut, bas, gauche, droite) */
+#define GEO_DR(d) ((d) == 0 ? -1 : (d) == 1 ? 1 : 0)
+#define GEO_DC(d) ((d) == 2 ? -1 : (d) == 3 ? 1 : 0)
+#define GEO_IN(r, c) ((r) >= 0 && (r) < 9 && (c) >= 0 && (c) < 9)
+
+/* Case à k pas de sq dans la direction d, -1 hors plateau */
+#define GEO_STEP(sq, d, k) \
+    (GEO_IN((sq) / 9 + (k) * GEO_DR(d), (sq) % 9 + (k) * GEO_DC(d)) \
+        ? (sq) + (k) * (9 * GEO_DR(d) + GEO_DC(d)) : -1)
+
+/* Bit d'une case, 0 hors plateau */
+#define GEO_BIT(s) ((Bitboard)((s) >= 0) << ((s) >= 0 ? (s) : 0))
+
+/* Répète une macro par case puis par direction */
+#define GEO_ROW(M, r) M((r)*9+0), M((r)*9+1), M((r)*9+2), M((r)*9+3), M((r)*9+4), \
+                      M((r)*9+5), M((r)*9+6), M((r)*9+7), M((r)*9+8)
+#define GEO_BOARD(M) { GEO_ROW(M, 0), GEO_ROW(M, 1), GEO_ROW(M, 2), GEO_ROW(M, 3), GEO_ROW(M, 4), \
+                       GEO_ROW(M, 5), GEO_ROW(M, 6), GEO_ROW(M, 7), GEO_ROW(M, 8) }
+#define GEO_EACH_DIR(M, sq) { M(sq, 0), M(sq, 1), M(sq, 2), M(sq, 3) }
+
+/* Paires voisine / suivante */
+#define GEO_PAIR_D(sq, d) { GEO_STEP(sq, d, 1), GEO_STEP(sq, d, 2) }
+#define GEO_PAIR_SQ(sq) GEO_EACH_DIR(GEO_PAIR_D, sq)
+
+/* Rayons : liste des cases */
+#define GEO_RAY_D(sq, d) { GEO_STEP(sq, d, 1), GEO_STEP(sq, d, 2), GEO_STEP(sq, d, 3), GEO_STEP(sq, d, 4), \
+                           GEO_STEP(sq, d, 5), GEO_STEP(sq, d, 6), GEO_STEP(sq, d, 7), GEO_STEP(sq, d, 8) }
+#define GEO_RAY_SQ(sq) GEO_EACH_DIR(GEO_RAY_D, sq)
+
+/* Rayons : bitboards */
+#define GEO_RAYBB_D(sq, d) (GEO_BIT(GEO_STEP(sq, d, 1)) | GEO_BIT(GEO_STEP(sq, d, 2)) | \
+                            GEO_BIT(GEO_STEP(sq, d, 3)) | GEO_BIT(GEO_STEP(sq, d, 4)) | \
+                            GEO_BIT(GEO_STEP(sq, d, 5)) | GEO_BIT(GEO_STEP(sq, d, 6)) | \
+                            GEO_BIT(GEO_STEP(sq, d, 7)) | GEO_BIT(GEO_STEP(sq, d, 8)))
+#define GEO_RAYBB_SQ(sq) GEO_EACH_DIR(GEO_RAYBB_D, sq)
+
+const GeoPair geo_pair[81][GEO_DIRS] = GEO_BOARD(GEO_PAIR_SQ);
+
+const signed char geo_ray_sq[81][GEO_DIRS][GEO_RAY_MAX] = GEO_BOARD(GEO_RAY_SQ);
+
+const Bitboard geo_ray[81][GEO_DIRS] = GEO_BOARD(GEO_RAYBB_SQ);
@@ -24,6 +24,9 @@
 #include "captures.h"
 #include "drawing.h"
 #include "status.h"
+#include "ui.h"
+#include "ia_job.h"
+#include "analysis.h"
 
 
 /** \brief Overlay GTK pour afficher le message de victoire */
@@ -47,8 +50,7 @@ static GtkApplication *g_app = NULL;
  */
 static void reset_game(void) {
     restore_initial_state();
-    refresh_game_status();
-    if (g_drawing_area) gtk_widget_queue_draw(g_drawing_area);
+    ui_mark(UI_DIRTY_STATUS | UI_DIRTY_BOARD);
 }
 
 /**
@@ -78,6 +80,10 @@ static void on_replay_clicked(GtkButton *btn, gpointer user_data) {
  */
 static void on_window_destroy(GtkWidget *widget, gpointer user_data) {
     gui_active = 0;
+    analysis_shutdown();
+    ia_job_shutdown(); // Arrêter la recherche de l'IA avant de quitter
+    ui_detach();
+    drawing_cache_clear();
     
     if (g_app) {
         g_application_quit(G_APPLICATION(g_app));
@@ -100,6 +106,7 @@ static void on_click(GtkGestureClick *gesture, int n_press, double x, double y,
     extern int ia_active; extern int ia_both_active; extern char ia_color;
     
     if (ia_both_active || (ia_active && current_turn == ia_color)) return;
+    if (net_waiting()) return; // adversaire réseau pas encore connecté
     if (g_socket != INVALID_SOCKET && current_turn != my_color) return;
 
     int row, col;
@@ -120,7 +127,7 @@ static void on_click(GtkGestureClick *gesture, int n_press, double x, double y,
     // Ignorer clics hors grille
         if (row == -1 || col == -1)
             return;
-        refresh_game_status();
+        ui_mark(UI_DIRTY_STATUS);
     } else {
         int switched = 0;
         for (int i = 0; i < piece_count; ++i) {
@@ -136,20 +143,13 @@ static void on_click(GtkGestureClick *gesture, int n_press, double x, double y,
             int old_col = pieces[selected_piece].col;
             int moved = move_piece(selected_piece, row, col);
             if (moved && g_socket != INVALID_SOCKET) {
-                char msg[5];
-                int N = 9;
-                msg[0] = 'A' + old_col;
-                msg[1] = '0' + (N - old_row);
-                msg[2] = 'A' + col;
-                msg[3] = '0' + (N - row);
-                msg[4] = '\0';
-                TCP_Send_Message(g_socket, msg);
+                net_send_move(old_row, old_col, row, col);
                 selected_piece = -1;
             }
         }
-        refresh_game_status();
+        ui_mark(UI_DIRTY_STATUS);
     }
-    gtk_widget_queue_draw(g_drawing_area);
+    ui_mark(UI_DIRTY_BOARD);
 }
 
 /**
@@ -308,11 +308,14 @@ static void on_activate(GtkApplication *app, gpointer user_data) {
     // --- Enregistrer les labels pour status ---
     status_register_labels(score_blue_label, score_red_label, game_status_label,
                            replay_button, victory_label, victory_overlay);
+    ui_attach(g_drawing_area); // mises à jour des labels et du plateau à chaque image
+    if (analysis_multipv > 0 && analysis_start(analysis_multipv) != 0)
+        fprintf(stderr, "Mode analyse indisponible (thread non cree).\n");
 
     // --- Snapshot initial et scores ---
     snapshot_initial_state();
     update_scores();
-    refresh_game_status();
+    ui_mark(UI_DIRTY_BOARD | UI_DIRTY_STATUS);
 
     // --- Déclencher IA si nécessaire ---
     extern int ia_active; extern int ia_both_active; extern char ia_color;
@@ -7,24 +7,109 @@
  *
  * \details
  * Implémentations principales :
- * - Représentation interne du plateau et des pièces
- * - Détection des mouvements valides
  * - Calcul des vulnérabilités (Linca/Seltou)
- * - Application des coups et captures
  * - Évaluation heuristique
  * - Minimax avec élagage alpha-bêta
  * - Système anti-boucle
- * - Optimisations de performance
+ * - Optimisations de performance (plateau en bitboards, voir bitboard.h)
+ * - Table de transposition avec hachage de Zobrist incrémental (voir tt.h)
+ * - Approfondissement itératif limité par un temps de réflexion par coup
+ * - Recherche parallèle Lazy SMP (threads partageant la table de transposition)
+ * - PVS, fenêtres d'aspiration, réductions de fin de liste (LMR), coup nul
+ * - Recherche de quiescence sur les captures
+ *
+ * Les coups, les captures et les fins de partie viennent du cœur des règles
+ * (rules.c) : la recherche ne lit que l'état reçu et son contexte, jamais
+ * les globales du jeu. Les points d'entrée de la partie de l'interface
+ * placent dans ce contexte son historique et sa limite de tours (max_turn) ;
+ * ia_search_game() reçoit ceux de sa partie.
  */
 
 #include "ia.h"
+#include "tt.h"
+#include "geometry.h"
+#include "eval_kernel.h"
+#include "book.h"
+#include "tablebase.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+// Répétitions : pile des positions de la partie puis du chemin (IaHistory, ia.h)
+#define IA_REP_MAX     IA_HISTORY_POSITIONS
+#define IA_REP_GAME    (IA_REP_MAX - IA_MAX_PLY - 2)  // part réservée à la partie
+#define IA_REP_FILTER  IA_HISTORY_FILTER
+
+typedef IaHistory RepStack;
+
+// Positions de la partie de l'interface, partagées entre ses recherches :
+// chaque recherche en prend une copie qu'elle prolonge avec son propre chemin
+static RepStack game_positions;
+static pthread_mutex_t history_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Score d'une victoire (roi capturé ou arrivé dans la cité adverse) ; un gain
+// lu dans la table de finales vaut IA_WIN_SCORE moins sa distance
+#define IA_WIN_SCORE 30000000
+#define IA_WIN_BOUND (IA_WIN_SCORE - TB_MAX_DIST)  // seuil des scores de gain forcé
+
+// Budget de temps par coup (approfondissement itératif) et nombre de threads
+static int ia_time_budget_ms = IA_DEFAULT_TIME_MS;
+static int ia_thread_count = 1;
+
+// Statistiques de la dernière recherche terminée (voir ia_get_search_stats)
+static IaSearchStats ia_last_stats;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Tirage du livre des parties de l'interface ; verrou : une tâche annulée
+// (ia_job.h) peut encore tirer pendant que la suivante démarre
+static uint64_t ia_gui_book_rng = BOOK_DEFAULT_SEED;
+static pthread_mutex_t gui_book_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Ordonnancement des coups : tranches de priorité du sélecteur (voir ia_score_moves)
+#define PICK_TT        (1 << 30)
+#define PICK_CAPTURE   (1 << 28)
+#define PICK_KILLER    (1 << 26)
+#define PICK_VETO      (-(1 << 29))
+#define IA_HISTORY_MAX (1 << 24)
+#define IA_MAX_PLY     64
+#define IA_VETO_PLY    2   // veto de sécurité du roi aux plies 0 et 1 seulement
+
+#define IA_QS_MAX_PLY  8   // quiescence : plies de captures au-delà de l'horizon
+
+// Réductions et fenêtres (voir ia_minimax, ia_iterative_search)
+#define IA_INF         100000000
+#define IA_NULL_DEPTH  3   // profondeur minimale du coup nul
+#define IA_NULL_R      2   // réduction du coup nul
+#define IA_LMR_DEPTH   3   // profondeur minimale des réductions de fin de liste
+#define IA_LMR_MOVES   3   // coups explorés à pleine profondeur avant réduction
+#define IA_ASPIRATION  60  // demi-largeur initiale de la fenêtre d'aspiration
 
-// Historique des coups pour détecter les répétitions
-#define MAX_MOVE_HISTORY 8
-static Move move_history[MAX_MOVE_HISTORY];
-static int history_count = 0;
+/**
+ * @brief État propre à un thread de recherche
+ *
+ * Chaque thread (principal ou auxiliaire Lazy SMP) a ses heuristiques
+ * d'ordonnancement, sa pile de positions (partie + chemin) et ses propres
+ * compteurs ; seule la table de transposition est partagée.
+ */
+typedef struct {
+    Move killer_moves[IA_MAX_PLY][2];  /**< Coups tueurs (2 par ply) */
+    int  history_score[2][81][81];     /**< Historique [couleur][départ][arrivée] */
+    RepStack positions;                /**< Positions de la partie puis du chemin courant */
+    unsigned long long nodes;          /**< Nœuds visités (quiescence comprise) */
+    unsigned long long qnodes;         /**< Nœuds de quiescence */
+    unsigned long long cutoffs;        /**< Coupures beta (ia_minimax) */
+    unsigned long long first_cutoffs;  /**< Coupures dès le premier coup */
+    unsigned long long tt_probes;      /**< Consultations de la table */
+    unsigned long long tt_hits;        /**< Consultations fructueuses */
+    unsigned long long tb_hits;        /**< Positions résolues par la table de finales */
+    int  aborted;                      /**< 1 si la recherche a été interrompue */
+    long long deadline_us;             /**< Échéance (0 = pas de limite) */
+    const int* stop;                   /**< Arrêt demandé par le thread principal (NULL sinon) */
+    int  turn_limit;                   /**< Limite de tours de la partie (0 = aucune) */
+    int  null_ply;                     /**< Ply du coup nul en cours (-2 si aucun) */
+} SearchCtx;
 
 
 // --- Utilitaires internes ---
@@ -38,122 +123,65 @@ static int history_count = 0;
 static inline int abs_i(int x) { return (x < 0) ? -x : x; }
 
 /**
- * \fn static int findPieceAt(GameState* s, int row, int col)
- * \brief Recherche l’index d’une pièce aux coordonnées données.
- * 
- * \param s État du jeu.
- * \param row Ligne.
- * \param col Colonne.
- * \return Index de la pièce trouvée, ou -1 si vide.
+ * \brief Indice de couleur pour les tableaux `occ[]` / `king_sq[]`.
+ *
+ * \param color Couleur ('B' ou 'R').
+ * \return 0 pour Bleu, 1 pour Rouge.
  */
-static int findPieceAt(GameState* s, int row, int col) {
-    for (int i = 0; i < s->piece_count; ++i)
-        if (s->pieces[i].row == row && s->pieces[i].col == col) return i;
-    return -1;
-}
+static inline int color_idx(char color) { return color == 'R'; }
 
 /**
- * \fn static int isCellFree(GameState* s, int row, int col)
- * \brief Vérifie si une case est libre.
- * 
+ * \brief Cases occupées par les deux couleurs.
+ *
  * \param s État du jeu.
- * \param row Ligne.
- * \param col Colonne.
- * \return 1 si la case est libre, 0 sinon.
+ * \return Bitboard des cases occupées.
  */
-static int isCellFree(GameState* s, int row, int col) {
-    return findPieceAt(s, row, col) < 0;
-}
+static inline Bitboard ia_occupied(const GameState* s) { return s->occ[0] | s->occ[1]; }
 
 /**
- * \fn static inline int in_bounds(int r, int c)
- * \brief Vérifie si une case est dans les limites du plateau.
- * 
- * \param r Ligne.
- * \param c Colonne.
- * \return 1 si la case est dans le plateau, 0 sinon.
+ * \brief Cases libres du plateau.
+ *
+ * \param s État du jeu.
+ * \return Bitboard des cases vides.
  */
-static inline int in_bounds(int r, int c) { return r >= 0 && r < 9 && c >= 0 && c < 9; }
+static inline Bitboard ia_empty(const GameState* s) { return ~ia_occupied(s) & BB_FULL; }
 
 /**
- * \fn static int can_specific_piece_reach_square(GameState* s, int piece_index, int tr, int tc)
- * \brief Vérifie si une pièce spécifique peut atteindre une case par un mouvement rectiligne.
- * 
- * \param s État du jeu.
- * \param piece_index Index de la pièce.
- * \param tr Ligne cible.
- * \param tc Colonne cible.
- * \return 1 si la pièce peut atteindre la case, 0 sinon.
- */
-static int can_specific_piece_reach_square(GameState* s, int piece_index, int tr, int tc) {
-    if (piece_index < 0 || piece_index >= s->piece_count) return 0;
-    if (!in_bounds(tr, tc) || !isCellFree(s, tr, tc)) return 0;
-    int r = s->pieces[piece_index].row;
-    int c = s->pieces[piece_index].col;
-    if (r == tr) {
-        int dir = (tc > c) ? 1 : -1;
-        for (int cc = c + dir; cc != tc; cc += dir) {
-            if (!isCellFree(s, r, cc)) return 0;
-        }
-        return 1;
-    } else if (c == tc) {
-        int dir = (tr > r) ? 1 : -1;
-        for (int rr = r + dir; rr != tr; rr += dir) {
-            if (!isCellFree(s, rr, c)) return 0;
-        }
-        return 1;
-    }
-    return 0;
+ * \fn static long long ia_now_us(void)
+ * \brief Horloge monotone en microsecondes.
+ *
+ * \return Temps courant (origine arbitraire).
+ */
+static long long ia_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
 }
 
 /**
- * \fn static int find_king_index(GameState* s, char color)
- * \brief Trouve l’index du roi d’une couleur.
- * 
- * \param s État du jeu.
- * \param color Couleur ('R' ou 'B').
- * \return Index du roi, ou -1 si non trouvé.
+ * \fn static int ia_should_stop(const SearchCtx* ctx)
+ * \brief Vérifie l'échéance et la demande d'arrêt d'un thread de recherche.
+ *
+ * \param ctx Contexte de recherche.
+ * \return 1 si la recherche doit s'interrompre.
  */
-static int find_king_index(GameState* s, char color) {
-    for (int i = 0; i < s->piece_count; ++i)
-        if (s->pieces[i].type == 'K' && s->pieces[i].color == color) return i;
-    return -1;
+static int ia_should_stop(const SearchCtx* ctx) {
+    if (ctx->stop && __atomic_load_n(ctx->stop, __ATOMIC_RELAXED)) return 1;
+    return ctx->deadline_us && ia_now_us() >= ctx->deadline_us;
 }
 
 /**
- * \fn static int can_color_reach_square(GameState* s, char color, int tr, int tc)
- * \brief Vérifie si une couleur peut atteindre une case par un déplacement rectiligne.
- * 
+ * \fn static Bitboard ia_king_reach(GameState* s, char color)
+ * \brief Cases atteignables en un coup par le roi d'une couleur.
+ *
  * \param s État du jeu.
- * \param color Couleur du joueur.
- * \param tr Ligne cible.
- * \param tc Colonne cible.
- * \return 1 si une pièce peut atteindre la case, 0 sinon.
- */
-static int can_color_reach_square(GameState* s, char color, int tr, int tc) {
-    if (!in_bounds(tr, tc)) return 0;
-    if (!isCellFree(s, tr, tc)) return 0; // doit être vide pour pouvoir y aller
-    // Cherche une pièce de cette couleur qui peut atteindre (tr,tc)
-    for (int i = 0; i < s->piece_count; ++i) {
-        if (s->pieces[i].color != color) continue;
-        int r = s->pieces[i].row, c = s->pieces[i].col;
-        if (r == tr) {
-            int dir = (tc > c) ? 1 : -1;
-            int ok = 1;
-            for (int cc = c + dir; cc != tc; cc += dir) {
-                if (!isCellFree(s, r, cc)) { ok = 0; break; }
-            }
-            if (ok) return 1;
-        } else if (c == tc) {
-            int dir = (tr > r) ? 1 : -1;
-            int ok = 1;
-            for (int rr = r + dir; rr != tr; rr += dir) {
-                if (!isCellFree(s, rr, c)) { ok = 0; break; }
-            }
-            if (ok) return 1;
-        }
-    }
-    return 0;
+ * \param color Couleur du roi.
+ * \return Bitboard des destinations du roi (vide si le roi est capturé).
+ */
+static Bitboard ia_king_reach(GameState* s, char color) {
+    int ksq = s->king_sq[color_idx(color)];
+    if (ksq < 0) return 0;
+    return bb_rook_reach(bb_bit(ksq), ia_empty(s));
 }
 
 /**
@@ -165,22 +193,23 @@ static int can_color_reach_square(GameState* s, char color, int tr, int tc) {
  */
 static int is_square_linca_vulnerable(GameState* s, int r, int c, char victim_color) {
     char enemy = (victim_color == 'B') ? 'R' : 'B';
-    const int dr[4] = {-1, 1, 0, 0};
-    const int dc[4] = { 0, 0,-1, 1};
-    int enemy_king = find_king_index(s, enemy);
+    const GeoPair* pairs = geo_pair[BB_SQ(r, c)];
+    Bitboard empty = ia_empty(s);
+    Bitboard enemy_occ = s->occ[color_idx(enemy)];
+    Bitboard enemy_reach = bb_rook_reach(enemy_occ, empty);
+    Bitboard king_reach = ia_king_reach(s, enemy);
+    int enemy_king_sq = s->king_sq[color_idx(enemy)];
     int sever = 0;
-    for (int d = 0; d < 4; ++d) {
-        int r1 = r + dr[d], c1 = c + dc[d];
-        int r2 = r + 2*dr[d], c2 = c + 2*dc[d];
-        if (!in_bounds(r1, c1) || !in_bounds(r2, c2)) continue;
-        if (!isCellFree(s, r1, c1)) continue; // l'adversaire doit pouvoir venir sur r1
-        int idx2 = findPieceAt(s, r2, c2);
-        if (idx2 >= 0 && s->pieces[idx2].color == enemy) {
-            int base = (s->pieces[idx2].type == 'K') ? 2 : 1; // roi derrière = menace accrue
+    for (int d = 0; d < GEO_DIRS; ++d) {
+        int sq1 = pairs[d].near, sq2 = pairs[d].far;
+        if (sq2 < 0) continue;
+        if (!bb_test(empty, sq1)) continue; // l'adversaire doit pouvoir venir sur r1
+        if (bb_test(enemy_occ, sq2)) {
+            int base = (sq2 == enemy_king_sq) ? 2 : 1; // roi derrière = menace accrue
             // l'adversaire peut-il atteindre r1 ?
-            if (can_color_reach_square(s, enemy, r1, c1)) {
+            if (bb_test(enemy_reach, sq1)) {
                 int level = base;
-                if (enemy_king >= 0 && can_specific_piece_reach_square(s, enemy_king, r1, c1)) level = base + 1;
+                if (bb_test(king_reach, sq1)) level = base + 1;
                 if (level > sever) sever = level;
             }
         }
@@ -201,172 +230,28 @@ static int is_square_linca_vulnerable(GameState* s, int r, int c, char victim_co
  */
 static int is_square_seltou_vulnerable(GameState* s, int r, int c, char victim_color) {
     char enemy = (victim_color == 'B') ? 'R' : 'B';
-    const int dr[4] = {-1, 1, 0, 0};
-    const int dc[4] = { 0, 0,-1, 1};
-    int enemy_king = find_king_index(s, enemy);
+    const GeoPair* pairs = geo_pair[BB_SQ(r, c)];
+    Bitboard empty = ia_empty(s);
+    Bitboard victim_occ = s->occ[color_idx(victim_color)];
+    Bitboard enemy_reach = bb_rook_reach(s->occ[color_idx(enemy)], empty);
+    Bitboard king_reach = ia_king_reach(s, enemy);
     int sever = 0;
-    for (int d = 0; d < 4; ++d) {
-        int r_adj = r + dr[d], c_adj = c + dc[d];
-        if (!in_bounds(r_adj, c_adj)) continue;
-        if (!isCellFree(s, r_adj, c_adj)) continue; // l'adversaire doit pouvoir se placer adjacent
-        int r_back = r - dr[d], c_back = c - dc[d];
-        if (in_bounds(r_back, c_back)) {
-            int idx_back = findPieceAt(s, r_back, c_back);
-            if (idx_back >= 0 && s->pieces[idx_back].color == victim_color) continue; // protégé -> pas de capture Seltou
-        }
-        if (can_color_reach_square(s, enemy, r_adj, c_adj)) {
+    for (int d = 0; d < GEO_DIRS; ++d) {
+        int sq_adj = pairs[d].near;
+        if (sq_adj < 0) continue;
+        if (!bb_test(empty, sq_adj)) continue; // l'adversaire doit pouvoir se placer adjacent
+        int sq_back = pairs[d ^ 1].near;
+        if (sq_back >= 0 && bb_test(victim_occ, sq_back))
+            continue; // protégé -> pas de capture Seltou
+        if (bb_test(enemy_reach, sq_adj)) {
             int level = 1;
-            if (enemy_king >= 0 && can_specific_piece_reach_square(s, enemy_king, r_adj, c_adj)) level = 2;
+            if (bb_test(king_reach, sq_adj)) level = 2;
             if (level > sever) sever = level;
         }
     }
     return sever;
 }
 
-/** \fn static inline int ia_find_after(GameState* gs, const Move* mmv, int row, int col)
- * \brief Trouve l’index d’une pièce après un coup, en tenant compte du déplacement.
- * 
- * \param gs État du jeu.
- * \param mmv Coup appliqué.
- * \param row Ligne.
- * \param col Colonne.
- * \return Index de la pièce, ou -1 si vide.
- */
-static inline int ia_find_after(GameState* gs, const Move* mmv, int row, int col) {
-    if (row == mmv->to_row && col == mmv->to_col) return mmv->piece_index;
-    if (row == mmv->from_row && col == mmv->from_col) return -1;
-    return findPieceAt(gs, row, col);
-}
-
-/** \fn static int ia_move_priority(GameState* s, const Move* mv)
- * \brief Calcule la priorité d’un coup pour le tri.
- * 
- * \param s État du jeu.
- * \param mv Coup à évaluer.
- * \return Priorité (plus élevé = meilleur).
- */
-static void ia_check_linca_capture(GameState* s, int moved_index) {
-    Piece* moved = &s->pieces[moved_index];
-    int r = moved->row, c = moved->col;
-    char ally = moved->color;
-    char enemy = (ally == 'B') ? 'R' : 'B';
-    const int dr[4] = {-1, 1, 0, 0};
-    const int dc[4] = { 0, 0,-1, 1};
-
-    for (int d = 0; d < 4; ++d) {
-        int r1 = r + dr[d], c1 = c + dc[d];
-        int r2 = r + 2*dr[d], c2 = c + 2*dc[d];
-        if (r2 < 0 || r2 > 8 || c2 < 0 || c2 > 8) continue;
-
-        int idx1 = findPieceAt(s, r1, c1);
-        int idx2 = findPieceAt(s, r2, c2);
-        if (idx1 >= 0 && s->pieces[idx1].color == enemy &&
-            idx2 >= 0 && s->pieces[idx2].color == ally) {
-
-            // Roi capturé → suppression
-            if (s->pieces[idx1].type == 'K') {
-                for (int k = idx1; k < s->piece_count - 1; ++k) s->pieces[k] = s->pieces[k+1];
-                --s->piece_count;
-                return; // suffit
-            }
-
-            s->cell_control[r1][c1] = 0;
-            for (int k = idx1; k < s->piece_count - 1; ++k) s->pieces[k] = s->pieces[k+1];
-            --s->piece_count;
-            // recommencer la boucle direction (au cas de chaînes)
-            d = -1;
-        }
-    }
-}
-
-/**
- * \fn static void ia_check_seltou_capture(GameState* s, int moved_index, int old_row, int old_col)
- * \brief Vérifie et applique les captures de type Seltou après un déplacement.
- * 
- * \param s État du jeu.
- * \param moved_index Index de la pièce déplacée.
- * \param old_row Ancienne ligne.
- * \param old_col Ancienne colonne.
- */
-static void ia_check_seltou_capture(GameState* s, int moved_index, int old_row, int old_col) {
-    Piece* moved = &s->pieces[moved_index];
-    char ally = moved->color;
-    char enemy = (ally == 'B') ? 'R' : 'B';
-    int r = moved->row, c = moved->col;
-
-    int dr = 0, dc = 0;
-    if (r != old_row && c != old_col) return;
-    if (r == old_row && c == old_col) return;
-    if (r != old_row) dr = (r > old_row) ? 1 : -1;
-    if (c != old_col) dc = (c > old_col) ? 1 : -1;
-
-    int enemy_row = r + dr, enemy_col = c + dc;
-    if (enemy_row < 0 || enemy_row > 8 || enemy_col < 0 || enemy_col > 8) return;
-    int idx_enemy = findPieceAt(s, enemy_row, enemy_col);
-    if (idx_enemy < 0 || s->pieces[idx_enemy].color != enemy) return;
-
-    int back_row = enemy_row + dr, back_col = enemy_col + dc;
-    if (back_row >= 0 && back_row < 9 && back_col >= 0 && back_col < 9) {
-        int idx_back = findPieceAt(s, back_row, back_col);
-        if (idx_back >= 0 && s->pieces[idx_back].color == enemy) return; // protégé
-    }
-
-    // capture
-    if (s->pieces[idx_enemy].type == 'K') {
-        for (int k = idx_enemy; k < s->piece_count - 1; ++k) s->pieces[k] = s->pieces[k+1];
-        --s->piece_count;
-        return;
-    }
-    s->cell_control[enemy_row][enemy_col] = 0;
-    for (int k = idx_enemy; k < s->piece_count - 1; ++k) s->pieces[k] = s->pieces[k+1];
-    --s->piece_count;
-}
-
-/**
- * \fn static void ia_apply_move(GameState* s, const Move* mv)
- * \brief Applique un coup à l’état du jeu, y compris les captures.
- * 
- * \param s État du jeu.
- * \param mv Coup à appliquer.
- */
-static void ia_apply_move(GameState* s, const Move* mv) {
-    if (mv->piece_index < 0 || mv->piece_index >= s->piece_count) return;
-    Piece* p = &s->pieces[mv->piece_index];
-    int old_row = p->row, old_col = p->col;
-
-    // Marquer les cases contrôlées (persistantes dans ce jeu)
-    s->cell_control[old_row][old_col] = (p->color == 'B') ? 1 : 2;
-
-    p->row = mv->to_row;
-    p->col = mv->to_col;
-
-    s->cell_control[p->row][p->col] = (p->color == 'B') ? 1 : 2;
-
-    ia_check_linca_capture(s, mv->piece_index);
-    int idx_now = findPieceAt(s, p->row, p->col);
-    if (idx_now >= 0) ia_check_seltou_capture(s, idx_now, old_row, old_col);
-}
-
-/**
- * \fn static void ia_generate_moves(GameState* s, Move* list, int* count)
- * \brief Génère tous les coups valides pour le joueur courant.
- * 
- * \param s État du jeu.
- * \param list Tableau pour stocker les coups générés.
- * \param count Pointeur pour stocker le nombre de coups générés.
- */
-static void ia_generate_moves(GameState* s, Move* list, int* count) {
-    *count = 0;
-    for (int i = 0; i < s->piece_count; ++i) {
-        if (s->pieces[i].color != s->current_player) continue;
-        int r = s->pieces[i].row, c = s->pieces[i].col;
-        for (int cc = c + 1; cc < 9; ++cc) { if (!isCellFree(s, r, cc)) break; list[(*count)++] = (Move){i, r, c, r, cc}; }
-        for (int cc = c - 1; cc >= 0; --cc){ if (!isCellFree(s, r, cc)) break; list[(*count)++] = (Move){i, r, c, r, cc}; }
-        for (int rr = r + 1; rr < 9; ++rr) { if (!isCellFree(s, rr, c)) break; list[(*count)++] = (Move){i, r, c, rr, c}; }
-        for (int rr = r - 1; rr >= 0; --rr){ if (!isCellFree(s, rr, c)) break; list[(*count)++] = (Move){i, r, c, rr, c}; }
-    }
-}
-
 /** 
  * \brief Structure pour trier les coups par priorité
  */
@@ -406,52 +291,39 @@ static int cmp_scored_move_desc(const void* a, const void* b) {
  */
 static int is_king_capturable_next_turn(GameState* s, char king_color) {
     char enemy = (king_color == 'B') ? 'R' : 'B';
-    int king_index = find_king_index(s, king_color);
-    if (king_index < 0) return 0; // Pas de roi, pas de capture possible
+    int ksq = s->king_sq[color_idx(king_color)];
+    if (ksq < 0) return 0; // Pas de roi, pas de capture possible
 
-    int kr = s->pieces[king_index].row, kc = s->pieces[king_index].col;
+    const GeoPair* pairs = geo_pair[ksq];
+    Bitboard empty = ia_empty(s);
+    Bitboard own_occ = s->occ[color_idx(king_color)];
+    Bitboard enemy_occ = s->occ[color_idx(enemy)];
+    Bitboard enemy_reach = bb_rook_reach(enemy_occ, empty);
 
     // Vérifier si le roi peut être capturé par Linca
-    const int dr[4] = {-1, 1, 0, 0};
-    const int dc[4] = { 0, 0,-1, 1};
-
-    for (int d = 0; d < 4; ++d) {
-        int r1 = kr + dr[d], c1 = kc + dc[d];
-        int r2 = kr + 2*dr[d], c2 = kc + 2*dc[d];
-
+    for (int d = 0; d < GEO_DIRS; ++d) {
         // Vérifier si l'ennemi peut créer un sandwich
-        if (in_bounds(r1, c1) && in_bounds(r2, c2)) {
-            int idx2 = findPieceAt(s, r2, c2);
+        if (pairs[d].far >= 0) {
+            int sq1 = pairs[d].near, sq2 = pairs[d].far;
             // Si il y a déjà une pièce ennemie à r2, vérifier si l'ennemi peut placer une pièce à r1
-            if (idx2 >= 0 && s->pieces[idx2].color == enemy) {
-                if (can_color_reach_square(s, enemy, r1, c1)) {
-                    return 1; // Le roi peut être capturé par Linca
-                }
+            if (bb_test(enemy_occ, sq2) && bb_test(enemy_reach, sq1)) {
+                return 1; // Le roi peut être capturé par Linca
             }
             // Ou vérifier si l'ennemi peut créer le sandwich dans l'autre sens
-            int idx1 = findPieceAt(s, r1, c1);
-            if (idx1 >= 0 && s->pieces[idx1].color == enemy) {
-                if (can_color_reach_square(s, enemy, r2, c2)) {
-                    return 1; // Le roi peut être capturé par Linca
-                }
+            if (bb_test(enemy_occ, sq1) && bb_test(enemy_reach, sq2)) {
+                return 1; // Le roi peut être capturé par Linca
             }
         }
     }
 
     // Vérifier si le roi peut être capturé par Seltou
-    for (int d = 0; d < 4; ++d) {
-        int r_adj = kr + dr[d], c_adj = kc + dc[d];
-        if (in_bounds(r_adj, c_adj) && isCellFree(s, r_adj, c_adj)) {
+    for (int d = 0; d < GEO_DIRS; ++d) {
+        int sq_adj = pairs[d].near;
+        if (sq_adj >= 0 && bb_test(empty, sq_adj)) {
             // Vérifier si l'arrière du roi est libre ou hors limites
-            int r_back = kr - dr[d], c_back = kc - dc[d];
-            int protected = 0;
-            if (in_bounds(r_back, c_back)) {
-                int idx_back = findPieceAt(s, r_back, c_back);
-                if (idx_back >= 0 && s->pieces[idx_back].color == king_color) {
-                    protected = 1;
-                }
-            }
-            if (!protected && can_color_reach_square(s, enemy, r_adj, c_adj)) {
+            int sq_back = pairs[d ^ 1].near;
+            int protected = sq_back >= 0 && bb_test(own_occ, sq_back);
+            if (!protected && bb_test(enemy_reach, sq_adj)) {
                 return 1; // Le roi peut être capturé par Seltou
             }
         }
@@ -460,333 +332,409 @@ static int is_king_capturable_next_turn(GameState* s, char king_color) {
     return 0;
 }
 
-/** \fn add_move_to_history(const Move* mv)
- * \brief Ajoute un coup à l'historique des coups.
- * 
- * \param mv Coup à ajouter.
+/**
+ * \fn static void ia_rep_push(RepStack* r, uint64_t hash)
+ * \brief Empile une position (la pile doit avoir de la place).
+ *
+ * \param r Pile des positions.
+ * \param hash Hachage de la position.
  */
-static void add_move_to_history(const Move* mv) {
-    if (history_count < MAX_MOVE_HISTORY) {
-        move_history[history_count] = *mv;
-        history_count++;
-    } else {
-        // Décaler l'historique (FIFO)
-        for (int i = 0; i < MAX_MOVE_HISTORY - 1; i++) {
-            move_history[i] = move_history[i + 1];
-        }
-        move_history[MAX_MOVE_HISTORY - 1] = *mv;
-    }
+static void ia_rep_push(RepStack* r, uint64_t hash) {
+    r->hash[r->count++] = hash;
+    r->filter[hash & (IA_REP_FILTER - 1)]++;
 }
 
-/** \fn static int is_move_recent(const Move* mv, int lookback)
- * \brief Vérifie si un coup similaire a été joué récemment.
- * 
- * \param mv Coup à vérifier.
- * \param lookback Nombre de coups récents à vérifier.
- * \return 1 si un coup similaire a été joué récemment, 0 sinon.
- */
-static int is_move_recent(const Move* mv, int lookback) {
-    if (lookback > history_count) lookback = history_count;
-
-    for (int i = history_count - lookback; i < history_count; i++) {
-        if (move_history[i].piece_index == mv->piece_index &&
-            move_history[i].from_row == mv->from_row &&
-            move_history[i].from_col == mv->from_col &&
-            move_history[i].to_row == mv->to_row &&
-            move_history[i].to_col == mv->to_col) {
-            return 1;
-        }
-    }
-    return 0;
+/**
+ * \fn static void ia_rep_pop(RepStack* r)
+ * \brief Dépile la dernière position.
+ *
+ * \param r Pile des positions (non vide).
+ */
+static void ia_rep_pop(RepStack* r) {
+    r->filter[r->hash[--r->count] & (IA_REP_FILTER - 1)]--;
 }
 
-/** \fn static int count_similar_recent_moves(const Move* mv, int lookback)
- * \brief Compte combien de fois un coup similaire a été joué récemment.
- * 
- * \param mv Coup à vérifier.
- * \param lookback Nombre de coups récents à vérifier.
- * \return Nombre de coups similaires joués récemment.
- */
-static int count_similar_recent_moves(const Move* mv, int lookback) {
-    if (lookback > history_count) lookback = history_count;
-
-    int count = 0;
-    for (int i = history_count - lookback; i < history_count; i++) {
-        if (move_history[i].piece_index == mv->piece_index) {
-            // Même direction de mouvement?
-            int old_dr = move_history[i].to_row - move_history[i].from_row;
-            int old_dc = move_history[i].to_col - move_history[i].from_col;
-            int new_dr = mv->to_row - mv->from_row;
-            int new_dc = mv->to_col - mv->from_col;
-
-            // Normaliser les directions (-1, 0, 1)
-            if (old_dr != 0) old_dr = (old_dr > 0) ? 1 : -1;
-            if (old_dc != 0) old_dc = (old_dc > 0) ? 1 : -1;
-            if (new_dr != 0) new_dr = (new_dr > 0) ? 1 : -1;
-            if (new_dc != 0) new_dc = (new_dc > 0) ? 1 : -1;
-
-            if (old_dr == new_dr && old_dc == new_dc) {
-                count++;
-            }
-        }
-    }
-    return count;
+/**
+ * \fn static int ia_rep_count(const RepStack* r, uint64_t hash)
+ * \brief Nombre d'occurrences d'une position dans la pile.
+ *
+ * Le filtre répond en O(1) dans le cas courant (aucune position de la pile
+ * dans la même case) ; sinon la pile est relue pour une égalité exacte des
+ * hachages, qui couvrent pièces, contrôle et trait.
+ *
+ * \param r Pile des positions.
+ * \param hash Hachage de la position cherchée.
+ * \return Nombre d'occurrences (0 si la position est nouvelle).
+ */
+static int ia_rep_count(const RepStack* r, uint64_t hash) {
+    if (r->filter[hash & (IA_REP_FILTER - 1)] == 0) return 0;
+    int n = 0;
+    for (int i = r->count - 1; i >= 0; --i) n += (r->hash[i] == hash);
+    return n;
 }
 
 /**
  * \brief 
  * Variables externes pour les scores (utilisées dans l’évaluation).
  */
-extern int score_blue, score_red;
 
 /**
- * \fn static int is_loop_detected(const Move* mv)
- * \brief Détecte si un coup crée une boucle de répétition.
- * 
- * \param mv Coup à vérifier.
- * \return 1 si une boucle est détectée, 0 sinon.
+ * \fn static int ia_capture_value(const GameState* s, const Move* mv)
+ * \brief Valeur des gains immédiats d'un coup, sans le jouer.
+ *
+ * Détecte à partir des bitboards les captures Linca (ennemi pris en sandwich
+ * par la case d'arrivée) et Seltou (ennemi poussé dans la direction du
+ * mouvement sans protection derrière), ainsi que le roi qui atteint la cité
+ * adverse.
+ *
+ * \param s État du jeu.
+ * \param mv Coup à examiner.
+ * \return 0 pour un coup calme, sinon une valeur croissante avec le gain.
  */
-static int is_loop_detected(const Move* mv) {
-    if (history_count < 4) return 0; // Besoin d'au moins 4 coups pour voir 2 de mes coups
-
-    // Vérifier si je répète le même coup depuis 3 tours
-    // history[count-1] = dernier coup adversaire
-    // history[count-2] = MON dernier coup
-    // history[count-3] = avant-dernier coup adversaire
-    // history[count-4] = MON avant-dernier coup
-
-    Move* my_last = &move_history[history_count - 2];      // Mon dernier coup
-    Move* my_before = &move_history[history_count - 4];    // Mon avant-dernier coup
-
-    // Si le coup actuel == mon dernier coup == mon avant-dernier coup
-    if (mv->piece_index == my_last->piece_index &&
-        mv->from_row == my_last->from_row && mv->from_col == my_last->from_col &&
-        mv->to_row == my_last->to_row && mv->to_col == my_last->to_col &&
-
-        my_last->piece_index == my_before->piece_index &&
-        my_last->from_row == my_before->from_row && my_last->from_col == my_before->from_col &&
-        my_last->to_row == my_before->to_row && my_last->to_col == my_before->to_col) {
-
-        return 1; // Même coup joué 3 fois consécutives
+static int ia_capture_value(const GameState* s, const Move* mv) {
+    const StatePiece* pc = &s->pieces[mv->piece_index];
+    int tr = mv->to_row, tc = mv->to_col;
+    int ally = color_idx(pc->color);
+    int enemy = 1 - ally;
+    int from = BB_SQ(mv->from_row, mv->from_col), to = BB_SQ(tr, tc);
+    const GeoPair* pairs = geo_pair[to];
+    // Occupation après le coup : la pièce quitte sa case de départ pour sa case d'arrivée
+    Bitboard ally_after = (s->occ[ally] & ~bb_bit(from)) | bb_bit(to);
+    Bitboard enemy_occ = s->occ[enemy];
+    int enemy_king_sq = s->king_sq[enemy];
+    int v = 0;
+
+    // Roi qui atteint la base adverse
+    if (pc->type == 'K' && to == (ally ? BB_SQ(0, 0) : BB_SQ(8, 8))) v += 20000;
+
+    // Linca
+    for (int d = 0; d < GEO_DIRS; ++d) {
+        if (pairs[d].far < 0) continue;
+        if (bb_test(enemy_occ, pairs[d].near) && bb_test(ally_after, pairs[d].far))
+            v += (pairs[d].near == enemy_king_sq) ? 10000 : 100;
     }
 
-    return 0;
+    // Seltou (uniquement dans la direction du mouvement)
+    int md = geo_dir(from, to);
+    if (md >= 0 && pairs[md].near >= 0 && bb_test(enemy_occ, pairs[md].near)) {
+        // hors limite derrière = non protégé
+        if (pairs[md].far < 0 || !bb_test(enemy_occ, pairs[md].far))
+            v += (pairs[md].near == enemy_king_sq) ? 10000 : 100;
+    }
+    return v;
 }
 
 /**
- * \fn static int ia_move_priority(GameState* s, const Move* mv)
- * \brief Calcule la priorité d’un coup pour le tri.
- * 
+ * \fn static int ia_quiet_priority(const GameState* s, const Move* mv)
+ * \brief Score statique d'un coup calme (progression du roi, centralisation, longueur).
+ *
  * \param s État du jeu.
  * \param mv Coup à évaluer.
  * \return Priorité (plus élevé = meilleur).
  */
-static int ia_move_priority(GameState* s, const Move* mv) {
-    const Piece* pc = &s->pieces[mv->piece_index];
+static int ia_quiet_priority(const GameState* s, const Move* mv) {
+    const StatePiece* pc = &s->pieces[mv->piece_index];
     int pr = 0;
-
-    // 0) Anti-boucle SIMPLIFIÉ - bannir TOUTES les boucles
-    if (is_loop_detected(mv)) {
-        return -999999999; // Bannir TOUTES les boucles, peu importe le score
-    }
-    // 1) Coups gagnants absolus
-    //    a) capture du roi adverse par l'effet du coup
-    //    b) roi qui atteint sa cité
-
-    // a) Détection de capture de roi (Linca/Seltou) après ce coup
-    {
-        int tr = mv->to_row, tc = mv->to_col;
-        char ally = pc->color;
-        char enemy = (ally == 'B') ? 'R' : 'B';
-        const int dr[4] = {-1, 1, 0, 0};
-        const int dc[4] = { 0, 0,-1, 1};
-        // Linca
-        for (int d = 0; d < 4; ++d) {
-            int r1 = tr + dr[d], c1 = tc + dc[d];
-            int r2 = tr + 2*dr[d], c2 = tc + 2*dc[d];
-            if (r2 >= 0 && r2 < 9 && c2 >= 0 && c2 < 9) {
-                int idx1 = ia_find_after(s, mv, r1, c1);
-                int idx2 = ia_find_after(s, mv, r2, c2);
-                if (idx1 >= 0 && s->pieces[idx1].color == enemy && s->pieces[idx1].type == 'K' &&
-                    idx2 >= 0 && s->pieces[idx2].color == ally) {
-                    return 10000000; // priorité absolue (capture roi)
-                }
-            }
-        }
-        // Seltou (uniquement dans la direction du mouvement)
-        int mdr = 0, mdc = 0;
-        if (mv->to_row != mv->from_row) mdr = (mv->to_row > mv->from_row) ? 1 : -1;
-        if (mv->to_col != mv->from_col) mdc = (mv->to_col > mv->from_col) ? 1 : -1;
-        if ((mdr == 0) != (mdc == 0)) {
-            int er = tr + mdr, ec = tc + mdc;
-            if (er >= 0 && er < 9 && ec >= 0 && ec < 9) {
-                int idxe = ia_find_after(s, mv, er, ec);
-                if (idxe >= 0 && s->pieces[idxe].color == enemy && s->pieces[idxe].type == 'K') {
-                    int br = er + mdr, bc = ec + mdc;
-                    if (br >= 0 && br < 9 && bc >= 0 && bc < 9) {
-                        int idxb = ia_find_after(s, mv, br, bc);
-                        if (!(idxb >= 0 && s->pieces[idxb].color == enemy)) {
-                            return 10000000; // capture roi non protégée
-                        }
-                    } else {
-                        // hors limite derrière = non protégé -> capture
-                        return 10000000;
-                    }
-                }
-            }
-        }
-    }
-
-    // 1) Roi qui atteint la base adverse
-    if (pc->type == 'K') {
-        if ((pc->color == 'R' && mv->to_row == 0 && mv->to_col == 0) ||
-            (pc->color == 'B' && mv->to_row == 8 && mv->to_col == 8)) {
-            return 5000000;
-        }
-    }
-    // 2) Amélioration de la distance du roi vers l’objectif
+    // Amélioration de la distance du roi vers l’objectif
     if (pc->type == 'K') {
         int old_d = (pc->color == 'R')
-                  ? (abs_i(pc->row - 0) + abs_i(pc->col - 0))
-                  : (abs_i(pc->row - 8) + abs_i(pc->col - 8));
+                  ? (abs_i(mv->from_row - 0) + abs_i(mv->from_col - 0))
+                  : (abs_i(mv->from_row - 8) + abs_i(mv->from_col - 8));
         int new_d = (pc->color == 'R')
                   ? (abs_i(mv->to_row - 0) + abs_i(mv->to_col - 0))
                   : (abs_i(mv->to_row - 8) + abs_i(mv->to_col - 8));
         pr += (old_d - new_d) * 50; // avancer le roi = mieux
     }
-    // 3) Centralisation (vers 4,4)
-    int center_old = abs_i(s->pieces[mv->piece_index].row - 4) + abs_i(s->pieces[mv->piece_index].col - 4);
+    // Centralisation (vers 4,4)
+    int center_old = abs_i(mv->from_row - 4) + abs_i(mv->from_col - 4);
     int center_new = abs_i(mv->to_row - 4) + abs_i(mv->to_col - 4);
     pr += (center_old - center_new) * 2;
-    // 4) Longueur du déplacement
+    // Longueur du déplacement
     pr += abs_i(mv->to_row - mv->from_row) + abs_i(mv->to_col - mv->from_col);
+    return pr;
+}
 
+/**
+ * \fn static int ia_root_adjust(SearchCtx* ctx, GameState* s, const Move* mv)
+ * \brief Ajustements réservés à la racine : répétitions et exposition de la pièce jouée.
+ *
+ * Les positions déjà atteintes dans la partie sont pénalisées quand on n'est
+ * pas devant (tourner en rond ne rattrape pas le retard). La pénalité
+ * d'exposition (Linca / Seltou) demande de jouer le coup, elle n'est donc
+ * calculée qu'ici.
+ *
+ * \param ctx Contexte de recherche (positions de la partie).
+ * \param s État du jeu (bitboards à jour).
+ * \param mv Coup à évaluer.
+ * \return Ajustement de priorité.
+ */
+static int ia_root_adjust(SearchCtx* ctx, GameState* s, const Move* mv) {
+    const StatePiece* pc = &s->pieces[mv->piece_index];
+    char my_color = pc->color;
+    int pr = 0;
 
-    // 5) Vérification critique: le roi peut-il être capturé après ce mouvement?
-    {
-        GameState t = *s;
-        ia_apply_move(&t, mv);
-        char my_color = pc->color;
-
-        // Si ce mouvement expose notre roi à une capture immédiate, rejeter complètement le coup
-        if (is_king_capturable_next_turn(&t, my_color)) {
-            return -50000000; // Priorité extrêmement négative pour éviter la capture du roi
+    // Gestion des répétitions selon le score (celui de la position, pas les
+    // globales du jeu : la recherche peut tourner sur un autre thread)
+    int blue_score, red_score;
+    rules_scores(s, &blue_score, &red_score);
+    int my_score = (my_color == 'B') ? blue_score : red_score;
+    int enemy_score = (my_color == 'B') ? red_score : blue_score;
+    int score_diff = my_score - enemy_score;
+
+    MoveUndo undo;
+    rules_make_move(s, mv, &undo);
+
+    // Si on est en retard ou à égalité, pénaliser fortement les répétitions
+    if (score_diff <= 0) {
+        int seen = ia_rep_count(&ctx->positions, s->hash);
+        if (seen > 0) {
+            pr -= 150000 + (seen - 1) * 8000; // Forte pénalité, croissante
+        } else if (score_diff < 0) {
+            pr += 3000; // Bonus d'exploration : position nouvelle
         }
     }
 
-    // 6) Gestion des répétitions selon le score
-    {
-        char my_color = pc->color;
-        int my_score = (my_color == 'B') ? score_blue : score_red;
-        int enemy_score = (my_color == 'B') ? score_red : score_blue;
-        int score_diff = my_score - enemy_score;
+    // Sécurité: éviter d'exposer la pièce (surtout le roi) à une capture immédiate (Linca/Seltou)
+    int idx = rules_piece_at(s, BB_SQ(mv->to_row, mv->to_col));
+    if (idx >= 0) {
+        int r = s->pieces[idx].sq / 9, c = s->pieces[idx].sq % 9;
+        int linca_v = is_square_linca_vulnerable(s, r, c, my_color);   // 0..3
+        int seltou_v = is_square_seltou_vulnerable(s, r, c, my_color); // 0..2
+        int penalty = 0;
+        penalty += linca_v * 2200;   // Linca plus sévère, surtout si roi adverse impliqué
+        penalty += seltou_v * 1100;
+        if (s->pieces[idx].type == 'K') penalty *= 8; // beaucoup plus sévère pour le roi
+        pr -= penalty;
+    }
+    rules_unmake_move(s, &undo);
+    return pr;
+}
 
-        // Si on est en retard ou à égalité, pénaliser fortement les répétitions
-        if (score_diff <= 0) {
-            // Pénalité pour coup exactement identique récent
-            if (is_move_recent(mv, 4)) {
-                pr -= 150000; // Forte pénalité pour éviter les boucles
-            }
+/**
+ * \fn static int ia_exposes_king(GameState* s, const Move* mv)
+ * \brief Vérifie si un coup laisse notre roi capturable au tour suivant.
+ *
+ * \param s État du jeu (bitboards à jour).
+ * \param mv Coup à vérifier.
+ * \return 1 si le roi devient capturable, 0 sinon.
+ */
+static int ia_exposes_king(GameState* s, const Move* mv) {
+    char my_color = s->pieces[mv->piece_index].color;
+    MoveUndo undo;
+    rules_make_move(s, mv, &undo);
+    int exposed = is_king_capturable_next_turn(s, my_color);
+    rules_unmake_move(s, &undo);
+    return exposed;
+}
 
-            // Pénalité pour coups similaires répétés
-            int similar_count = count_similar_recent_moves(mv, 6);
-            if (similar_count > 0) {
-                pr -= similar_count * 8000; // Pénalité croissante
-            }
+/**
+ * \fn static inline int ia_same_squares(const Move* a, const Move* b)
+ * \brief Compare deux coups par leurs cases (indépendamment de l'index de pièce).
+ *
+ * \param a Premier coup.
+ * \param b Deuxième coup.
+ * \return 1 si mêmes cases de départ et d'arrivée.
+ */
+static inline int ia_same_squares(const Move* a, const Move* b) {
+    return a->from_row == b->from_row && a->from_col == b->from_col &&
+           a->to_row == b->to_row && a->to_col == b->to_col;
+}
 
-            // Bonus pour l'exploration si on est en retard
-            if (score_diff < 0) {
-                // Favoriser les coups "nouveaux" qui n'ont pas été essayés récemment
-                if (!is_move_recent(mv, 6) && count_similar_recent_moves(mv, 6) == 0) {
-                    pr += 3000; // Bonus d'exploration
-                }
-            }
-        }
+/**
+ * \fn static void ia_score_moves(SearchCtx* ctx, GameState* s, ScoredMove* moves, int n, const TTEntry* tte, int ply)
+ * \brief Range chaque coup dans sa tranche de priorité.
+ *
+ * Tranches, de la plus prioritaire à la moins prioritaire :
+ * 1. coup de la table de transposition
+ * 2. captures et arrivée du roi dans la cité, par gain décroissant
+ * 3. coups tueurs de ce ply
+ * 4. coups calmes, par score d'historique puis score statique
+ * 5. coups qui exposent notre roi (vérifiés seulement près de la racine)
+ *
+ * \param ctx Contexte de recherche (coups tueurs, historique).
+ * \param s État du jeu.
+ * \param moves Coups à classer (champ `prio` rempli).
+ * \param n Nombre de coups.
+ * \param tte Entrée de la table pour cette position (NULL si absente).
+ * \param ply Distance à la racine.
+ */
+static void ia_score_moves(SearchCtx* ctx, GameState* s, ScoredMove* moves, int n, const TTEntry* tte, int ply) {
+    int ci = color_idx(s->current_player);
+    const Move* k0 = (ply < IA_MAX_PLY) ? &ctx->killer_moves[ply][0] : NULL;
+    const Move* k1 = (ply < IA_MAX_PLY) ? &ctx->killer_moves[ply][1] : NULL;
+
+    for (int i = 0; i < n; ++i) {
+        const Move* mv = &moves[i].mv;
+        int from = BB_SQ(mv->from_row, mv->from_col), to = BB_SQ(mv->to_row, mv->to_col);
+        int gain = ia_capture_value(s, mv);
+        int pr;
+
+        if (tte && tte->from_sq == from && tte->to_sq == to) pr = PICK_TT;
+        else if (gain > 0)                                   pr = PICK_CAPTURE + gain;
+        else if (k0 && ia_same_squares(mv, k0))              pr = PICK_KILLER + 1;
+        else if (k1 && ia_same_squares(mv, k1))              pr = PICK_KILLER;
+        else pr = ctx->history_score[ci][from][to] + ia_quiet_priority(s, mv);
+
+        if (ply == 0) pr += ia_root_adjust(ctx, s, mv);
+        // Veto de sécurité du roi, coûteux : seulement près de la racine
+        if (ply < IA_VETO_PLY && gain < 10000 && ia_exposes_king(s, mv)) pr += PICK_VETO;
+        moves[i].prio = pr;
     }
+}
 
-    // 7) Sécurité: éviter d'exposer la pièce (surtout le roi) à une capture immédiate (Linca/Seltou)
-    {
-        GameState t = *s;
-        ia_apply_move(&t, mv);
-        int idx = findPieceAt(&t, mv->to_row, mv->to_col);
-        if (idx >= 0) {
-            char my_color = t.pieces[idx].color;
-            int r = t.pieces[idx].row, c = t.pieces[idx].col;
-            int linca_v = is_square_linca_vulnerable(&t, r, c, my_color);   // 0..3
-            int seltou_v = is_square_seltou_vulnerable(&t, r, c, my_color); // 0..2
-            int penalty = 0;
-            penalty += linca_v * 2200;   // Linca plus sévère, surtout si roi adverse impliqué
-            penalty += seltou_v * 1100;
-            if (t.pieces[idx].type == 'K') penalty *= 8; // beaucoup plus sévère pour le roi
-            pr -= penalty;
-        }
+/**
+ * \fn static void ia_pick_next(ScoredMove* moves, int n, int i)
+ * \brief Sélection paresseuse : amène en position `i` le meilleur coup restant.
+ *
+ * Une coupure survient souvent dans les premiers coups : trier toute la liste
+ * serait du travail perdu.
+ *
+ * \param moves Coups classés.
+ * \param n Nombre de coups.
+ * \param i Position à remplir (les coups avant `i` ont déjà été explorés).
+ */
+static void ia_pick_next(ScoredMove* moves, int n, int i) {
+    int best = i;
+    for (int j = i + 1; j < n; ++j)
+        if (moves[j].prio > moves[best].prio) best = j;
+    if (best != i) {
+        ScoredMove t = moves[i];
+        moves[i] = moves[best];
+        moves[best] = t;
     }
+}
 
-    return pr;
+/**
+ * \fn static void ia_record_cutoff(SearchCtx* ctx, const GameState* s, const Move* mv, int profondeur, int ply)
+ * \brief Met à jour coups tueurs et historique après une coupure par un coup calme.
+ *
+ * \param ctx Contexte de recherche.
+ * \param s État du jeu (avant le coup).
+ * \param mv Coup ayant provoqué la coupure.
+ * \param profondeur Profondeur restante.
+ * \param ply Distance à la racine.
+ */
+static void ia_record_cutoff(SearchCtx* ctx, const GameState* s, const Move* mv, int profondeur, int ply) {
+    if (ia_capture_value(s, mv) > 0) return;
+    if (ply < IA_MAX_PLY && !ia_same_squares(mv, &ctx->killer_moves[ply][0])) {
+        ctx->killer_moves[ply][1] = ctx->killer_moves[ply][0];
+        ctx->killer_moves[ply][0] = *mv;
+    }
+    int* h = &ctx->history_score[color_idx(s->current_player)][BB_SQ(mv->from_row, mv->from_col)][BB_SQ(mv->to_row, mv->to_col)];
+    *h += profondeur * profondeur;
+    if (*h > IA_HISTORY_MAX) {
+        // Vieillissement : on garde l'ordre relatif, sous la tranche des coups tueurs
+        for (int c = 0; c < 2; ++c)
+            for (int a = 0; a < 81; ++a)
+                for (int b = 0; b < 81; ++b) ctx->history_score[c][a][b] /= 2;
+    }
+}
+
+/**
+ * \fn static void ia_ctx_init(SearchCtx* ctx, const GameState* root, long long deadline_us, const int* stop, const IaHistory* history, int turn_limit)
+ * \brief Prépare un contexte de recherche vierge.
+ *
+ * Efface coups tueurs et historique et copie les positions de la partie,
+ * pour que la recherche n'ait plus à lire l'état partagé. La racine, si elle
+ * est la dernière position jouée, est retirée de la copie : la recherche
+ * l'empile elle-même en tête de son chemin.
+ *
+ * \param ctx Contexte à initialiser.
+ * \param root Position de départ de la recherche.
+ * \param deadline_us Échéance (0 = pas de limite).
+ * \param stop Drapeau d'arrêt à surveiller (NULL pour le thread principal).
+ * \param history Positions de la partie (NULL : celles de l'interface, ia_record_position()).
+ * \param turn_limit Limite de tours de la partie (0 = aucune).
+ */
+static void ia_ctx_init(SearchCtx* ctx, const GameState* root, long long deadline_us, const int* stop, const IaHistory* history, int turn_limit) {
+    memset(ctx->history_score, 0, sizeof(ctx->history_score));
+    for (int p = 0; p < IA_MAX_PLY; ++p)
+        ctx->killer_moves[p][0] = ctx->killer_moves[p][1] = (Move){ .piece_index = -1, -1, -1, -1, -1 };
+    if (history) {
+        ctx->positions = *history;
+    } else {
+        pthread_mutex_lock(&history_lock);
+        ctx->positions = game_positions;
+        pthread_mutex_unlock(&history_lock);
+    }
+    RepStack* r = &ctx->positions;
+    if (r->count > 0 && r->hash[r->count - 1] == root->hash) ia_rep_pop(r);
+    ctx->nodes = ctx->qnodes = 0;
+    ctx->cutoffs = ctx->first_cutoffs = 0;
+    ctx->tt_probes = ctx->tt_hits = ctx->tb_hits = 0;
+    ctx->aborted = 0;
+    ctx->deadline_us = deadline_us;
+    ctx->stop = stop;
+    ctx->turn_limit = turn_limit;
+    ctx->null_ply = -2;
 }
 
 /**
- * \fn static void ia_generate_sorted_moves(GameState* s, ScoredMove* out, int* count)
- * \brief Génère et trie les coups par priorité.
+ * \fn static void ia_generate_sorted_moves(SearchCtx* ctx, GameState* s, ScoredMove* out, int* count)
+ * \brief Génère et trie entièrement les coups de la racine.
  * 
+ * \param ctx Contexte de recherche.
  * \param s État du jeu.
  * \param out Tableau pour stocker les coups triés.
  * \param count Pointeur pour stocker le nombre de coups générés.
  */
-static void ia_generate_sorted_moves(GameState* s, ScoredMove* out, int* count) {
+static void ia_generate_sorted_moves(SearchCtx* ctx, GameState* s, ScoredMove* out, int* count) {
     Move tmp[300];
-    ia_generate_moves(s, tmp, count);
-    for (int i = 0; i < *count; ++i) {
-        out[i].mv = tmp[i];
-        out[i].prio = ia_move_priority(s, &tmp[i]);
-    }
+    *count = rules_legal_moves(s, tmp);
+    for (int i = 0; i < *count; ++i) out[i].mv = tmp[i];
+    ia_score_moves(ctx, s, out, *count, NULL, 0);
     qsort(out, *count, sizeof(ScoredMove), cmp_scored_move_desc);
 }
 
 /**
- * \fn static int ia_is_terminal(GameState* s)
- * \brief Vérifie si l’état du jeu est terminal (victoire/défaite).
- * 
- * \param s État du jeu.
- * \return 1 si terminal, 0 sinon.
+ * \fn static void ia_tt_move_first(const TTEntry* e, ScoredMove* moves, int n)
+ * \brief Place en tête de liste le meilleur coup mémorisé dans la table de transposition.
+ *
+ * Le coup est identifié par ses cases (l'ordre de `pieces[]` peut différer
+ * entre deux transpositions) ; les autres coups gardent leur ordre relatif.
+ *
+ * \param e Entrée de la table pour cette position.
+ * \param moves Coups triés.
+ * \param n Nombre de coups.
  */
-static int ia_is_terminal(GameState* s) {
-    // Roi atteint la base adverse
-    for (int i = 0; i < s->piece_count; ++i) {
-        Piece *p = &s->pieces[i];
-        if (p->type == 'K') {
-            if ((p->color == 'R' && p->row == 0 && p->col == 0) ||
-                (p->color == 'B' && p->row == 8 && p->col == 8)) return 1;
+static void ia_tt_move_first(const TTEntry* e, ScoredMove* moves, int n) {
+    if (e->from_sq > 80) return;
+    for (int i = 0; i < n; ++i) {
+        const Move* m = &moves[i].mv;
+        if (BB_SQ(m->from_row, m->from_col) == e->from_sq && BB_SQ(m->to_row, m->to_col) == e->to_sq) {
+            ScoredMove hit = moves[i];
+            memmove(&moves[1], &moves[0], (size_t)i * sizeof(ScoredMove));
+            moves[0] = hit;
+            return;
         }
     }
-    // Roi capturé
-    int r_king = 0, b_king = 0;
-    for (int i = 0; i < s->piece_count; ++i) if (s->pieces[i].type == 'K') {
-        if (s->pieces[i].color == 'R') r_king = 1; else b_king = 1;
-    }
-    return (r_king == 0 || b_king == 0);
 }
 
 /**
- * \fn static int ia_count_mobility(GameState* s, char color)
- * \brief Compte la mobilité (nombre de cases accessibles) pour une couleur.
+ * \fn static inline int ia_tt_bound_for(int bound, int is_max)
+ * \brief Convertit un type de borne entre le joueur au trait et le joueur maximisant.
+ *
+ * La table mémorise les scores du point de vue du joueur au trait, alors que
+ * la recherche les exprime pour le joueur maximisant : quand ce n'est pas lui
+ * qui joue, le score change de signe et les bornes s'échangent.
+ *
+ * \param bound Type de borne (tt_bound_t).
+ * \param is_max 1 si le joueur au trait est le joueur maximisant.
+ * \return Type de borne dans l'autre référentiel.
+ */
+static inline int ia_tt_bound_for(int bound, int is_max) {
+    if (is_max || bound == TT_EXACT) return bound;
+    return (bound == TT_LOWER) ? TT_UPPER : TT_LOWER;
+}
+
+/**
+ * \fn static int ia_is_terminal(const GameState* s)
+ * \brief Vérifie si l’état du jeu est terminal (victoire/défaite, auto-défaite comprise).
  * 
  * \param s État du jeu.
- * \param color Couleur ('R' ou 'B').
- * \return Nombre de cases accessibles.
+ * \return 1 si terminal, 0 sinon.
  */
-static int ia_count_mobility(GameState* s, char color) {
-    int mv = 0;
-    for (int i = 0; i < s->piece_count; ++i) {
-        if (s->pieces[i].color != color) continue;
-        int r = s->pieces[i].row, c = s->pieces[i].col;
-        for (int cc = c + 1; cc < 9; ++cc) { if (isCellFree(s, r, cc)) mv++; else break; }
-        for (int cc = c - 1; cc >= 0; --cc){ if (isCellFree(s, r, cc)) mv++; else break; }
-        for (int rr = r + 1; rr < 9; ++rr) { if (isCellFree(s, rr, c)) mv++; else break; }
-        for (int rr = r - 1; rr >= 0; --rr){ if (isCellFree(s, rr, c)) mv++; else break; }
-    }
-    return mv;
-}
+static int ia_is_terminal(const GameState* s) { return rules_winner(s, NULL) != 0; }
 
 /**
  * \fn static int ia_eval(GameState* s, char perspective)
@@ -798,38 +746,24 @@ static int ia_count_mobility(GameState* s, char color) {
  */
 static int ia_eval(GameState* s, char perspective) {
     int score = 0;
-    int r_kr = -1, r_kc = -1;
-    int b_kr = -1, b_kc = -1;
-    int red_pawns = 0, blue_pawns = 0;
-
-    for (int i = 0; i < s->piece_count; ++i) {
-        Piece *pc = &s->pieces[i];
-        if (pc->type == 'K') {
-            if (pc->color == 'R') { r_kr = pc->row; r_kc = pc->col; }
-            else { b_kr = pc->row; b_kc = pc->col; }
-        } else {
-            if (pc->color == 'R') red_pawns++; else blue_pawns++;
-        }
-    }
-    if (r_kr < 0) return (perspective == 'B') ? 30000 : -30000;
-    if (b_kr < 0) return (perspective == 'R') ? 30000 : -30000;
+    int r_ksq = s->king_sq[1], b_ksq = s->king_sq[0];
+    if (r_ksq < 0) return (perspective == 'B') ? 30000 : -30000;
+    if (b_ksq < 0) return (perspective == 'R') ? 30000 : -30000;
 
+    int r_kr = r_ksq / 9, r_kc = r_ksq % 9;
+    int b_kr = b_ksq / 9, b_kc = b_ksq % 9;
     // Matériel
-    score += (red_pawns - blue_pawns) * 100;
+    score += (s->pawn_count[1] - s->pawn_count[0]) * 100;
 
     // Objectifs des rois
     score += (18 - (abs_i(r_kr - 0) + abs_i(r_kc - 0))) * 8;
     score -= (18 - (abs_i(b_kr - 8) + abs_i(b_kc - 8))) * 8;
 
-    // Mobilité
-    score += (ia_count_mobility(s, 'R') - ia_count_mobility(s, 'B')) * 2;
-
-    // Contrôle de cases persistantes
-    for (int r = 0; r < 9; ++r)
-        for (int c = 0; c < 9; ++c) {
-            if (s->cell_control[r][c] == 2) score += 1;
-            else if (s->cell_control[r][c] == 1) score -= 1;
-        }
+    // Mobilité et contrôle de cases persistantes (plans tenus par rules_make_move)
+    EvalFeatures f;
+    eval_features(s, &f);
+    score += (f.mobility[1] - f.mobility[0]) * 2;
+    score += f.control[1] - f.control[0];
 
     return (perspective == 'R') ? score : -score;
 }
@@ -841,7 +775,7 @@ static int ia_eval(GameState* s, char perspective) {
  * \param jeu État du jeu.
  * \return 1 si le jeu est terminé, 0 sinon.
  */
-int isGameOver(GameState* jeu) { return ia_is_terminal(jeu); }
+int isGameOver(GameState* jeu) { rules_sync(jeu); return ia_is_terminal(jeu); }
 
 /**
  * \fn int evaluation(GameState* jeu, char evaluating_player)
@@ -851,65 +785,600 @@ int isGameOver(GameState* jeu) { return ia_is_terminal(jeu); }
  * \param evaluating_player Couleur de la perspective ('R' ou 'B').
  * \return Score (positif = avantage pour la couleur, négatif = désavantage).
  */
-int evaluation(GameState* jeu, char evaluating_player) { return ia_eval(jeu, evaluating_player); }
+int evaluation(GameState* jeu, char evaluating_player) { rules_sync(jeu); return ia_eval(jeu, evaluating_player); }
 
 /**
- * \fn static int minimaxIA(GameState* jeu, int profondeur, char maximizing_player, int alpha, int beta)
- * \brief Algorithme Minimax avec élagage alpha-bêta.
+ * \fn static int ia_win_score(const GameState* s, char maximizing_player, int* score)
+ * \brief Score d'une position gagnée (roi capturé, roi dans la cité adverse, auto-défaite).
+ *
+ * \param s État du jeu.
+ * \param maximizing_player Couleur du joueur maximisant.
+ * \param score Score extrême du point de vue de `maximizing_player` (retour).
+ * \return 1 si la position est terminale, 0 sinon.
+ */
+static int ia_win_score(const GameState* s, char maximizing_player, int* score) {
+    char winner = rules_winner(s, NULL);
+    if (!winner) return 0;
+    *score = (winner == maximizing_player) ? IA_WIN_SCORE : -IA_WIN_SCORE;
+    return 1;
+}
+
+/**
+ * \fn static int ia_tb_score(SearchCtx* ctx, const GameState* s, char maximizing_player, int* score)
+ * \brief Score d'une position gagnée ou perdue d'après la table de finales (tablebase.h).
+ *
+ * Le résultat n'est retenu que si sa distance tient dans les coups restants
+ * avant la limite de tours du contexte : au-delà, la partie se décide aux scores et la recherche
+ * continue normalement, comme pour une position nulle.
+ *
+ * \param ctx Contexte de recherche du thread.
+ * \param s État du jeu.
+ * \param maximizing_player Couleur du joueur maximisant.
+ * \param score IA_WIN_SCORE moins la distance, du point de vue de `maximizing_player` (retour).
+ * \return 1 si la table résout la position, 0 sinon.
+ */
+static int ia_tb_score(SearchCtx* ctx, const GameState* s, char maximizing_player, int* score) {
+    int dist;
+    TbResult r = tb_probe(s, &dist);
+    if (r != TB_WIN && r != TB_LOSS) return 0;
+    if (ctx->turn_limit > 0 && dist > ctx->turn_limit - s->turn_number) return 0;
+    ++ctx->tb_hits;
+    int v = IA_WIN_SCORE - dist;
+    *score = ((r == TB_WIN) == (s->current_player == maximizing_player)) ? v : -v;
+    return 1;
+}
+
+/**
+ * \fn static int ia_quiesce(SearchCtx* ctx, GameState* jeu, int qply, char maximizing_player, int alpha, int beta)
+ * \brief Recherche de quiescence : prolonge l'horizon tant que des captures sont en cours.
+ *
+ * Au lieu d'évaluer une position au milieu d'un échange Linca/Seltou, on ne
+ * considère plus que les coups qui capturent (ou amènent le roi dans la cité),
+ * repérés par ia_capture_value() comme dans l'ordonnancement, les plus gros
+ * gains d'abord. Le joueur au trait peut toujours s'arrêter là (stand-pat) :
+ * l'évaluation statique sert de borne et coupe dès qu'elle sort de la fenêtre.
+ * Rien n'est stocké dans la table de transposition.
+ *
+ * \param ctx Contexte de recherche du thread.
+ * \param jeu État du jeu (bitboards à jour).
+ * \param qply Distance à l'horizon.
+ * \param maximizing_player Couleur du joueur maximisant.
+ * \param alpha Valeur alpha.
+ * \param beta Valeur beta.
+ * \return Score évalué.
+ */
+static int ia_quiesce(SearchCtx* ctx, GameState* jeu, int qply, char maximizing_player, int alpha, int beta) {
+    if (ctx->aborted) return 0;
+    ++ctx->qnodes;
+    if ((++ctx->nodes & 1023) == 0 && ia_should_stop(ctx)) {
+        ctx->aborted = 1;
+        return 0;
+    }
+    int win;
+    if (ia_win_score(jeu, maximizing_player, &win)) return win;
+
+    // Stand-pat : le joueur au trait peut refuser l'échange
+    int is_max = (jeu->current_player == maximizing_player);
+    int best = ia_eval(jeu, maximizing_player);
+    if (qply >= IA_QS_MAX_PLY) return best;
+    if (is_max) { if (best >= beta) return best; if (best > alpha) alpha = best; }
+    else        { if (best <= alpha) return best; if (best < beta) beta = best; }
+
+    Move gen[300];
+    ScoredMove moves[300];
+    int n, k = 0;
+    n = rules_legal_moves(jeu, gen);
+    for (int i = 0; i < n; ++i) {
+        int gain = ia_capture_value(jeu, &gen[i]);
+        if (gain == 0) continue;
+        moves[k].mv = gen[i];
+        moves[k].prio = gain;
+        k++;
+    }
+
+    for (int i = 0; i < k; ++i) {
+        ia_pick_next(moves, k, i);
+        MoveUndo undo;
+        rules_make_move(jeu, &moves[i].mv, &undo);
+        int v = ia_quiesce(ctx, jeu, qply + 1, maximizing_player, alpha, beta);
+        rules_unmake_move(jeu, &undo);
+        if (ctx->aborted) return 0;
+
+        if (is_max) {
+            if (v > best) best = v;
+            if (v > alpha) alpha = v;
+        } else {
+            if (v < best) best = v;
+            if (v < beta) beta = v;
+        }
+        if (beta <= alpha) break;
+    }
+    return best;
+}
+
+/**
+ * \fn static void ia_make_null_move(GameState* s)
+ * \brief Passe la main sans jouer (coup nul) ; un second appel l'annule.
+ *
+ * \param s État du jeu.
+ */
+static void ia_make_null_move(GameState* s) {
+    s->current_player = (s->current_player == 'R') ? 'B' : 'R';
+    s->hash ^= zobrist_side;
+}
+
+static int ia_minimax(SearchCtx* ctx, GameState* jeu, int profondeur, int ply, char maximizing_player, int alpha, int beta);
+
+/**
+ * \fn static int ia_scout(SearchCtx* ctx, GameState* jeu, int profondeur, int ply, char maximizing_player, int parent_max, int alpha, int beta)
+ * \brief Recherche à fenêtre nulle sur la borne du nœud parent.
+ *
+ * Pour un parent maximisant, la fenêtre est (alpha, alpha + 1) : le résultat
+ * dit seulement si le coup dépasse alpha. Pour un parent minimisant, c'est
+ * (beta - 1, beta).
+ *
+ * \param ctx Contexte de recherche du thread.
+ * \param jeu État du jeu après le coup.
+ * \param profondeur Profondeur restante (éventuellement réduite).
+ * \param ply Distance à la racine.
+ * \param maximizing_player Couleur du joueur maximisant.
+ * \param parent_max 1 si le parent est un nœud maximisant.
+ * \param alpha Alpha du parent.
+ * \param beta Beta du parent.
+ * \return Score borné du coup.
+ */
+static int ia_scout(SearchCtx* ctx, GameState* jeu, int profondeur, int ply, char maximizing_player, int parent_max, int alpha, int beta) {
+    return parent_max ? ia_minimax(ctx, jeu, profondeur, ply, maximizing_player, alpha, alpha + 1)
+                      : ia_minimax(ctx, jeu, profondeur, ply, maximizing_player, beta - 1, beta);
+}
+
+/**
+ * \fn static int ia_minimax(SearchCtx* ctx, GameState* jeu, int profondeur, int ply, char maximizing_player, int alpha, int beta)
+ * \brief Algorithme Minimax avec élagage alpha-bêta (bitboards supposés à jour).
+ *
+ * À l'horizon (`profondeur == 0`), la recherche se prolonge par ia_quiesce().
+ * Au-dessus, le premier coup est cherché avec la fenêtre complète et les
+ * suivants à fenêtre nulle (PVS, re-recherche s'ils la dépassent) ; les coups
+ * calmes tardifs sont réduits d'un ou deux plies (LMR) et le coup nul coupe
+ * les positions où l'on peut se permettre de passer.
  * 
+ * \param ctx Contexte de recherche du thread.
  * \param jeu État du jeu.
  * \param profondeur Profondeur de recherche.
+ * \param ply Distance à la racine (coups tueurs, veto de sécurité).
  * \param maximizing_player Couleur du joueur maximisant ('R' ou 'B').
  * \param alpha Valeur alpha pour l'élagage.
  * \param beta Valeur beta pour l'élagage.
  * \return Score évalué.
  */
-int minimaxIA(GameState* jeu, int profondeur, char maximizing_player, int alpha, int beta) {
-    if (profondeur == 0 || ia_is_terminal(jeu)) {
-        // Donner un score extrême en cas de terminal (victoire/défaite immédiate)
-        // Détecter le vainqueur
-        int red_king = -1, blue_king = -1;
-        for (int i = 0; i < jeu->piece_count; ++i) if (jeu->pieces[i].type == 'K') {
-            if (jeu->pieces[i].color == 'R') red_king = i; else blue_king = i;
-        }
-        int red_wins = 0, blue_wins = 0;
-        if (red_king >= 0 && jeu->pieces[red_king].row == 0 && jeu->pieces[red_king].col == 0) red_wins = 1;
-        if (blue_king >= 0 && jeu->pieces[blue_king].row == 8 && jeu->pieces[blue_king].col == 8) blue_wins = 1;
-        if (red_king < 0) blue_wins = 1;
-        if (blue_king < 0) red_wins = 1;
-        if (red_wins || blue_wins) {
-            int winner = red_wins ? 'R' : 'B';
-            return (winner == maximizing_player) ? 30000000 : -30000000;
+static int ia_minimax(SearchCtx* ctx, GameState* jeu, int profondeur, int ply, char maximizing_player, int alpha, int beta) {
+    if (ctx->aborted) return 0;
+    if ((++ctx->nodes & 1023) == 0 && ia_should_stop(ctx)) {
+        ctx->aborted = 1;
+        return 0;
+    }
+    int win;
+    if (ia_win_score(jeu, maximizing_player, &win)) return win;
+    if (ia_tb_score(ctx, jeu, maximizing_player, &win)) return win;
+    // Position répétée (partie ou chemin) : le cycle laisse la position en l'état
+    if (ia_rep_count(&ctx->positions, jeu->hash)) return ia_eval(jeu, maximizing_player);
+    if (profondeur == 0) return ia_quiesce(ctx, jeu, 0, maximizing_player, alpha, beta);
+
+    int is_max = (jeu->current_player == maximizing_player);
+    int alpha0 = alpha, beta0 = beta;
+
+    // Table de transposition : coupure directe si l'entrée est assez profonde
+    TTEntry tte;
+    int have_tt = tt_probe(jeu->hash, &tte);
+    ++ctx->tt_probes;
+    ctx->tt_hits += have_tt;
+    if (have_tt && tte.depth >= profondeur) {
+        int v = is_max ? tte.score : -tte.score;
+        int bound = ia_tt_bound_for(tt_entry_bound(&tte), is_max);
+        if (bound == TT_EXACT) return v;
+        if (bound == TT_LOWER && v >= beta) return v;
+        if (bound == TT_UPPER && v <= alpha) return v;
+    }
+
+    // Roi menacé : ni coup nul ni réduction, la position n'est pas calme
+    int in_danger = profondeur >= IA_LMR_DEPTH && is_king_capturable_next_turn(jeu, jeu->current_player);
+
+    // Coup nul : si passer son tour suffit déjà à sortir de la fenêtre, un
+    // vrai coup fera au moins aussi bien. Les pièces glissantes rendent le
+    // zugzwang très rare ; on l'exclut quand il ne reste que le roi.
+    if (profondeur >= IA_NULL_DEPTH && !in_danger && ctx->null_ply != ply - 1 &&
+        jeu->pawn_count[color_idx(jeu->current_player)] > 0) {
+        int stand = ia_eval(jeu, maximizing_player);
+        if (is_max ? stand >= beta : stand <= alpha) {
+            int saved_null = ctx->null_ply;
+            ctx->null_ply = ply;
+            ia_make_null_move(jeu);
+            int v = is_max ? ia_minimax(ctx, jeu, profondeur - 1 - IA_NULL_R, ply + 1, maximizing_player, beta - 1, beta)
+                           : ia_minimax(ctx, jeu, profondeur - 1 - IA_NULL_R, ply + 1, maximizing_player, alpha, alpha + 1);
+            ia_make_null_move(jeu);
+            ctx->null_ply = saved_null;
+            if (ctx->aborted) return 0;
+            // Un gain forcé trouvé en passant n'est pas une preuve : borne seulement
+            if (is_max && v >= beta)  return (v >= IA_WIN_BOUND) ? beta : v;
+            if (!is_max && v <= alpha) return (v <= -IA_WIN_BOUND) ? alpha : v;
         }
-        return ia_eval(jeu, maximizing_player);
     }
+
+    Move gen[300];
     ScoredMove moves[300];
-    int n; ia_generate_sorted_moves(jeu, moves, &n);
+    int n = rules_legal_moves(jeu, gen);
     if (n == 0) return (jeu->current_player == maximizing_player) ? -20000 : 20000;
+    for (int i = 0; i < n; ++i) moves[i].mv = gen[i];
+    ia_score_moves(ctx, jeu, moves, n, have_tt ? &tte : NULL, ply);
 
-    int is_max = (jeu->current_player == maximizing_player);
-    int best = is_max ? -100000000 : 100000000;
+    int best = is_max ? -IA_INF : IA_INF;
+    int best_i = 0;
 
+    ia_rep_push(&ctx->positions, jeu->hash);
     for (int i = 0; i < n; ++i) {
-        GameState backup = *jeu;
-        ia_apply_move(jeu, &moves[i].mv);
-        jeu->current_player = (jeu->current_player == 'R') ? 'B' : 'R';
-
-        int v = minimaxIA(jeu, profondeur - 1, maximizing_player, alpha, beta);
-        *jeu = backup;
+        ia_pick_next(moves, n, i);
+        MoveUndo undo;
+        rules_make_move(jeu, &moves[i].mv, &undo);
+        int v;
+        if (i == 0) {
+            v = ia_minimax(ctx, jeu, profondeur - 1, ply + 1, maximizing_player, alpha, beta);
+        } else {
+            // PVS : les coups suivants n'ont qu'à prouver qu'ils ne battent pas le
+            // premier (fenêtre nulle) ; les coups calmes de fin de liste, réduits.
+            int r = 0;
+            if (profondeur >= IA_LMR_DEPTH && i >= IA_LMR_MOVES && !in_danger && moves[i].prio < PICK_KILLER)
+                r = (i >= 4 * IA_LMR_MOVES && profondeur > IA_LMR_DEPTH) ? 2 : 1;
+            v = ia_scout(ctx, jeu, profondeur - 1 - r, ply + 1, maximizing_player, is_max, alpha, beta);
+            if (r && !ctx->aborted && (is_max ? v > alpha : v < beta))
+                v = ia_scout(ctx, jeu, profondeur - 1, ply + 1, maximizing_player, is_max, alpha, beta);
+            if (!ctx->aborted && v > alpha && v < beta && beta - alpha > 1)
+                v = ia_minimax(ctx, jeu, profondeur - 1, ply + 1, maximizing_player, alpha, beta);
+        }
+        rules_unmake_move(jeu, &undo);
+        if (ctx->aborted) break;
 
         if (is_max) {
-            if (v > best) best = v;
+            if (v > best) { best = v; best_i = i; }
             if (v > alpha) alpha = v;
         } else {
-            if (v < best) best = v;
+            if (v < best) { best = v; best_i = i; }
             if (v < beta) beta = v;
         }
-        if (beta <= alpha) break;
+        if (beta <= alpha) {
+            ++ctx->cutoffs;
+            ctx->first_cutoffs += (i == 0);
+            ia_record_cutoff(ctx, jeu, &moves[i].mv, profondeur, ply);
+            break;
+        }
     }
+    ia_rep_pop(&ctx->positions);
+    if (ctx->aborted) return 0; // résultat partiel : ne rien mémoriser
+
+    // Mémoriser le résultat, du point de vue du joueur au trait
+    int bound = (best <= alpha0) ? TT_UPPER : (best >= beta0) ? TT_LOWER : TT_EXACT;
+    const Move* bm = &moves[best_i].mv;
+    tt_store(jeu->hash, profondeur, ia_tt_bound_for(bound, is_max), is_max ? best : -best,
+             BB_SQ(bm->from_row, bm->from_col), BB_SQ(bm->to_row, bm->to_col));
     return best;
 }
 
+/**
+ * \fn int minimaxIA(GameState* jeu, int profondeur, char maximizing_player, int alpha, int beta)
+ * \brief Algorithme Minimax avec élagage alpha-bêta.
+ * 
+ * \param jeu État du jeu.
+ * \param profondeur Profondeur de recherche.
+ * \param maximizing_player Couleur du joueur maximisant ('R' ou 'B').
+ * \param alpha Valeur alpha pour l'élagage.
+ * \param beta Valeur beta pour l'élagage.
+ * \return Score évalué.
+ */
+int minimaxIA(GameState* jeu, int profondeur, char maximizing_player, int alpha, int beta) {
+    SearchCtx ctx;
+    rules_sync(jeu);
+    tt_new_search();
+    ia_ctx_init(&ctx, jeu, 0, NULL, NULL, max_turn);
+    return ia_minimax(&ctx, jeu, profondeur, 0, maximizing_player, alpha, beta);
+}
+
+/**
+ * \fn static int ia_search_root(SearchCtx* ctx, GameState* jeu, ScoredMove* moves, int n, int profondeur, int alpha, int beta, Move* best_move)
+ * \brief Recherche à la racine sur une liste de coups déjà ordonnée.
+ *
+ * Les coups qui ramèneraient une troisième fois une position de la partie
+ * sont ignorés, sauf s'il n'y en a pas d'autres. Le premier coup
+ * est cherché dans la fenêtre (alpha, beta), les autres à fenêtre nulle puis
+ * re-cherchés s'ils la dépassent (PVS). Un score hors de la fenêtre
+ * initiale n'est qu'une borne.
+ *
+ * \param ctx Contexte de recherche du thread.
+ * \param jeu État du jeu (bitboards à jour).
+ * \param moves Coups de la racine, dans l'ordre d'exploration.
+ * \param n Nombre de coups.
+ * \param profondeur Profondeur de recherche.
+ * \param alpha Borne basse de la fenêtre.
+ * \param beta Borne haute de la fenêtre.
+ * \param best_move Meilleur coup trouvé (piece_index = -1 si aucun).
+ * \return Score du meilleur coup pour le joueur au trait.
+ */
+static int ia_search_root(SearchCtx* ctx, GameState* jeu, ScoredMove* moves, int n, int profondeur, int alpha, int beta, Move* best_move) {
+    int best_val = -IA_INF;
+    int searched = 0;
+    char maximizing = jeu->current_player;
+    best_move->piece_index = -1;
+
+    ia_rep_push(&ctx->positions, jeu->hash);
+    // Second passage seulement si tous les coups recréaient une boucle
+    for (int pass = 0; pass < 2 && searched == 0 && !ctx->aborted; ++pass) {
+        for (int i = 0; i < n; ++i) {
+            MoveUndo undo;
+            rules_make_move(jeu, &moves[i].mv, &undo);
+            // Anti-boucle : ne pas revenir une troisième fois sur une position
+            if (pass == 0 && ia_rep_count(&ctx->positions, jeu->hash) >= 2) {
+                rules_unmake_move(jeu, &undo);
+                continue;
+            }
+            int v;
+            if (searched++ == 0) {
+                v = ia_minimax(ctx, jeu, profondeur - 1, 1, maximizing, alpha, beta);
+            } else {
+                v = ia_minimax(ctx, jeu, profondeur - 1, 1, maximizing, alpha, alpha + 1);
+                if (!ctx->aborted && v > alpha && v < beta)
+                    v = ia_minimax(ctx, jeu, profondeur - 1, 1, maximizing, alpha, beta);
+            }
+            rules_unmake_move(jeu, &undo);
+            if (ctx->aborted) break;
+
+            if (v > best_val) {
+                best_val = v;
+                *best_move = moves[i].mv;
+            }
+            if (v > alpha) alpha = v;
+            if (beta <= alpha) break;
+        }
+    }
+    ia_rep_pop(&ctx->positions);
+    return best_val;
+}
+
+/**
+ * @brief Thread auxiliaire de la recherche parallèle (Lazy SMP)
+ */
+typedef struct {
+    pthread_t thread;   /**< Thread système */
+    GameState state;    /**< Copie privée de la position */
+    SearchCtx ctx;      /**< Heuristiques et compteurs propres au thread */
+    int start_depth;    /**< Première profondeur de l'approfondissement */
+    int max_depth;      /**< Dernière profondeur */
+    int started;        /**< 1 si pthread_create() a réussi */
+} SmpWorker;
+
+/**
+ * @brief Ensemble des threads auxiliaires d'une recherche
+ */
+typedef struct {
+    SmpWorker* workers[IA_MAX_THREADS]; /**< Threads auxiliaires */
+    int count;                          /**< Nombre de threads auxiliaires */
+    int stop;                           /**< Drapeau d'arrêt (accès atomiques) */
+} SmpPool;
+
+/**
+ * \fn static void* ia_smp_worker(void* arg)
+ * \brief Corps d'un thread auxiliaire : approfondissement itératif sans résultat.
+ *
+ * Le thread ne rend aucun coup : il remplit la table de transposition
+ * partagée, dont le thread principal profite (coupures, ordre des coups).
+ *
+ * \param arg Thread auxiliaire (SmpWorker*).
+ * \return NULL.
+ */
+static void* ia_smp_worker(void* arg) {
+    SmpWorker* w = arg;
+    ScoredMove moves[300];
+    int n; ia_generate_sorted_moves(&w->ctx, &w->state, moves, &n);
+    TTEntry tte;
+
+    for (int depth = w->start_depth; depth <= w->max_depth && !w->ctx.aborted; ++depth) {
+        if (tt_probe(w->state.hash, &tte)) ia_tt_move_first(&tte, moves, n);
+        Move iter;
+        int v = ia_search_root(&w->ctx, &w->state, moves, n, depth, -IA_INF, IA_INF, &iter);
+        if (v >= IA_WIN_BOUND || v <= -IA_WIN_BOUND) break;
+    }
+    return NULL;
+}
+
+/**
+ * \fn static void ia_smp_start(SmpPool* pool, const GameState* jeu, int max_depth, long long deadline_us, const SearchCtx* root)
+ * \brief Lance ia_thread_count - 1 threads auxiliaires sur la position.
+ *
+ * Les threads impairs commencent une profondeur plus loin, pour que les
+ * threads ne parcourent pas tous le même arbre au même moment.
+ *
+ * \param pool Ensemble de threads à remplir.
+ * \param jeu Position de la racine (bitboards à jour).
+ * \param max_depth Profondeur maximale.
+ * \param deadline_us Échéance (0 = jusqu'à ia_smp_stop()).
+ * \param root Contexte du thread principal : positions de la partie et limite de tours.
+ */
+static void ia_smp_start(SmpPool* pool, const GameState* jeu, int max_depth, long long deadline_us, const SearchCtx* root) {
+    pool->count = 0;
+    pool->stop = 0;
+    for (int i = 1; i < ia_thread_count; ++i) {
+        SmpWorker* w = malloc(sizeof(SmpWorker));
+        if (!w) break;
+        w->state = *jeu;
+        ia_ctx_init(&w->ctx, jeu, deadline_us, &pool->stop, &root->positions, root->turn_limit);
+        w->start_depth = 1 + (i & 1);
+        w->max_depth = max_depth;
+        w->started = (pthread_create(&w->thread, NULL, ia_smp_worker, w) == 0);
+        pool->workers[pool->count++] = w;
+    }
+}
+
+/**
+ * \fn static void ia_smp_stop(SmpPool* pool)
+ * \brief Arrête et attend les threads auxiliaires, puis les libère.
+ *
+ * \param pool Ensemble de threads lancé par ia_smp_start().
+ */
+static void ia_smp_stop(SmpPool* pool) {
+    __atomic_store_n(&pool->stop, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < pool->count; ++i) {
+        if (pool->workers[i]->started) pthread_join(pool->workers[i]->thread, NULL);
+        free(pool->workers[i]);
+    }
+    pool->count = 0;
+}
+
+/**
+ * \fn static int ia_tt_reply(GameState* jeu, Move* reply)
+ * \brief Coup de la table de transposition pour la position, s'il est légal.
+ *
+ * \param jeu État du jeu (bitboards à jour).
+ * \param reply Coup trouvé (retour).
+ * \return 1 si la table propose un coup légal, 0 sinon.
+ */
+static int ia_tt_reply(GameState* jeu, Move* reply) {
+    TTEntry tte;
+    if (ia_is_terminal(jeu) || !tt_probe(jeu->hash, &tte) || tte.from_sq > 80) return 0;
+
+    Move moves[300];
+    int n = rules_legal_moves(jeu, moves);
+    for (int i = 0; i < n; ++i) {
+        if (BB_SQ(moves[i].from_row, moves[i].from_col) == tte.from_sq &&
+            BB_SQ(moves[i].to_row, moves[i].to_col) == tte.to_sq) {
+            *reply = moves[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \fn static int ia_walk_pv(GameState* jeu, const Move* first, int depth, Move* pv)
+ * \brief Variante d'un coup : le coup puis les coups de la table de transposition.
+ *
+ * \param jeu Position de départ (restaurée au retour).
+ * \param first Premier coup (piece_index = -1 si aucun).
+ * \param depth Profondeur cherchée : la variante n'est pas plus longue.
+ * \param pv Variante (retour, au plus IA_MAX_PV coups).
+ * \return Nombre de coups de la variante.
+ */
+static int ia_walk_pv(GameState* jeu, const Move* first, int depth, Move* pv) {
+    MoveUndo undo[IA_MAX_PV];
+    Move mv = *first;
+    int len = 0;
+    while (len < IA_MAX_PV && len < depth && mv.piece_index >= 0) {
+        pv[len] = mv;
+        rules_make_move(jeu, &mv, &undo[len++]);
+        if (!ia_tt_reply(jeu, &mv)) break;
+    }
+    for (int i = len - 1; i >= 0; --i) rules_unmake_move(jeu, &undo[i]);
+    return len;
+}
+
+/**
+ * \fn static void ia_publish_stats(const SearchCtx* ctx, GameState* jeu, const Move* best, int depth, int score, long long start_us)
+ * \brief Enregistre les statistiques d'une recherche terminée (voir ia_get_search_stats()).
+ *
+ * La variante principale part du coup rendu puis suit les coups de la table
+ * de transposition, tant qu'ils sont légaux et au plus IA_MAX_PV coups.
+ *
+ * \param ctx Contexte du thread principal.
+ * \param jeu Position cherchée (restaurée au retour).
+ * \param best Coup rendu (piece_index = -1 si aucun).
+ * \param depth Dernière profondeur terminée.
+ * \param score Score du coup rendu pour le joueur au trait.
+ * \param start_us Début de la recherche (ia_now_us()).
+ */
+static void ia_publish_stats(const SearchCtx* ctx, GameState* jeu, const Move* best, int depth, int score, long long start_us) {
+    IaSearchStats st = {
+        .nodes = ctx->nodes, .qnodes = ctx->qnodes,
+        .cutoffs = ctx->cutoffs, .first_cutoffs = ctx->first_cutoffs,
+        .tt_probes = ctx->tt_probes, .tt_hits = ctx->tt_hits,
+        .tb_hits = ctx->tb_hits,
+        .depth = depth, .score = score,
+        .elapsed_us = ia_now_us() - start_us,
+        .threads = ia_thread_count,
+    };
+
+    st.pv_length = ia_walk_pv(jeu, best, depth, st.pv);
+
+    pthread_mutex_lock(&stats_lock);
+    ia_last_stats = st;
+    pthread_mutex_unlock(&stats_lock);
+}
+
+/**
+ * \fn static int ia_book_move(const GameState* jeu, Move* best_move, long long start_us, uint64_t* book_rng)
+ * \brief Coup du livre d'ouverture (book.h), joué sans recherche.
+ *
+ * Les statistiques publiées n'ont alors ni nœud ni profondeur : seul le coup
+ * figure dans la variante.
+ *
+ * \param jeu État du jeu (synchronisé).
+ * \param best_move Coup du livre (retour).
+ * \param start_us Début de la recherche (ia_now_us()).
+ * \param book_rng État du tirage du livre (NULL : celui de l'interface).
+ * \return 1 si la position est dans le livre, 0 sinon.
+ */
+static int ia_book_move(const GameState* jeu, Move* best_move, long long start_us, uint64_t* book_rng) {
+    int found;
+    if (book_rng) {
+        found = book_probe(jeu, book_rng, best_move);
+    } else {
+        pthread_mutex_lock(&gui_book_lock);
+        found = book_probe(jeu, &ia_gui_book_rng, best_move);
+        pthread_mutex_unlock(&gui_book_lock);
+    }
+    if (!found) return 0;
+    IaSearchStats st = {
+        .elapsed_us = ia_now_us() - start_us,
+        .threads = ia_thread_count,
+        .book = 1,
+        .pv_length = 1,
+        .pv = { *best_move },
+    };
+    pthread_mutex_lock(&stats_lock);
+    ia_last_stats = st;
+    pthread_mutex_unlock(&stats_lock);
+    return 1;
+}
+
+/**
+ * \fn static void ia_depth_search(GameState* jeu, Move* best_move, int profondeur, const IaHistory* history, uint64_t* book_rng, int turn_limit)
+ * \brief Recherche à profondeur fixe commune à trouverMeilleurCoupIA() et ia_search_game().
+ *
+ * \param jeu État du jeu.
+ * \param best_move Pointeur pour stocker le meilleur coup trouvé.
+ * \param profondeur Profondeur de recherche.
+ * \param history Positions de la partie (NULL : celles de l'interface).
+ * \param book_rng État du tirage du livre (NULL : celui de l'interface).
+ * \param turn_limit Limite de tours de la partie (0 = aucune).
+ */
+static void ia_depth_search(GameState* jeu, Move* best_move, int profondeur, const IaHistory* history, uint64_t* book_rng,
+                            int turn_limit) {
+    SearchCtx ctx;
+    SmpPool pool;
+    long long start = ia_now_us();
+    rules_sync(jeu);
+    if (ia_book_move(jeu, best_move, start, book_rng)) return;
+    tt_new_search();
+    ia_ctx_init(&ctx, jeu, 0, NULL, history, turn_limit);
+    ScoredMove moves[300];
+    int n; ia_generate_sorted_moves(&ctx, jeu, moves, &n);
+    best_move->piece_index = -1;
+    if (n == 0) return;
+
+    ia_smp_start(&pool, jeu, profondeur, 0, &ctx);
+    TTEntry tte;
+    if (tt_probe(jeu->hash, &tte)) ia_tt_move_first(&tte, moves, n);
+
+    int v = ia_search_root(&ctx, jeu, moves, n, profondeur, -IA_INF, IA_INF, best_move);
+    ia_smp_stop(&pool);
+    ia_publish_stats(&ctx, jeu, best_move, profondeur, v, start);
+}
+
 /**
  * \fn void trouverMeilleurCoupIA(GameState* jeu, Move* best_move, int profondeur)
  * \brief Trouve le meilleur coup pour l’IA en utilisant Minimax.
@@ -919,63 +1388,414 @@ int minimaxIA(GameState* jeu, int profondeur, char maximizing_player, int alpha,
  * \param profondeur Profondeur de recherche.
  */
 void trouverMeilleurCoupIA(GameState* jeu, Move* best_move, int profondeur) {
+    ia_depth_search(jeu, best_move, profondeur, NULL, NULL, max_turn);
+}
+
+/**
+ * \fn void trouverMeilleurCoupIA_Temps(GameState* jeu, Move* best_move, int budget_ms)
+ * \brief Approfondissement itératif limité par un temps de réflexion.
+ *
+ * Les profondeurs 1, 2, 3... sont cherchées tant que le budget le permet.
+ * Le meilleur coup de l'itération précédente est exploré en premier. Une
+ * itération interrompue par l'échéance est abandonnée : le coup rendu est
+ * celui de la dernière profondeur terminée (la profondeur 1 l'est toujours).
+ * Avec plusieurs threads (ia_set_threads()), les threads auxiliaires
+ * cherchent la même position en parallèle jusqu'à la fin de la réflexion.
+ *
+ * \param jeu État du jeu.
+ * \param best_move Pointeur pour stocker le meilleur coup trouvé.
+ * \param budget_ms Temps de réflexion en millisecondes.
+ */
+void trouverMeilleurCoupIA_Temps(GameState* jeu, Move* best_move, int budget_ms) {
+    trouverMeilleurCoupIA_Annulable(jeu, best_move, budget_ms, NULL);
+}
+
+/**
+ * \fn static void ia_iterative_search(GameState* jeu, Move* best_move, long long budget_us, const int* stop, const IaHistory* history, uint64_t* book_rng, int turn_limit)
+ * \brief Approfondissement itératif commun aux recherches limitées en temps et à la réflexion anticipée.
+ *
+ * \param jeu État du jeu.
+ * \param best_move Meilleur coup de la dernière profondeur terminée.
+ * \param budget_us Budget en microsecondes (0 = jusqu'à `*stop` ou IA_MAX_DEPTH).
+ * \param stop Drapeau d'annulation (NULL si aucun).
+ * \param history Positions de la partie (NULL : celles de l'interface).
+ * \param book_rng État du tirage du livre (NULL : celui de l'interface).
+ * \param turn_limit Limite de tours de la partie (0 = aucune).
+ */
+static void ia_iterative_search(GameState* jeu, Move* best_move, long long budget_us, const int* stop, const IaHistory* history,
+                                uint64_t* book_rng, int turn_limit) {
+    long long start = ia_now_us();
+    long long deadline = budget_us ? start + budget_us : 0;
+    SearchCtx ctx;
+    SmpPool pool;
+
+    rules_sync(jeu);
+    // Réflexion anticipée (budget nul) : aucun coup à rendre, le livre ne sert pas
+    if (budget_us && ia_book_move(jeu, best_move, start, book_rng)) return;
+    tt_new_search();
+    ia_ctx_init(&ctx, jeu, 0, stop, history, turn_limit);
     ScoredMove moves[300];
-    int n; ia_generate_sorted_moves(jeu, moves, &n);
+    int n; ia_generate_sorted_moves(&ctx, jeu, moves, &n);
     best_move->piece_index = -1;
     if (n == 0) return;
 
-    int alpha = -100000000, beta = 100000000;
-    int best_val = -100000000;
-    char maximizing = jeu->current_player;
+    ia_smp_start(&pool, jeu, IA_MAX_DEPTH, deadline, &ctx);
+    TTEntry tte;
+    if (tt_probe(jeu->hash, &tte)) ia_tt_move_first(&tte, moves, n);
+
+    Move best = { .piece_index = -1 };
+    int prev = 0, done_depth = 0;
+    for (int depth = 1; depth <= IA_MAX_DEPTH; ++depth) {
+        // Coup de l'itération précédente en tête
+        for (int i = 1; best.piece_index >= 0 && i < n; ++i) {
+            if (memcmp(&moves[i].mv, &best, sizeof(Move)) == 0) {
+                ScoredMove hit = moves[i];
+                memmove(&moves[1], &moves[0], (size_t)i * sizeof(ScoredMove));
+                moves[0] = hit;
+                break;
+            }
+        }
 
-    for (int i = 0; i < n; ++i) {
-        // VÉRIFICATION ANTI-BOUCLE dans le minimax aussi !
-        if (is_loop_detected(&moves[i].mv)) {
-            continue; // Ignorer complètement ce coup
+        ctx.deadline_us = (depth == 1) ? 0 : deadline;
+        Move iter;
+        int v;
+        if (depth < 3 || prev >= IA_WIN_BOUND || prev <= -IA_WIN_BOUND) {
+            v = ia_search_root(&ctx, jeu, moves, n, depth, -IA_INF, IA_INF, &iter);
+        } else {
+            // Fenêtre d'aspiration autour du score précédent, élargie à chaque échec
+            int delta = IA_ASPIRATION;
+            int alpha = prev - delta, beta = prev + delta;
+            for (;;) {
+                v = ia_search_root(&ctx, jeu, moves, n, depth, alpha, beta, &iter);
+                if (ctx.aborted) break;
+                if (v <= alpha && alpha > -IA_INF)    alpha = (delta >= IA_INF / 4) ? -IA_INF : v - delta;
+                else if (v >= beta && beta < IA_INF) beta = (delta >= IA_INF / 4) ? IA_INF : v + delta;
+                else break;
+                delta *= 4;
+            }
         }
+        if (ctx.aborted || iter.piece_index < 0) break;
+        best = iter;
+        prev = v;
+        done_depth = depth;
+
+        // Gain ou perte forcé : inutile de chercher plus loin
+        if (v >= IA_WIN_BOUND || v <= -IA_WIN_BOUND) break;
+        // L'itération suivante coûte bien plus que toutes les précédentes
+        if (budget_us && (ia_now_us() - start) * 2 > budget_us) break;
+    }
+    ia_smp_stop(&pool);
+    ia_publish_stats(&ctx, jeu, &best, done_depth, prev, start);
+
+    if (stop && __atomic_load_n(stop, __ATOMIC_RELAXED)) best.piece_index = -1;
+    *best_move = best;
+}
+
+/**
+ * \fn void trouverMeilleurCoupIA_Annulable(GameState* jeu, Move* best_move, int budget_ms, const int* stop)
+ * \brief trouverMeilleurCoupIA_Temps() interruptible depuis un autre thread.
+ *
+ * Dès que `*stop` devient non nul, la recherche s'arrête au plus vite, ne rend
+ * aucun coup.
+ *
+ * \param jeu État du jeu.
+ * \param best_move Pointeur pour stocker le meilleur coup trouvé.
+ * \param budget_ms Temps de réflexion en millisecondes.
+ * \param stop Drapeau d'annulation (lu atomiquement, NULL si aucun).
+ */
+void trouverMeilleurCoupIA_Annulable(GameState* jeu, Move* best_move, int budget_ms, const int* stop) {
+    long long budget_us = (long long)(budget_ms > 0 ? budget_ms : 1) * 1000LL;
+    ia_iterative_search(jeu, best_move, budget_us, stop, NULL, NULL, max_turn);
+}
+
+/**
+ * \fn void ia_search_game(GameState* jeu, Move* best_move, int profondeur, int budget_ms, const int* stop, const IaHistory* history, uint64_t* book_rng, int turn_limit)
+ * \brief Recherche d'un coup d'une partie qui tient son propre historique des positions.
+ *
+ * \param jeu État du jeu.
+ * \param best_move Pointeur pour stocker le meilleur coup trouvé.
+ * \param profondeur Profondeur fixe (> 0), sinon approfondissement itératif sur `budget_ms`.
+ * \param budget_ms Temps de réflexion en millisecondes (si `profondeur` <= 0).
+ * \param stop Drapeau d'annulation (lu atomiquement, NULL si aucun).
+ * \param history Positions de la partie.
+ * \param book_rng État du tirage du livre de la partie (NULL : celui de l'interface).
+ * \param turn_limit Limite de tours de la partie (0 = aucune).
+ */
+void ia_search_game(GameState* jeu, Move* best_move, int profondeur, int budget_ms, const int* stop, const IaHistory* history,
+                    uint64_t* book_rng, int turn_limit) {
+    if (profondeur > 0) {
+        ia_depth_search(jeu, best_move, profondeur, history, book_rng, turn_limit);
+        return;
+    }
+    long long budget_us = (long long)(budget_ms > 0 ? budget_ms : 1) * 1000LL;
+    ia_iterative_search(jeu, best_move, budget_us, stop, history, book_rng, turn_limit);
+}
 
-        GameState backup = *jeu;
-        ia_apply_move(jeu, &moves[i].mv);
-        jeu->current_player = (jeu->current_player == 'R') ? 'B' : 'R';
-        int v = minimaxIA(jeu, profondeur - 1, maximizing, alpha, beta);
-        *jeu = backup;
+/**
+ * \fn void ia_ponder(GameState* jeu, const int* stop)
+ * \brief Réflexion anticipée : approfondit la position jusqu'à annulation.
+ *
+ * Aucun coup n'est rendu ni ajouté à l'historique : seul compte le contenu
+ * laissé dans la table de transposition, que la prochaine recherche réutilise.
+ *
+ * \param jeu État du jeu.
+ * \param stop Drapeau d'arrêt (lu atomiquement).
+ */
+void ia_ponder(GameState* jeu, const int* stop) {
+    Move unused;
+    ia_iterative_search(jeu, &unused, 0, stop, NULL, NULL, max_turn);
+}
 
-        if (v > best_val) {
-            best_val = v;
-            *best_move = moves[i].mv;
+/**
+ * \fn void ia_analyse(GameState* jeu, int multipv, int max_depth, const int* stop, ia_analysis_cb cb, void* user_data)
+ * \brief Analyse multi-PV : les meilleurs coups de la racine à chaque profondeur.
+ *
+ * À chaque profondeur, la ligne k est la meilleure des coups non encore
+ * classés (recherche à fenêtre pleine sur moves[k..n-1]) ; son coup passe
+ * alors au rang k. Les lignes sont retriées par score une fois toutes
+ * cherchées, les coups de tête avec elles : l'itération suivante commence
+ * par les lignes dans l'ordre de la précédente, et la table de transposition
+ * (non vidée d'une position à l'autre) fournit les coups des positions déjà
+ * vues.
+ * L'analyse s'arrête sur `*stop`, à `max_depth` ou quand toutes les lignes
+ * sont des gains ou pertes forcés.
+ *
+ * \param jeu État du jeu.
+ * \param multipv Nombre de lignes.
+ * \param max_depth Profondeur maximale (<= 0 : IA_MAX_DEPTH).
+ * \param stop Drapeau d'arrêt (lu atomiquement, NULL si aucun).
+ * \param cb Callback de chaque profondeur terminée.
+ * \param user_data Donnée du callback.
+ */
+void ia_analyse(GameState* jeu, int multipv, int max_depth, const int* stop, ia_analysis_cb cb, void* user_data) {
+    long long start = ia_now_us();
+    SearchCtx ctx;
+    if (multipv < 1) multipv = 1;
+    if (multipv > IA_MAX_MULTIPV) multipv = IA_MAX_MULTIPV;
+    if (max_depth <= 0 || max_depth > IA_MAX_DEPTH) max_depth = IA_MAX_DEPTH;
+
+    rules_sync(jeu);
+    if (ia_is_terminal(jeu)) return;
+    tt_new_search();
+    ia_ctx_init(&ctx, jeu, 0, stop, NULL, max_turn);
+    ScoredMove moves[300];
+    int n; ia_generate_sorted_moves(&ctx, jeu, moves, &n);
+    if (n == 0) return;
+    TTEntry tte;
+    if (tt_probe(jeu->hash, &tte)) ia_tt_move_first(&tte, moves, n);
+    int lines = (multipv < n) ? multipv : n;
+
+    for (int depth = 1; depth <= max_depth; ++depth) {
+        IaAnalysis an = { .hash = jeu->hash, .depth = depth };
+        int forced = 0;
+        for (int k = 0; k < lines; ++k) {
+            Move iter;
+            int v = ia_search_root(&ctx, jeu, moves + k, n - k, depth, -IA_INF, IA_INF, &iter);
+            if (ctx.aborted || iter.piece_index < 0) break;
+            for (int i = k + 1; i < n; ++i) {
+                if (memcmp(&moves[i].mv, &iter, sizeof(Move)) == 0) {
+                    ScoredMove hit = moves[i];
+                    memmove(&moves[k + 1], &moves[k], (size_t)(i - k) * sizeof(ScoredMove));
+                    moves[k] = hit;
+                    break;
+                }
+            }
+            IaAnalysisLine* line = &an.lines[an.count++];
+            line->score = v;
+            line->forced = (v >= IA_WIN_BOUND) ? 1 : (v <= -IA_WIN_BOUND) ? -1 : 0;
+            line->pv_length = ia_walk_pv(jeu, &iter, depth, line->pv);
+            forced += (line->forced != 0);
         }
-        if (v > alpha) alpha = v;
-        if (beta <= alpha) break;
+        if (ctx.aborted || ia_should_stop(&ctx)) break;
+        // Recherches successives : une ligne peut dépasser la précédente (réductions, table)
+        for (int k = 1; k < an.count; ++k) {
+            for (int j = k; j > 0 && an.lines[j].score > an.lines[j - 1].score; --j) {
+                IaAnalysisLine tl = an.lines[j]; an.lines[j] = an.lines[j - 1]; an.lines[j - 1] = tl;
+                ScoredMove tm = moves[j]; moves[j] = moves[j - 1]; moves[j - 1] = tm;
+            }
+        }
+        an.nodes = ctx.nodes;
+        an.elapsed_us = ia_now_us() - start;
+        if (cb) cb(&an, user_data);
+        if (forced == an.count) break;
     }
+}
 
-    // Ajouter le meilleur coup à l'historique pour la détection de répétitions
-    if (best_move->piece_index >= 0) {
-        add_move_to_history(best_move);
+/**
+ * \fn int ia_predict_reply(GameState* jeu, Move* reply)
+ * \brief Coup attendu du joueur au trait, d'après la table de transposition.
+ *
+ * \param jeu État du jeu.
+ * \param reply Coup prévu (retour).
+ * \return 1 si la table propose un coup légal, 0 sinon.
+ */
+int ia_predict_reply(GameState* jeu, Move* reply) {
+    rules_sync(jeu);
+    return ia_tt_reply(jeu, reply);
+}
+
+/**
+ * \fn void trouverMeilleurCoupIA_Adaptatif(GameState* jeu, Move* best_move)
+ * \brief Meilleur coup dans le budget de temps configuré (ia_set_time_budget()).
+ *
+ * \param jeu État du jeu.
+ * \param best_move Pointeur pour stocker le meilleur coup trouvé.
+ */
+void trouverMeilleurCoupIA_Adaptatif(GameState* jeu, Move* best_move) {
+    trouverMeilleurCoupIA_Temps(jeu, best_move, ia_time_budget_ms);
+}
+
+/**
+ * \fn void trouverMeilleurCoupIA_Rapide(GameState* jeu, Move* best_move)
+ * \brief Meilleur coup en temps réduit (au plus IA_RAPIDE_TIME_MS).
+ *
+ * \param jeu État du jeu.
+ * \param best_move Pointeur pour stocker le meilleur coup trouvé.
+ */
+void trouverMeilleurCoupIA_Rapide(GameState* jeu, Move* best_move) {
+    int ms = ia_time_budget_ms < IA_RAPIDE_TIME_MS ? ia_time_budget_ms : IA_RAPIDE_TIME_MS;
+    trouverMeilleurCoupIA_Temps(jeu, best_move, ms);
+}
+
+/**
+ * \fn void ia_set_time_budget(int ms)
+ * \brief Règle le temps de réflexion par coup de trouverMeilleurCoupIA_Adaptatif().
+ *
+ * \param ms Temps en millisecondes (valeurs <= 0 : IA_DEFAULT_TIME_MS).
+ */
+void ia_set_time_budget(int ms) {
+    ia_time_budget_ms = (ms > 0) ? ms : IA_DEFAULT_TIME_MS;
+}
+
+/**
+ * \fn int ia_get_time_budget(void)
+ * \brief Temps de réflexion par coup courant.
+ *
+ * \return Temps en millisecondes.
+ */
+int ia_get_time_budget(void) {
+    return ia_time_budget_ms;
+}
+
+/**
+ * \fn void ia_set_threads(int n)
+ * \brief Règle le nombre de threads de recherche (Lazy SMP).
+ *
+ * \param n Nombre de threads, borné à [1, IA_MAX_THREADS].
+ */
+void ia_set_threads(int n) {
+    if (n < 1) n = 1;
+    if (n > IA_MAX_THREADS) n = IA_MAX_THREADS;
+    ia_thread_count = n;
+}
+
+/**
+ * \fn int ia_get_threads(void)
+ * \brief Nombre de threads de recherche courant.
+ *
+ * \return Nombre de threads (1 = recherche séquentielle).
+ */
+int ia_get_threads(void) {
+    return ia_thread_count;
+}
+
+/**
+ * \fn void ia_get_search_stats(IaSearchStats* out)
+ * \brief Copie les statistiques de la dernière recherche terminée.
+ *
+ * \param out Statistiques (retour).
+ */
+void ia_get_search_stats(IaSearchStats* out) {
+    pthread_mutex_lock(&stats_lock);
+    *out = ia_last_stats;
+    pthread_mutex_unlock(&stats_lock);
+}
+
+/**
+ * \fn void ia_print_search_stats(const IaSearchStats* st)
+ * \brief Affiche les statistiques d'une recherche et sa variante principale.
+ *
+ * \param st Statistiques à afficher.
+ */
+void ia_print_search_stats(const IaSearchStats* st) {
+    if (st->book) {
+        const Move* m = &st->pv[0];
+        printf("IA: livre d'ouverture, %c%d-%c%d, %.3f s\n",
+               'A' + m->from_col, 9 - m->from_row, 'A' + m->to_col, 9 - m->to_row, st->elapsed_us / 1e6);
+        return;
     }
+    double secs = st->elapsed_us / 1e6;
+    double knps = secs > 0 ? st->nodes / secs / 1e3 : 0;
+    double first = st->cutoffs ? 100.0 * st->first_cutoffs / st->cutoffs : 0;
+    double hits = st->tt_probes ? 100.0 * st->tt_hits / st->tt_probes : 0;
+    printf("IA: profondeur %d, score %d, %llu noeuds (%llu quiescence), %.3f s, %.0f kN/s, "
+           "coupures %llu (%.1f%% au 1er coup), TT %.1f%% (%llu/%llu), %d thread(s)",
+           st->depth, st->score, st->nodes, st->qnodes, secs, knps,
+           st->cutoffs, first, hits, st->tt_hits, st->tt_probes, st->threads);
+    if (st->tb_hits) printf(", table de finales %llu", st->tb_hits);
+    printf("\n");
+    printf("IA: variante");
+    for (int i = 0; i < st->pv_length; ++i) {
+        const Move* m = &st->pv[i];
+        printf(" %c%d-%c%d", 'A' + m->from_col, 9 - m->from_row, 'A' + m->to_col, 9 - m->to_row);
+    }
+    printf("\n");
 }
 
 /**
- * \fn  void reset_move_history(void)
- * \brief Réinitialise l'historique des coups.
+ * \fn void ia_history_record(IaHistory* h, const GameState* s)
+ * \brief Ajoute une position jouée à un historique.
+ *
+ * Sans effet si c'est déjà la dernière position enregistrée. Quand
+ * l'historique est plein, la moitié la plus ancienne est oubliée.
+ *
+ * \param h Historique de la partie.
+ * \param s Position atteinte (hachage à jour).
  */
-void reset_move_history(void) {
-    history_count = 0;
+void ia_history_record(IaHistory* h, const GameState* s) {
+    if (h->count > 0 && h->hash[h->count - 1] == s->hash) return;
+    if (h->count >= IA_REP_GAME) {
+        int keep = h->count / 2;
+        memmove(h->hash, h->hash + h->count - keep, keep * sizeof(h->hash[0]));
+        h->count = keep;
+        memset(h->filter, 0, sizeof(h->filter));
+        for (int i = 0; i < keep; ++i) h->filter[h->hash[i] & (IA_REP_FILTER - 1)]++;
+    }
+    ia_rep_push(h, s->hash);
 }
 
 /**
- * \fn GameState createGameStateFromCurrent(void)
- * \brief Crée une copie de l’état actuel du jeu.
- * 
- * \return Copie de l’état actuel du jeu.
- */
-GameState createGameStateFromCurrent(void) {
-    GameState st;
-    st.piece_count = piece_count;
-    for (int i = 0; i < piece_count; ++i) st.pieces[i] = pieces[i];
-    for (int r = 0; r < 9; ++r)
-        for (int c = 0; c < 9; ++c)
-            st.cell_control[r][c] = cell_control[r][c];
-    st.current_player = current_turn;
-    st.turn_number = turn_number;
-    return st;
+ * \fn void ia_history_reset(IaHistory* h, const GameState* start)
+ * \brief Réinitialise un historique à la seule position de départ.
+ *
+ * \param h Historique de la partie.
+ * \param start Position de départ (hachage à jour).
+ */
+void ia_history_reset(IaHistory* h, const GameState* start) {
+    memset(h, 0, sizeof(*h));
+    ia_history_record(h, start);
+}
+
+/**
+ * \fn void ia_record_position(const GameState* s)
+ * \brief Ajoute une position jouée à l'historique de la partie de l'interface.
+ *
+ * \param s Position atteinte (hachage à jour).
+ */
+void ia_record_position(const GameState* s) {
+    pthread_mutex_lock(&history_lock);
+    ia_history_record(&game_positions, s);
+    pthread_mutex_unlock(&history_lock);
+}
+
+/**
+ * \fn void ia_reset_history(const GameState* start)
+ * \brief Réinitialise l'historique de la partie de l'interface à la seule position de départ.
+ *
+ * \param start Position de départ (hachage à jour).
+ */
+void ia_reset_history(const GameState* start) {
+    pthread_mutex_lock(&history_lock);
+    ia_history_reset(&game_positions, start);
+    pthread_mutex_unlock(&history_lock);
 }
@@ -0,0 +1,192 @@
+/**
+ * \file ia_job.c
+ * \brief Recherche de l'IA sur un thread dédié, résultat rendu via g_idle_add.
+ * \author valentin.leray@uha.fr
+ * \version 0.1
+ * \date 2025-10-06
+ *
+ * \details
+ * - Une tâche = une copie de la position + un thread de recherche
+ * - Le thread ne touche à aucun état du jeu : il ne lit que sa copie
+ * - Le résultat revient sur le thread GTK (g_idle_add), qui joint le thread
+ *   et libère la tâche
+ * - L'annulation passe par le drapeau d'arrêt de trouverMeilleurCoupIA_Annulable()
+ * - Réflexion anticipée : même mécanisme avec ia_ponder(), sans résultat
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "ia_job.h"
+#include "log.h"
+
+/**
+ * @brief Tâche de recherche en arrière-plan
+ */
+typedef struct {
+    pthread_t      thread;    /**< Thread de recherche */
+    GameState      root;      /**< Position au lancement (rendue au callback) */
+    GameState      work;      /**< Copie modifiée pendant la recherche */
+    int            budget_ms; /**< Temps de réflexion */
+    int            ponder;    /**< 1 pour une réflexion anticipée (aucun coup rendu) */
+    int            stop;      /**< Annulation demandée (accès atomiques) */
+    int            finished;  /**< Recherche terminée (accès atomiques) */
+    int            joined;    /**< Thread déjà joint (thread GTK uniquement) */
+    Move           result;    /**< Coup trouvé */
+    ia_job_done_cb done;      /**< Callback de fin */
+    gpointer       user_data; /**< Donnée du callback */
+} IaJob;
+
+/** \brief Tâche courante (NULL si aucune), manipulée sur le thread GTK uniquement */
+static IaJob *current_job = NULL;
+
+/**
+ * \fn static gboolean ia_job_deliver(gpointer data)
+ * \brief Rend le résultat d'une tâche sur le thread GTK puis la libère.
+ *
+ * \param data Tâche terminée.
+ * \return G_SOURCE_REMOVE.
+ */
+static gboolean ia_job_deliver(gpointer data) {
+    IaJob *job = data;
+    if (!job->joined) {
+        pthread_join(job->thread, NULL);
+        job->joined = 1;
+    }
+    if (job == current_job) current_job = NULL;
+
+    if (!__atomic_load_n(&job->stop, __ATOMIC_RELAXED) && job->done)
+        job->done(&job->root, &job->result, job->user_data);
+    free(job);
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * \fn static void *ia_job_thread(void *arg)
+ * \brief Corps du thread : recherche puis remise du résultat à la boucle GTK.
+ *
+ * \param arg Tâche.
+ * \return NULL.
+ */
+static void *ia_job_thread(void *arg) {
+    IaJob *job = arg;
+    if (job->ponder) ia_ponder(&job->work, &job->stop);
+    else trouverMeilleurCoupIA_Annulable(&job->work, &job->result, job->budget_ms, &job->stop);
+    __atomic_store_n(&job->finished, 1, __ATOMIC_RELEASE);
+    g_idle_add(ia_job_deliver, job);
+    return NULL;
+}
+
+/**
+ * \fn static int ia_job_launch(const GameState *state, int budget_ms, int ponder, ia_job_done_cb done, gpointer user_data)
+ * \brief Crée une tâche et son thread, après annulation de la précédente.
+ *
+ * \param state Position à chercher (copiée).
+ * \param budget_ms Temps de réflexion en millisecondes.
+ * \param ponder 1 pour une réflexion anticipée.
+ * \param done Callback de fin.
+ * \param user_data Donnée du callback.
+ * \return 0 si succès, -1 si la tâche n'a pas pu être lancée.
+ */
+static int ia_job_launch(const GameState *state, int budget_ms, int ponder, ia_job_done_cb done, gpointer user_data) {
+    if (!state) return -1;
+    if (!ponder && current_job && current_job->ponder && current_job->root.hash == state->hash)
+        LOG_DEBUG("[ia] prédiction juste : la recherche réutilise la table de la réflexion anticipée");
+    ia_job_cancel();
+
+    IaJob *job = calloc(1, sizeof(IaJob));
+    if (!job) return -1;
+    job->root = *state;
+    job->work = *state;
+    job->budget_ms = budget_ms;
+    job->ponder = ponder;
+    job->result.piece_index = -1;
+    job->done = done;
+    job->user_data = user_data;
+
+    if (pthread_create(&job->thread, NULL, ia_job_thread, job) != 0) {
+        free(job);
+        return -1;
+    }
+    current_job = job;
+    return 0;
+}
+
+/**
+ * \fn int ia_job_start(const GameState *state, int budget_ms, ia_job_done_cb done, gpointer user_data)
+ * \brief Lance une recherche en arrière-plan, après annulation de la précédente.
+ *
+ * \param state Position à chercher (copiée).
+ * \param budget_ms Temps de réflexion en millisecondes.
+ * \param done Callback de fin.
+ * \param user_data Donnée du callback.
+ * \return 0 si succès, -1 si la tâche n'a pas pu être lancée.
+ */
+int ia_job_start(const GameState *state, int budget_ms, ia_job_done_cb done, gpointer user_data) {
+    return ia_job_launch(state, budget_ms, 0, done, user_data);
+}
+
+/**
+ * \fn int ia_job_ponder(const GameState *state)
+ * \brief Lance une réflexion anticipée en arrière-plan.
+ *
+ * \param state Position à approfondir (copiée).
+ * \return 0 si succès, -1 sinon.
+ */
+int ia_job_ponder(const GameState *state) {
+    return ia_job_launch(state, 0, 1, NULL, NULL);
+}
+
+/**
+ * \fn void ia_job_cancel(void)
+ * \brief Annule la tâche en cours sans attendre son thread.
+ *
+ * La tâche se libère d'elle-même lorsque son thread a fini (ia_job_deliver()).
+ */
+void ia_job_cancel(void) {
+    if (!current_job) return;
+    __atomic_store_n(&current_job->stop, 1, __ATOMIC_RELAXED);
+    current_job = NULL;
+}
+
+/**
+ * \fn int ia_job_busy(void)
+ * \brief Indique si une recherche est en cours.
+ *
+ * \return 1 si la tâche courante n'a pas encore fini sa recherche, 0 sinon.
+ */
+int ia_job_busy(void) {
+    return current_job && !__atomic_load_n(&current_job->finished, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * \fn int ia_job_wait(Move *best_move)
+ * \brief Attend la fin de la tâche courante (le callback reste rendu par la boucle GTK).
+ *
+ * \param best_move Coup trouvé (retour, peut être NULL).
+ * \return 0 si une tâche a été attendue, -1 sinon.
+ */
+int ia_job_wait(Move *best_move) {
+    IaJob *job = current_job;
+    if (!job) return -1;
+    if (!job->joined) {
+        pthread_join(job->thread, NULL);
+        job->joined = 1;
+    }
+    if (best_move) *best_move = job->result;
+    return 0;
+}
+
+/**
+ * \fn void ia_job_shutdown(void)
+ * \brief Annule la tâche en cours et attend la fin de son thread.
+ */
+void ia_job_shutdown(void) {
+    IaJob *job = current_job;
+    if (!job) return;
+    __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+    if (!job->joined) {
+        pthread_join(job->thread, NULL);
+        job->joined = 1;
+    }
+    current_job = NULL;
+}
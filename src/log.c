@@ -0,0 +1,257 @@
+/**
+ * \file log.c
+ * \brief Journal asynchrone à anneau sans verrou.
+ *
+ * \details
+ * Ce fichier implémente le journal de log.h :
+ * - Anneau borné à numéros de séquence par case (une case est libre pour
+ *   la position `p` quand sa séquence vaut `p`, pleine quand elle vaut
+ *   `p + 1`) : les écrivains réservent une position par compare-and-swap,
+ *   le thread d'écriture seul consomme.
+ * - Horodatage monotone (CLOCK_MONOTONIC) relatif au démarrage du journal.
+ * - Thread d'écriture : vide l'anneau par lots, un seul fflush par lot,
+ *   puis dort LOG_FLUSH_MS ms quand l'anneau est vide.
+ * - Écriture directe avant log_start() et dans les processus fils.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <pthread.h>
+#include "log.h"
+
+/** \brief Masque des positions dans l'anneau. */
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+/** @brief Message du journal, copié tel quel dans l'anneau */
+typedef struct {
+    uint64_t ns;                 /**< Horodatage monotone (ns) */
+    int level;                   /**< LogLevel */
+    char text[LOG_RECORD_TEXT];  /**< Message, terminé par '\0' */
+} LogRecord;
+
+/** @brief Case de l'anneau */
+typedef struct {
+    uint64_t seq;   /**< Séquence : libre pour `seq`, pleine pour `seq - 1` (accès atomiques) */
+    LogRecord rec;  /**< Enregistrement */
+} LogSlot;
+
+int log_threshold = LOG_LEVEL_INFO;
+
+static LogSlot log_ring[LOG_RING_SIZE];
+static uint64_t log_head;            /**< Prochaine position à réserver (écrivains) */
+static uint64_t log_tail;            /**< Prochaine position à lire (thread d'écriture) */
+static int log_running;              /**< Thread d'écriture actif (accès atomiques) */
+static int log_sample_every = 1;     /**< Un message INFO/DEBUG sur N */
+static unsigned long log_sample_count;
+static long log_written, log_dropped, log_sampled;
+static FILE *log_out;
+static pthread_t log_thread;
+static struct timespec log_epoch;
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+
+/**
+ * \fn static void log_init_once(void)
+ * \brief Séquences de l'anneau et origine des horodatages.
+ */
+static void log_init_once(void) {
+    for (uint64_t i = 0; i < LOG_RING_SIZE; ++i) log_ring[i].seq = i;
+    clock_gettime(CLOCK_MONOTONIC, &log_epoch);
+}
+
+/**
+ * \fn static uint64_t log_now_ns(void)
+ * \brief Nanosecondes écoulées depuis l'origine du journal.
+ */
+static uint64_t log_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)(ts.tv_sec - log_epoch.tv_sec) * 1000000000ULL + (uint64_t)ts.tv_nsec - (uint64_t)log_epoch.tv_nsec;
+}
+
+/**
+ * \fn static void log_emit(FILE *out, const LogRecord *rec)
+ * \brief Écrit un enregistrement : "[secondes] NIVEAU message".
+ */
+static void log_emit(FILE *out, const LogRecord *rec) {
+    static const char *names[] = { "", "ERROR", "WARN", "INFO", "DEBUG" };
+    fprintf(out, "[%11.6f] %-5s %s\n", (double)rec->ns / 1e9, names[rec->level], rec->text);
+    __atomic_fetch_add(&log_written, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * \fn static int log_drain(FILE *out)
+ * \brief Écrit tout ce que l'anneau contient (thread d'écriture seulement).
+ *
+ * \return Nombre d'enregistrements écrits.
+ */
+static int log_drain(FILE *out) {
+    int n = 0;
+    for (;;) {
+        LogSlot *slot = &log_ring[log_tail & LOG_RING_MASK];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != log_tail + 1) break;
+        LogRecord rec = slot->rec;
+        __atomic_store_n(&slot->seq, log_tail + LOG_RING_SIZE, __ATOMIC_RELEASE);
+        ++log_tail;
+        log_emit(out, &rec);
+        ++n;
+    }
+    if (n) fflush(out);
+    return n;
+}
+
+/**
+ * \fn static void *log_flusher(void *arg)
+ * \brief Thread d'écriture : vide l'anneau jusqu'à log_stop().
+ */
+static void *log_flusher(void *arg) {
+    (void)arg;
+    struct timespec pause = { 0, LOG_FLUSH_MS * 1000000L };
+    while (__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) {
+        if (!log_drain(log_out)) nanosleep(&pause, NULL);
+    }
+    log_drain(log_out);
+    return NULL;
+}
+
+/**
+ * \fn static void log_after_fork(void)
+ * \brief Processus fils : pas de thread d'écriture, écriture directe.
+ */
+static void log_after_fork(void) {
+    log_running = 0;
+}
+
+/**
+ * \fn int log_start(FILE *out)
+ * \brief Démarre le thread d'écriture du journal.
+ *
+ * \param out Sortie du journal (NULL = stdout).
+ * \return 0 si succès, -1 sinon.
+ */
+int log_start(FILE *out) {
+    pthread_once(&log_once, log_init_once);
+    if (__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) return 0;
+    log_out = out ? out : stdout;
+    fflush(log_out);
+    __atomic_store_n(&log_running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&log_thread, NULL, log_flusher, NULL) != 0) {
+        __atomic_store_n(&log_running, 0, __ATOMIC_RELEASE);
+        return -1;
+    }
+    static int atfork_done = 0;
+    if (!atfork_done) {
+        pthread_atfork(NULL, NULL, log_after_fork);
+        atexit(log_stop);
+        atfork_done = 1;
+    }
+    return 0;
+}
+
+/**
+ * \fn void log_stop(void)
+ * \brief Arrête le thread d'écriture ; l'anneau est vidé avant son arrêt.
+ */
+void log_stop(void) {
+    if (!__atomic_exchange_n(&log_running, 0, __ATOMIC_ACQ_REL)) return;
+    pthread_join(log_thread, NULL);
+    long dropped = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+    if (dropped > 0) fprintf(log_out, "[journal] %ld message(s) perdu(s), anneau plein\n", dropped);
+    fflush(log_out);
+    log_out = NULL; // écriture directe sur stdout ensuite
+}
+
+/**
+ * \fn void log_set_level(LogLevel level)
+ * \brief Change le seuil du journal.
+ */
+void log_set_level(LogLevel level) {
+    __atomic_store_n(&log_threshold, (int)level, __ATOMIC_RELAXED);
+}
+
+/**
+ * \fn void log_set_sampling(int every)
+ * \brief Garde un message INFO ou DEBUG sur `every`.
+ */
+void log_set_sampling(int every) {
+    __atomic_store_n(&log_sample_every, every > 1 ? every : 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * \fn int log_parse_level(const char *name, LogLevel *out)
+ * \brief Lit un nom de niveau (off, error, warn, info, debug).
+ *
+ * \return 0 si succès, -1 si le nom est inconnu.
+ */
+int log_parse_level(const char *name, LogLevel *out) {
+    static const char *names[] = { "off", "error", "warn", "info", "debug" };
+    for (int i = 0; i <= LOG_LEVEL_DEBUG; ++i) {
+        if (name && strcmp(name, names[i]) == 0) {
+            *out = (LogLevel)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * \fn void log_write(LogLevel level, const char *fmt, ...)
+ * \brief Formate un message dans une case de l'anneau (ou l'écrit directement sans thread d'écriture).
+ */
+void log_write(LogLevel level, const char *fmt, ...) {
+    if (level <= LOG_LEVEL_OFF || !LOG_ENABLED(level)) return;
+    int every = __atomic_load_n(&log_sample_every, __ATOMIC_RELAXED);
+    if (level >= LOG_LEVEL_INFO && every > 1 &&
+        __atomic_fetch_add(&log_sample_count, 1, __ATOMIC_RELAXED) % (unsigned long)every != 0) {
+        __atomic_fetch_add(&log_sampled, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    pthread_once(&log_once, log_init_once);
+
+    va_list ap;
+    if (!__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) {
+        LogRecord rec;
+        rec.ns = log_now_ns();
+        rec.level = level;
+        va_start(ap, fmt);
+        vsnprintf(rec.text, sizeof(rec.text), fmt, ap);
+        va_end(ap);
+        FILE *out = log_out ? log_out : stdout;
+        log_emit(out, &rec);
+        return;
+    }
+
+    // Réservation d'une position libre ; anneau plein : message perdu
+    uint64_t pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+    LogSlot *slot;
+    for (;;) {
+        slot = &log_ring[pos & LOG_RING_MASK];
+        int64_t diff = (int64_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&log_head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (diff < 0) {
+            __atomic_fetch_add(&log_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+        }
+    }
+    slot->rec.ns = log_now_ns();
+    slot->rec.level = level;
+    va_start(ap, fmt);
+    vsnprintf(slot->rec.text, sizeof(slot->rec.text), fmt, ap);
+    va_end(ap);
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * \fn void log_get_stats(LogStats *out)
+ * \brief Compteurs du journal.
+ */
+void log_get_stats(LogStats *out) {
+    out->written = __atomic_load_n(&log_written, __ATOMIC_RELAXED);
+    out->dropped = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+    out->sampled = __atomic_load_n(&log_sampled, __ATOMIC_RELAXED);
+}
@@ -16,6 +16,17 @@
 #include "../include/app.h"
 #include "../include/gui.h"
 #include "../include/net.h"
+#include "../include/tt.h"
+#include "../include/ia.h"
+#include "../include/game.h"
+#include "../include/selfplay.h"
+#include "../include/book.h"
+#include "../include/tablebase.h"
+#include "../include/server.h"
+#include "../include/log.h"
+#include "../include/analysis.h"
+
+_Static_assert(ARGS_MAX_ANALYSE == IA_MAX_MULTIPV, "args.h : --analyse borné par IA_MAX_MULTIPV");
 
 
 /**
@@ -36,7 +47,12 @@
  *   - **Client** : se connecte à un serveur (\c run_client).
  *   - **Local** : démarre une partie à 2 joueurs sur la même machine (\c start_gui).
  *   - **IA locale** : démarre une partie où une ou deux IA jouent en local.
+ *   - **Selfplay** : enchaîne des parties IA contre IA sans interface (\c run_selfplay).
+ *   - **Table de finales** : génère la table et s'arrête (\c tb_generate).
+ *   - **Serveur de parties** : parties contre l'IA sans interface, une par client (\c run_match_server).
  * - Configure l’IA selon le mode et les options (\c ia_active, \c ia_color, \c ia_both_active).
+ * - Ouvre le livre d'ouverture et la table de finales demandés (\c book_open, \c tb_open).
+ * - Règle et démarre le journal asynchrone (\c log_start), vidé à la sortie.
  * - Libère la mémoire associée aux arguments (\c free_args).
  */
 
@@ -59,6 +75,87 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    // table de transposition de l'IA, allouée avant tout thread
+    size_t tt_mb = args.tt_mb > 0 ? (size_t)args.tt_mb : TT_DEFAULT_MB;
+    if (tt_init(tt_mb) != 0) {
+        fprintf(stderr, "Erreur: impossible d'allouer %zu Mo pour la table de transposition.\n", tt_mb);
+        free_args(&args);
+        return 1;
+    }
+
+
+    // temps de réflexion de l'IA par coup
+    if (args.time_ms > 0) ia_set_time_budget(args.time_ms);
+    if (args.threads > 0) ia_set_threads(args.threads);
+    if (args.ponder) ia_set_pondering(1);
+    if (args.verbose) ia_set_verbose(1);
+
+    // journal asynchrone (coups, captures, réseau)
+    log_set_level(args.log_level);
+    log_set_sampling(args.log_sample);
+    if (log_start(stdout) != 0) fprintf(stderr, "Journal asynchrone indisponible, ecriture directe.\n");
+
+    // mode analyse de l'interface (thread démarré avec la fenêtre)
+    analysis_multipv = args.analyse;
+
+    // canal de contrôle des parties réseau
+    if (args.ping_ms) net_set_ping_interval(args.ping_ms > 0 ? args.ping_ms : 0);
+
+    // livre d'ouverture de l'IA, projeté en mémoire
+    if (args.book && book_open(args.book) != 0) {
+        fprintf(stderr, "Erreur: livre d'ouverture %s absent ou invalide.\n", args.book);
+        free_args(&args);
+        return 1;
+    }
+
+    // table de finales de l'IA, projetée en mémoire
+    if (args.tb && tb_open(args.tb) != 0) {
+        fprintf(stderr, "Erreur: table de finales %s absente ou invalide.\n", args.tb);
+        free_args(&args);
+        return 1;
+    }
+
+    // génération de la table de finales (pas de gtk_init)
+    if (args.mode == MODE_TBGEN) {
+        int pawns = args.tb_pawns > 0 ? args.tb_pawns : ARGS_DEFAULT_TB_PAWNS;
+        int classes = tb_generate(args.tb_gen, pawns, stderr);
+        if (classes < 0) fprintf(stderr, "Erreur: impossible de generer la table de finales %s.\n", args.tb_gen);
+        else printf("Table de finales %s : %d classe(s)\n", args.tb_gen, classes);
+        free_args(&args);
+        return classes < 0;
+    }
+
+    // parties IA contre IA sans interface (pas de gtk_init)
+    if (args.mode == MODE_SELFPLAY) {
+        SelfPlayConfig cfg = {
+            .games = args.games,
+            .workers = args.workers > 0 ? args.workers : 1,
+            .engine = { args.engine_a, args.engine_b },
+            .out_path = args.out,
+            .book_out = args.book_out,
+            .record_path = args.record,
+            .record_every = args.record_every
+        };
+        int res = run_selfplay(&cfg);
+        free_args(&args);
+        return res;
+    }
+
+    // serveur de parties sans interface (pas de gtk_init)
+    if (args.mode == MODE_SERVE) {
+        ServerConfig cfg = {
+            .port = args.port,
+            .max_matches = args.max_matches > 0 ? args.max_matches : SERVER_DEFAULT_MATCHES,
+            .workers = args.search_workers > 0 ? args.search_workers : 1,
+            .engine = { .depth = 0, .time_ms = ia_get_time_budget() },
+            .log = stderr,
+            .record = args.record,
+            .record_every = args.record_every
+        };
+        int res = run_match_server(&cfg);
+        free_args(&args);
+        return res;
+    }
 
     // verif fonctionnalites
     if (args.mode == MODE_SERVER) {
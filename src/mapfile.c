@@ -0,0 +1,74 @@
+/**
+ * \file mapfile.c
+ * \brief Projection d'un fichier en lecture seule (mmap, ou lecture d'un bloc sous Windows).
+ *
+ * \details
+ * - Un seul chargeur pour le livre d'ouverture, la table de finales et les
+ *   fichiers de parties : ouverture, taille, projection privée.
+ * - Un fichier vide est refusé, comme un fichier absent.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "mapfile.h"
+
+/**
+ * \fn int map_file(const char *path, void **data, size_t *len)
+ * \brief Projette un fichier en mémoire, en lecture seule.
+ *
+ * \param path Fichier.
+ * \param data Début de la zone (retour).
+ * \param len Taille (retour).
+ * \return 0 si succès, -1 sinon.
+ */
+int map_file(const char *path, void **data, size_t *len) {
+    if (!path) return -1;
+    void *p = NULL;
+    size_t n = 0;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { close(fd); return -1; }
+    n = (size_t)st.st_size;
+    p = mmap(NULL, n, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return -1;
+#else
+    FILE *f = fopen(path, "rb");
+    if (!f) return -1;
+    if (fseek(f, 0, SEEK_END) != 0 || (n = (size_t)ftell(f)) == 0 || fseek(f, 0, SEEK_SET) != 0 ||
+        !(p = malloc(n)) || fread(p, 1, n, f) != n) {
+        free(p);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+#endif
+    *data = p;
+    *len = n;
+    return 0;
+}
+
+/**
+ * \fn void unmap_file(void *data, size_t len)
+ * \brief Libère une zone rendue par map_file().
+ *
+ * \param data Début de la zone (NULL accepté).
+ * \param len Taille rendue par map_file().
+ */
+void unmap_file(void *data, size_t len) {
+    if (!data) return;
+#ifndef _WIN32
+    munmap(data, len);
+#else
+    (void)len;
+    free(data);
+#endif
+}
@@ -8,8 +8,18 @@
  * \details
  * Ce fichier implémente les fonctions réseau du jeu :
  * - Création et gestion des sockets TCP.
- * - Boucles serveur et client avec réception et envoi des coups.
- * - Communication avec l'interface GTK via des callbacks.
+ * - Acceptation et connexion asynchrones, surveillées par la boucle GLib
+ *   (g_unix_fd_add) : aucun thread réseau, la fenêtre s'ouvre tout de suite.
+ * - Réception dans un tampon réutilisé : les coups sont joués dès que la
+ *   socket est lisible, sur le thread de l'interface, sans allocation.
+ * - Socket de partie non bloquante : ce que le système n'accepte pas tout
+ *   de suite attend dans une file d'envoi vidée quand la socket redevient
+ *   inscriptible (G_IO_OUT), sans jamais bloquer l'interface.
+ * - Canal de contrôle entre les coups : PING / PONG périodiques, temps
+ *   d'aller-retour et détection d'un adversaire qui ne répond plus.
+ * - Options de faible latence (TCP_NODELAY) sur les sockets de partie.
+ * - Resynchronisation par instantané (SYNC_REQUEST / SYNC_STATE), somme
+ *   de contrôle après chaque coup et reprise après une connexion perdue.
  * - Gestion des erreurs réseau et fermeture propre des sockets.
  */
 
@@ -21,8 +31,9 @@
 #include <gui.h>
 #include <game.h>
 #include <status.h>
+#include <ui.h>
 #include <ctype.h>
-#include <pthread.h>
+#include <log.h>
 
 #ifdef _WIN32
     #include <winsock2.h>
@@ -31,31 +42,72 @@
 #else
     #include <sys/socket.h>
     #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <netinet/ip.h>
     #include <netdb.h>
     #include <unistd.h>
+    #include <fcntl.h>
     #include <arpa/inet.h>
+    #include <glib-unix.h>
+    #include <signal.h>
     #define SOCKET_ERROR -1
 #endif
 #include "net.h"
 
-#define BUFFER_SIZE 5               // 4 chars + \0 pour les chaînes de coups
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // Windows (pas de SIGPIPE) ; ailleurs SIGPIPE est ignoré par run_server() / run_client()
+#endif
 
 SOCKET g_socket = INVALID_SOCKET;   // Socket globale utilisée pour la communication reseau
 char my_color = '\0';               // Couleur du joueur local ('R' ou 'B')
 
+/** @brief État de la connexion de la partie réseau */
+typedef enum {
+    NET_OFF,        /**< Pas de partie réseau */
+    NET_WAITING,    /**< Écoute ou connexion en cours */
+    NET_CONNECTED,  /**< Adversaire connecté */
+    NET_CLOSED      /**< Connexion terminée */
+} net_state_t;
+
 /**
- * @brief Contexte d'exécution d'un serveur/client réseau
- * 
- * Cette structure maintient l'état d'une connexion réseau active,
- * utilisée à la fois par le serveur et le client pour gérer
- * la communication et la synchronisation.
+ * @brief Connexion de la partie réseau, tenue par la boucle GLib
+ *
+ * Une seule connexion par processus : l'écoute (serveur) ou la connexion
+ * en cours (client), puis la socket de la partie et son tampon.
  */
 typedef struct {
-    SOCKET s;           /**< Socket de communication active */
-    game_mode_t mode;   /**< Mode de jeu (serveur/client) */
-    int running;        /**< Flag d'exécution du thread réseau */
-} server_context_t;
+    net_state_t state;   /**< État de la connexion */
+    SOCKET listen_sock;  /**< Socket d'écoute du serveur (INVALID_SOCKET sinon) */
+    SOCKET s;            /**< Socket de la partie (connexion en cours côté client) */
+    guint watch;         /**< Source GLib surveillant `listen_sock` ou `s` (0 = aucune) */
+    const char *peer;    /**< Nom de l'adversaire dans le journal ("CLIENT", "SERVEUR") */
+    NetRecvBuffer rx;    /**< Octets reçus pas encore joués */
+    NetSendBuffer tx;    /**< Octets à envoyer que la socket n'a pas encore pris */
+    guint tx_watch;      /**< Source GLib attendant que `s` soit inscriptible (0 = file vide) */
+    guint ping_timer;    /**< Source GLib des PING (0 = aucune) */
+    uint64_t last_rx_us; /**< Dernière réception (horloge monotone, µs) */
+    int pongs;           /**< PONG reçus depuis la connexion */
+    int awaiting_sync;   /**< Client : SYNC_STATE demandé, pas encore reçu */
+    int reconnects;      /**< Client : tentatives de reconnexion depuis la perte */
+    guint retry_timer;   /**< Source GLib de la prochaine tentative (0 = aucune) */
+    char host[256];      /**< Client : adresse du serveur, pour se reconnecter */
+    short port;          /**< Client : port du serveur */
+} net_conn_t;
+
+static net_conn_t net_conn = { NET_OFF, INVALID_SOCKET, INVALID_SOCKET, 0, "", { { 0 }, 0, 0 }, { { 0 }, 0, 0 }, 0,
+                                0, 0, 0, 0, 0, 0, "", 0 };
+
+static int net_ping_interval_ms = NET_PING_INTERVAL_MS;
 
+/** @brief Dernières mesures d'aller-retour (anneau) */
+static struct {
+    double ms[NET_RTT_SAMPLES]; /**< Mesures */
+    int count;                  /**< Mesures conservées */
+    int next;                   /**< Prochaine case écrite */
+    double last;                /**< Dernière mesure */
+} net_rtt;
+
+typedef gboolean (*net_watch_fn)(SOCKET s, GIOCondition cond);
 
 /**
  * \fn void cleanup_socket(SOCKET s)
@@ -74,24 +126,358 @@ void cleanup_socket(SOCKET s) {
 }
 
 /**
- * \fn int recv_move(SOCKET s, char *buffer)
- * \brief Lit exactement 4 caractères depuis une socket.
- * 
- * \param s Socket source.
- * \param buffer Buffer de réception (doit pouvoir contenir 5 caractères).
- * \return Nombre de caractères lus (4) ou <=0 en cas d'erreur ou connexion fermée.
+ * \fn static int net_set_blocking(SOCKET s, int blocking)
+ * \brief Passe une socket en mode bloquant ou non bloquant.
+ *
+ * \return 0 si succès, -1 sinon.
  */
-int recv_move(SOCKET s, char *buffer) {
-    int total = 0;
-    while (total < 4) {
-        int r = recv(s, buffer + total, 4 - total, 0);
-        if (r <= 0) {
-            return r; // erreur ou connexion fermee
+static int net_set_blocking(SOCKET s, int blocking) {
+#ifdef _WIN32
+    u_long nb = !blocking;
+    return ioctlsocket(s, FIONBIO, &nb) == 0 ? 0 : -1;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0) return -1;
+    flags = blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+    return fcntl(s, F_SETFL, flags) == 0 ? 0 : -1;
+#endif
+}
+
+/**
+ * \fn static int net_would_block(void)
+ * \brief La dernière opération non bloquante doit-elle être reprise plus tard ?
+ */
+static int net_would_block(void) {
+#ifdef _WIN32
+    int e = WSAGetLastError();
+    return e == WSAEWOULDBLOCK || e == WSAEINPROGRESS;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS || errno == EINTR;
+#endif
+}
+
+#ifdef _WIN32
+/** \brief Surveillance d'une socket Windows : canal GLib et fonction à appeler. */
+typedef struct { SOCKET s; net_watch_fn fn; } net_win_watch_t;
+
+static gboolean net_channel_cb(GIOChannel *ch, GIOCondition cond, gpointer data) {
+    (void)ch;
+    net_win_watch_t *w = data;
+    return w->fn(w->s, cond);
+}
+#else
+static gboolean net_fd_cb(gint fd, GIOCondition cond, gpointer data) {
+    return ((net_watch_fn)data)((SOCKET)fd, cond);
+}
+#endif
+
+/**
+ * \fn static guint net_add_watch(SOCKET s, GIOCondition cond, net_watch_fn fn)
+ * \brief Appelle `fn` depuis la boucle GLib chaque fois que `s` remplit `cond`.
+ *
+ * \return Identifiant de la source (g_source_remove()).
+ */
+static guint net_add_watch(SOCKET s, GIOCondition cond, net_watch_fn fn) {
+#ifdef _WIN32
+    net_win_watch_t *w = g_new(net_win_watch_t, 1);
+    w->s = s;
+    w->fn = fn;
+    GIOChannel *ch = g_io_channel_win32_new_socket((gint)s);
+    guint id = g_io_add_watch_full(ch, G_PRIORITY_DEFAULT, cond, net_channel_cb, w, g_free);
+    g_io_channel_unref(ch);
+    return id;
+#else
+    return g_unix_fd_add((gint)s, cond, net_fd_cb, (gpointer)fn);
+#endif
+}
+
+/**
+ * \fn void net_recv_reset(NetRecvBuffer* rb)
+ * \brief Vide un tampon de réception.
+ */
+void net_recv_reset(NetRecvBuffer* rb) {
+    rb->start = rb->len = 0;
+}
+
+/**
+ * \fn int net_recv_fill(NetRecvBuffer* rb, SOCKET s)
+ * \brief Lit les octets disponibles d'une socket à la suite du tampon.
+ *
+ * Le reste non traité est d'abord ramené en tête : la place libre est
+ * toujours au moins NET_RECV_BUFFER - NET_MOVE_LEN + 1 octets.
+ *
+ * \param rb Tampon de réception.
+ * \param s Socket connectée, lisible.
+ * \return Octets lus, 0 si la connexion est fermée, négatif en cas d'erreur.
+ */
+int net_recv_fill(NetRecvBuffer* rb, SOCKET s) {
+    if (rb->start > 0) {
+        memmove(rb->data, rb->data + rb->start, rb->len - rb->start);
+        rb->len -= rb->start;
+        rb->start = 0;
+    }
+    int r = recv(s, rb->data + rb->len, (int)(sizeof(rb->data) - rb->len), 0);
+    if (r > 0) rb->len += (size_t)r;
+    return r;
+}
+
+/**
+ * \fn int net_recv_frame(NetRecvBuffer* rb, NetFrame* frame)
+ * \brief Extrait la prochaine trame complète du tampon : coup ou trame de contrôle.
+ *
+ * \return 1 si une trame a été extraite, 0 s'il manque des octets, -1 si la
+ *         longueur annoncée dépasse NET_CTRL_MAX_PAYLOAD.
+ */
+int net_recv_frame(NetRecvBuffer* rb, NetFrame* frame) {
+    size_t avail = rb->len - rb->start;
+    const unsigned char *p = (const unsigned char *)rb->data + rb->start;
+    if (avail == 0) return 0;
+    if (p[0] != (unsigned char)NET_CTRL_MARK) {
+        if (avail < NET_MOVE_LEN) return 0;
+        frame->type = 0;
+        frame->len = 0;
+        memcpy(frame->move, p, NET_MOVE_LEN);
+        frame->move[NET_MOVE_LEN] = '\0';
+        rb->start += NET_MOVE_LEN;
+        return 1;
+    }
+    if (avail < NET_CTRL_HEADER) return 0;
+    size_t len = (size_t)p[2] | ((size_t)p[3] << 8);
+    if (len > NET_CTRL_MAX_PAYLOAD) return -1;
+    if (avail < NET_CTRL_HEADER + len) return 0;
+    frame->type = (char)p[1];
+    frame->len = len;
+    frame->move[0] = '\0';
+    memcpy(frame->payload, p + NET_CTRL_HEADER, len);
+    rb->start += NET_CTRL_HEADER + len;
+    return 1;
+}
+
+/**
+ * \fn int net_recv_next(NetRecvBuffer* rb, char move[NET_MOVE_LEN + 1])
+ * \brief Extrait le prochain coup complet du tampon, trames de contrôle sautées.
+ *
+ * \return 1 si un coup a été extrait, 0 sinon.
+ */
+int net_recv_next(NetRecvBuffer* rb, char move[NET_MOVE_LEN + 1]) {
+    NetFrame frame;
+    int r;
+    while ((r = net_recv_frame(rb, &frame)) == 1) {
+        if (frame.type == 0) {
+            memcpy(move, frame.move, NET_MOVE_LEN + 1);
+            return 1;
         }
-        total += r;
     }
-    buffer[4] = '\0'; // terminaison de chaîne
-    return total;
+    return 0;
+}
+
+/**
+ * \fn static size_t net_ctrl_encode(unsigned char *buf, char type, const void* payload, size_t len)
+ * \brief Écrit une trame de contrôle (en-tête puis charge) dans `buf`.
+ *
+ * \param buf Au moins NET_CTRL_HEADER + NET_CTRL_MAX_PAYLOAD octets.
+ * \return Taille de la trame, 0 si la charge est trop longue.
+ */
+static size_t net_ctrl_encode(unsigned char *buf, char type, const void* payload, size_t len) {
+    if (len > NET_CTRL_MAX_PAYLOAD) return 0;
+    buf[0] = (unsigned char)NET_CTRL_MARK;
+    buf[1] = (unsigned char)type;
+    buf[2] = (unsigned char)(len & 0xFF);
+    buf[3] = (unsigned char)(len >> 8);
+    if (len) memcpy(buf + NET_CTRL_HEADER, payload, len);
+    return NET_CTRL_HEADER + len;
+}
+
+/**
+ * \fn int net_send_control(SOCKET s, char type, const void* payload, size_t len)
+ * \brief Envoie une trame de contrôle d'un seul envoi.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int net_send_control(SOCKET s, char type, const void* payload, size_t len) {
+    if (s == INVALID_SOCKET) return -1;
+    unsigned char buf[NET_CTRL_HEADER + NET_CTRL_MAX_PAYLOAD];
+    size_t size = net_ctrl_encode(buf, type, payload, len);
+    if (size == 0) return -1;
+    size_t total = 0;
+    while (total < size) {
+        int r = send(s, (const char *)buf + total, (int)(size - total), MSG_NOSIGNAL);
+        if (r <= 0) return -1;
+        total += (size_t)r;
+    }
+    return 0;
+}
+
+/**
+ * \fn void net_send_reset(NetSendBuffer* sb)
+ * \brief Vide une file d'envoi.
+ */
+void net_send_reset(NetSendBuffer* sb) {
+    sb->start = sb->len = 0;
+}
+
+/**
+ * \fn int net_send_queue(NetSendBuffer* sb, const void* data, size_t len)
+ * \brief Ajoute des octets en fin de file, d'un bloc.
+ *
+ * \return 0 si succès, -1 si la file n'a pas la place.
+ */
+int net_send_queue(NetSendBuffer* sb, const void* data, size_t len) {
+    if (sb->start > 0) {
+        memmove(sb->data, sb->data + sb->start, sb->len - sb->start);
+        sb->len -= sb->start;
+        sb->start = 0;
+    }
+    if (len > sizeof(sb->data) - sb->len) return -1;
+    memcpy(sb->data + sb->len, data, len);
+    sb->len += len;
+    return 0;
+}
+
+/**
+ * \fn int net_send_queue_control(NetSendBuffer* sb, char type, const void* payload, size_t len)
+ * \brief Ajoute une trame de contrôle en fin de file.
+ *
+ * \return 0 si succès, -1 si la charge est trop longue ou la file pleine.
+ */
+int net_send_queue_control(NetSendBuffer* sb, char type, const void* payload, size_t len) {
+    unsigned char buf[NET_CTRL_HEADER + NET_CTRL_MAX_PAYLOAD];
+    size_t size = net_ctrl_encode(buf, type, payload, len);
+    if (size == 0) return -1;
+    return net_send_queue(sb, buf, size);
+}
+
+/**
+ * \fn int net_send_flush(NetSendBuffer* sb, SOCKET s)
+ * \brief Envoie ce que la socket accepte de la file, jusqu'à ce qu'elle refuse d'attendre.
+ *
+ * \return Octets encore en attente, -1 si la connexion est perdue.
+ */
+int net_send_flush(NetSendBuffer* sb, SOCKET s) {
+    while (sb->start < sb->len) {
+        int r = send(s, (const char *)sb->data + sb->start, (int)(sb->len - sb->start), MSG_NOSIGNAL);
+        if (r < 0 && net_would_block()) break;
+        if (r <= 0) return -1;
+        sb->start += (size_t)r;
+    }
+    if (sb->start == sb->len) sb->start = sb->len = 0;
+    return (int)(sb->len - sb->start);
+}
+
+/**
+ * \fn int net_set_low_latency(SOCKET s)
+ * \brief TCP_NODELAY (et IPTOS_LOWDELAY si disponible) sur une socket de partie.
+ *
+ * \return 0 si TCP_NODELAY est actif, -1 sinon.
+ */
+int net_set_low_latency(SOCKET s) {
+    int one = 1;
+#ifdef IPTOS_LOWDELAY
+    int tos = IPTOS_LOWDELAY;
+    setsockopt(s, IPPROTO_IP, IP_TOS, (char*)&tos, sizeof(tos)); // indicatif, ignoré si refusé
+#endif
+    return setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (char*)&one, sizeof(one)) == 0 ? 0 : -1;
+}
+
+/**
+ * \fn void net_set_ping_interval(int ms)
+ * \brief Intervalle des PING (0 = aucun).
+ */
+void net_set_ping_interval(int ms) {
+    net_ping_interval_ms = ms > 0 ? ms : 0;
+}
+
+/**
+ * \fn static uint64_t net_now_us(void)
+ * \brief Horloge monotone en microsecondes (PING, adversaire perdu).
+ */
+static uint64_t net_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/**
+ * \fn void net_rtt_add(double ms)
+ * \brief Ajoute une mesure d'aller-retour à l'anneau des mesures.
+ */
+void net_rtt_add(double ms) {
+    net_rtt.ms[net_rtt.next] = ms;
+    net_rtt.next = (net_rtt.next + 1) % NET_RTT_SAMPLES;
+    if (net_rtt.count < NET_RTT_SAMPLES) net_rtt.count++;
+    net_rtt.last = ms;
+}
+
+/**
+ * \fn static int net_cmp_double(const void *a, const void *b)
+ * \brief Ordre croissant pour qsort().
+ */
+static int net_cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * \fn void net_get_rtt(NetRttStats* out)
+ * \brief Percentiles (rang le plus proche) des dernières mesures d'aller-retour.
+ */
+void net_get_rtt(NetRttStats* out) {
+    memset(out, 0, sizeof(*out));
+    int n = net_rtt.count;
+    if (n == 0) return;
+    double sorted[NET_RTT_SAMPLES];
+    memcpy(sorted, net_rtt.ms, (size_t)n * sizeof(double));
+    qsort(sorted, (size_t)n, sizeof(double), net_cmp_double);
+    out->count = n;
+    out->last_ms = net_rtt.last;
+    out->p50_ms = sorted[(n * 50 + 99) / 100 - 1];
+    out->p90_ms = sorted[(n * 90 + 99) / 100 - 1];
+    out->p99_ms = sorted[(n * 99 + 99) / 100 - 1];
+}
+
+/**
+ * \fn void net_rtt_reset(void)
+ * \brief Efface les mesures d'aller-retour.
+ */
+void net_rtt_reset(void) {
+    memset(&net_rtt, 0, sizeof(net_rtt));
+}
+
+/**
+ * \fn void net_move_encode(int from_row, int from_col, int to_row, int to_col, char out[NET_MOVE_LEN + 1])
+ * \brief Écrit un coup au format réseau ("A1B2").
+ */
+void net_move_encode(int from_row, int from_col, int to_row, int to_col, char out[NET_MOVE_LEN + 1]) {
+    int N = 9;
+    out[0] = (char)('A' + from_col);
+    out[1] = (char)('0' + (N - from_row));
+    out[2] = (char)('A' + to_col);
+    out[3] = (char)('0' + (N - to_row));
+    out[4] = '\0';
+}
+
+/**
+ * \fn int net_move_decode(const char* msg, int* from_row, int* from_col, int* to_row, int* to_col)
+ * \brief Lit un coup au format réseau.
+ *
+ * \return 1 si les deux cases sont sur le plateau, 0 sinon.
+ */
+int net_move_decode(const char* msg, int* from_row, int* from_col, int* to_row, int* to_col) {
+    int N = 9;
+    *from_col = toupper((unsigned char)msg[0]) - 'A';
+    *from_row = N - (msg[1] - '0');
+    *to_col = toupper((unsigned char)msg[2]) - 'A';
+    *to_row = N - (msg[3] - '0');
+    return *from_col >= 0 && *from_col < N && *from_row >= 0 && *from_row < N &&
+           *to_col >= 0 && *to_col < N && *to_row >= 0 && *to_row < N;
+}
+
+/**
+ * \fn int net_waiting(void)
+ * \brief La partie réseau attend-elle encore son adversaire ?
+ */
+int net_waiting(void) {
+    return net_conn.state == NET_WAITING || net_conn.awaiting_sync;
 }
 
 /**
@@ -130,14 +516,15 @@ SOCKET TCP_Create_Server(short port) {
 }
 
 /**
- * \fn SOCKET TCP_Create_Client(const char* addr, short port)
- * \brief Crée un client TCP et se connecte à un serveur.
+ * \fn SOCKET TCP_Create_Client(const char* addr, short port, int* pending)
+ * \brief Crée un client TCP et lance sa connexion sans attendre.
  * 
  * \param addr Adresse IP du serveur.
  * \param port Port du serveur.
+ * \param pending 1 si la connexion est encore en cours (retour), 0 si elle est établie.
  * \return Socket client valide ou INVALID_SOCKET en cas d'erreur.
  */
-SOCKET TCP_Create_Client(const char* addr, short port) {
+SOCKET TCP_Create_Client(const char* addr, short port, int* pending) {
     SOCKET s = socket(AF_INET, SOCK_STREAM, 0);
     if (s == INVALID_SOCKET) {
         perror("socket");
@@ -152,11 +539,21 @@ SOCKET TCP_Create_Client(const char* addr, short port) {
         cleanup_socket(s);
         return INVALID_SOCKET;
     }
-    if (connect(s,(struct sockaddr*)&sin,sizeof(sin))==SOCKET_ERROR) {
-        perror("connect");
+    *pending = 0;
+    net_set_low_latency(s);
+    if (net_set_blocking(s, 0) != 0) {
+        perror("fcntl");
         cleanup_socket(s);
         return INVALID_SOCKET;
     }
+    if (connect(s,(struct sockaddr*)&sin,sizeof(sin))==SOCKET_ERROR) {
+        if (!net_would_block()) {
+            perror("connect");
+            cleanup_socket(s);
+            return INVALID_SOCKET;
+        }
+        *pending = 1;
+    }
     return s;
 }
 
@@ -170,22 +567,18 @@ SOCKET TCP_Create_Client(const char* addr, short port) {
  */
 int TCP_Send_Message(SOCKET s, const char* move) {
     if (!move) return -1;
-    if (strlen(move) != 4) {
-        fprintf(stderr, "Erreur: le coup doit avoir exactement 4 caractères\n");
+    if (strlen(move) != NET_MOVE_LEN) {
+        LOG_WARN("[net] coup de %zu caractères refusé (%d attendus)", strlen(move), NET_MOVE_LEN);
         return -1;
     }
 
-    time_t now;
-    time(&now);
-    char* time_str = ctime(&now);
-    time_str[strlen(time_str)-1] = '\0'; // retirer le \n
-    printf("[%s] ENVOI: %c%c%c%c\n", time_str, move[0], move[1], move[2], move[3]);
+    LOG_INFO("ENVOI: %.4s", move);
 
     int total = 0;
-    while (total < 4) {
-        int r = send(s, move + total, 4 - total, 0);
+    while (total < NET_MOVE_LEN) {
+        int r = send(s, move + total, NET_MOVE_LEN - total, MSG_NOSIGNAL);
         if (r <= 0) {
-            perror("send");
+            LOG_WARN("[net] envoi du coup %.4s impossible : %s", move, strerror(errno));
             return -1;
         }
         total += r;
@@ -193,104 +586,517 @@ int TCP_Send_Message(SOCKET s, const char* move) {
     return total;
 }
 
+static gboolean net_on_writable(SOCKET s, GIOCondition cond);
+
 /**
- * \fn gboolean gui_move_piece_callback(gpointer data)
- * \brief Callback GTK pour traiter un coup reçu et mettre à jour l'interface.
- * 
- * \param data Chaîne de 4 caractères représentant le coup.
- * \return G_SOURCE_REMOVE après traitement.
+ * \fn static int net_tx_flush(void)
+ * \brief Envoie ce que la socket de la partie accepte de sa file ; le reste attend G_IO_OUT.
+ *
+ * Une connexion perdue n'est pas traitée ici : la lecture (ou l'absence de
+ * PONG) la signale, depuis la boucle GLib.
+ *
+ * \return 0 si les octets sont envoyés ou en attente, -1 si la connexion est perdue.
  */
-gboolean gui_move_piece_callback(gpointer data) {
-    char *msg = (char*)data;
-    if (strlen(msg) != 4) {
-        g_free(msg);
-        return G_SOURCE_REMOVE;
+static int net_tx_flush(void) {
+    if (net_conn.tx_watch) return 0; // net_on_writable() videra la file
+    int left = net_send_flush(&net_conn.tx, net_conn.s);
+    if (left < 0) {
+        LOG_WARN("[net] envoi impossible vers le %s", my_color == 'R' ? "client" : "serveur");
+        net_send_reset(&net_conn.tx);
+        return -1;
     }
+    if (left > 0) net_conn.tx_watch = net_add_watch(net_conn.s, G_IO_OUT, net_on_writable);
+    return 0;
+}
 
-    int N = 9;
+/**
+ * \fn static gboolean net_on_writable(SOCKET s, GIOCondition cond)
+ * \brief Socket de la partie inscriptible : continue de vider la file d'envoi.
+ *
+ * \return G_SOURCE_CONTINUE tant qu'il reste des octets.
+ */
+static gboolean net_on_writable(SOCKET s, GIOCondition cond) {
+    (void)cond;
+    int left = net_send_flush(&net_conn.tx, s);
+    if (left > 0) return G_SOURCE_CONTINUE;
+    if (left < 0) {
+        LOG_WARN("[net] envoi impossible vers le %s", my_color == 'R' ? "client" : "serveur");
+        net_send_reset(&net_conn.tx);
+    }
+    net_conn.tx_watch = 0; // source retirée par G_SOURCE_REMOVE
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * \fn static int net_tx_control(char type, const void* payload, size_t len)
+ * \brief Trame de contrôle vers l'adversaire, par la file d'envoi de la partie.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+static int net_tx_control(char type, const void* payload, size_t len) {
+    if (net_conn.s == INVALID_SOCKET) return -1;
+    if (net_send_queue_control(&net_conn.tx, type, payload, len) != 0) return -1;
+    return net_tx_flush();
+}
 
-    int from_col = toupper(msg[0]) - 'A';
-    int from_row = N - (msg[1] - '0');
-    int to_col = toupper(msg[2]) - 'A';
-    int to_row = N - (msg[3] - '0');
+/**
+ * \fn static void net_tx_reset(void)
+ * \brief Abandonne la file d'envoi et sa surveillance (connexion fermée ou remplacée).
+ */
+static void net_tx_reset(void) {
+    if (net_conn.tx_watch) g_source_remove(net_conn.tx_watch);
+    net_conn.tx_watch = 0;
+    net_send_reset(&net_conn.tx);
+}
+
+/**
+ * \fn int net_send_move(int from_row, int from_col, int to_row, int to_col)
+ * \brief Envoie un coup joué localement, puis la somme de contrôle de la position obtenue.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int net_send_move(int from_row, int from_col, int to_row, int to_col) {
+    if (g_socket == INVALID_SOCKET) return -1;
+    char msg[NET_MOVE_LEN + 1];
+    net_move_encode(from_row, from_col, to_row, to_col, msg);
+    LOG_INFO("ENVOI: %.4s", msg);
+    SyncState snap;
+    game_sync_store(&snap);
+    if (net_send_queue(&net_conn.tx, msg, NET_MOVE_LEN) != 0 ||
+        net_send_queue_control(&net_conn.tx, NET_CTRL_CHECK, &snap.checksum, sizeof(snap.checksum)) != 0) {
+        LOG_WARN("[net] file d'envoi pleine, coup %s non envoyé", msg);
+        return -1;
+    }
+    return net_tx_flush();
+}
+
+/**
+ * \fn static int net_handle_move(const char *msg)
+ * \brief Joue un coup reçu de l'adversaire et met à jour l'interface.
+ * 
+ * Un coup illégal termine la partie et ferme la connexion.
+ *
+ * \param msg Coup de 4 caractères ("A1B2").
+ * \return 1 si le coup a été joué, 0 s'il a été refusé.
+ */
+static int net_handle_move(const char *msg) {
+    int from_row, from_col, to_row, to_col;
+    if (!net_move_decode(msg, &from_row, &from_col, &to_row, &to_col)) {
+        LOG_WARN("Coup reçu invalide: case hors du plateau (%s)", msg);
+        goto invalid_move;
+    }
 
     int piece_idx = find_piece_at(from_row, from_col);
     if (piece_idx < 0) {
-        printf("Coup reçu invalide: aucune pièce à (%d,%d)\n", from_row, from_col);
+        LOG_WARN("Coup reçu invalide: aucune pièce à (%d,%d)", from_row, from_col);
         goto invalid_move;
     }
 
     if (pieces[piece_idx].color != current_turn) {
-        printf("Coup reçu invalide: pas le tour de la couleur %c\n", pieces[piece_idx].color);
+        LOG_WARN("Coup reçu invalide: pas le tour de la couleur %c", pieces[piece_idx].color);
         goto invalid_move;
     }
 
     if (!can_move(piece_idx, to_row, to_col)) {
-        printf("Coup reçu invalide: déplacement interdit (%d,%d) -> (%d,%d)\n",
+        LOG_WARN("Coup reçu invalide: déplacement interdit (%d,%d) -> (%d,%d)",
         from_row, from_col, to_row, to_col);
         goto invalid_move;
     }
 
     move_piece(piece_idx, to_row, to_col);
-    gtk_widget_queue_draw(g_drawing_area);
-    g_free(msg);
-    return G_SOURCE_REMOVE;
+    ui_mark(UI_DIRTY_BOARD);
+    return 1;
 
     invalid_move:
     game_over = 1;
     set_victory_message(my_color == 'B', "L'adversaire a joué un coup invalide.");
-    gtk_widget_queue_draw(g_drawing_area);
+    ui_mark(UI_DIRTY_BOARD);
+    return 0;
+}
 
-    if (g_socket != INVALID_SOCKET) {
-        #ifdef _WIN32
-            closesocket(g_socket);
-        #else
-            shutdown(g_socket, SHUT_RDWR);
-            close(g_socket);
-        #endif
-        g_socket = INVALID_SOCKET;
+/**
+ * \fn static void net_close(void)
+ * \brief Ferme l'écoute et la connexion et retire leur surveillance.
+ */
+static void net_close(void) {
+    if (net_conn.watch) g_source_remove(net_conn.watch);
+    net_conn.watch = 0;
+    net_tx_reset();
+    if (net_conn.ping_timer) g_source_remove(net_conn.ping_timer);
+    net_conn.ping_timer = 0;
+    if (net_conn.retry_timer) g_source_remove(net_conn.retry_timer);
+    net_conn.retry_timer = 0;
+    cleanup_socket(net_conn.listen_sock);
+    net_conn.listen_sock = INVALID_SOCKET;
+    if (net_conn.s != INVALID_SOCKET) {
+#ifndef _WIN32
+        shutdown(net_conn.s, SHUT_RDWR);
+#endif
+        cleanup_socket(net_conn.s);
+    }
+    net_conn.s = INVALID_SOCKET;
+    g_socket = INVALID_SOCKET;
+    net_conn.awaiting_sync = 0;
+    if (net_conn.state != NET_OFF) net_conn.state = NET_CLOSED;
+}
+
+/**
+ * \fn static void net_end_game(const char *reason)
+ * \brief Ferme la connexion et termine la partie (sans effet sur une partie déjà finie).
+ */
+static void net_end_game(const char *reason) {
+    net_close();
+    if (!game_over) {
+        game_over = 1;
+        set_victory_message(my_color == 'B', reason);
+        ui_mark(UI_DIRTY_BOARD);
+    }
+}
+
+static gboolean net_on_accept(SOCKET master, GIOCondition cond);
+static gboolean net_on_connect(SOCKET s, GIOCondition cond);
+static gboolean net_on_retry(gpointer data);
+static void net_on_connected(SOCKET s);
+
+/**
+ * \fn static void net_schedule_retry(void)
+ * \brief Client : prochaine tentative de reconnexion, ou fin de partie après NET_RECONNECT_ATTEMPTS échecs.
+ */
+static void net_schedule_retry(void) {
+    if (net_conn.reconnects >= NET_RECONNECT_ATTEMPTS) {
+        LOG_WARN("[net] reconnexion abandonnée après %d tentatives", net_conn.reconnects);
+        net_end_game("Connexion au serveur perdue.");
+        return;
+    }
+    net_conn.state = NET_WAITING;
+    net_conn.retry_timer = g_timeout_add(NET_RECONNECT_DELAY_MS, net_on_retry, NULL);
+}
+
+/**
+ * \fn static void net_on_lost(const char *reason)
+ * \brief Connexion perdue : la partie attend la reconnexion du client au lieu de se terminer.
+ *
+ * Le serveur surveille à nouveau son écoute, le client programme sa
+ * reconnexion. Une partie finie est simplement fermée. Les sources de la
+ * connexion perdue dont l'appelant rend G_SOURCE_REMOVE doivent être
+ * remises à 0 avant l'appel.
+ *
+ * \param reason Message de fin de partie si aucune reprise n'est possible.
+ */
+static void net_on_lost(const char *reason) {
+    if (net_conn.watch) g_source_remove(net_conn.watch);
+    net_conn.watch = 0;
+    net_tx_reset();
+    if (net_conn.ping_timer) g_source_remove(net_conn.ping_timer);
+    net_conn.ping_timer = 0;
+    cleanup_socket(net_conn.s);
+    net_conn.s = INVALID_SOCKET;
+    g_socket = INVALID_SOCKET;
+    net_conn.awaiting_sync = 0;
+    if (game_over) {
+        net_close();
+        return;
+    }
+    if (my_color == 'R' && net_conn.listen_sock != INVALID_SOCKET) {
+        LOG_INFO("[net] en attente du retour du client");
+        net_conn.state = NET_WAITING;
+        net_conn.watch = net_add_watch(net_conn.listen_sock, G_IO_IN, net_on_accept);
+    } else if (my_color == 'B' && net_conn.host[0]) {
+        net_conn.reconnects = 0;
+        net_schedule_retry();
+    } else {
+        net_end_game(reason);
+        return;
     }
+    ui_mark(UI_DIRTY_STATUS | UI_DIRTY_BOARD);
+}
 
-    g_free(msg);
+/**
+ * \fn static gboolean net_on_retry(gpointer data)
+ * \brief Client : nouvelle tentative de connexion au serveur.
+ *
+ * \return G_SOURCE_REMOVE (la tentative suivante a sa propre source).
+ */
+static gboolean net_on_retry(gpointer data) {
+    (void)data;
+    net_conn.retry_timer = 0;
+    net_conn.reconnects++;
+    LOG_INFO("[net] reconnexion à %s:%d (%d/%d)", net_conn.host, net_conn.port,
+             net_conn.reconnects, NET_RECONNECT_ATTEMPTS);
+    int pending = 0;
+    SOCKET s = TCP_Create_Client(net_conn.host, net_conn.port, &pending);
+    if (s == INVALID_SOCKET) {
+        net_schedule_retry();
+    } else if (pending) {
+        net_conn.s = s;
+        net_conn.watch = net_add_watch(s, G_IO_OUT | G_IO_ERR | G_IO_HUP, net_on_connect);
+    } else {
+        net_on_connected(s);
+    }
     return G_SOURCE_REMOVE;
 }
 
 /**
- * \fn void* server_loop(void* arg)
- * \brief Boucle principale du serveur pour recevoir les coups du client.
- * 
- * \param arg Pointeur vers server_context_t.
- * \return NULL à la fin du thread.
- */
-void* server_loop(void* arg) {
-    server_context_t* ctx = (server_context_t*)arg;
-    char buffer[BUFFER_SIZE];
-
-    while (ctx->running) {
-        int bytes_received = recv_move(ctx->s, buffer);
-        if (bytes_received <= 0) {
-            printf("[net] connexion fermée par le client\n");
-            break;
+ * \fn static void net_send_state(void)
+ * \brief Serveur : envoie l'instantané de la partie courante (SYNC_STATE).
+ */
+static void net_send_state(void) {
+    SyncState snap;
+    game_sync_store(&snap);
+    if (net_tx_control(NET_CTRL_SYNC_STATE, &snap, sizeof(snap)) != 0)
+        LOG_WARN("[net] envoi de l'instantané impossible");
+    else
+        LOG_INFO("[net] instantané envoyé (tour %d)", turn_number);
+}
+
+/**
+ * \fn static void net_request_state(void)
+ * \brief Client : demande l'instantané du serveur ; coups et CHECK sont ignorés jusqu'à sa réception.
+ */
+static void net_request_state(void) {
+    net_conn.awaiting_sync = 1;
+    if (net_tx_control(NET_CTRL_SYNC_REQUEST, NULL, 0) != 0)
+        LOG_WARN("[net] demande d'instantané impossible");
+}
+
+/**
+ * \fn static int net_on_state(const NetFrame *frame)
+ * \brief Client : SYNC_STATE reçu, la partie du serveur remplace la partie locale.
+ *
+ * \return 1 si l'instantané a été chargé (ou ignoré côté serveur), 0 s'il est invalide.
+ */
+static int net_on_state(const NetFrame *frame) {
+    if (my_color != 'B') return 1; // la partie du serveur fait foi
+    SyncState snap;
+    if (frame->len != sizeof(snap)) return 0;
+    memcpy(&snap, frame->payload, sizeof(snap));
+    if (game_sync_load(&snap) != 0) return 0;
+    net_conn.awaiting_sync = 0;
+    net_conn.reconnects = 0;
+    LOG_INFO("[net] position synchronisée : tour %d, au tour des %s", turn_number,
+             current_turn == 'B' ? "bleus" : "rouges");
+    ui_mark(UI_DIRTY_STATUS | UI_DIRTY_BOARD);
+
+    extern int ia_active; extern char ia_color;
+    if (!game_over && ia_active && current_turn == ia_color)
+        g_timeout_add(500, trigger_ia_move, NULL);
+    return 1;
+}
+
+/**
+ * \fn static void net_on_check(const NetFrame *frame)
+ * \brief Somme de contrôle de l'adversaire après son coup : resynchronisation si elle diffère.
+ */
+static void net_on_check(const NetFrame *frame) {
+    SyncState snap;
+    if (frame->len != sizeof(snap.checksum)) return;
+    game_sync_store(&snap);
+    if (memcmp(frame->payload, &snap.checksum, sizeof(snap.checksum)) == 0) return;
+    LOG_WARN("[net] désynchronisation détectée au tour %d", turn_number);
+    if (my_color == 'B') net_request_state();
+    else net_send_state();
+}
+
+/**
+ * \fn static void net_on_pong(const NetFrame *frame)
+ * \brief PONG reçu : temps d'aller-retour depuis l'envoi du PING (charge = date d'envoi).
+ */
+static void net_on_pong(const NetFrame *frame) {
+    uint64_t sent;
+    if (frame->len != sizeof(sent)) return;
+    memcpy(&sent, frame->payload, sizeof(sent));
+    uint64_t now = net_now_us();
+    if (sent > now) return;
+    double ms = (double)(now - sent) / 1000.0;
+    net_rtt_add(ms);
+    LOG_DEBUG("[net] PONG : %.3f ms", ms);
+    if (++net_conn.pongs % NET_RTT_LOG_EVERY == 0) {
+        NetRttStats st;
+        net_get_rtt(&st);
+        LOG_INFO("[net] aller-retour p50 %.2f ms, p90 %.2f ms, p99 %.2f ms (%d mesures)",
+                 st.p50_ms, st.p90_ms, st.p99_ms, st.count);
+    }
+    ui_mark(UI_DIRTY_STATUS);
+}
+
+/**
+ * \fn static gboolean net_on_readable(SOCKET s, GIOCondition cond)
+ * \brief Socket de la partie lisible : lit ce qui est arrivé et joue les coups complets.
+ *
+ * \return G_SOURCE_CONTINUE tant que la connexion est ouverte.
+ */
+static gboolean net_on_readable(SOCKET s, GIOCondition cond) {
+    (void)cond;
+    int r = net_recv_fill(&net_conn.rx, s);
+    if (r <= 0) {
+        if (r < 0 && net_would_block()) return G_SOURCE_CONTINUE;
+        LOG_WARN("[net] connexion fermée par le %s", my_color == 'R' ? "client" : "serveur");
+        net_conn.watch = 0; // source retirée par G_SOURCE_REMOVE
+        net_on_lost("L'adversaire s'est déconnecté.");
+        return G_SOURCE_REMOVE;
+    }
+    net_conn.last_rx_us = net_now_us();
+    NetFrame frame;
+    int f;
+    while ((f = net_recv_frame(&net_conn.rx, &frame)) == 1) {
+        if (frame.type == NET_CTRL_PING) {
+            if (net_tx_control(NET_CTRL_PONG, frame.payload, frame.len) != 0)
+                LOG_WARN("[net] envoi du PONG impossible");
+        } else if (frame.type == NET_CTRL_PONG) {
+            net_on_pong(&frame);
+        } else if (frame.type == NET_CTRL_SYNC_REQUEST) {
+            if (my_color == 'R') net_send_state();
+        } else if (frame.type == NET_CTRL_SYNC_STATE) {
+            if (!net_on_state(&frame)) {
+                LOG_WARN("[net] instantané invalide du serveur");
+                net_conn.watch = 0;
+                net_end_game("Le serveur a envoyé une position invalide.");
+                return G_SOURCE_REMOVE;
+            }
+        } else if (net_conn.awaiting_sync) {
+            LOG_DEBUG("[net] trame ignorée en attendant l'instantané");
+        } else if (frame.type == NET_CTRL_CHECK) {
+            net_on_check(&frame);
+        } else if (frame.type == 0) {
+            LOG_INFO("%s: %s", net_conn.peer, frame.move);
+            if (!net_handle_move(frame.move)) {
+                net_conn.watch = 0;
+                net_close();
+                return G_SOURCE_REMOVE;
+            }
         }
+    }
+    if (f < 0) {
+        LOG_WARN("[net] trame de contrôle invalide du %s", my_color == 'R' ? "client" : "serveur");
+        net_conn.watch = 0;
+        net_end_game("L'adversaire a envoyé une trame invalide.");
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
 
-        time_t now;
-        time(&now);
-        char* time_str = ctime(&now);
-        time_str[strlen(time_str)-1] = '\0';
-        printf("[%s] CLIENT: %s\n", time_str, buffer);
+/**
+ * \fn static gboolean net_on_ping_timer(gpointer data)
+ * \brief Envoie un PING, ou déclare l'adversaire perdu s'il se tait depuis trop longtemps.
+ *
+ * \return G_SOURCE_CONTINUE tant que la connexion est ouverte.
+ */
+static gboolean net_on_ping_timer(gpointer data) {
+    (void)data;
+    if (net_conn.state != NET_CONNECTED) {
+        net_conn.ping_timer = 0;
+        return G_SOURCE_REMOVE;
+    }
+    uint64_t now = net_now_us();
+    if (now - net_conn.last_rx_us > (uint64_t)net_ping_interval_ms * NET_PEER_TIMEOUT_PINGS * 1000ULL) {
+        LOG_WARN("[net] aucune réponse du %s depuis %d ms", my_color == 'R' ? "client" : "serveur",
+                 (int)((now - net_conn.last_rx_us) / 1000));
+        net_conn.ping_timer = 0; // source retirée par G_SOURCE_REMOVE
+        net_on_lost("L'adversaire ne répond plus.");
+        return G_SOURCE_REMOVE;
+    }
+    if (net_tx_control(NET_CTRL_PING, &now, sizeof(now)) != 0)
+        LOG_WARN("[net] envoi du PING impossible");
+    return G_SOURCE_CONTINUE;
+}
 
-        char *msg_copy = g_strdup(buffer);
-        g_idle_add(gui_move_piece_callback, msg_copy);
+/**
+ * \fn static void net_on_connected(SOCKET s)
+ * \brief Adversaire connecté : la socket reste non bloquante, sa lecture est
+ *        confiée à la boucle GLib et ses envois à la file d'envoi, les PING
+ *        démarrent. Le client demande la position du serveur ; côté serveur,
+ *        l'IA joue si c'est son tour.
+ */
+static void net_on_connected(SOCKET s) {
+    net_set_blocking(s, 0); // une socket acceptée n'hérite pas du mode de l'écoute
+    net_set_low_latency(s);
+    net_conn.s = s;
+    g_socket = s;
+    net_conn.state = NET_CONNECTED;
+    net_recv_reset(&net_conn.rx);
+    net_tx_reset();
+    net_conn.watch = net_add_watch(s, G_IO_IN | G_IO_HUP | G_IO_ERR, net_on_readable);
+    net_conn.last_rx_us = net_now_us();
+    net_conn.pongs = 0;
+    net_rtt_reset();
+    if (net_ping_interval_ms > 0)
+        net_conn.ping_timer = g_timeout_add((guint)net_ping_interval_ms, net_on_ping_timer, NULL);
+    if (my_color == 'B') {
+        net_request_state(); // l'IA du client joue à la réception (net_on_state())
+        ui_mark(UI_DIRTY_STATUS);
+        return;
+    }
+    ui_mark(UI_DIRTY_STATUS);
+
+    extern int ia_active; extern char ia_color;
+    if (!game_over && ia_active && current_turn == ia_color)
+        g_timeout_add(500, trigger_ia_move, NULL);
+}
+
+/**
+ * \fn static gboolean net_on_accept(SOCKET master, GIOCondition cond)
+ * \brief Connexion entrante sur l'écoute du serveur.
+ *
+ * L'écoute reste ouverte, sans surveillance, pour une reconnexion du client.
+ *
+ * \return G_SOURCE_REMOVE une fois le client accepté.
+ */
+static gboolean net_on_accept(SOCKET master, GIOCondition cond) {
+    (void)cond;
+    struct sockaddr_in client_addr;
+    socklen_t client_len = sizeof(client_addr);
+    SOCKET s = accept(master, (struct sockaddr*)&client_addr, &client_len);
+    if (s == INVALID_SOCKET) {
+        if (net_would_block()) return G_SOURCE_CONTINUE;
+        LOG_WARN("[net] accept : %s", strerror(errno));
+        return G_SOURCE_CONTINUE;
     }
+    LOG_INFO("Client connecté depuis %s:%d",
+           inet_ntoa(client_addr.sin_addr),
+           ntohs(client_addr.sin_port));
+    net_conn.watch = 0; // source retirée par G_SOURCE_REMOVE
+    net_on_connected(s);
+    return G_SOURCE_REMOVE;
+}
 
-    ctx->running = 0;
-    return NULL;
+/**
+ * \fn static gboolean net_on_connect(SOCKET s, GIOCondition cond)
+ * \brief Fin de la connexion du client (socket inscriptible ou en erreur).
+ *
+ * \return G_SOURCE_REMOVE dans tous les cas.
+ */
+static gboolean net_on_connect(SOCKET s, GIOCondition cond) {
+    (void)cond;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(s, SOL_SOCKET, SO_ERROR, (char*)&err, &len) != 0) err = errno;
+    net_conn.watch = 0;
+    if (err != 0) {
+        LOG_WARN("[net] connect : %s", strerror(err));
+        if (net_conn.reconnects > 0 && !game_over) {
+            cleanup_socket(s);
+            net_conn.s = INVALID_SOCKET;
+            net_schedule_retry();
+            return G_SOURCE_REMOVE;
+        }
+        net_close();
+        game_over = 1;
+        set_victory_message(FALSE, "Connexion au serveur impossible.");
+        ui_mark(UI_DIRTY_BOARD);
+        return G_SOURCE_REMOVE;
+    }
+    LOG_INFO("Connecté au serveur");
+    net_on_connected(s);
+    return G_SOURCE_REMOVE;
 }
 
 /**
  * \fn int run_server(short port, game_mode_t mode)
  * \brief Lance le serveur TCP et l'interface GUI.
  * 
+ * L'écoute est surveillée par la boucle GLib : la fenêtre s'ouvre avant
+ * l'arrivée du client.
+ *
  * \param port Port d'écoute.
  * \param mode Mode de jeu.
  * \return 0 si succès, 1 en cas d'erreur.
@@ -304,92 +1110,38 @@ int run_server(short port, game_mode_t mode) {
     }
 #endif
 
-    printf("Mode serveur, port %d\n", port);
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN); // un adversaire parti fait échouer send(), sans tuer la partie
+#endif
+    LOG_INFO("Mode serveur, port %d", port);
     SOCKET master = TCP_Create_Server(port);
     if (master == INVALID_SOCKET) return 1;
+    net_set_blocking(master, 0);
 
-    printf("En attente d'une connexion...\n");
-    struct sockaddr_in client_addr;
-    socklen_t client_len = sizeof(client_addr);
-    SOCKET s = accept(master, (struct sockaddr*)&client_addr, &client_len);
-    cleanup_socket(master);
-
-    if (s == INVALID_SOCKET) {
-        fprintf(stderr, "Erreur accept\n");
-        return 1;
-    }
-
-    printf("Client connecté depuis %s:%d\n",
-           inet_ntoa(client_addr.sin_addr),
-           ntohs(client_addr.sin_port));
-    g_socket = s;
+    LOG_INFO("En attente d'une connexion...");
     my_color = 'R';
-
-    server_context_t ctx;
-    ctx.s = s;
-    ctx.mode = mode;
-    ctx.running = 1;
-
-    pthread_t net_thread;
-    pthread_create(&net_thread, NULL, server_loop, &ctx);
+    net_conn.state = NET_WAITING;
+    net_conn.listen_sock = master;
+    net_conn.peer = "CLIENT";
+    net_conn.watch = net_add_watch(master, G_IO_IN, net_on_accept);
 
     int gui_argc = 1;
     char *gui_argv[] = { "server_gui", NULL };
     start_gui(gui_argc, gui_argv, mode);
 
-    ctx.running = 0;
-
-#ifdef _WIN32
-    closesocket(s);
-#else
-    shutdown(s, SHUT_RDWR);
-#endif
-
-    pthread_join(net_thread, NULL);
-
-    cleanup_socket(s);
+    net_close();
 #ifdef _WIN32
     WSACleanup();
 #endif
     return 0;
 }
 
-/**
- * \fn void* client_loop(void* arg)
- * \brief Boucle principale du client pour recevoir les coups du serveur.
- * 
- * \param arg Pointeur vers server_context_t.
- * \return NULL à la fin du thread.
- */
-void* client_loop(void* arg) {
-    server_context_t* ctx = (server_context_t*)arg;
-    char buffer[BUFFER_SIZE];
-
-    while (ctx->running) {
-        int bytes_received = recv_move(ctx->s, buffer);
-        if (bytes_received <= 0) {
-            printf("[net] connexion fermée par le serveur\n");
-            break;
-        }
-
-        time_t now;
-        time(&now);
-        char* time_str = ctime(&now);
-        time_str[strlen(time_str)-1] = '\0';
-        printf("[%s] SERVEUR: %s\n", time_str, buffer);
-
-        char *msg_copy = g_strdup(buffer);
-        g_idle_add(gui_move_piece_callback, msg_copy);
-    }
-
-    ctx->running = 0;
-    return NULL;
-}
-
 /**
  * \fn int run_client(const char* addr, short port, game_mode_t mode)
  * \brief Lance le client TCP et l'interface GUI.
  * 
+ * La connexion se termine dans la boucle GLib (net_on_connect()).
+ *
  * \param addr Adresse IP du serveur.
  * \param port Port du serveur.
  * \param mode Mode de jeu.
@@ -404,51 +1156,37 @@ int run_client(const char* addr, short port, game_mode_t mode) {
         }
     #endif
 
-    printf("Mode client, connexion à %s:%d\n", addr, port);
-    SOCKET s = TCP_Create_Client(addr, port);
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN); // un adversaire parti fait échouer send(), sans tuer la partie
+#endif
+    LOG_INFO("Mode client, connexion à %s:%d", addr, port);
+    int pending = 0;
+    SOCKET s = TCP_Create_Client(addr, port, &pending);
     if (s == INVALID_SOCKET) {
         #ifdef _WIN32
             WSACleanup();
         #endif
         return 1;
     }
-    printf("Connecté au serveur\n");
 
-    g_socket = s;
     my_color = 'B';
-
-    server_context_t ctx;
-    ctx.s = s;
-    ctx.mode = mode;
-    ctx.running = 1;
-
-    pthread_t net_thread;
-    if (pthread_create(&net_thread, NULL, client_loop, &ctx) != 0) {
-        perror("pthread_create");
-        ctx.running = 0;
-        cleanup_socket(s);
-#ifdef _WIN32
-        WSACleanup();
-#endif
-        return 1;
+    snprintf(net_conn.host, sizeof(net_conn.host), "%s", addr);
+    net_conn.port = port;
+    net_conn.peer = "SERVEUR";
+    net_conn.state = NET_WAITING;
+    if (pending) {
+        net_conn.s = s;
+        net_conn.watch = net_add_watch(s, G_IO_OUT | G_IO_ERR | G_IO_HUP, net_on_connect);
+    } else {
+        LOG_INFO("Connecté au serveur");
+        net_on_connected(s);
     }
 
     int gui_argc = 1;
     char *gui_argv[] = { "client_gui", NULL };
     start_gui(gui_argc, gui_argv, mode);
 
-    ctx.running = 0;
-
-#ifdef _WIN32
-    closesocket(s);
-#else
-    shutdown(s, SHUT_RDWR);
-    close(s);
-#endif
-    g_socket = INVALID_SOCKET;
-
-    pthread_join(net_thread, NULL);
-
+    net_close();
 #ifdef _WIN32
     WSACleanup();
 #endif
@@ -0,0 +1,366 @@
+/**
+ * \file record.c
+ * \brief Enregistrement des parties : écriture en ajout seul, index final, lecture projetée en mémoire.
+ *
+ * \details
+ * - Un bloc de partie est préparé en mémoire puis écrit d'un seul fwrite :
+ *   les instantanés sont obtenus en rejouant les coups avec rules_play().
+ * - La position d'un instantané ou d'un coup ne dépend que du numéro de coup
+ *   et de K (record_snapshot_off(), record_move_off()).
+ * - Le fichier est projeté en mémoire par map_file() (mapfile.h). Sans pied
+ *   valide, l'index est reconstruit en parcourant les blocs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+#include "record.h"
+#include "mapfile.h"
+
+/** \brief Taille d'un enregistrement de coup, de début ou de fin de partie. */
+#define RECORD_UNIT 4
+/** \brief Taille d'un enregistrement d'instantané (étiquette comprise). */
+#define RECORD_SNAPSHOT_LEN (RECORD_UNIT + SYNC_STATE_SIZE)
+
+_Static_assert(sizeof(RecordHeader) == 16 && sizeof(RecordIndexEntry) == 16 && sizeof(RecordTrailer) == 24,
+               "record.h : disposition inattendue");
+
+/**
+ * \fn static uint64_t record_snapshot_off(uint64_t game_off, uint32_t j, uint32_t k)
+ * \brief Position de l'instantané `j` (avant le coup j * K) d'une partie.
+ */
+static uint64_t record_snapshot_off(uint64_t game_off, uint32_t j, uint32_t k) {
+    return game_off + RECORD_UNIT + (uint64_t)j * (RECORD_SNAPSHOT_LEN + (uint64_t)k * RECORD_UNIT);
+}
+
+/**
+ * \fn static uint64_t record_move_off(uint64_t game_off, uint32_t ply, uint32_t k)
+ * \brief Position du coup numéro `ply` d'une partie.
+ */
+static uint64_t record_move_off(uint64_t game_off, uint32_t ply, uint32_t k) {
+    return record_snapshot_off(game_off, ply / k, k) + RECORD_SNAPSHOT_LEN + (uint64_t)(ply % k) * RECORD_UNIT;
+}
+
+/**
+ * \fn static uint64_t record_block_len(uint32_t plies, uint32_t k)
+ * \brief Taille du bloc d'une partie de `plies` coups.
+ */
+static uint64_t record_block_len(uint32_t plies, uint32_t k) {
+    uint64_t snapshots = plies == 0 ? 1 : (plies - 1) / k + 1;
+    return RECORD_UNIT + snapshots * RECORD_SNAPSHOT_LEN + (uint64_t)plies * RECORD_UNIT + RECORD_UNIT;
+}
+
+/**
+ * \fn static int record_push(RecordIndexEntry **index, size_t *count, size_t *cap, const RecordIndexEntry *e)
+ * \brief Ajoute une entrée à un index alloué.
+ *
+ * \return 0 si succès, -1 si la mémoire manque.
+ */
+static int record_push(RecordIndexEntry **index, size_t *count, size_t *cap, const RecordIndexEntry *e) {
+    if (*count == *cap) {
+        size_t grown_cap = *cap ? *cap * 2 : 256;
+        RecordIndexEntry *grown = realloc(*index, grown_cap * sizeof(RecordIndexEntry));
+        if (!grown) return -1;
+        *index = grown;
+        *cap = grown_cap;
+    }
+    (*index)[(*count)++] = *e;
+    return 0;
+}
+
+/**
+ * \fn static int record_rebuild(RecordReader *r)
+ * \brief Reconstruit l'index en parcourant les blocs ; s'arrête à la première partie incomplète.
+ *
+ * \return 0 si succès, -1 si la mémoire manque.
+ */
+static int record_rebuild(RecordReader *r) {
+    size_t cap = 0;
+    uint32_t k = r->snap_every;
+    uint64_t pos = sizeof(RecordHeader);
+    r->data_end = pos;
+    while (pos + RECORD_UNIT <= r->len && r->map[pos] == RECORD_TAG_GAME) {
+        uint64_t start = pos;
+        uint32_t plies = 0;
+        int complete = 0;
+        pos += RECORD_UNIT;
+        while (pos + RECORD_UNIT <= r->len) {
+            unsigned char tag = r->map[pos];
+            if (tag == RECORD_TAG_SNAPSHOT) {
+                if (plies % k != 0 || pos + RECORD_SNAPSHOT_LEN > r->len) break;
+                pos += RECORD_SNAPSHOT_LEN;
+            } else if (tag == RECORD_TAG_MOVE) {
+                if (plies >= RECORD_MAX_PLIES) break;
+                ++plies;
+                pos += RECORD_UNIT;
+            } else {
+                complete = (tag == RECORD_TAG_END);
+                pos += RECORD_UNIT;
+                break;
+            }
+        }
+        if (!complete || pos - start != record_block_len(plies, k)) break;
+        RecordIndexEntry e = { start, plies, (char)r->map[pos - 3], r->map[pos - 2], 0 };
+        if (record_push(&r->rebuilt, &r->games, &cap, &e) != 0) return -1;
+        r->data_end = pos;
+    }
+    r->index = r->rebuilt;
+    return 0;
+}
+
+/**
+ * \fn void record_reader_close(RecordReader *r)
+ * \brief Libère la projection et l'index reconstruit.
+ */
+void record_reader_close(RecordReader *r) {
+    unmap_file((void *)r->map, r->len);
+    free(r->rebuilt);
+    memset(r, 0, sizeof(*r));
+}
+
+/**
+ * \fn int record_reader_open(RecordReader *r, const char *path)
+ * \brief Projette un fichier de parties et trouve son index (pied, ou parcours des blocs).
+ *
+ * \param r Lecture (retour).
+ * \param path Fichier.
+ * \return 0 si succès, -1 sinon.
+ */
+int record_reader_open(RecordReader *r, const char *path) {
+    memset(r, 0, sizeof(*r));
+    void *data = NULL;
+    size_t len = 0;
+    if (map_file(path, &data, &len) != 0) return -1;
+    r->map = data;
+    r->len = len;
+
+    RecordHeader h;
+    if (len < sizeof(h)) { record_reader_close(r); return -1; }
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0 || h.version != RECORD_VERSION ||
+        h.snap_every == 0 || h.snap_every > RECORD_MAX_SNAP_EVERY) {
+        record_reader_close(r);
+        return -1;
+    }
+    r->snap_every = h.snap_every;
+
+    RecordTrailer t;
+    if (len >= sizeof(h) + sizeof(t)) {
+        memcpy(&t, r->map + len - sizeof(t), sizeof(t));
+        uint64_t index_end = len - sizeof(t);
+        if (memcmp(t.magic, RECORD_INDEX_MAGIC, sizeof(RECORD_INDEX_MAGIC)) == 0 &&
+            t.index_offset >= sizeof(h) && t.index_offset % 8 == 0 && t.index_offset <= index_end &&
+            (index_end - t.index_offset) / sizeof(RecordIndexEntry) == t.games &&
+            (index_end - t.index_offset) % sizeof(RecordIndexEntry) == 0) {
+            r->index = (const RecordIndexEntry *)(r->map + t.index_offset);
+            r->games = (size_t)t.games;
+            const RecordIndexEntry *last = r->games ? &r->index[r->games - 1] : NULL;
+            r->data_end = last ? last->offset + record_block_len(last->plies, r->snap_every) : sizeof(h);
+            if (r->data_end <= t.index_offset) return 0;
+            r->index = NULL;
+            r->games = 0;
+        }
+    }
+    if (record_rebuild(r) != 0) {
+        record_reader_close(r);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \fn static const RecordIndexEntry *record_entry(const RecordReader *r, size_t game)
+ * \brief Entrée d'une partie, si son bloc tient dans le fichier.
+ */
+static const RecordIndexEntry *record_entry(const RecordReader *r, size_t game) {
+    if (!r->map || game >= r->games) return NULL;
+    const RecordIndexEntry *e = &r->index[game];
+    if (e->plies > RECORD_MAX_PLIES || e->offset < sizeof(RecordHeader) ||
+        e->offset + record_block_len(e->plies, r->snap_every) > r->data_end ||
+        r->map[e->offset] != RECORD_TAG_GAME) return NULL;
+    return e;
+}
+
+/**
+ * \fn int record_move(const RecordReader *r, size_t game, int ply, int *from_sq, int *to_sq)
+ * \brief Lit un coup d'une partie.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int record_move(const RecordReader *r, size_t game, int ply, int *from_sq, int *to_sq) {
+    const RecordIndexEntry *e = record_entry(r, game);
+    if (!e || ply < 0 || (uint32_t)ply >= e->plies) return -1;
+    const unsigned char *m = r->map + record_move_off(e->offset, (uint32_t)ply, r->snap_every);
+    if (m[0] != RECORD_TAG_MOVE || m[1] > 80 || m[2] > 80) return -1;
+    *from_sq = m[1];
+    *to_sq = m[2];
+    return 0;
+}
+
+/**
+ * \fn int record_seek(const RecordReader *r, size_t game, int ply, GameState *out)
+ * \brief Position après `ply` coups : instantané le plus proche avant, puis les coups qui suivent.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int record_seek(const RecordReader *r, size_t game, int ply, GameState *out) {
+    const RecordIndexEntry *e = record_entry(r, game);
+    if (!e || ply < 0 || (uint32_t)ply > e->plies) return -1;
+    uint32_t k = r->snap_every;
+    uint32_t j = (uint32_t)ply / k;
+    if (e->plies > 0 && j > (e->plies - 1) / k) j = (e->plies - 1) / k; // pas d'instantané après le dernier coup
+    uint64_t so = record_snapshot_off(e->offset, j, k);
+    if (r->map[so] != RECORD_TAG_SNAPSHOT) return -1;
+    SyncState snap;
+    memcpy(&snap, r->map + so + RECORD_UNIT, sizeof(snap));
+    GameState s;
+    if (sync_to_state(&snap, &s) != 0) return -1;
+    for (uint32_t p = j * k; p < (uint32_t)ply; ++p) {
+        int from, to;
+        if (record_move(r, game, (int)p, &from, &to) != 0) return -1;
+        Move mv = { rules_piece_at(&s, from), from / 9, from % 9, to / 9, to % 9 };
+        RulesResult res;
+        if (mv.piece_index < 0 || !rules_play(&s, &mv, max_turn, &res)) return -1;
+    }
+    *out = s;
+    return 0;
+}
+
+/**
+ * \fn int record_writer_open(RecordWriter *w, const char *path, int snap_every)
+ * \brief Crée un fichier de parties ou le rouvre en ajout (index repris, partie incomplète effacée).
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int record_writer_open(RecordWriter *w, const char *path, int snap_every) {
+    memset(w, 0, sizeof(*w));
+    if (!path || snap_every < 0 || snap_every > RECORD_MAX_SNAP_EVERY) return -1;
+    w->snap_every = snap_every ? (uint32_t)snap_every : RECORD_DEFAULT_SNAP_EVERY;
+
+    long existing = 0;
+    FILE *probe = fopen(path, "rb");
+    if (probe) {
+        if (fseek(probe, 0, SEEK_END) == 0) existing = ftell(probe);
+        fclose(probe);
+    }
+    if (existing > 0) {
+        RecordReader r;
+        if (record_reader_open(&r, path) != 0) return -1; // fichier d'un autre format : il n'est pas écrasé
+        w->snap_every = r.snap_every;
+        w->end = r.data_end;
+        for (size_t i = 0; i < r.games; ++i) {
+            if (record_push(&w->index, &w->count, &w->cap, &r.index[i]) != 0) {
+                record_reader_close(&r);
+                free(w->index);
+                return -1;
+            }
+        }
+        record_reader_close(&r);
+        w->f = fopen(path, "r+b");
+#ifndef _WIN32
+        if (w->f && ftruncate(fileno(w->f), (off_t)w->end) != 0) { fclose(w->f); w->f = NULL; }
+#else
+        if (w->f && _chsize(_fileno(w->f), (long)w->end) != 0) { fclose(w->f); w->f = NULL; }
+#endif
+        if (!w->f || fseek(w->f, (long)w->end, SEEK_SET) != 0) {
+            if (w->f) fclose(w->f);
+            free(w->index);
+            memset(w, 0, sizeof(*w));
+            return -1;
+        }
+        return 0;
+    }
+
+    w->f = fopen(path, "wb");
+    if (!w->f) return -1;
+    RecordHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+    h.version = RECORD_VERSION;
+    h.snap_every = w->snap_every;
+    if (fwrite(&h, sizeof(h), 1, w->f) != 1) {
+        fclose(w->f);
+        w->f = NULL;
+        return -1;
+    }
+    w->end = sizeof(h);
+    return 0;
+}
+
+/**
+ * \fn int record_writer_append(RecordWriter *w, const GameState *start, const uint8_t (*moves)[2], int plies, char winner, int end)
+ * \brief Prépare le bloc d'une partie en mémoire (instantanés compris) et l'écrit d'un coup.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int record_writer_append(RecordWriter *w, const GameState *start, const uint8_t (*moves)[2], int plies,
+                         char winner, int end) {
+    if (!w->f || plies < 0 || plies > RECORD_MAX_PLIES) return -1;
+    uint32_t k = w->snap_every;
+    uint64_t len = record_block_len((uint32_t)plies, k);
+    unsigned char *block = calloc(1, (size_t)len);
+    if (!block) return -1;
+
+    GameState s = *start;
+    SyncState snap;
+    block[0] = RECORD_TAG_GAME;
+    int ok = 1;
+    for (int p = 0; p <= plies && ok; ++p) {
+        if (p % (int)k == 0 && (p < plies || p == 0)) {
+            unsigned char *rec = block + record_snapshot_off(0, (uint32_t)p / k, k);
+            rec[0] = RECORD_TAG_SNAPSHOT;
+            sync_from_state(&s, &snap);
+            memcpy(rec + RECORD_UNIT, &snap, sizeof(snap));
+        }
+        if (p == plies) break;
+        int from = moves[p][0], to = moves[p][1];
+        Move mv = { from < 81 ? rules_piece_at(&s, from) : -1, from / 9, from % 9, to / 9, to % 9 };
+        RulesResult res;
+        ok = to < 81 && mv.piece_index >= 0 && s.pieces[mv.piece_index].color == s.current_player &&
+             rules_play(&s, &mv, max_turn, &res) && (!res.winner || p == plies - 1);
+        unsigned char *rec = block + record_move_off(0, (uint32_t)p, k);
+        rec[0] = RECORD_TAG_MOVE;
+        rec[1] = (unsigned char)from;
+        rec[2] = (unsigned char)to;
+    }
+    unsigned char *tail = block + len - RECORD_UNIT;
+    tail[0] = RECORD_TAG_END;
+    tail[1] = (unsigned char)winner;
+    tail[2] = (unsigned char)end;
+
+    RecordIndexEntry e = { w->end, (uint32_t)plies, winner, (uint8_t)end, 0 };
+    if (ok) ok = fwrite(block, 1, (size_t)len, w->f) == (size_t)len && record_push(&w->index, &w->count, &w->cap, &e) == 0;
+    free(block);
+    if (!ok) return -1;
+    w->end += len;
+    return 0;
+}
+
+/**
+ * \fn int record_writer_close(RecordWriter *w)
+ * \brief Écrit l'index (aligné sur 8 octets) et le pied, puis ferme le fichier.
+ *
+ * \return 0 si succès, -1 sinon.
+ */
+int record_writer_close(RecordWriter *w) {
+    if (!w->f) return -1;
+    static const unsigned char zeros[8] = { 0 };
+    size_t pad = (size_t)((8 - w->end % 8) % 8);
+    RecordTrailer t;
+    memset(&t, 0, sizeof(t));
+    memcpy(t.magic, RECORD_INDEX_MAGIC, sizeof(RECORD_INDEX_MAGIC));
+    t.index_offset = w->end + pad;
+    t.games = w->count;
+    int ok = fwrite(zeros, 1, pad, w->f) == pad &&
+             (w->count == 0 || fwrite(w->index, sizeof(RecordIndexEntry), w->count, w->f) == w->count) &&
+             fwrite(&t, sizeof(t), 1, w->f) == 1;
+    if (fclose(w->f) != 0) ok = 0;
+    free(w->index);
+    memset(w, 0, sizeof(*w));
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,532 @@
+/**
+ * \file rules.c
+ * \brief Règles du jeu sur un état explicite, sans variable globale ni GTK.
+ *
+ * \details
+ * Implémentations principales :
+ * - Conversion entre `GameState` et le format de l'interface (`pieces[]`, `cell_control`)
+ * - Plateau case → pièce, bitboards et clé de Zobrist tenus à jour ensemble
+ * - Déplacements, captures Linca et Seltou, contrôle des cases
+ * - Coup joué / annulé pour la recherche (rules_make_move(), rules_unmake_move())
+ * - Coup de partie complet avec son issue (rules_play())
+ *
+ * Toutes les fonctions travaillent sur l'état reçu : appelées sur des états
+ * distincts, elles peuvent tourner en parallèle.
+ */
+
+#include "rules.h"
+#include "tt.h"
+#include "geometry.h"
+#include <string.h>
+
+_Static_assert(sizeof(GameState) == RULES_STATE_SIZE, "GameState : disposition inattendue");
+
+/**
+ * \fn static inline int in_bounds(int r, int c)
+ * \brief Vérifie si une case est dans les limites du plateau.
+ */
+static inline int in_bounds(int r, int c) { return r >= 0 && r < 9 && c >= 0 && c < 9; }
+
+/**
+ * \fn static inline uint64_t rules_piece_key(const StatePiece* p)
+ * \brief Valeur de Zobrist d'une pièce sur sa case.
+ */
+static inline uint64_t rules_piece_key(const StatePiece* p) {
+    return zobrist_piece[rules_color_idx(p->color)][p->type == 'K'][p->sq];
+}
+
+/**
+ * \fn static inline uint64_t rules_control_key(int value, int sq)
+ * \brief Valeur de Zobrist d'une case de contrôle (0 pour une case neutre).
+ */
+static inline uint64_t rules_control_key(int value, int sq) {
+    return (value == 1 || value == 2) ? zobrist_control[value - 1][sq] : 0;
+}
+
+/**
+ * \fn static inline int rules_control_at(const GameState* s, int sq)
+ * \brief Valeur de contrôle d'une case lue dans les plans `control`.
+ *
+ * \return 0 (neutre), 1 (Bleu) ou 2 (Rouge).
+ */
+static inline int rules_control_at(const GameState* s, int sq) {
+    return bb_test(s->control[0], sq) ? 1 : bb_test(s->control[1], sq) ? 2 : 0;
+}
+
+/**
+ * \fn static void rules_set_control(GameState* s, int sq, int value)
+ * \brief Écrit une case des plans de contrôle et met à jour la clé de Zobrist.
+ *
+ * Les plans complets sont sauvegardés dans `MoveUndo` : rien à mémoriser ici.
+ */
+static void rules_set_control(GameState* s, int sq, int value) {
+    Bitboard b = bb_bit(sq);
+    s->hash ^= rules_control_key(rules_control_at(s, sq), sq) ^ rules_control_key(value, sq);
+    s->control[0] &= ~b;
+    s->control[1] &= ~b;
+    if (value == 1 || value == 2) s->control[value - 1] |= b;
+}
+
+/**
+ * \fn static void rules_mark_control(GameState* s, int sq, int ci)
+ * \brief Case traversée par une pièce : elle passe sous son contrôle, sauf les cités.
+ */
+static void rules_mark_control(GameState* s, int sq, int ci) {
+    if (sq == RULES_BLUE_CITY || sq == RULES_RED_CITY) return;
+    rules_set_control(s, sq, ci + 1);
+}
+
+/**
+ * \fn static void rules_remove_piece(GameState* s, int idx, MoveUndo* u, RulesResult* res, char rule)
+ * \brief Retire une pièce capturée (bitboards, plateau, roi et tableau compacté).
+ *
+ * \param s État du jeu.
+ * \param idx Index de la pièce à retirer.
+ * \param u Entrée d'annulation à compléter (peut être NULL).
+ * \param res Captures constatées (peut être NULL).
+ * \param rule 'L' (Linca) ou 'S' (Seltou).
+ */
+static void rules_remove_piece(GameState* s, int idx, MoveUndo* u, RulesResult* res, char rule) {
+    const StatePiece* p = &s->pieces[idx];
+    int ci = rules_color_idx(p->color);
+    if (u && u->capture_count < RULES_MAX_CAPTURES) {
+        u->captured_slot[u->capture_count] = idx;
+        u->captured[u->capture_count] = *p;
+        u->capture_count++;
+    }
+    if (res && res->capture_count < RULES_MAX_CAPTURES)
+        res->captures[res->capture_count++] = (RulesCapture){ p->sq, (uint8_t)idx, p->color, p->type, rule };
+    s->occ[ci] &= ~bb_bit(p->sq);
+    s->board[p->sq] = -1;
+    s->hash ^= rules_piece_key(p);
+    if (p->type == 'K') s->king_sq[ci] = -1;
+    else s->pawn_count[ci]--;
+    for (int k = idx; k < s->piece_count - 1; ++k) {
+        s->pieces[k] = s->pieces[k+1];
+        if (s->pieces[k].sq < 81) s->board[s->pieces[k].sq] = (int8_t)k;
+    }
+    --s->piece_count;
+}
+
+/**
+ * \fn void rules_linca(GameState* s, int moved_index, MoveUndo* u, RulesResult* res)
+ * \brief Captures par encadrement (Linca) autour de la pièce qui vient d'arriver.
+ *
+ * \param s État du jeu.
+ * \param moved_index Index de la pièce déplacée.
+ * \param u Entrée d'annulation à compléter (NULL si le coup ne sera pas annulé).
+ * \param res Captures constatées (peut être NULL).
+ */
+void rules_linca(GameState* s, int moved_index, MoveUndo* u, RulesResult* res) {
+    const StatePiece* moved = &s->pieces[moved_index];
+    int ally = rules_color_idx(moved->color);
+    int enemy = 1 - ally;
+    const GeoPair* pairs = geo_pair[moved->sq];
+
+    for (int d = 0; d < GEO_DIRS; ++d) {
+        int sq1 = pairs[d].near, sq2 = pairs[d].far;
+        if (sq2 < 0) continue;
+
+        if (bb_test(s->occ[enemy], sq1) && bb_test(s->occ[ally], sq2)) {
+            int idx1 = s->board[sq1];
+
+            // Roi capturé → la partie est finie
+            if (s->pieces[idx1].type == 'K') {
+                rules_remove_piece(s, idx1, u, res, 'L');
+                return;
+            }
+
+            rules_set_control(s, sq1, 0);
+            rules_remove_piece(s, idx1, u, res, 'L');
+            // recommencer la boucle direction (au cas de chaînes)
+            d = -1;
+        }
+    }
+}
+
+/**
+ * \fn void rules_seltou(GameState* s, int moved_index, int from, MoveUndo* u, RulesResult* res)
+ * \brief Capture par arrière vide (Seltou) : la pièce poussée n'est pas protégée.
+ *
+ * \param s État du jeu.
+ * \param moved_index Index de la pièce déplacée.
+ * \param from Case de départ de la pièce.
+ * \param u Entrée d'annulation à compléter (NULL si le coup ne sera pas annulé).
+ * \param res Captures constatées (peut être NULL).
+ */
+void rules_seltou(GameState* s, int moved_index, int from, MoveUndo* u, RulesResult* res) {
+    const StatePiece* moved = &s->pieces[moved_index];
+    int enemy = 1 - rules_color_idx(moved->color);
+    int to = moved->sq;
+
+    int d = geo_dir(from, to);
+    if (d < 0) return; // pas de mouvement orthogonal
+
+    GeoPair pr = geo_pair[to][d];
+    if (pr.near < 0 || !bb_test(s->occ[enemy], pr.near)) return;
+    if (pr.far >= 0 && bb_test(s->occ[enemy], pr.far)) return; // protégé
+
+    int idx_enemy = s->board[pr.near];
+    if (s->pieces[idx_enemy].type != 'K') rules_set_control(s, pr.near, 0);
+    rules_remove_piece(s, idx_enemy, u, res, 'S');
+}
+
+/**
+ * \fn static void rules_apply(GameState* s, const Move* mv, MoveUndo* u, RulesResult* res)
+ * \brief Déplace la pièce et applique les captures, sans changer le trait.
+ *
+ * \param s État du jeu.
+ * \param mv Coup à appliquer.
+ * \param u Entrée d'annulation à remplir (NULL si le coup ne sera pas annulé).
+ * \param res Captures constatées (peut être NULL).
+ */
+static void rules_apply(GameState* s, const Move* mv, MoveUndo* u, RulesResult* res) {
+    if (u) {
+        u->moved_index = -1;
+        u->capture_count = 0;
+        u->occ[0] = s->occ[0];
+        u->occ[1] = s->occ[1];
+        u->control[0] = s->control[0];
+        u->control[1] = s->control[1];
+        u->king_sq[0] = s->king_sq[0];
+        u->king_sq[1] = s->king_sq[1];
+        u->pawn_count[0] = s->pawn_count[0];
+        u->pawn_count[1] = s->pawn_count[1];
+        u->hash = s->hash;
+    }
+    if (mv->piece_index < 0 || mv->piece_index >= s->piece_count) return;
+    StatePiece* p = &s->pieces[mv->piece_index];
+    int from = p->sq, to = BB_SQ(mv->to_row, mv->to_col);
+    int ci = rules_color_idx(p->color);
+    if (u) {
+        u->moved_index = mv->piece_index;
+        u->from_sq = from;
+    }
+
+    // Marquer les cases contrôlées (persistantes dans ce jeu)
+    rules_mark_control(s, from, ci);
+
+    s->occ[ci] &= ~bb_bit(from);
+    s->board[from] = -1;
+    s->hash ^= rules_piece_key(p);
+    p->sq = (uint8_t)to;
+    s->occ[ci] |= bb_bit(to);
+    s->board[to] = (int8_t)mv->piece_index;
+    s->hash ^= rules_piece_key(p);
+    if (p->type == 'K') s->king_sq[ci] = (signed char)to;
+
+    rules_mark_control(s, to, ci);
+
+    rules_linca(s, mv->piece_index, u, res);
+    if (s->king_sq[1 - ci] < 0) return; // roi capturé : pas de Seltou
+    // Linca peut avoir compacté le tableau : la pièce jouée est retrouvée par sa case
+    rules_seltou(s, s->board[to], from, u, res);
+}
+
+/**
+ * \fn void rules_make_move(GameState* s, const Move* mv, MoveUndo* u)
+ * \brief Joue un coup (captures comprises), passe la main et remplit l'entrée d'annulation.
+ *
+ * \param s État du jeu (synchronisé).
+ * \param mv Coup à jouer.
+ * \param u Entrée d'annulation, à passer telle quelle à rules_unmake_move().
+ */
+void rules_make_move(GameState* s, const Move* mv, MoveUndo* u) {
+    u->current_player = s->current_player;
+    u->turn_number = s->turn_number;
+    rules_apply(s, mv, u, NULL);
+    s->current_player = (s->current_player == 'R') ? 'B' : 'R';
+    s->hash ^= zobrist_side;
+    s->turn_number++;
+}
+
+/**
+ * \fn void rules_unmake_move(GameState* s, const MoveUndo* u)
+ * \brief Annule le dernier coup joué par rules_make_move().
+ *
+ * Les plans de contrôle et les bitboards sont restaurés d'un bloc, puis les
+ * pièces capturées sont réinsérées à leur emplacement d'origine
+ * (dans l'ordre inverse des captures), ce qui redonne au tableau `pieces[]`
+ * et au plateau exactement leur disposition d'avant le coup.
+ *
+ * \param s État du jeu.
+ * \param u Entrée remplie par l'appel correspondant à rules_make_move().
+ */
+void rules_unmake_move(GameState* s, const MoveUndo* u) {
+    for (int i = u->capture_count - 1; i >= 0; --i) {
+        int slot = u->captured_slot[i];
+        for (int k = s->piece_count; k > slot; --k) {
+            s->pieces[k] = s->pieces[k-1];
+            if (s->pieces[k].sq < 81) s->board[s->pieces[k].sq] = (int8_t)k;
+        }
+        s->pieces[slot] = u->captured[i];
+        s->board[u->captured[i].sq] = (int8_t)slot;
+        s->piece_count++;
+    }
+
+    if (u->moved_index >= 0) {
+        StatePiece* p = &s->pieces[u->moved_index];
+        s->board[p->sq] = -1;
+        p->sq = (uint8_t)u->from_sq;
+        s->board[u->from_sq] = (int8_t)u->moved_index;
+    }
+    s->occ[0] = u->occ[0];
+    s->occ[1] = u->occ[1];
+    s->control[0] = u->control[0];
+    s->control[1] = u->control[1];
+    s->king_sq[0] = u->king_sq[0];
+    s->king_sq[1] = u->king_sq[1];
+    s->pawn_count[0] = u->pawn_count[0];
+    s->pawn_count[1] = u->pawn_count[1];
+    s->hash = u->hash;
+    s->current_player = u->current_player;
+    s->turn_number = u->turn_number;
+}
+
+/**
+ * \fn Bitboard rules_destinations(const GameState* s, int index)
+ * \brief Cases atteignables par une pièce (glissement orthogonal sans saut).
+ */
+Bitboard rules_destinations(const GameState* s, int index) {
+    if (index < 0 || index >= s->piece_count || s->pieces[index].sq >= 81) return 0;
+    int from = s->pieces[index].sq;
+    Bitboard occ = rules_occupied(s), reach = 0;
+    for (int d = 0; d < GEO_DIRS; ++d) reach |= geo_slide(from, d, occ);
+    return reach;
+}
+
+/**
+ * \fn int rules_can_move(const GameState* s, int index, int to_row, int to_col)
+ * \brief Vérifie si une pièce peut se déplacer vers une case donnée.
+ *
+ * \return 1 si le déplacement est possible, 0 sinon.
+ */
+int rules_can_move(const GameState* s, int index, int to_row, int to_col) {
+    if (!in_bounds(to_row, to_col)) return 0;
+    if (index < 0 || index >= s->piece_count || s->pieces[index].sq >= 81) return 0;
+    int from = s->pieces[index].sq;
+    int to = BB_SQ(to_row, to_col);
+
+    int d = geo_dir(from, to);
+    if (d < 0) return 0; // pas diagonal (ni sur place)
+
+    // Le rayon s'arrête avant la première pièce rencontrée
+    return bb_test(geo_slide(from, d, rules_occupied(s)), to);
+}
+
+/**
+ * \fn char rules_auto_defeat(const GameState* s)
+ * \brief Camp réduit à son roi et un seul soldat.
+ *
+ * \return 'B' ou 'R' (le perdant), 0 sinon.
+ */
+char rules_auto_defeat(const GameState* s) {
+    if (s->king_sq[0] >= 0 && s->pawn_count[0] == 1) return 'B';
+    if (s->king_sq[1] >= 0 && s->pawn_count[1] == 1) return 'R';
+    return 0;
+}
+
+/**
+ * \fn char rules_winner(const GameState* s, RulesEnd* end)
+ * \brief Vainqueur d'une position (roi capturé, roi dans la cité, auto-défaite).
+ *
+ * \param s État du jeu.
+ * \param end Raison (retour, peut être NULL).
+ * \return 'B' ou 'R', 0 si la partie continue.
+ */
+char rules_winner(const GameState* s, RulesEnd* end) {
+    char winner = 0;
+    RulesEnd why = RULES_END_NONE;
+    int blue_ksq = s->king_sq[0], red_ksq = s->king_sq[1];
+    if (blue_ksq < 0 && red_ksq < 0) {
+        // Position sans rois (diagramme de test) : jamais terminale
+    } else if (blue_ksq < 0 || red_ksq < 0) {
+        winner = (blue_ksq < 0) ? 'R' : 'B';
+        why = RULES_END_KING_CAPTURED;
+    } else if (red_ksq == RULES_BLUE_CITY || blue_ksq == RULES_RED_CITY) {
+        winner = (red_ksq == RULES_BLUE_CITY) ? 'R' : 'B';
+        why = RULES_END_KING_IN_CITY;
+    } else {
+        char loser = rules_auto_defeat(s);
+        if (loser) {
+            winner = (loser == 'B') ? 'R' : 'B';
+            why = RULES_END_AUTO_DEFEAT;
+        }
+    }
+    if (end) *end = why;
+    return winner;
+}
+
+/**
+ * \fn void rules_scores(const GameState* s, int* blue, int* red)
+ * \brief Scores du jeu (pièces + cases contrôlées - 1), comme update_scores().
+ */
+void rules_scores(const GameState* s, int* blue, int* red) {
+    *blue = bb_popcount(s->occ[0]) + bb_popcount(s->control[0]) - 1;
+    *red  = bb_popcount(s->occ[1]) + bb_popcount(s->control[1]) - 1;
+}
+
+/**
+ * \fn int rules_legal_moves(const GameState* s, Move* out)
+ * \brief Génère les coups du joueur au trait (aucun si la partie est finie).
+ *
+ * \param s État du jeu (synchronisé).
+ * \param out Tableau d'au moins RULES_MAX_MOVES coups.
+ * \return Nombre de coups.
+ */
+int rules_legal_moves(const GameState* s, Move* out) {
+    if (rules_winner(s, NULL)) return 0;
+    int n = 0;
+    Bitboard occ = rules_occupied(s);
+    for (int i = 0; i < s->piece_count; ++i) {
+        if (s->pieces[i].color != s->current_player || s->pieces[i].sq >= 81) continue;
+        int from = s->pieces[i].sq;
+        int r = from / 9, c = from % 9;
+        Bitboard t;
+        int sq;
+        // Destinations énumérées en s'éloignant de la pièce (est, ouest, sud, nord)
+        for (t = geo_slide(from, 3, occ); t; t ^= bb_bit(sq)) { sq = bb_lsb(t); out[n++] = (Move){i, r, c, r, sq % 9}; }
+        for (t = geo_slide(from, 2, occ); t; t ^= bb_bit(sq)) { sq = bb_msb(t); out[n++] = (Move){i, r, c, r, sq % 9}; }
+        for (t = geo_slide(from, 1, occ); t; t ^= bb_bit(sq)) { sq = bb_lsb(t); out[n++] = (Move){i, r, c, sq / 9, c}; }
+        for (t = geo_slide(from, 0, occ); t; t ^= bb_bit(sq)) { sq = bb_msb(t); out[n++] = (Move){i, r, c, sq / 9, c}; }
+    }
+    return n;
+}
+
+/**
+ * \fn int rules_play(GameState* s, const Move* mv, int max_turn, RulesResult* res)
+ * \brief Joue un coup de partie et rend ses captures et son issue.
+ *
+ * \param s État du jeu (synchronisé).
+ * \param mv Coup à jouer.
+ * \param max_turn Limite de tours (0 = aucune).
+ * \param res Captures et issue (retour).
+ * \return 1 si le coup a été joué, 0 s'il est refusé.
+ */
+int rules_play(GameState* s, const Move* mv, int max_turn, RulesResult* res) {
+    memset(res, 0, sizeof(*res));
+    if (rules_winner(s, NULL) || (max_turn > 0 && s->turn_number >= max_turn)) return 0;
+    if (!rules_can_move(s, mv->piece_index, mv->to_row, mv->to_col)) return 0;
+
+    rules_apply(s, mv, NULL, res);
+    res->winner = rules_winner(s, &res->end);
+    if (!res->winner) {
+        s->current_player = (s->current_player == 'R') ? 'B' : 'R';
+        s->hash ^= zobrist_side;
+        s->turn_number++;
+    }
+    rules_scores(s, &res->score_blue, &res->score_red);
+    if (!res->winner && max_turn > 0 && s->turn_number >= max_turn) {
+        res->end = RULES_END_TURN_LIMIT;
+        res->winner = (res->score_blue > res->score_red) ? 'B'
+                    : (res->score_red > res->score_blue) ? 'R' : 'D';
+    }
+    return 1;
+}
+
+/**
+ * \fn void rules_state_load(GameState* s, const Piece* arr, int count, const int control[9][9], char player, int turn)
+ * \brief Convertit des pièces et un contrôle au format de l'interface en `GameState`.
+ *
+ * \param s État à remplir.
+ * \param arr Pièces (ligne, colonne), dans l'ordre de `pieces[]`.
+ * \param count Nombre de pièces (tronqué à RULES_MAX_PIECES).
+ * \param control Contrôle des cases (0, 1 ou 2), NULL pour un plateau neutre.
+ * \param player Joueur au trait.
+ * \param turn Numéro du tour.
+ */
+void rules_state_load(GameState* s, const Piece* arr, int count, const int control[9][9], char player, int turn) {
+    memset(s, 0, sizeof(*s));
+    if (count > RULES_MAX_PIECES) count = RULES_MAX_PIECES;
+    if (count < 0) count = 0;
+    s->piece_count = (uint8_t)count;
+    for (int i = 0; i < count; ++i) {
+        s->pieces[i].sq = in_bounds(arr[i].row, arr[i].col) ? (uint8_t)BB_SQ(arr[i].row, arr[i].col) : RULES_NO_SQ;
+        s->pieces[i].color = arr[i].color;
+        s->pieces[i].type = arr[i].type;
+    }
+    if (control)
+        for (int sq = 0; sq < 81; ++sq) {
+            int v = control[sq / 9][sq % 9];
+            if (v == 1 || v == 2) s->control[v - 1] |= bb_bit(sq);
+        }
+    s->current_player = player;
+    s->turn_number = (uint16_t)turn;
+    rules_sync(s);
+}
+
+/**
+ * \fn void rules_state_store(const GameState* s, Piece* arr, int* count, int control[9][9])
+ * \brief Recopie un `GameState` au format de l'interface.
+ *
+ * \param s État source.
+ * \param arr Pièces (au moins RULES_MAX_PIECES), NULL pour l'ignorer.
+ * \param count Nombre de pièces (retour), NULL pour l'ignorer.
+ * \param control Contrôle des cases (0, 1 ou 2), NULL pour l'ignorer.
+ */
+void rules_state_store(const GameState* s, Piece* arr, int* count, int control[9][9]) {
+    if (arr)
+        for (int i = 0; i < s->piece_count; ++i) arr[i] = rules_state_piece(s, i);
+    if (count) *count = s->piece_count;
+    if (control)
+        for (int sq = 0; sq < 81; ++sq) control[sq / 9][sq % 9] = rules_control_at(s, sq);
+}
+
+/**
+ * \fn Piece rules_state_piece(const GameState* s, int index)
+ * \brief Pièce d'un `GameState` au format `Piece`.
+ *
+ * \param s État du jeu.
+ * \param index Indice de la pièce.
+ * \return Pièce convertie (row = col = -1 hors plateau).
+ */
+Piece rules_state_piece(const GameState* s, int index) {
+    const StatePiece* p = &s->pieces[index];
+    int on_board = p->sq < 81;
+    return (Piece){ .row = on_board ? p->sq / 9 : -1, .col = on_board ? p->sq % 9 : -1,
+                    .color = p->color, .type = p->type };
+}
+
+/**
+ * \fn int rules_state_control(const GameState* s, int row, int col)
+ * \brief Valeur de contrôle d'une case au format de `cell_control`.
+ *
+ * \return 0, 1 ou 2 (0 hors plateau).
+ */
+int rules_state_control(const GameState* s, int row, int col) {
+    return in_bounds(row, col) ? rules_control_at(s, BB_SQ(row, col)) : 0;
+}
+
+/**
+ * \fn void rules_sync(GameState* jeu)
+ * \brief Reconstruit le plateau, les bitboards d'occupation, les cases des rois,
+ *        le compteur de soldats et la clé de Zobrist.
+ *
+ * Si deux pièces partagent une case, le plateau garde la première, comme
+ * find_piece_at().
+ *
+ * \param jeu État du jeu dont `pieces[]`, `control` et `current_player` font foi.
+ */
+void rules_sync(GameState* jeu) {
+    tt_init_zobrist();
+    memset(jeu->board, -1, sizeof(jeu->board));
+    jeu->occ[0] = jeu->occ[1] = 0;
+    jeu->king_sq[0] = jeu->king_sq[1] = -1;
+    jeu->pawn_count[0] = jeu->pawn_count[1] = 0;
+    jeu->hash = (jeu->current_player == 'R') ? zobrist_side : 0;
+    for (int i = 0; i < jeu->piece_count; ++i) {
+        const StatePiece* p = &jeu->pieces[i];
+        if (p->sq >= 81) continue;
+        int ci = rules_color_idx(p->color);
+        if (jeu->board[p->sq] < 0) jeu->board[p->sq] = (int8_t)i;
+        jeu->occ[ci] |= bb_bit(p->sq);
+        jeu->hash ^= rules_piece_key(p);
+        if (p->type == 'K') jeu->king_sq[ci] = (signed char)p->sq;
+        else jeu->pawn_count[ci]++;
+    }
+    jeu->control[0] &= BB_FULL;
+    jeu->control[1] &= BB_FULL & ~jeu->control[0];
+    for (int c = 0; c < 2; ++c)
+        for (Bitboard t = jeu->control[c]; t; t &= t - 1)
+            jeu->hash ^= zobrist_control[c][bb_lsb(t)];
+}
@@ -0,0 +1,434 @@
+/**
+ * \file selfplay.c
+ * \brief Parties IA contre IA sans interface graphique.
+ *
+ * \details
+ * Ce fichier implémente l'option `--selfplay` :
+ * - Lecture des configurations de moteur (`dN`, `tMS`).
+ * - Une partie complète jouée avec les règles de game.c, sans délai ni widgets.
+ * - Répartition des parties sur plusieurs processus (fork), chacun rendant
+ *   ses résultats au processus principal par un tube.
+ * - Écriture des résultats en CSV ou en JSON et bilan sur stderr.
+ * - Construction d'un livre d'ouverture à partir des premiers coups.
+ * - Ajout des parties entières à un fichier de parties (record.h).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+#include "selfplay.h"
+#include "game.h"
+#include "ia.h"
+#include "tt.h"
+#include "status.h"
+#include "args.h"
+#include "book.h"
+#include "record.h"
+
+_Static_assert(SELFPLAY_MAX_PLIES <= RECORD_MAX_PLIES, "selfplay.h : parties trop longues pour record.h");
+
+/**
+ * \fn int selfplay_parse_engine(const char *spec, EngineConfig *out)
+ * \brief Lit une configuration de moteur `dN` ou `tMS`.
+ *
+ * \param spec Texte à analyser (ex : "d4", "t100").
+ * \param out Configuration (retour).
+ * \return 0 si succès, -1 si le texte est invalide.
+ */
+int selfplay_parse_engine(const char *spec, EngineConfig *out) {
+    if (!spec || !out || (spec[0] != 'd' && spec[0] != 't') || spec[1] == '\0') return -1;
+    char *end = NULL;
+    long val = strtol(spec + 1, &end, 10);
+    if (*end != '\0' || val <= 0) return -1;
+    if (spec[0] == 'd') {
+        if (val > IA_MAX_DEPTH) return -1;
+        out->depth = (int)val;
+        out->time_ms = 0;
+    } else {
+        if (val > ARGS_MAX_TIME_MS) return -1;
+        out->depth = 0;
+        out->time_ms = (int)val;
+    }
+    return 0;
+}
+
+/**
+ * \fn static double selfplay_now(void)
+ * \brief Horloge monotone en secondes.
+ */
+static double selfplay_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * \fn static unsigned selfplay_rand(unsigned *seed)
+ * \brief Générateur pseudo-aléatoire propre à une partie (reproductible).
+ */
+static unsigned selfplay_rand(unsigned *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 16;
+}
+
+/**
+ * \fn static GameState selfplay_start_state(void)
+ * \brief Position de départ (game_start_state()), sans IA active côté interface.
+ */
+static GameState selfplay_start_state(void) {
+    ia_active = 0;
+    ia_both_active = 0;
+    return game_start_state();
+}
+
+/**
+ * \fn void selfplay_play_game(const SelfPlayConfig *cfg, int index, SelfPlayResult *out)
+ * \brief Joue une partie complète sur un état local (rules_play()).
+ *
+ * Le moteur A joue les bleus aux parties paires et les rouges aux parties
+ * impaires. Un camp sans coup légal perd la partie. Seule la position de
+ * départ passe par l'état global : la partie tient son propre historique
+ * des répétitions (ia_search_game()), indépendant des autres parties.
+ *
+ * \param cfg Paramètres de la série.
+ * \param index Numéro de la partie.
+ * \param out Résultat (retour).
+ */
+void selfplay_play_game(const SelfPlayConfig *cfg, int index, SelfPlayResult *out) {
+    memset(out, 0, sizeof(*out));
+    out->index = index;
+    out->a_color = (index & 1) ? 'R' : 'B';
+
+    GameState state = selfplay_start_state();
+    tt_clear();
+    IaHistory history;
+    ia_history_reset(&history, &state);
+    unsigned seed = 0x9E3779B9u ^ (unsigned)index * 2654435761u;
+    uint64_t book_rng = BOOK_DEFAULT_SEED ^ (uint64_t)index * 0x9E3779B97F4A7C15ULL;
+    double start = selfplay_now();
+    RulesResult res = {0};
+    char winner = 0;
+    const char *reason = NULL;
+    int plies = 0;
+
+    while (plies < SELFPLAY_MAX_PLIES) {
+        Move moves[RULES_MAX_MOVES];
+        int n = rules_legal_moves(&state, moves);
+        if (n == 0) {
+            winner = (state.current_player == 'B') ? 'R' : 'B';
+            reason = "Aucun coup légal.";
+            break;
+        }
+
+        Move mv;
+        if (plies < SELFPLAY_RANDOM_PLIES) {
+            mv = moves[selfplay_rand(&seed) % (unsigned)n];
+        } else {
+            const EngineConfig *eng = &cfg->engine[state.current_player == out->a_color ? 0 : 1];
+            GameState search = state;
+            mv.piece_index = -1;
+            ia_search_game(&search, &mv, eng->depth, eng->time_ms, NULL, &history, &book_rng, max_turn);
+            if (mv.piece_index < 0) mv = moves[0];
+        }
+
+        if (plies < SELFPLAY_OPENING_PLIES) {
+            out->opening[plies][0] = (unsigned char)(mv.from_row * 9 + mv.from_col);
+            out->opening[plies][1] = (unsigned char)(mv.to_row * 9 + mv.to_col);
+        }
+        out->moves[plies][0] = (uint8_t)(mv.from_row * 9 + mv.from_col);
+        out->moves[plies][1] = (uint8_t)(mv.to_row * 9 + mv.to_col);
+        if (!rules_play(&state, &mv, max_turn, &res)) {
+            // Coup refusé par les règles : l'IA a proposé un coup illégal
+            winner = (state.current_player == 'B') ? 'R' : 'B';
+            reason = "Coup refusé par les règles.";
+            break;
+        }
+        ++plies;
+        if (plies <= SELFPLAY_OPENING_PLIES) out->opening_len = plies;
+        if (res.winner) break;
+        ia_history_record(&history, &state);
+    }
+
+    char why[sizeof(out->reason)];
+    if (!winner && res.winner) {
+        winner = res.winner;
+        out->end = res.end;
+        status_end_reason(&res, why, sizeof(why));
+        reason = why;
+    }
+    if (!winner) { winner = 'D'; reason = "Limite de coups du banc atteinte."; }
+
+    rules_scores(&state, &out->score_blue, &out->score_red);
+    out->plies = plies;
+    out->seconds = selfplay_now() - start;
+    out->winner = (winner == 'D') ? 'D' : (winner == out->a_color ? 'A' : 'B');
+    snprintf(out->reason, sizeof(out->reason), "%s", reason ? reason : "");
+}
+
+/**
+ * \fn static void selfplay_write_quoted(FILE *f, const char *s, int json)
+ * \brief Écrit une chaîne entre guillemets, échappée pour CSV ou JSON.
+ */
+static void selfplay_write_quoted(FILE *f, const char *s, int json) {
+    fputc('"', f);
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"') fputs(json ? "\\\"" : "\"\"", f);
+        else if (json && c == '\\') fputs("\\\\", f);
+        else if (json && c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+/**
+ * \fn void selfplay_write_csv(FILE *f, const SelfPlayResult *results, int count)
+ * \brief Écrit les résultats en CSV.
+ */
+void selfplay_write_csv(FILE *f, const SelfPlayResult *results, int count) {
+    fprintf(f, "game,a_color,winner,plies,score_blue,score_red,seconds,reason\n");
+    for (int i = 0; i < count; ++i) {
+        const SelfPlayResult *r = &results[i];
+        fprintf(f, "%d,%c,%c,%d,%d,%d,%.3f,", r->index, r->a_color, r->winner,
+                r->plies, r->score_blue, r->score_red, r->seconds);
+        selfplay_write_quoted(f, r->reason, 0);
+        fputc('\n', f);
+    }
+}
+
+/**
+ * \fn void selfplay_write_json(FILE *f, const SelfPlayResult *results, int count)
+ * \brief Écrit les résultats en JSON.
+ */
+void selfplay_write_json(FILE *f, const SelfPlayResult *results, int count) {
+    fprintf(f, "[\n");
+    for (int i = 0; i < count; ++i) {
+        const SelfPlayResult *r = &results[i];
+        fprintf(f, "  {\"game\": %d, \"a_color\": \"%c\", \"winner\": \"%c\", \"plies\": %d, "
+                   "\"score_blue\": %d, \"score_red\": %d, \"seconds\": %.3f, \"reason\": ",
+                r->index, r->a_color, r->winner, r->plies, r->score_blue, r->score_red, r->seconds);
+        selfplay_write_quoted(f, r->reason, 1);
+        fprintf(f, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(f, "]\n");
+}
+
+/**
+ * \fn long selfplay_write_book(const char *path, const SelfPlayResult *results, int count)
+ * \brief Rejoue les premiers coups de chaque partie et écrit le livre d'ouverture.
+ *
+ * \param path Fichier du livre.
+ * \param results Résultats des parties.
+ * \param count Nombre de résultats.
+ * \return Nombre d'entrées écrites, -1 en cas d'erreur.
+ */
+long selfplay_write_book(const char *path, const SelfPlayResult *results, int count) {
+    BookBuilder b;
+    book_builder_init(&b);
+    const GameState start = selfplay_start_state();
+    int failed = 0;
+    for (int g = 0; g < count && !failed; ++g) {
+        const SelfPlayResult *r = &results[g];
+        char winner = (r->winner == 'D') ? 'D' : (r->winner == 'A') ? r->a_color : (r->a_color == 'B' ? 'R' : 'B');
+        GameState s = start;
+        RulesResult res;
+        for (int i = 0; i < r->opening_len; ++i) {
+            int from = r->opening[i][0], to = r->opening[i][1];
+            Move mv = { rules_piece_at(&s, from), from / 9, from % 9, to / 9, to % 9 };
+            if (mv.piece_index < 0) break;
+            int weight = (winner == 'D') ? 1 : (winner == s.current_player) ? 2 : 0;
+            if (book_builder_add(&b, &s, &mv, weight) != 0) { failed = 1; break; }
+            if (!rules_play(&s, &mv, max_turn, &res) || res.winner) break;
+        }
+    }
+    long written = failed ? -1 : book_builder_write(&b, path);
+    book_builder_free(&b);
+    return written;
+}
+
+/**
+ * \fn long selfplay_write_record(const char *path, int snap_every, const SelfPlayResult *results, int count)
+ * \brief Ajoute les parties, dans l'ordre de leur numéro, à un fichier de parties.
+ *
+ * \param path Fichier de parties.
+ * \param snap_every Coups entre deux instantanés d'un nouveau fichier.
+ * \param results Résultats des parties.
+ * \param count Nombre de résultats.
+ * \return Nombre de parties ajoutées, -1 en cas d'erreur.
+ */
+long selfplay_write_record(const char *path, int snap_every, const SelfPlayResult *results, int count) {
+    RecordWriter w;
+    if (record_writer_open(&w, path, snap_every) != 0) return -1;
+    const GameState start = selfplay_start_state();
+    long added = 0;
+    for (int g = 0; g < count; ++g) {
+        const SelfPlayResult *r = &results[g];
+        char winner = (r->winner == 'D') ? 'D' : (r->winner == 'A') ? r->a_color : (r->a_color == 'B' ? 'R' : 'B');
+        if (record_writer_append(&w, &start, r->moves, r->plies, winner, r->end) != 0) break;
+        ++added;
+    }
+    if (record_writer_close(&w) != 0 || added != count) return -1;
+    return added;
+}
+
+/**
+ * \fn static int selfplay_cmp(const void *a, const void *b)
+ * \brief Tri des résultats par numéro de partie.
+ */
+static int selfplay_cmp(const void *a, const void *b) {
+    return ((const SelfPlayResult *)a)->index - ((const SelfPlayResult *)b)->index;
+}
+
+#ifndef _WIN32
+/**
+ * \fn static int selfplay_run_workers(const SelfPlayConfig *cfg, SelfPlayResult *results)
+ * \brief Joue la série dans `cfg->workers` processus fils.
+ *
+ * Le fils k joue les parties k, k + workers, ... et écrit chaque résultat
+ * sur son tube ; le journal des coups (stdout) est redirigé vers /dev/null.
+ *
+ * \return Nombre de résultats reçus, -1 si un processus n'a pas pu être créé.
+ */
+static int selfplay_run_workers(const SelfPlayConfig *cfg, SelfPlayResult *results) {
+    int workers = cfg->workers < 1 ? 1 : cfg->workers;
+    if (workers > SELFPLAY_MAX_WORKERS) workers = SELFPLAY_MAX_WORKERS;
+    if (workers > cfg->games) workers = cfg->games;
+    int fds[SELFPLAY_MAX_WORKERS];
+    pid_t pids[SELFPLAY_MAX_WORKERS];
+    int started = 0;
+
+    fflush(stdout);
+    fflush(stderr);
+    for (; started < workers; ++started) {
+        int p[2];
+        if (pipe(p) != 0) break;
+        pid_t pid = fork();
+        if (pid < 0) { close(p[0]); close(p[1]); break; }
+        if (pid == 0) {
+            close(p[0]);
+            for (int k = 0; k < started; ++k) close(fds[k]);
+            int devnull = open("/dev/null", O_WRONLY);
+            if (devnull >= 0) { dup2(devnull, STDOUT_FILENO); close(devnull); }
+            for (int g = started; g < cfg->games; g += workers) {
+                SelfPlayResult r;
+                selfplay_play_game(cfg, g, &r);
+                if (write(p[1], &r, sizeof(r)) != (ssize_t)sizeof(r)) _exit(1);
+            }
+            close(p[1]);
+            _exit(0);
+        }
+        close(p[1]);
+        fds[started] = p[0];
+        pids[started] = pid;
+    }
+
+    // Résultats lus au fil de l'eau (un tube plein bloquerait son fils)
+    int received = 0, open_fds = started;
+    struct pollfd pfd[SELFPLAY_MAX_WORKERS];
+    size_t partial[SELFPLAY_MAX_WORKERS] = {0};
+    SelfPlayResult pending[SELFPLAY_MAX_WORKERS];
+    for (int k = 0; k < started; ++k) { pfd[k].fd = fds[k]; pfd[k].events = POLLIN; }
+    while (open_fds > 0) {
+        if (poll(pfd, (nfds_t)started, -1) < 0) break;
+        for (int k = 0; k < started; ++k) {
+            if (pfd[k].fd < 0 || !(pfd[k].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            ssize_t got = read(pfd[k].fd, (char *)&pending[k] + partial[k], sizeof(SelfPlayResult) - partial[k]);
+            if (got <= 0) {
+                close(pfd[k].fd);
+                pfd[k].fd = -1;
+                --open_fds;
+                continue;
+            }
+            partial[k] += (size_t)got;
+            if (partial[k] == sizeof(SelfPlayResult)) {
+                partial[k] = 0;
+                if (received < cfg->games) results[received++] = pending[k];
+                fprintf(stderr, "\rParties jouées : %d/%d", received, cfg->games);
+            }
+        }
+    }
+    fprintf(stderr, "\n");
+    for (int k = 0; k < started; ++k) waitpid(pids[k], NULL, 0);
+    return started == workers ? received : -1;
+}
+#endif
+
+/**
+ * \fn int run_selfplay(const SelfPlayConfig *cfg)
+ * \brief Joue la série, écrit les résultats et affiche le bilan.
+ *
+ * \param cfg Paramètres de la série.
+ * \return 0 si succès, 1 en cas d'erreur.
+ */
+int run_selfplay(const SelfPlayConfig *cfg) {
+    if (cfg->games <= 0) return 1;
+    SelfPlayResult *results = calloc((size_t)cfg->games, sizeof(SelfPlayResult));
+    if (!results) return 1;
+
+    double start = selfplay_now();
+    int count;
+#ifndef _WIN32
+    count = selfplay_run_workers(cfg, results);
+    if (count < 0) {
+        fprintf(stderr, "Erreur: impossible de lancer les processus de parties.\n");
+        free(results);
+        return 1;
+    }
+#else
+    // Pas de fork() : parties jouées à la suite dans ce processus
+    for (count = 0; count < cfg->games; ++count) selfplay_play_game(cfg, count, &results[count]);
+#endif
+    qsort(results, (size_t)count, sizeof(SelfPlayResult), selfplay_cmp);
+
+    FILE *f = stdout;
+    if (cfg->out_path && !(f = fopen(cfg->out_path, "w"))) {
+        fprintf(stderr, "Erreur: impossible d'ouvrir %s.\n", cfg->out_path);
+        free(results);
+        return 1;
+    }
+    size_t len = cfg->out_path ? strlen(cfg->out_path) : 0;
+    if (len >= 5 && strcmp(cfg->out_path + len - 5, ".json") == 0) selfplay_write_json(f, results, count);
+    else selfplay_write_csv(f, results, count);
+    if (f != stdout) fclose(f);
+
+    if (cfg->book_out) {
+        long entries = selfplay_write_book(cfg->book_out, results, count);
+        if (entries < 0) {
+            fprintf(stderr, "Erreur: impossible d'écrire le livre d'ouverture %s.\n", cfg->book_out);
+            free(results);
+            return 1;
+        }
+        fprintf(stderr, "Livre d'ouverture : %ld entrées écrites dans %s\n", entries, cfg->book_out);
+    }
+
+    if (cfg->record_path) {
+        long added = selfplay_write_record(cfg->record_path, cfg->record_every, results, count);
+        if (added < 0) {
+            fprintf(stderr, "Erreur: impossible d'enregistrer les parties dans %s.\n", cfg->record_path);
+            free(results);
+            return 1;
+        }
+        fprintf(stderr, "Enregistrement : %ld parties ajoutées à %s\n", added, cfg->record_path);
+    }
+
+    int wins_a = 0, wins_b = 0, draws = 0;
+    long plies = 0;
+    for (int i = 0; i < count; ++i) {
+        if (results[i].winner == 'A') ++wins_a;
+        else if (results[i].winner == 'B') ++wins_b;
+        else ++draws;
+        plies += results[i].plies;
+    }
+    fprintf(stderr, "Selfplay : %d parties en %.1f s (%.1f coups en moyenne) — A %d, B %d, égalités %d\n",
+            count, selfplay_now() - start, count ? (double)plies / count : 0.0, wins_a, wins_b, draws);
+
+    free(results);
+    return count == cfg->games ? 0 : 1;
+}
@@ -0,0 +1,704 @@
+/**
+ * \file server.c
+ * \brief Serveur de parties sans interface : plusieurs parties contre l'IA sur une seule écoute.
+ *
+ * \details
+ * Ce fichier implémente l'option `--serve` :
+ * - Une boucle sur un seul thread : écoute, connexions et tube de réveil
+ *   surveillés par epoll (Linux) ou poll() (autres systèmes, ou
+ *   SERVER_USE_POLL défini).
+ * - Une table de parties de taille fixe, chacune avec son GameState et son
+ *   tampon de réception (NetRecvBuffer) ; les coups du client sont vérifiés
+ *   par rules_play().
+ * - Un groupe de threads de recherche alimenté par une file de tâches ;
+ *   chaque tâche cherche une copie de la position et rend son coup par une
+ *   file de résultats et un octet écrit dans le tube de réveil.
+ * - Coups envoyés et reçus au format de TCP_Send_Message() ("A1B2").
+ * - Coups de chaque partie gardés pour l'enregistrement (record.h), ajouté
+ *   d'un bloc à la fin de la partie.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdarg.h>
+#include "server.h"
+#include "net.h"
+#include "game.h"
+#include "ia.h"
+#include "status.h"
+#include "sync.h"
+#include "record.h"
+#include "book.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#if defined(__linux__) && !defined(SERVER_USE_POLL)
+#define SERVER_EPOLL 1
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/** \brief Étiquette de l'écoute dans les événements (les parties ont leur numéro de case). */
+#define SERVER_TAG_LISTEN ((unsigned)SERVER_MAX_MATCHES)
+/** \brief Étiquette du tube de réveil. */
+#define SERVER_TAG_WAKE   ((unsigned)SERVER_MAX_MATCHES + 1)
+/** \brief Événements lus par attente au plus. */
+#define SERVER_MAX_EVENTS 64
+
+/** @brief État d'une case de la table des parties */
+typedef enum {
+    MATCH_FREE,       /**< Case libre */
+    MATCH_CLIENT,     /**< Partie en cours, au client de jouer */
+    MATCH_SEARCHING,  /**< Partie en cours, l'IA cherche son coup */
+    MATCH_DRAINING    /**< Connexion fermée pendant une recherche : la case attend son résultat */
+} match_state_t;
+
+/** @brief Une partie du serveur */
+typedef struct {
+    match_state_t state; /**< État de la case */
+    SOCKET s;            /**< Connexion du client */
+    unsigned serial;     /**< Numéro de la partie (journal) */
+    GameState game;      /**< Position de la partie */
+    NetRecvBuffer rx;    /**< Octets reçus pas encore joués */
+    char peer[48];       /**< Adresse du client */
+    int plies;           /**< Coups joués (enregistrés dans `moves` jusqu'à RECORD_MAX_PLIES) */
+    uint8_t moves[RECORD_MAX_PLIES][2]; /**< Coups joués : cases de départ et d'arrivée */
+    IaHistory history;   /**< Positions de la partie (répétitions vues par la recherche) */
+    uint64_t book_rng;   /**< Tirage du livre d'ouverture de la partie */
+} server_match_t;
+
+/** @brief Recherche confiée aux threads (tâche puis résultat) */
+typedef struct {
+    int slot;       /**< Case de la partie */
+    GameState game; /**< Position à chercher (copie) */
+    IaHistory history; /**< Positions de la partie (copie) */
+    uint64_t book_rng; /**< Tirage du livre (avancé par la recherche, rendu à la partie) */
+    Move move;      /**< Coup trouvé (piece_index = -1 si aucun) */
+} server_job_t;
+
+/** @brief File circulaire de taille fixe (une recherche au plus par case) */
+typedef struct {
+    server_job_t *items; /**< max_matches éléments */
+    int head;            /**< Premier élément */
+    int count;           /**< Éléments présents */
+} server_queue_t;
+
+#ifndef _WIN32
+/**
+ * @brief État du serveur (une instance par processus)
+ *
+ * La boucle seule touche aux parties et aux sockets ; les threads de
+ * recherche ne partagent avec elle que les deux files, sous `lock`.
+ */
+typedef struct {
+    int open;                 /**< Serveur ouvert */
+    ServerConfig cfg;         /**< Paramètres */
+    SOCKET listen_sock;       /**< Écoute */
+    int port;                 /**< Port d'écoute effectif */
+    int wake[2];              /**< Tube de réveil : lecture (boucle), écriture (threads) */
+#ifdef SERVER_EPOLL
+    int epfd;                 /**< Instance epoll */
+#endif
+    server_match_t *matches;  /**< max_matches parties */
+    unsigned next_serial;     /**< Numéro de la prochaine partie */
+    GameState start;          /**< Position de départ */
+    RecordWriter record;      /**< Fichier de parties (ouvert si cfg.record) */
+    ServerStats stats;        /**< Compteurs */
+    pthread_mutex_t lock;     /**< Protège `jobs`, `done` et `stopping` */
+    pthread_cond_t cond;      /**< Tâche disponible ou arrêt */
+    server_queue_t jobs;      /**< Recherches à faire */
+    server_queue_t done;      /**< Recherches terminées */
+    int stopping;             /**< Arrêt demandé (accès atomiques, lu par la recherche) */
+    pthread_t threads[SERVER_MAX_WORKERS]; /**< Threads de recherche */
+    int thread_count;         /**< Threads démarrés */
+} server_t;
+
+static server_t srv;
+
+/** \brief Arrêt demandé par signal (run_match_server()). */
+static volatile sig_atomic_t server_signaled = 0;
+
+/**
+ * \fn static void server_log(const char *fmt, ...)
+ * \brief Ligne du journal, préfixée par "[serveur]".
+ */
+static void server_log(const char *fmt, ...) {
+    if (!srv.cfg.log) return;
+    va_list ap;
+    va_start(ap, fmt);
+    fputs("[serveur] ", srv.cfg.log);
+    vfprintf(srv.cfg.log, fmt, ap);
+    fputc('\n', srv.cfg.log);
+    va_end(ap);
+    fflush(srv.cfg.log);
+}
+
+/**
+ * \fn static void server_queue_push(server_queue_t *q, const server_job_t *job)
+ * \brief Ajoute un élément en fin de file (place garantie : une recherche par case).
+ */
+static void server_queue_push(server_queue_t *q, const server_job_t *job) {
+    q->items[(q->head + q->count) % srv.cfg.max_matches] = *job;
+    q->count++;
+}
+
+/**
+ * \fn static void server_queue_pop(server_queue_t *q, server_job_t *job)
+ * \brief Retire le premier élément de la file (non vide).
+ */
+static void server_queue_pop(server_queue_t *q, server_job_t *job) {
+    *job = q->items[q->head];
+    q->head = (q->head + 1) % srv.cfg.max_matches;
+    q->count--;
+}
+
+/**
+ * \fn static void *server_worker(void *arg)
+ * \brief Thread de recherche : prend les tâches une à une jusqu'à l'arrêt.
+ */
+static void *server_worker(void *arg) {
+    (void)arg;
+    for (;;) {
+        server_job_t job;
+        pthread_mutex_lock(&srv.lock);
+        while (!srv.stopping && srv.jobs.count == 0) pthread_cond_wait(&srv.cond, &srv.lock);
+        if (srv.stopping) {
+            pthread_mutex_unlock(&srv.lock);
+            return NULL;
+        }
+        server_queue_pop(&srv.jobs, &job);
+        pthread_mutex_unlock(&srv.lock);
+
+        job.move.piece_index = -1;
+        ia_search_game(&job.game, &job.move, srv.cfg.engine.depth, srv.cfg.engine.time_ms, &srv.stopping,
+                       &job.history, &job.book_rng, max_turn);
+
+        pthread_mutex_lock(&srv.lock);
+        server_queue_push(&srv.done, &job);
+        pthread_mutex_unlock(&srv.lock);
+        char b = 1;
+        if (write(srv.wake[1], &b, 1) < 0 && errno != EAGAIN) perror("write");
+    }
+}
+
+/**
+ * \fn static int server_watch(SOCKET s, unsigned tag)
+ * \brief Surveille la lecture d'un descripteur (epoll ; rien à faire pour poll()).
+ */
+static int server_watch(SOCKET s, unsigned tag) {
+#ifdef SERVER_EPOLL
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = tag;
+    return epoll_ctl(srv.epfd, EPOLL_CTL_ADD, s, &ev);
+#else
+    (void)s; (void)tag;
+    return 0;
+#endif
+}
+
+/**
+ * \fn static void server_unwatch(SOCKET s)
+ * \brief Cesse de surveiller un descripteur avant sa fermeture.
+ */
+static void server_unwatch(SOCKET s) {
+#ifdef SERVER_EPOLL
+    epoll_ctl(srv.epfd, EPOLL_CTL_DEL, s, NULL);
+#else
+    (void)s;
+#endif
+}
+
+/**
+ * \fn static int server_wait(int timeout_ms, unsigned *tags)
+ * \brief Attend des descripteurs lisibles.
+ *
+ * \param timeout_ms Attente maximale (négatif = illimitée).
+ * \param tags Étiquettes des descripteurs lisibles (retour, SERVER_MAX_EVENTS au plus).
+ * \return Nombre d'étiquettes, -1 en cas d'erreur.
+ */
+static int server_wait(int timeout_ms, unsigned *tags) {
+#ifdef SERVER_EPOLL
+    struct epoll_event ev[SERVER_MAX_EVENTS];
+    int n = epoll_wait(srv.epfd, ev, SERVER_MAX_EVENTS, timeout_ms);
+    if (n < 0) return errno == EINTR ? 0 : -1;
+    for (int i = 0; i < n; ++i) tags[i] = ev[i].data.u32;
+    return n;
+#else
+    struct pollfd fds[SERVER_MAX_MATCHES + 2];
+    unsigned fd_tags[SERVER_MAX_MATCHES + 2];
+    int nfds = 0;
+    fds[nfds].fd = srv.listen_sock; fd_tags[nfds++] = SERVER_TAG_LISTEN;
+    fds[nfds].fd = srv.wake[0];     fd_tags[nfds++] = SERVER_TAG_WAKE;
+    for (int i = 0; i < srv.cfg.max_matches; ++i) {
+        if (srv.matches[i].s == INVALID_SOCKET) continue;
+        fds[nfds].fd = srv.matches[i].s;
+        fd_tags[nfds++] = (unsigned)i;
+    }
+    for (int i = 0; i < nfds; ++i) fds[i].events = POLLIN;
+    int r = poll(fds, (nfds_t)nfds, timeout_ms);
+    if (r < 0) return errno == EINTR ? 0 : -1;
+    int n = 0;
+    for (int i = 0; i < nfds && n < SERVER_MAX_EVENTS; ++i)
+        if (fds[i].revents) tags[n++] = fd_tags[i];
+    return n;
+#endif
+}
+
+/**
+ * \fn static void server_push_move(server_match_t *m, const Move *mv)
+ * \brief Garde un coup joué pour l'enregistrement de la partie et la position atteinte pour les répétitions.
+ */
+static void server_push_move(server_match_t *m, const Move *mv) {
+    ia_history_record(&m->history, &m->game);
+    if (m->plies < RECORD_MAX_PLIES) {
+        m->moves[m->plies][0] = (uint8_t)(mv->from_row * 9 + mv->from_col);
+        m->moves[m->plies][1] = (uint8_t)(mv->to_row * 9 + mv->to_col);
+    }
+    m->plies++;
+}
+
+/**
+ * \fn static void server_record_game(server_match_t *m, char winner, RulesEnd end)
+ * \brief Ajoute la partie au fichier de parties, une seule fois ; une partie interrompue sans coup est ignorée.
+ */
+static void server_record_game(server_match_t *m, char winner, RulesEnd end) {
+    if (!srv.cfg.record || (m->plies == 0 && !winner)) return;
+    int plies = m->plies;
+    if (plies > RECORD_MAX_PLIES) { plies = RECORD_MAX_PLIES; winner = 0; end = RULES_END_NONE; }
+    if (record_writer_append(&srv.record, &srv.start, m->moves, plies, winner, (int)end) != 0)
+        server_log("partie %u (%s) : enregistrement impossible", m->serial, m->peer);
+    m->plies = 0;
+}
+
+/**
+ * \fn static void server_end_match(server_match_t *m, const char *why)
+ * \brief Ferme la connexion d'une partie ; la case reste réservée si une recherche est en cours.
+ *
+ * Une partie pas encore enregistrée l'est ici comme interrompue.
+ */
+static void server_end_match(server_match_t *m, const char *why) {
+    server_record_game(m, 0, RULES_END_NONE);
+    server_log("partie %u (%s) : %s", m->serial, m->peer, why);
+    server_unwatch(m->s);
+    close(m->s);
+    m->s = INVALID_SOCKET;
+    m->state = (m->state == MATCH_SEARCHING) ? MATCH_DRAINING : MATCH_FREE;
+    srv.stats.active--;
+    srv.stats.finished++;
+}
+
+/**
+ * \fn static void server_end_game(server_match_t *m, const RulesResult *res)
+ * \brief Fin de partie selon les règles : raison au journal, connexion fermée.
+ */
+static void server_end_game(server_match_t *m, const RulesResult *res) {
+    char why[160];
+    status_end_reason(res, why, sizeof(why));
+    server_record_game(m, res->winner, res->end);
+    server_end_match(m, why);
+}
+
+/**
+ * \fn static int server_no_move(server_match_t *m)
+ * \brief Ferme la partie si le joueur au trait n'a aucun coup légal (il perd).
+ *
+ * \return 1 si la partie est finie.
+ */
+static int server_no_move(server_match_t *m) {
+    Move moves[RULES_MAX_MOVES];
+    if (rules_legal_moves(&m->game, moves) > 0) return 0;
+    server_record_game(m, m->game.current_player == 'B' ? 'R' : 'B', RULES_END_NONE);
+    server_end_match(m, m->game.current_player == 'B' ? "Les bleus n'ont aucun coup légal."
+                                                      : "Les rouges n'ont aucun coup légal.");
+    return 1;
+}
+
+/**
+ * \fn static void server_accept(void)
+ * \brief Accepte les connexions en attente ; une case libre par client, sinon refus.
+ */
+static void server_accept(void) {
+    for (;;) {
+        struct sockaddr_in sin;
+        socklen_t len = sizeof(sin);
+        SOCKET s = accept(srv.listen_sock, (struct sockaddr *)&sin, &len);
+        if (s == INVALID_SOCKET) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) perror("accept");
+            return;
+        }
+        int slot = -1;
+        for (int i = 0; i < srv.cfg.max_matches && slot < 0; ++i)
+            if (srv.matches[i].state == MATCH_FREE) slot = i;
+        if (slot < 0 || server_watch(s, (unsigned)slot) != 0) {
+            close(s);
+            srv.stats.rejected++;
+            server_log("client refusé : %d parties en cours", srv.stats.active);
+            continue;
+        }
+        server_match_t *m = &srv.matches[slot];
+        m->state = MATCH_CLIENT;
+        m->s = s;
+        net_set_low_latency(s);
+        m->serial = ++srv.next_serial;
+        m->game = srv.start;
+        m->plies = 0;
+        ia_history_reset(&m->history, &m->game);
+        m->book_rng = BOOK_DEFAULT_SEED ^ (uint64_t)m->serial * 0x9E3779B97F4A7C15ULL;
+        net_recv_reset(&m->rx);
+        char ip[INET_ADDRSTRLEN] = "?";
+        inet_ntop(AF_INET, &sin.sin_addr, ip, sizeof(ip));
+        snprintf(m->peer, sizeof(m->peer), "%s:%d", ip, ntohs(sin.sin_port));
+        srv.stats.active++;
+        server_log("partie %u (%s) : client connecté, %d partie(s) en cours", m->serial, m->peer, srv.stats.active);
+    }
+}
+
+/**
+ * \fn static void server_client_move(int slot, const char *msg)
+ * \brief Joue un coup du client puis confie la réponse de l'IA aux threads.
+ */
+static void server_client_move(int slot, const char *msg) {
+    server_match_t *m = &srv.matches[slot];
+    if (m->state != MATCH_CLIENT) {
+        server_end_match(m, "coup reçu hors du tour du client");
+        return;
+    }
+    Move mv;
+    RulesResult res;
+    if (!net_move_decode(msg, &mv.from_row, &mv.from_col, &mv.to_row, &mv.to_col)) {
+        server_end_match(m, "coup hors du plateau");
+        return;
+    }
+    mv.piece_index = rules_piece_at(&m->game, mv.from_row * 9 + mv.from_col);
+    if (mv.piece_index < 0 || m->game.pieces[mv.piece_index].color != m->game.current_player ||
+        !rules_play(&m->game, &mv, max_turn, &res)) {
+        server_end_match(m, "coup illégal du client");
+        return;
+    }
+    server_push_move(m, &mv);
+    if (res.winner) {
+        server_end_game(m, &res);
+        return;
+    }
+    if (server_no_move(m)) return;
+
+    server_job_t job;
+    job.slot = slot;
+    job.game = m->game;
+    job.history = m->history;
+    job.book_rng = m->book_rng;
+    m->state = MATCH_SEARCHING;
+    pthread_mutex_lock(&srv.lock);
+    server_queue_push(&srv.jobs, &job);
+    pthread_cond_signal(&srv.cond);
+    pthread_mutex_unlock(&srv.lock);
+}
+
+/**
+ * \fn static void server_ai_move(const server_job_t *job)
+ * \brief Coup trouvé par l'IA : joué, envoyé au client, qui reprend la main.
+ */
+static void server_ai_move(const server_job_t *job) {
+    server_match_t *m = &srv.matches[job->slot];
+    srv.stats.searches++;
+    if (m->state == MATCH_DRAINING) {
+        m->state = MATCH_FREE;
+        return;
+    }
+    m->state = MATCH_CLIENT;
+    m->book_rng = job->book_rng;
+    RulesResult res;
+    if (job->move.piece_index < 0 || !rules_play(&m->game, &job->move, max_turn, &res)) {
+        server_end_match(m, "l'IA n'a pas trouvé de coup légal");
+        return;
+    }
+    server_push_move(m, &job->move);
+    char msg[NET_MOVE_LEN + 1];
+    net_move_encode(job->move.from_row, job->move.from_col, job->move.to_row, job->move.to_col, msg);
+    if (send(m->s, msg, NET_MOVE_LEN, MSG_NOSIGNAL) != NET_MOVE_LEN) {
+        server_end_match(m, "envoi impossible, client déconnecté");
+        return;
+    }
+    if (res.winner) server_end_game(m, &res);
+    else server_no_move(m);
+}
+
+/**
+ * \fn static void server_read(int slot)
+ * \brief Connexion d'une partie lisible : joue les coups complets reçus,
+ *        répond aux PING et aux SYNC_REQUEST du client.
+ */
+static void server_read(int slot) {
+    server_match_t *m = &srv.matches[slot];
+    if (m->s == INVALID_SOCKET) return; // fermée plus tôt dans la même attente
+    int r = net_recv_fill(&m->rx, m->s);
+    if (r <= 0) {
+        if (r < 0 && (errno == EAGAIN || errno == EINTR)) return;
+        server_end_match(m, "client déconnecté");
+        return;
+    }
+    NetFrame frame;
+    while (m->s != INVALID_SOCKET && (r = net_recv_frame(&m->rx, &frame)) != 0) {
+        if (r < 0) {
+            server_end_match(m, "trame de contrôle invalide");
+            return;
+        }
+        if (frame.type == 0) server_client_move(slot, frame.move);
+        else if (frame.type == NET_CTRL_PING) net_send_control(m->s, NET_CTRL_PONG, frame.payload, frame.len);
+        else if (frame.type == NET_CTRL_SYNC_REQUEST) {
+            SyncState snap;
+            sync_from_state(&m->game, &snap);
+            net_send_control(m->s, NET_CTRL_SYNC_STATE, &snap, sizeof(snap));
+        }
+    }
+}
+
+/**
+ * \fn static void server_drain(void)
+ * \brief Vide le tube de réveil et traite les recherches terminées.
+ */
+static void server_drain(void) {
+    char buf[64];
+    while (read(srv.wake[0], buf, sizeof(buf)) > 0) {}
+    for (;;) {
+        server_job_t job;
+        pthread_mutex_lock(&srv.lock);
+        int any = srv.done.count > 0;
+        if (any) server_queue_pop(&srv.done, &job);
+        pthread_mutex_unlock(&srv.lock);
+        if (!any) return;
+        server_ai_move(&job);
+    }
+}
+
+/**
+ * \fn int server_open(const ServerConfig *cfg)
+ * \brief Ouvre l'écoute, la table des parties et les threads de recherche.
+ *
+ * \param cfg Paramètres (copiés).
+ * \return 0 si succès, -1 sinon.
+ */
+int server_open(const ServerConfig *cfg) {
+    if (srv.open || cfg->max_matches < 1 || cfg->max_matches > SERVER_MAX_MATCHES ||
+        cfg->workers < 1 || cfg->workers > SERVER_MAX_WORKERS) return -1;
+    memset(&srv, 0, sizeof(srv));
+    srv.cfg = *cfg;
+    srv.listen_sock = INVALID_SOCKET;
+    srv.wake[0] = srv.wake[1] = -1;
+#ifdef SERVER_EPOLL
+    srv.epfd = -1;
+#endif
+
+    // Position de départ des parties, comme en mode selfplay
+    srv.start = game_start_state();
+
+    srv.matches = calloc((size_t)cfg->max_matches, sizeof(*srv.matches));
+    srv.jobs.items = calloc((size_t)cfg->max_matches, sizeof(server_job_t));
+    srv.done.items = calloc((size_t)cfg->max_matches, sizeof(server_job_t));
+    if (!srv.matches || !srv.jobs.items || !srv.done.items) goto fail;
+    for (int i = 0; i < cfg->max_matches; ++i) srv.matches[i].s = INVALID_SOCKET;
+    if (cfg->record && record_writer_open(&srv.record, cfg->record, cfg->record_every) != 0) {
+        fprintf(stderr, "Erreur: impossible d'ouvrir le fichier de parties %s.\n", cfg->record);
+        goto fail;
+    }
+
+    srv.listen_sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (srv.listen_sock == INVALID_SOCKET) { perror("socket"); goto fail; }
+    int opt = 1;
+    setsockopt(srv.listen_sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    struct sockaddr_in sin;
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = INADDR_ANY;
+    sin.sin_port = htons((uint16_t)cfg->port);
+    socklen_t len = sizeof(sin);
+    if (bind(srv.listen_sock, (struct sockaddr *)&sin, sizeof(sin)) != 0 ||
+        listen(srv.listen_sock, SOMAXCONN) != 0 ||
+        getsockname(srv.listen_sock, (struct sockaddr *)&sin, &len) != 0) {
+        perror("bind");
+        goto fail;
+    }
+    srv.port = ntohs(sin.sin_port);
+
+    if (pipe(srv.wake) != 0) { perror("pipe"); goto fail; }
+    fcntl(srv.listen_sock, F_SETFL, fcntl(srv.listen_sock, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(srv.wake[0], F_SETFL, fcntl(srv.wake[0], F_GETFL, 0) | O_NONBLOCK);
+    fcntl(srv.wake[1], F_SETFL, fcntl(srv.wake[1], F_GETFL, 0) | O_NONBLOCK);
+#ifdef SERVER_EPOLL
+    srv.epfd = epoll_create1(0);
+    if (srv.epfd < 0) { perror("epoll_create1"); goto fail; }
+#endif
+    if (server_watch(srv.listen_sock, SERVER_TAG_LISTEN) != 0 || server_watch(srv.wake[0], SERVER_TAG_WAKE) != 0)
+        goto fail;
+
+    pthread_mutex_init(&srv.lock, NULL);
+    pthread_cond_init(&srv.cond, NULL);
+    srv.open = 1;
+    for (int i = 0; i < cfg->workers; ++i) {
+        if (pthread_create(&srv.threads[i], NULL, server_worker, NULL) != 0) {
+            server_close();
+            return -1;
+        }
+        srv.thread_count++;
+    }
+    server_log("écoute sur le port %d : %d parties au plus, %d thread(s) de recherche",
+               srv.port, cfg->max_matches, cfg->workers);
+    return 0;
+
+fail:
+    if (srv.listen_sock != INVALID_SOCKET) close(srv.listen_sock);
+    if (srv.wake[0] >= 0) { close(srv.wake[0]); close(srv.wake[1]); }
+#ifdef SERVER_EPOLL
+    if (srv.epfd >= 0) close(srv.epfd);
+#endif
+    if (srv.record.f) record_writer_close(&srv.record);
+    free(srv.matches);
+    free(srv.jobs.items);
+    free(srv.done.items);
+    memset(&srv, 0, sizeof(srv));
+    return -1;
+}
+
+/**
+ * \fn int server_port(void)
+ * \brief Port d'écoute effectif.
+ */
+int server_port(void) {
+    return srv.open ? srv.port : 0;
+}
+
+/**
+ * \fn int server_poll(int timeout_ms)
+ * \brief Une attente de la boucle du serveur et le traitement de ses événements.
+ *
+ * \param timeout_ms Attente maximale (négatif = illimitée).
+ * \return Nombre d'événements traités, -1 en cas d'erreur.
+ */
+int server_poll(int timeout_ms) {
+    if (!srv.open) return -1;
+    unsigned tags[SERVER_MAX_EVENTS];
+    int n = server_wait(timeout_ms, tags);
+    for (int i = 0; i < n; ++i) {
+        if (tags[i] == SERVER_TAG_LISTEN) server_accept();
+        else if (tags[i] == SERVER_TAG_WAKE) server_drain();
+        else if (tags[i] < (unsigned)srv.cfg.max_matches) server_read((int)tags[i]);
+    }
+    return n;
+}
+
+/**
+ * \fn void server_get_stats(ServerStats *out)
+ * \brief Compteurs courants du serveur.
+ */
+void server_get_stats(ServerStats *out) {
+    *out = srv.stats;
+}
+
+/**
+ * \fn void server_close(void)
+ * \brief Arrête les threads de recherche, ferme les parties et l'écoute.
+ */
+void server_close(void) {
+    if (!srv.open) return;
+    pthread_mutex_lock(&srv.lock);
+    __atomic_store_n(&srv.stopping, 1, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&srv.cond);
+    pthread_mutex_unlock(&srv.lock);
+    for (int i = 0; i < srv.thread_count; ++i) pthread_join(srv.threads[i], NULL);
+
+    for (int i = 0; i < srv.cfg.max_matches; ++i)
+        if (srv.matches[i].s != INVALID_SOCKET) server_end_match(&srv.matches[i], "arrêt du serveur");
+    if (srv.cfg.record && record_writer_close(&srv.record) != 0)
+        fprintf(stderr, "Erreur: écriture de l'index de %s impossible.\n", srv.cfg.record);
+    close(srv.listen_sock);
+    close(srv.wake[0]);
+    close(srv.wake[1]);
+#ifdef SERVER_EPOLL
+    close(srv.epfd);
+#endif
+    pthread_cond_destroy(&srv.cond);
+    pthread_mutex_destroy(&srv.lock);
+    free(srv.matches);
+    free(srv.jobs.items);
+    free(srv.done.items);
+    srv.matches = NULL;
+    srv.jobs.items = srv.done.items = NULL;
+    srv.open = 0;
+}
+
+/**
+ * \fn static void server_on_signal(int sig)
+ * \brief SIGINT / SIGTERM : demande l'arrêt de run_match_server().
+ */
+static void server_on_signal(int sig) {
+    (void)sig;
+    server_signaled = 1;
+}
+
+/**
+ * \fn int run_match_server(const ServerConfig *cfg)
+ * \brief Mode `--serve` : boucle du serveur jusqu'à SIGINT ou SIGTERM.
+ *
+ * \param cfg Paramètres.
+ * \return 0 à l'arrêt, 1 si le serveur n'a pas pu démarrer.
+ */
+int run_match_server(const ServerConfig *cfg) {
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, server_on_signal);
+    signal(SIGTERM, server_on_signal);
+    if (server_open(cfg) != 0) {
+        fprintf(stderr, "Erreur: impossible d'ouvrir le serveur sur le port %d.\n", cfg->port);
+        return 1;
+    }
+    while (!server_signaled && server_poll(500) >= 0) {}
+
+    ServerStats st;
+    server_get_stats(&st);
+    server_close();
+    if (cfg->log)
+        fprintf(cfg->log, "[serveur] arrêt : %d partie(s) terminée(s), %d client(s) refusé(s), %ld recherche(s)\n",
+                st.finished, st.rejected, st.searches);
+    return 0;
+}
+
+#else /* _WIN32 */
+
+int server_open(const ServerConfig *cfg) {
+    (void)cfg;
+    fprintf(stderr, "Erreur: le serveur de parties n'est pas disponible sous Windows.\n");
+    return -1;
+}
+
+int server_port(void) { return 0; }
+
+int server_poll(int timeout_ms) {
+    (void)timeout_ms;
+    return -1;
+}
+
+void server_get_stats(ServerStats *out) {
+    memset(out, 0, sizeof(*out));
+}
+
+void server_close(void) {}
+
+int run_match_server(const ServerConfig *cfg) {
+    return server_open(cfg) == 0 ? 0 : 1;
+}
+
+#endif
@@ -11,10 +11,15 @@
  * - L'affichage de l'état actuel du jeu.
  * - L'affichage des messages de victoire ou d'égalité.
  * - L'activation du bouton "Rejouer".
+ * - L'enregistrement de l'issue de la partie (utilisée sans interface par selfplay.c).
+ * - Les textes des fins de partie décrites par rules_play().
  */
 
+#include <stdio.h>
+#include <string.h>
 #include "status.h"
 #include "game.h"
+#include "net.h"
 
 /** \brief Label GTK pour le score de l'équipe bleue */
 static GtkWidget *g_score_blue_label  = NULL;
@@ -28,6 +33,12 @@ static GtkWidget *g_replay_button     = NULL;
 static GtkWidget *g_victory_label     = NULL;
 /** \brief Conteneur GTK pour le message de victoire */
 static GtkWidget *g_victory_box       = NULL;
+/** \brief Valeurs affichées par les labels de score (-1 = à écrire) */
+static int g_shown_scores[4] = { -1, -1, -1, -1 };
+/** \brief Issue de la partie ('B', 'R', 'D' ou 0) */
+static char g_result = 0;
+/** \brief Raison de la fin de partie */
+static char g_result_reason[160] = "";
 
 /**
  * \fn void status_register_labels(GtkWidget *score_blue_label, GtkWidget *score_red_label,
@@ -50,26 +61,75 @@ void status_register_labels(GtkWidget *score_blue_label, GtkWidget *score_red_la
     g_replay_button     = replay_button;
     g_victory_label     = victory_label;
     g_victory_box      = victory_box;
+    for (int i = 0; i < 4; ++i) g_shown_scores[i] = -1;
 }
 
 
 /**
  * \fn void status_on_scores_changed(void)
  * \brief Met à jour les labels de score avec les valeurs actuelles.
+ *
+ * Un label dont les valeurs n'ont pas changé depuis sa dernière écriture
+ * n'est pas réécrit.
  */
 void status_on_scores_changed(void) {
-    if (g_score_blue_label) {
+    if (g_score_blue_label && (g_shown_scores[0] != score_blue || g_shown_scores[1] != pieces_blue)) {
+        g_shown_scores[0] = score_blue;
+        g_shown_scores[1] = pieces_blue;
         char *txt = g_strdup_printf("• Score équipe bleue: %d\n\t%d pièces restantes", score_blue, pieces_blue);
         gtk_label_set_text(GTK_LABEL(g_score_blue_label), txt);
         g_free(txt);
     }
-    if (g_score_red_label) {
+    if (g_score_red_label && (g_shown_scores[2] != score_red || g_shown_scores[3] != pieces_red)) {
+        g_shown_scores[2] = score_red;
+        g_shown_scores[3] = pieces_red;
         char *txt = g_strdup_printf("• Score équipe rouge: %d\n\t%d pièces restantes", score_red, pieces_red);
         gtk_label_set_text(GTK_LABEL(g_score_red_label), txt);
         g_free(txt);
     }
 }
 
+/**
+ * \fn static void status_set_result(char result, const char *reason)
+ * \brief Enregistre l'issue de la partie.
+ * 
+ * \param result 'B', 'R' ou 'D'.
+ * \param reason Raison de la fin (peut être NULL).
+ */
+static void status_set_result(char result, const char *reason) {
+    g_result = result;
+    snprintf(g_result_reason, sizeof(g_result_reason), "%s", reason ? reason : "");
+}
+
+/**
+ * \fn char status_result(void)
+ * \brief Issue de la partie terminée.
+ * 
+ * \return 'B' ou 'R' (vainqueur), 'D' (égalité), 0 si la partie est en cours.
+ */
+char status_result(void) {
+    return g_result;
+}
+
+/**
+ * \fn const char *status_result_reason(void)
+ * \brief Raison de la fin de partie.
+ * 
+ * \return Texte de la raison ("" si la partie est en cours).
+ */
+const char *status_result_reason(void) {
+    return g_result_reason;
+}
+
+/**
+ * \fn void status_clear_result(void)
+ * \brief Efface l'issue enregistrée.
+ */
+void status_clear_result(void) {
+    g_result = 0;
+    g_result_reason[0] = '\0';
+}
+
 /**
  * \fn void set_draw_message(const char *reason)
  * \brief Affiche un message d'égalité avec une raison optionnelle.
@@ -77,6 +137,7 @@ void status_on_scores_changed(void) {
  * \param reason Raison de l'égalité (peut être NULL).
  */
 void set_draw_message(const char *reason) {
+    status_set_result('D', reason);
     if (!g_game_status_label) return;
     const char *color = "#6B7280"; 
     char *markup = g_strdup_printf(
@@ -97,6 +158,7 @@ void set_draw_message(const char *reason) {
  * \param reason Raison de la victoire (peut être NULL).
  */
 void set_victory_message(gboolean blue_won, const char *reason) {
+    status_set_result(blue_won ? 'B' : 'R', reason);
     if (!g_victory_label) return;
     const char *color = blue_won ? "#b3b3f0ff" : "#FF1E1E";
     const char *team  = blue_won ? "BLEUS" : "ROUGES";
@@ -112,15 +174,68 @@ void set_victory_message(gboolean blue_won, const char *reason) {
     if (g_replay_button) gtk_widget_set_sensitive(g_replay_button, TRUE);
 }
 
+/**
+ * \fn void status_end_reason(const RulesResult *res, char *buf, size_t len)
+ * \brief Texte de la raison de fin d'une partie terminée par rules_play().
+ * 
+ * \param res Issue du coup (`winner` non nul).
+ * \param buf Tampon de sortie.
+ * \param len Taille du tampon.
+ */
+void status_end_reason(const RulesResult *res, char *buf, size_t len) {
+    int blue = (res->winner == 'B');
+    switch (res->end) {
+    case RULES_END_KING_CAPTURED:
+        snprintf(buf, len, "%s", blue ? "Le roi rouge a été capturé." : "Le roi bleu a été capturé.");
+        break;
+    case RULES_END_KING_IN_CITY:
+        snprintf(buf, len, "%s", blue ? "Le roi bleu a atteint la base rouge." : "Le roi rouge a atteint la base bleue.");
+        break;
+    case RULES_END_AUTO_DEFEAT:
+        snprintf(buf, len, "%s", blue ? "Les rouges n'ont plus qu'un pion et un roi." : "Les bleus n'ont plus qu'un pion et un roi.");
+        break;
+    case RULES_END_TURN_LIMIT:
+        if (res->winner == 'D')
+            snprintf(buf, len, "Limite de %d tours atteinte — scores égaux (%d chacun).", max_turn, res->score_blue);
+        else
+            snprintf(buf, len, "Limite de %d tours atteinte — score des %s supérieur (%d vs %d).", max_turn,
+                     blue ? "bleus" : "rouges",
+                     blue ? res->score_blue : res->score_red, blue ? res->score_red : res->score_blue);
+        break;
+    default:
+        snprintf(buf, len, "%s", "");
+        break;
+    }
+}
+
+/**
+ * \fn void status_report_end(const RulesResult *res)
+ * \brief Affiche la fin de partie décrite par rules_play() (victoire ou égalité).
+ * 
+ * \param res Issue du coup (sans effet si `winner` est nul).
+ */
+void status_report_end(const RulesResult *res) {
+    if (!res->winner) return;
+    char buf[160];
+    status_end_reason(res, buf, sizeof(buf));
+    if (res->winner == 'D') set_draw_message(buf);
+    else set_victory_message(res->winner == 'B', buf);
+}
+
 /**
  * \fn void refresh_game_status(void)
- * \brief Met à jour le label de statut du jeu avec le tour actuel et la pièce sélectionnée.
+ * \brief Met à jour le label de statut du jeu avec le tour actuel et la pièce sélectionnée,
+ *        et l'aller-retour réseau mesuré par les PING en partie réseau.
  */
 void refresh_game_status(void) {
     if (!g_game_status_label) return;
     if (game_over) return; // Ne pas écraser un message de fin de partie
-    char buf[256];
-    if (selected_piece >= 0) {
+    char buf[384];
+    if (net_waiting()) {
+        snprintf(buf, sizeof(buf),
+                 "<span weight='bold'>En attente de l'adversaire…</span>\n"
+                 "La partie %s à sa connexion.", turn_number > 1 ? "reprend" : "commence");
+    } else if (selected_piece >= 0) {
         snprintf(buf, sizeof(buf),
                  "<span weight='bold'>Tour %d / %d — </span>"
                  "<span foreground='%s' weight='bold'>au tour des %s.\nPièce sélectionnée : %c en %c%d </span>",
@@ -139,5 +254,13 @@ void refresh_game_status(void) {
                  (current_turn == 'B') ? "bleus" : "rouges",
                  (current_turn == 'B') ? "bleue" : "rouge");
     }
+    NetRttStats rtt;
+    net_get_rtt(&rtt);
+    if (g_socket != INVALID_SOCKET && rtt.count > 0) {
+        size_t used = strlen(buf);
+        snprintf(buf + used, sizeof(buf) - used,
+                 "\n<span size='small'>Réseau : %.1f ms (p90 %.1f ms, p99 %.1f ms)</span>",
+                 rtt.last_ms, rtt.p90_ms, rtt.p99_ms);
+    }
     gtk_label_set_markup(GTK_LABEL(g_game_status_label), buf);
 }
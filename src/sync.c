@@ -0,0 +1,115 @@
+/**
+ * \file sync.c
+ * \brief Instantané binaire de la position : écriture, vérification, relecture.
+ *
+ * \details
+ * - L'instantané est écrit champ par champ dans une structure sans
+ *   remplissage (vérifié à la compilation), zéros compris.
+ * - Somme de contrôle FNV-1a 32 bits des octets qui précèdent `checksum`.
+ * - La relecture vérifie tout ce qu'un pair pourrait envoyer de faux avant
+ *   de toucher à l'état : signature, version, somme, bornes, cases en double,
+ *   scores recalculés.
+ */
+
+#include <string.h>
+#include <stddef.h>
+#include "sync.h"
+
+_Static_assert(sizeof(SyncState) == SYNC_STATE_SIZE, "SyncState : disposition inattendue");
+_Static_assert(offsetof(SyncState, checksum) == SYNC_STATE_SIZE - 4, "SyncState : somme de contrôle en fin");
+
+/** \brief Conversion vers et depuis le petit-boutiste de l'instantané. */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SYNC_LE16(x) __builtin_bswap16(x)
+#define SYNC_LE32(x) __builtin_bswap32(x)
+#else
+#define SYNC_LE16(x) (x)
+#define SYNC_LE32(x) (x)
+#endif
+
+/**
+ * \fn uint32_t sync_checksum(const SyncState* in)
+ * \brief FNV-1a 32 bits des octets de l'instantané jusqu'à `checksum` exclu.
+ */
+uint32_t sync_checksum(const SyncState* in) {
+    const unsigned char *p = (const unsigned char *)in;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(SyncState, checksum); ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * \fn void sync_from_state(const GameState* s, SyncState* out)
+ * \brief Écrit l'instantané d'un état.
+ */
+void sync_from_state(const GameState* s, SyncState* out) {
+    memset(out, 0, sizeof(*out));
+    memcpy(out->magic, SYNC_MAGIC, sizeof(out->magic));
+    out->version = SYNC_VERSION;
+    out->piece_count = s->piece_count;
+    out->current_turn = s->current_player;
+    out->turn_number = SYNC_LE16(s->turn_number);
+    int blue, red;
+    rules_scores(s, &blue, &red);
+    out->score_blue = SYNC_LE16((uint16_t)blue);
+    out->score_red = SYNC_LE16((uint16_t)red);
+    for (int i = 0; i < RULES_MAX_PIECES; ++i) {
+        if (i < s->piece_count) out->pieces[i] = s->pieces[i];
+        else out->pieces[i].sq = RULES_NO_SQ;
+    }
+    for (int sq = 0; sq < 81; ++sq) out->control[sq] = (uint8_t)rules_state_control(s, sq / 9, sq % 9);
+    out->checksum = SYNC_LE32(sync_checksum(out));
+}
+
+/**
+ * \fn int sync_to_state(const SyncState* in, GameState* s)
+ * \brief Vérifie un instantané puis reconstruit l'état qu'il décrit.
+ *
+ * \return 0 si succès, -1 si l'instantané est invalide (`s` inchangé).
+ */
+int sync_to_state(const SyncState* in, GameState* s) {
+    if (memcmp(in->magic, SYNC_MAGIC, sizeof(in->magic)) != 0 || in->version != SYNC_VERSION) return -1;
+    if (SYNC_LE32(in->checksum) != sync_checksum(in)) return -1;
+    if (in->piece_count > RULES_MAX_PIECES) return -1;
+    if (in->current_turn != 'B' && in->current_turn != 'R') return -1;
+
+    GameState st;
+    memset(&st, 0, sizeof(st));
+    int used[81] = { 0 };
+    for (int i = 0; i < in->piece_count; ++i) {
+        StatePiece p = in->pieces[i];
+        if ((p.color != 'B' && p.color != 'R') || (p.type != 'K' && p.type != 'P')) return -1;
+        if (p.sq != RULES_NO_SQ) {
+            if (p.sq >= 81 || used[p.sq]) return -1;
+            used[p.sq] = 1;
+        }
+        st.pieces[i] = p;
+    }
+    for (int sq = 0; sq < 81; ++sq) {
+        if (in->control[sq] > 2) return -1;
+        if (in->control[sq]) st.control[in->control[sq] - 1] |= bb_bit(sq);
+    }
+    st.piece_count = in->piece_count;
+    st.current_player = in->current_turn;
+    st.turn_number = SYNC_LE16(in->turn_number);
+    rules_sync(&st);
+
+    int blue, red;
+    rules_scores(&st, &blue, &red);
+    if ((uint16_t)blue != SYNC_LE16(in->score_blue) || (uint16_t)red != SYNC_LE16(in->score_red)) return -1;
+    *s = st;
+    return 0;
+}
+
+/**
+ * \fn uint32_t sync_state_digest(const GameState* s)
+ * \brief Empreinte d'une position (somme de contrôle de son instantané).
+ */
+uint32_t sync_state_digest(const GameState* s) {
+    SyncState snap;
+    sync_from_state(s, &snap);
+    return SYNC_LE32(snap.checksum);
+}
@@ -0,0 +1,464 @@
+/**
+ * \file tablebase.c
+ * \brief Table de finales : indexation des classes, génération rétrograde et consultation.
+ *
+ * \details
+ * - Index d'une position : trait, case du roi bleu, case du roi rouge, puis
+ *   rang de chaque ensemble de soldats dans le système combinatoire
+ *   (rang = somme des C(case_i, i) sur les cases croissantes).
+ * - Génération d'une classe : chaque position reçoit un état (en cours,
+ *   gain ou perte en attente à une distance, résolue, invalide). Les
+ *   distances sont traitées dans l'ordre croissant ; une position résolue
+ *   à la distance `d` prévient ses prédécesseurs, obtenus en ramenant une
+ *   pièce du camp qui vient de jouer le long d'une ligne vide puis en
+ *   rejouant le coup pour écarter ceux qui auraient capturé.
+ * - Un octet par position dans le fichier : 0 nul, 255 invalide, gain en
+ *   `d` codé 2d - 1, perte en `d` codée 2d + 2.
+ * - Le fichier est projeté en mémoire par map_file() (mapfile.h).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tablebase.h"
+#include "mapfile.h"
+
+/** \brief Une classe en mémoire : matériel, nombre de positions, octets codés. */
+typedef struct {
+    int pawns[2];
+    uint64_t size;
+    const uint8_t *data;
+} TbTable;
+
+/** \brief Table courante : zone projetée (ou lue) et ses classes. */
+static void *tb_map = NULL;
+static size_t tb_map_len = 0;
+static TbTable tb_tables[TB_MAX_CLASSES];
+static int tb_count = 0;
+
+/** \brief Coefficients binomiaux C(n, k), n ≤ 81, k ≤ TB_MAX_PAWNS. */
+static uint64_t tb_binom[82][TB_MAX_PAWNS + 1];
+static int tb_binom_ready = 0;
+
+/** \brief États d'une position pendant la génération. */
+enum { TB_GEN_OPEN = 0, TB_GEN_WIN_AT, TB_GEN_LOSS_AT, TB_GEN_WIN, TB_GEN_LOSS, TB_GEN_INVALID };
+
+#define TB_CODE_DRAW    0
+#define TB_CODE_INVALID 255
+
+/**
+ * \fn static void tb_init_binom(void)
+ * \brief Remplit le triangle de Pascal (une seule fois).
+ */
+static void tb_init_binom(void) {
+    if (tb_binom_ready) return;
+    for (int n = 0; n <= 81; ++n) {
+        tb_binom[n][0] = 1;
+        for (int k = 1; k <= TB_MAX_PAWNS; ++k)
+            tb_binom[n][k] = n ? tb_binom[n - 1][k - 1] + tb_binom[n - 1][k] : 0;
+    }
+    tb_binom_ready = 1;
+}
+
+/**
+ * \fn uint64_t tb_class_size(int blue_pawns, int red_pawns)
+ * \brief Positions d'une classe : 2 × 81 × 81 × C(81, b) × C(81, r).
+ */
+uint64_t tb_class_size(int blue_pawns, int red_pawns) {
+    if (blue_pawns < 0 || blue_pawns > TB_MAX_PAWNS || red_pawns < 0 || red_pawns > TB_MAX_PAWNS) return 0;
+    tb_init_binom();
+    return 2ULL * 81 * 81 * tb_binom[81][blue_pawns] * tb_binom[81][red_pawns];
+}
+
+/**
+ * \fn static uint64_t tb_rank(Bitboard pawns)
+ * \brief Rang combinatoire d'un ensemble de cases.
+ */
+static uint64_t tb_rank(Bitboard pawns) {
+    uint64_t rank = 0;
+    for (int i = 1; pawns; ++i) {
+        int sq = bb_lsb(pawns);
+        pawns &= pawns - 1;
+        rank += tb_binom[sq][i];
+    }
+    return rank;
+}
+
+/**
+ * \fn static void tb_unrank(uint64_t rank, int k, int *sq)
+ * \brief Cases (décroissantes) d'un rang combinatoire de `k` éléments.
+ */
+static void tb_unrank(uint64_t rank, int k, int *sq) {
+    int s = 80;
+    for (int i = k; i >= 1; --i) {
+        while (tb_binom[s][i] > rank) --s;
+        sq[k - i] = s;
+        rank -= tb_binom[s][i];
+        --s;
+    }
+}
+
+/**
+ * \fn uint64_t tb_index(const GameState *s)
+ * \brief Index d'une position dans sa classe.
+ */
+uint64_t tb_index(const GameState *s) {
+    tb_init_binom();
+    int b = s->pawn_count[0], r = s->pawn_count[1];
+    int bk = s->king_sq[0], rk = s->king_sq[1];
+    uint64_t idx = (uint64_t)(s->current_player == 'R') * 81 + (uint64_t)bk;
+    idx = idx * 81 + (uint64_t)rk;
+    idx = idx * tb_binom[81][b] + tb_rank(s->occ[0] & ~bb_bit(bk));
+    idx = idx * tb_binom[81][r] + tb_rank(s->occ[1] & ~bb_bit(rk));
+    return idx;
+}
+
+/**
+ * \fn int tb_decode(uint64_t idx, int blue_pawns, int red_pawns, GameState *out)
+ * \brief Position d'un index : roi bleu, soldats bleus, roi rouge, soldats rouges.
+ *
+ * \return 1 si les pièces occupent des cases distinctes, 0 sinon.
+ */
+int tb_decode(uint64_t idx, int blue_pawns, int red_pawns, GameState *out) {
+    tb_init_binom();
+    int pawns[2] = { blue_pawns, red_pawns };
+    int sq[2][TB_MAX_PAWNS];
+    uint64_t nb = tb_binom[81][blue_pawns], nr = tb_binom[81][red_pawns];
+    tb_unrank(idx % nr, red_pawns, sq[1]);
+    idx /= nr;
+    tb_unrank(idx % nb, blue_pawns, sq[0]);
+    idx /= nb;
+    int kings[2];
+    kings[1] = (int)(idx % 81);
+    idx /= 81;
+    kings[0] = (int)(idx % 81);
+    idx /= 81;
+
+    memset(out, 0, sizeof(*out));
+    Bitboard used = 0;
+    int n = 0;
+    for (int c = 0; c < 2; ++c) {
+        char color = c ? 'R' : 'B';
+        if (used & bb_bit(kings[c])) return 0;
+        used |= bb_bit(kings[c]);
+        out->pieces[n++] = (StatePiece){ (uint8_t)kings[c], color, 'K' };
+        for (int i = 0; i < pawns[c]; ++i) {
+            if (used & bb_bit(sq[c][i])) return 0;
+            used |= bb_bit(sq[c][i]);
+            out->pieces[n++] = (StatePiece){ (uint8_t)sq[c][i], color, 'P' };
+        }
+    }
+    out->piece_count = (uint8_t)n;
+    out->current_player = idx ? 'R' : 'B';
+    out->turn_number = 1;
+    rules_sync(out);
+    return 1;
+}
+
+/**
+ * \fn static TbResult tb_decode_code(uint8_t code, int *dist)
+ * \brief Issue et distance d'un octet de la table.
+ */
+static TbResult tb_decode_code(uint8_t code, int *dist) {
+    if (code == TB_CODE_INVALID) return TB_UNKNOWN;
+    if (code == TB_CODE_DRAW) return TB_DRAW;
+    if (dist) *dist = (code & 1) ? (code + 1) / 2 : (code - 2) / 2;
+    return (code & 1) ? TB_WIN : TB_LOSS;
+}
+
+/**
+ * \fn static TbResult tb_lookup(const TbTable *tables, int count, const GameState *s, int *dist)
+ * \brief Issue d'une position dans une liste de classes.
+ */
+static TbResult tb_lookup(const TbTable *tables, int count, const GameState *s, int *dist) {
+    if (s->king_sq[0] < 0 || s->king_sq[1] < 0) return TB_UNKNOWN;
+    for (int i = 0; i < count; ++i)
+        if (tables[i].pawns[0] == s->pawn_count[0] && tables[i].pawns[1] == s->pawn_count[1])
+            return tb_decode_code(tables[i].data[tb_index(s)], dist);
+    return TB_UNKNOWN;
+}
+
+/**
+ * \fn static void tb_relocate(GameState *s, int index, int to)
+ * \brief Déplace une pièce sur une case vide, sans capture (plateau, bitboards, roi).
+ */
+static void tb_relocate(GameState *s, int index, int to) {
+    StatePiece *p = &s->pieces[index];
+    int ci = rules_color_idx(p->color);
+    s->board[p->sq] = -1;
+    s->occ[ci] ^= bb_bit(p->sq) | bb_bit(to);
+    s->board[to] = (int8_t)index;
+    if (p->type == 'K') s->king_sq[ci] = (signed char)to;
+    p->sq = (uint8_t)to;
+}
+
+/** \brief Génération d'une classe : états et distances des positions. */
+typedef struct {
+    uint8_t *state;   /**< TB_GEN_* */
+    uint8_t *dist;    /**< Distance en attente ou résolue ; perte la plus lente connue pour TB_GEN_OPEN */
+    uint8_t *count;   /**< Coups internes à la classe pas encore résolus en gain adverse */
+    int max_pending;  /**< Plus grande distance mise en attente */
+} TbGen;
+
+/**
+ * \fn static void tb_gen_offer(TbGen *g, uint64_t idx, int state, int d)
+ * \brief Met une position en attente de gain ou de perte à la distance `d`.
+ *
+ * Un gain plus court remplace un gain en attente ; au-delà de TB_MAX_DIST
+ * la position reste ouverte (nulle).
+ */
+static void tb_gen_offer(TbGen *g, uint64_t idx, int state, int d) {
+    if (d > TB_MAX_DIST) return;
+    if (g->state[idx] == TB_GEN_WIN_AT && g->dist[idx] <= d) return;
+    g->state[idx] = (uint8_t)state;
+    g->dist[idx] = (uint8_t)d;
+    if (d > g->max_pending) g->max_pending = d;
+}
+
+/**
+ * \fn static void tb_gen_init(TbGen *g, const TbTable *t, const TbTable *done, int ndone, uint64_t idx)
+ * \brief Première passe sur une position : fin de partie, coups qui quittent la classe, compteur.
+ */
+static void tb_gen_init(TbGen *g, const TbTable *t, const TbTable *done, int ndone, uint64_t idx) {
+    GameState s;
+    if (!tb_decode(idx, t->pawns[0], t->pawns[1], &s)) { g->state[idx] = TB_GEN_INVALID; return; }
+    char w = rules_winner(&s, NULL);
+    if (w) {
+        // Le joueur au trait ne peut pas avoir déjà gagné : son adversaire vient de jouer
+        if (w == s.current_player) g->state[idx] = TB_GEN_INVALID;
+        else tb_gen_offer(g, idx, TB_GEN_LOSS_AT, 0);
+        return;
+    }
+
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(&s, moves);
+    int open = 0, slowest = 0, quickest = TB_MAX_DIST + 1;
+    for (int i = 0; i < n; ++i) {
+        MoveUndo undo;
+        rules_make_move(&s, &moves[i], &undo);
+        char cw = rules_winner(&s, NULL);
+        TbResult r = TB_UNKNOWN;
+        int d = 0;
+        if (cw) r = (cw == s.current_player) ? TB_WIN : TB_LOSS;
+        else if (undo.capture_count) r = tb_lookup(done, ndone, &s, &d);
+        rules_unmake_move(&s, &undo);
+        if (!cw && !undo.capture_count) { ++open; continue; } // reste dans la classe
+        if (r == TB_LOSS) { if (d + 1 < quickest) quickest = d + 1; }
+        else if (r == TB_WIN) { if (d + 1 > slowest) slowest = d + 1; }
+        else ++open; // nul ou inconnu : ce coup ne perd pas
+    }
+    if (quickest <= TB_MAX_DIST) tb_gen_offer(g, idx, TB_GEN_WIN_AT, quickest);
+    else if (n > 0 && open == 0) tb_gen_offer(g, idx, TB_GEN_LOSS_AT, slowest);
+    else g->dist[idx] = (uint8_t)slowest;
+    g->count[idx] = (uint8_t)(open > 255 ? 255 : open);
+}
+
+/**
+ * \fn static void tb_gen_resolve(TbGen *g, const TbTable *t, uint64_t idx, int won, int d)
+ * \brief Position résolue à la distance `d` : met à jour ses prédécesseurs dans la classe.
+ *
+ * Un prédécesseur d'une perte est gagné en d + 1 ; un prédécesseur d'un
+ * gain perd un coup ouvert et, s'il n'en reste aucun, est perdu en
+ * max(perte la plus lente, d + 1).
+ */
+static void tb_gen_resolve(TbGen *g, const TbTable *t, uint64_t idx, int won, int d) {
+    GameState p;
+    tb_decode(idx, t->pawns[0], t->pawns[1], &p);
+    char mover = (p.current_player == 'R') ? 'B' : 'R';
+    Bitboard empty = ~rules_occupied(&p) & BB_FULL;
+    for (int i = 0; i < p.piece_count; ++i) {
+        if (p.pieces[i].color != mover) continue;
+        int to = p.pieces[i].sq;
+        for (Bitboard from = bb_rook_reach(bb_bit(to), empty); from; from &= from - 1) {
+            GameState q = p;
+            int f = bb_lsb(from);
+            tb_relocate(&q, i, f);
+            q.current_player = mover;
+            if (rules_winner(&q, NULL)) continue;
+            // Le coup rejoué depuis q doit arriver sur p sans capturer
+            Move mv = { i, f / 9, f % 9, to / 9, to % 9 };
+            MoveUndo undo;
+            rules_make_move(&q, &mv, &undo);
+            int captured = undo.capture_count;
+            rules_unmake_move(&q, &undo);
+            if (captured) continue;
+
+            uint64_t qi = tb_index(&q);
+            uint8_t st = g->state[qi];
+            if (st == TB_GEN_WIN || st == TB_GEN_LOSS || st == TB_GEN_INVALID || st == TB_GEN_LOSS_AT) continue;
+            if (!won) {
+                tb_gen_offer(g, qi, TB_GEN_WIN_AT, d + 1);
+            } else if (st == TB_GEN_OPEN && g->count[qi] > 0) {
+                if (d + 1 > g->dist[qi]) g->dist[qi] = (uint8_t)(d + 1 > TB_MAX_DIST ? TB_MAX_DIST + 1 : d + 1);
+                if (--g->count[qi] == 0) tb_gen_offer(g, qi, TB_GEN_LOSS_AT, g->dist[qi]);
+            }
+        }
+    }
+}
+
+/**
+ * \fn static int tb_generate_class(TbTable *t, const TbTable *done, int ndone, FILE *log)
+ * \brief Analyse rétrograde complète d'une classe ; `t->data` reçoit les octets codés.
+ *
+ * \return 0 si succès, -1 si la mémoire manque.
+ */
+static int tb_generate_class(TbTable *t, const TbTable *done, int ndone, FILE *log) {
+    uint64_t n = t->size;
+    TbGen g = { calloc(n, 1), calloc(n, 1), calloc(n, 1), 0 };
+    if (!g.state || !g.dist || !g.count) {
+        free(g.state); free(g.dist); free(g.count);
+        return -1;
+    }
+    for (uint64_t idx = 0; idx < n; ++idx) tb_gen_init(&g, t, done, ndone, idx);
+
+    uint64_t wins = 0, losses = 0;
+    for (int d = 0; d <= g.max_pending; ++d) {
+        for (uint64_t idx = 0; idx < n; ++idx) {
+            uint8_t st = g.state[idx];
+            if ((st != TB_GEN_WIN_AT && st != TB_GEN_LOSS_AT) || g.dist[idx] != d) continue;
+            int won = st == TB_GEN_WIN_AT;
+            g.state[idx] = won ? TB_GEN_WIN : TB_GEN_LOSS;
+            if (won) ++wins; else ++losses;
+            tb_gen_resolve(&g, t, idx, won, d);
+        }
+    }
+
+    // Codage en place dans `state`
+    for (uint64_t idx = 0; idx < n; ++idx) {
+        uint8_t st = g.state[idx], d = g.dist[idx];
+        g.state[idx] = st == TB_GEN_WIN ? (uint8_t)(2 * d - 1)
+                     : st == TB_GEN_LOSS ? (uint8_t)(2 * d + 2)
+                     : st == TB_GEN_INVALID ? TB_CODE_INVALID : TB_CODE_DRAW;
+    }
+    free(g.dist);
+    free(g.count);
+    t->data = g.state;
+    if (log)
+        fprintf(log, "table de finales : classe %d/%d, %llu positions, %llu gains, %llu pertes, distance max %d\n",
+                t->pawns[0], t->pawns[1], (unsigned long long)n, (unsigned long long)wins,
+                (unsigned long long)losses, g.max_pending);
+    return 0;
+}
+
+/**
+ * \fn int tb_generate(const char *path, int max_pawns, FILE *log)
+ * \brief Génère les classes, des plus petites aux plus grandes, et écrit le fichier.
+ *
+ * \param path Fichier à écrire.
+ * \param max_pawns Soldats par camp au plus.
+ * \param log Progression (NULL accepté).
+ * \return Nombre de classes écrites, -1 en cas d'erreur.
+ */
+int tb_generate(const char *path, int max_pawns, FILE *log) {
+    if (max_pawns < 0 || max_pawns > TB_GEN_MAX_PAWNS) return -1;
+    TbTable tables[TB_MAX_CLASSES];
+    int count = 0;
+    // Ordre par nombre total de soldats : les captures mènent à des classes déjà faites
+    for (int total = 0; total <= 2 * max_pawns; ++total)
+        for (int b = 0; b <= max_pawns; ++b) {
+            int r = total - b;
+            if (r < 0 || r > max_pawns || b == 1 || r == 1) continue;
+            uint64_t size = tb_class_size(b, r);
+            if (size > TB_MAX_CLASS_POSITIONS) {
+                if (log) fprintf(log, "table de finales : classe %d/%d ignoree (%llu positions)\n",
+                                 b, r, (unsigned long long)size);
+                continue;
+            }
+            tables[count] = (TbTable){ { b, r }, size, NULL };
+            if (tb_generate_class(&tables[count], tables, count, log) != 0) {
+                for (int i = 0; i < count; ++i) free((void *)tables[i].data);
+                return -1;
+            }
+            ++count;
+        }
+
+    int ok = 0;
+    FILE *f = fopen(path, "wb");
+    if (f) {
+        TbHeader h = { .version = TB_VERSION, .class_count = (uint32_t)count };
+        memcpy(h.magic, TB_MAGIC, sizeof(TB_MAGIC));
+        ok = fwrite(&h, sizeof(h), 1, f) == 1;
+        uint64_t offset = sizeof(TbHeader) + (uint64_t)count * sizeof(TbClass);
+        for (int i = 0; i < count && ok; ++i) {
+            TbClass c = { { (uint8_t)tables[i].pawns[0], (uint8_t)tables[i].pawns[1] }, { 0 }, offset, tables[i].size };
+            ok = fwrite(&c, sizeof(c), 1, f) == 1;
+            offset += tables[i].size;
+        }
+        for (int i = 0; i < count && ok; ++i)
+            ok = fwrite(tables[i].data, 1, tables[i].size, f) == tables[i].size;
+        if (fclose(f) != 0) ok = 0;
+    }
+    for (int i = 0; i < count; ++i) free((void *)tables[i].data);
+    return ok ? count : -1;
+}
+
+/**
+ * \fn static int tb_load(const void *data, size_t len)
+ * \brief Vérifie l'en-tête et les classes d'un fichier et remplit `tb_tables`.
+ */
+static int tb_load(const void *data, size_t len) {
+    if (len < sizeof(TbHeader)) return 0;
+    const TbHeader *h = data;
+    if (memcmp(h->magic, TB_MAGIC, sizeof(TB_MAGIC)) != 0 || h->version != TB_VERSION) return 0;
+    if (h->class_count > TB_MAX_CLASSES || len < sizeof(TbHeader) + h->class_count * sizeof(TbClass)) return 0;
+    const TbClass *c = (const TbClass *)((const char *)data + sizeof(TbHeader));
+    for (uint32_t i = 0; i < h->class_count; ++i) {
+        int b = c[i].pawns[0], r = c[i].pawns[1];
+        if (c[i].size == 0 || c[i].size != tb_class_size(b, r) ||
+            c[i].offset > len || c[i].size > len - c[i].offset) return 0;
+        tb_tables[i] = (TbTable){ { b, r }, c[i].size, (const uint8_t *)data + c[i].offset };
+    }
+    tb_count = (int)h->class_count;
+    return 1;
+}
+
+/**
+ * \fn void tb_close(void)
+ * \brief Ferme la table courante.
+ */
+void tb_close(void) {
+    unmap_file(tb_map, tb_map_len);
+    tb_map = NULL;
+    tb_map_len = 0;
+    tb_count = 0;
+}
+
+/**
+ * \fn int tb_open(const char *path)
+ * \brief Projette une table de finales en mémoire.
+ *
+ * \param path Fichier de la table.
+ * \return 0 si succès, -1 sinon.
+ */
+int tb_open(const char *path) {
+    tb_close();
+    void *data = NULL;
+    size_t len = 0;
+    if (map_file(path, &data, &len) != 0) return -1;
+    tb_map = data;
+    tb_map_len = len;
+    if (!tb_load(data, len)) {
+        tb_close();
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \fn int tb_class_count(void)
+ * \brief Nombre de classes de la table courante.
+ */
+int tb_class_count(void) { return tb_count; }
+
+/**
+ * \fn TbResult tb_probe(const GameState *s, int *dist)
+ * \brief Issue d'une position pour le joueur au trait.
+ *
+ * \param s État du jeu (synchronisé).
+ * \param dist Distance en coups (retour, NULL accepté).
+ * \return Issue, TB_UNKNOWN hors de la table.
+ */
+TbResult tb_probe(const GameState *s, int *dist) {
+    if (!tb_count) return TB_UNKNOWN;
+    return tb_lookup(tb_tables, tb_count, s, dist);
+}
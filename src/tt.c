@@ -0,0 +1,243 @@
+/**
+ * \file tt.c
+ * \brief Hachage de Zobrist et table de transposition de l'IA.
+ * \author valentin.leray@uha.fr
+ * \version 0.1
+ * \date 2025-10-02
+ *
+ * \details
+ * - Génération déterministe des valeurs de Zobrist (splitmix64)
+ * - Table de seaux alignés sur 64 octets, nombre de seaux en puissance de 2
+ * - Remplacement : même position, sinon entrée vide, sinon entrée la plus
+ *   ancienne / la moins profonde du seau
+ * - Accès concurrents sans verrou (clé XOR données, voir tt.h)
+ * - Allocation une fois, par tt_init(), avant le démarrage des threads
+ */
+
+#include "tt.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+uint64_t zobrist_piece[2][2][81];
+uint64_t zobrist_control[2][81];
+uint64_t zobrist_side;
+
+static TTBucket* tt_table = NULL;
+static size_t tt_bucket_count = 0;
+static uint8_t tt_generation = 0; // accès atomiques : plusieurs recherches peuvent tourner à la fois
+static pthread_once_t zobrist_once = PTHREAD_ONCE_INIT;
+
+/**
+ * \fn static uint64_t splitmix64(uint64_t* state)
+ * \brief Générateur pseudo-aléatoire 64 bits (suite reproductible).
+ *
+ * \param state État du générateur, mis à jour.
+ * \return Valeur suivante.
+ */
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * \fn static void tt_fill_zobrist(void)
+ * \brief Tire les valeurs de Zobrist (appelée une seule fois par pthread_once()).
+ */
+static void tt_fill_zobrist(void) {
+    uint64_t seed = 0x4B524F4A414E5459ULL; // "KROJANTY"
+    for (int c = 0; c < 2; ++c)
+        for (int t = 0; t < 2; ++t)
+            for (int sq = 0; sq < 81; ++sq)
+                zobrist_piece[c][t][sq] = splitmix64(&seed);
+    for (int v = 0; v < 2; ++v)
+        for (int sq = 0; sq < 81; ++sq)
+            zobrist_control[v][sq] = splitmix64(&seed);
+    zobrist_side = splitmix64(&seed);
+}
+
+/**
+ * \fn void tt_init_zobrist(void)
+ * \brief Initialise les valeurs de Zobrist (une seule fois, sûr entre threads).
+ */
+void tt_init_zobrist(void) {
+    pthread_once(&zobrist_once, tt_fill_zobrist);
+}
+
+/**
+ * \fn int tt_init(size_t mb)
+ * \brief Initialise les valeurs de Zobrist et alloue la table.
+ *
+ * \param mb Taille maximale en mégaoctets (0 = TT_DEFAULT_MB).
+ * \return 0 si succès, -1 sinon.
+ */
+int tt_init(size_t mb) {
+    tt_init_zobrist();
+    return tt_resize(mb ? mb : TT_DEFAULT_MB);
+}
+
+/**
+ * \fn int tt_resize(size_t mb)
+ * \brief (Ré)alloue la table de transposition.
+ *
+ * \param mb Taille maximale en mégaoctets.
+ * \return 0 si succès, -1 sinon (l'ancienne table est conservée).
+ */
+int tt_resize(size_t mb) {
+    if (mb < 1 || mb > TT_MAX_MB) return -1;
+
+    size_t want = (mb << 20) / sizeof(TTBucket);
+    size_t count = 1;
+    while (count * 2 <= want) count *= 2;
+
+    TTBucket* table = aligned_alloc(64, count * sizeof(TTBucket));
+    if (!table) return -1;
+
+    free(tt_table);
+    tt_table = table;
+    tt_bucket_count = count;
+    tt_clear();
+    return 0;
+}
+
+/**
+ * \fn size_t tt_size_mb(void)
+ * \brief Taille actuelle de la table.
+ *
+ * \return Taille en mégaoctets.
+ */
+size_t tt_size_mb(void) {
+    return (tt_bucket_count * sizeof(TTBucket)) >> 20;
+}
+
+/**
+ * \fn void tt_clear(void)
+ * \brief Vide toutes les entrées de la table.
+ */
+void tt_clear(void) {
+    if (tt_table) memset(tt_table, 0, tt_bucket_count * sizeof(TTBucket));
+    __atomic_store_n(&tt_generation, 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * \fn void tt_new_search(void)
+ * \brief Prépare la table pour une nouvelle recherche.
+ */
+void tt_new_search(void) {
+    __atomic_fetch_add(&tt_generation, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * \fn static uint64_t tt_pack(const TTEntry* e)
+ * \brief Empaquette les champs hors clé d'une entrée sur 64 bits.
+ *
+ * \param e Entrée.
+ * \return Données empaquetées.
+ */
+static uint64_t tt_pack(const TTEntry* e) {
+    return (uint64_t)(uint32_t)e->score
+         | (uint64_t)e->from_sq << 32
+         | (uint64_t)e->to_sq << 40
+         | (uint64_t)(uint8_t)e->depth << 48
+         | (uint64_t)e->bound_gen << 56;
+}
+
+/**
+ * \fn static void tt_unpack(uint64_t key, uint64_t data, TTEntry* out)
+ * \brief Reconstruit une entrée à partir de sa clé et de ses données.
+ *
+ * \param key Clé de Zobrist.
+ * \param data Données empaquetées.
+ * \param out Entrée reconstruite.
+ */
+static void tt_unpack(uint64_t key, uint64_t data, TTEntry* out) {
+    out->key = key;
+    out->score = (int32_t)(uint32_t)data;
+    out->from_sq = (uint8_t)(data >> 32);
+    out->to_sq = (uint8_t)(data >> 40);
+    out->depth = (int8_t)(data >> 48);
+    out->bound_gen = (uint8_t)(data >> 56);
+}
+
+/**
+ * \fn static int tt_load(const TTSlot* slot, TTEntry* out)
+ * \brief Lit un emplacement, éventuellement écrit en parallèle.
+ *
+ * \param slot Emplacement.
+ * \param out Entrée lue.
+ * \return 1 si l'emplacement est occupé et cohérent, 0 sinon.
+ */
+static int tt_load(const TTSlot* slot, TTEntry* out) {
+    uint64_t lock = __atomic_load_n(&slot->lock, __ATOMIC_RELAXED);
+    uint64_t data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);
+    tt_unpack(lock ^ data, data, out);
+    return tt_entry_bound(out) != TT_NONE;
+}
+
+/**
+ * \fn int tt_probe(uint64_t key, TTEntry* out)
+ * \brief Cherche une position dans son seau.
+ *
+ * \param key Clé de Zobrist.
+ * \param out Copie de l'entrée trouvée.
+ * \return 1 si trouvée, 0 sinon.
+ */
+int tt_probe(uint64_t key, TTEntry* out) {
+    if (!tt_table) return 0;
+    TTBucket* b = &tt_table[key & (tt_bucket_count - 1)];
+    TTEntry e;
+    for (int i = 0; i < TT_BUCKET_SIZE; ++i) {
+        if (tt_load(&b->e[i], &e) && e.key == key) {
+            *out = e;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \fn void tt_store(uint64_t key, int depth, int bound, int score, int from_sq, int to_sq)
+ * \brief Mémorise une position dans son seau.
+ *
+ * \param key Clé de Zobrist.
+ * \param depth Profondeur restante.
+ * \param bound Type de borne.
+ * \param score Score (joueur au trait).
+ * \param from_sq Case de départ du meilleur coup (-1 si aucun).
+ * \param to_sq Case d'arrivée du meilleur coup (-1 si aucun).
+ */
+void tt_store(uint64_t key, int depth, int bound, int score, int from_sq, int to_sq) {
+    if (!tt_table) return;
+    TTBucket* b = &tt_table[key & (tt_bucket_count - 1)];
+    TTSlot* victim = NULL;
+    TTEntry old = { 0 };
+    int victim_worth = 0x7fffffff;
+
+    for (int i = 0; i < TT_BUCKET_SIZE; ++i) {
+        TTEntry e;
+        if (!tt_load(&b->e[i], &e) || e.key == key) { victim = &b->e[i]; old = e; break; }
+        // Les entrées des recherches précédentes partent en premier
+        int age = (__atomic_load_n(&tt_generation, __ATOMIC_RELAXED) - (e.bound_gen >> 2)) & 63;
+        int worth = e.depth - 8 * age;
+        if (worth < victim_worth) { victim_worth = worth; victim = &b->e[i]; old = e; }
+    }
+
+    // Conserver le coup connu si la nouvelle recherche n'en fournit pas
+    if (from_sq < 0 && old.key == key && tt_entry_bound(&old) != TT_NONE) {
+        from_sq = old.from_sq;
+        to_sq = old.to_sq;
+    }
+
+    TTEntry e;
+    e.key = key;
+    e.score = score;
+    e.from_sq = (uint8_t)(from_sq < 0 ? 255 : from_sq);
+    e.to_sq = (uint8_t)(to_sq < 0 ? 255 : to_sq);
+    e.depth = (int8_t)depth;
+    e.bound_gen = (uint8_t)(((__atomic_load_n(&tt_generation, __ATOMIC_RELAXED) & 63) << 2) | (bound & 3));
+    uint64_t data = tt_pack(&e);
+    __atomic_store_n(&victim->lock, key ^ data, __ATOMIC_RELAXED);
+    __atomic_store_n(&victim->data, data, __ATOMIC_RELAXED);
+}
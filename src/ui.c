@@ -0,0 +1,111 @@
+/**
+ * \file ui.c
+ * \brief Drapeaux de changement de l'interface, appliqués une fois par image.
+ *
+ * \details
+ * - Les marques sont cumulées dans un masque ; le premier marquage pose un
+ *   rappel de l'horloge d'images sur la zone de dessin.
+ * - Le rappel applique le masque (ui_flush()) et se retire : sans
+ *   changement, l'horloge ne réveille plus la boucle GTK.
+ */
+
+#include "ui.h"
+#include "status.h"
+#include "game.h"
+#include "analysis.h"
+
+/** \brief Zone de dessin rattachée (NULL sans fenêtre). */
+static GtkWidget *ui_area = NULL;
+/** \brief Rappel d'image en attente (0 = aucun). */
+static guint ui_tick_id = 0;
+/** \brief Mises à jour marquées. */
+static unsigned ui_dirty = 0;
+/** \brief Compteurs. */
+static UiStats ui_stats;
+
+/**
+ * \fn static gboolean ui_on_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer user_data)
+ * \brief Rappel d'image : applique les mises à jour marquées puis se retire.
+ */
+static gboolean ui_on_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer user_data) {
+    (void)widget; (void)clock; (void)user_data;
+    ui_tick_id = 0;
+    ui_flush();
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * \fn static void ui_schedule(void)
+ * \brief Pose le rappel de la prochaine image s'il y a des marques et aucun rappel en attente.
+ */
+static void ui_schedule(void) {
+    if (ui_area && ui_dirty && !ui_tick_id)
+        ui_tick_id = gtk_widget_add_tick_callback(ui_area, ui_on_tick, NULL, NULL);
+}
+
+/**
+ * \fn void ui_attach(GtkWidget *area)
+ * \brief Rattache la zone de dessin et planifie les marques déjà posées.
+ */
+void ui_attach(GtkWidget *area) {
+    ui_detach();
+    ui_area = area;
+    ui_schedule();
+}
+
+/**
+ * \fn void ui_detach(void)
+ * \brief Retire le rappel en attente et oublie la zone de dessin.
+ */
+void ui_detach(void) {
+    if (ui_area && ui_tick_id) gtk_widget_remove_tick_callback(ui_area, ui_tick_id);
+    ui_tick_id = 0;
+    ui_area = NULL;
+}
+
+/**
+ * \fn void ui_mark(unsigned flags)
+ * \brief Cumule des mises à jour pour la prochaine image.
+ */
+void ui_mark(unsigned flags) {
+    ui_stats.marks++;
+    ui_dirty |= flags & UI_DIRTY_ALL;
+    ui_schedule();
+}
+
+/**
+ * \fn unsigned ui_pending(void)
+ * \brief Mises à jour marquées pas encore appliquées.
+ */
+unsigned ui_pending(void) {
+    return ui_dirty;
+}
+
+/**
+ * \fn void ui_flush(void)
+ * \brief Applique chaque mise à jour marquée une fois : scores, état, plateau.
+ *
+ * Un plateau changé est aussi la nouvelle position du mode analyse
+ * (analysis.h), sans effet si elle n'a pas changé.
+ */
+void ui_flush(void) {
+    unsigned dirty = ui_dirty;
+    ui_dirty = 0;
+    if (!dirty) return;
+    ui_stats.flushes++;
+    if (dirty & UI_DIRTY_SCORES) status_on_scores_changed();
+    if (dirty & UI_DIRTY_STATUS) refresh_game_status();
+    if ((dirty & UI_DIRTY_BOARD) && analysis_running()) {
+        GameState s = createGameStateFromCurrent();
+        analysis_set_position(game_over ? NULL : &s);
+    }
+    if ((dirty & UI_DIRTY_BOARD) && ui_area) gtk_widget_queue_draw(ui_area);
+}
+
+/**
+ * \fn void ui_get_stats(UiStats *out)
+ * \brief Compteurs depuis le démarrage.
+ */
+void ui_get_stats(UiStats *out) {
+    *out = ui_stats;
+}
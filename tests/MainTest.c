@@ -9,9 +9,24 @@
  * - Drawing.c : tests des fonctions graphiques (conversion clic → case).
  * - Game.c : tests de la logique de jeu (déplacement, score, blocage, auto-défaite).
  * - Args.c : tests du parsing des arguments en ligne de commande.
- * - Net.c : tests des fonctions réseau (envoi de messages).
+ * - Net.c : tests des fonctions réseau (envoi de messages, canal de contrôle).
  * - Status.c : tests de l’affichage et de l’enregistrement des états.
  * - IA : tests de l’algorithme Minimax et de la recherche de coups.
+ * - Tt.c : tests de la table de transposition et du hachage de Zobrist.
+ * - IaJob.c : tests de la recherche de l'IA en arrière-plan.
+ * - Geometry.c : tests des tables géométriques précalculées.
+ * - Selfplay.c : tests des parties IA contre IA sans interface.
+ * - Rules.c : tests du cœur des règles sur un état explicite.
+ * - EvalKernel.c : tests des variantes du noyau d'évaluation.
+ * - Book.c : tests du livre d'ouverture.
+ * - Tablebase.c : tests de la table de finales.
+ * - Server.c : tests du serveur de parties sans interface.
+ * - Log.c : tests du journal asynchrone.
+ * - Sync.c : tests de l'instantané binaire de la position.
+ * - Record.c : tests de l'enregistrement des parties.
+ * - Ui.c : tests des mises à jour groupées de l'interface.
+ * - Analysis.c : tests du mode analyse.
+ * - Mapfile.c : tests de la projection de fichiers.
  *
  * \authors loic.claude@uha.fr, corentin.banocay@uha.fr
  *
@@ -22,6 +37,7 @@
 
 #include <stdio.h>
 #include <gtk/gtk.h>
+#include "tt.h"
 
 // Déclarations des tests Capture.c
 void test_linca_simple_capture();
@@ -37,6 +53,7 @@ void test_seltou_deux_pieces();
 
 // Déclarations des tests Drawing.c
 void test_click_to_cell();
+void test_drawing_board_signature();
 
 // Déclarations des tests Game.c
 void test_game_setup_default();
@@ -53,12 +70,29 @@ void test_parse_args_local();
 void test_parse_args_server();
 void test_parse_args_client();
 void test_parse_args_ia();
+void test_parse_args_tt();
+void test_parse_args_time();
+void test_parse_args_threads();
+void test_parse_args_ponder();
+void test_parse_args_verbose();
+void test_parse_args_selfplay();
+void test_parse_args_book();
+void test_parse_args_tb();
+void test_parse_args_serve();
+void test_parse_args_ping();
+void test_parse_args_record();
+void test_parse_args_analyse();
 void test_parse_args_invalid();
 
 // Déclarations des tests Net.c
 void test_net_send_message_invalid();
 void test_net_send_message_null();
 void test_net_send_message_sequence();
+void test_net_recv_buffer();
+void test_net_move_format();
+void test_net_control_frames();
+void test_net_send_queue();
+void test_net_send_message_closed_peer();
 
 
 // Déclarations des tests status.c
@@ -69,6 +103,75 @@ void test_status_register_and_draw(void);
 void test_ai_minimax_basic();
 void test_trouverMeilleurCoupIA();
 void test_minimaxIA_basic();
+void test_ia_sync_bitboards();
+void test_ia_make_unmake_move();
+void test_ia_iterative_deepening_budget();
+void test_ia_finds_king_capture();
+void test_ia_lazy_smp();
+void test_ia_state_load_store();
+void test_ia_quiescence();
+void test_ia_pvs_reductions();
+void test_ia_repetition();
+void test_ia_search_stats();
+void test_ia_analyse_multipv();
+
+// Déclarations des tests tt.c
+void test_tt_store_probe();
+void test_tt_zobrist_incremental();
+
+// Déclarations des tests ia_job.c
+void test_ia_job_start_wait();
+void test_ia_job_cancel();
+void test_ia_job_ponder();
+
+// Déclarations des tests geometry.c
+void test_geo_tables();
+void test_geo_slide();
+
+// Déclarations des tests selfplay.c
+void test_selfplay_parse_engine();
+void test_selfplay_game();
+
+// Déclarations des tests rules.c
+void test_rules_play_capture();
+void test_rules_board_make_unmake();
+void test_rules_endings();
+
+// Déclarations des tests eval_kernel.c
+void test_eval_kernel_variants();
+
+// Déclarations des tests book.c
+void test_book_build_probe();
+void test_book_selfplay_search();
+
+// Déclarations des tests tablebase.c
+void test_tb_index_roundtrip();
+void test_tb_generate_kings();
+void test_tb_search();
+
+// Déclarations des tests server.c
+void test_server_matches();
+
+// Déclarations des tests log.c
+void test_log_ring();
+void test_log_saturation();
+
+// Déclarations des tests sync.c
+void test_sync_roundtrip();
+void test_sync_invalid();
+
+// Déclarations des tests record.c
+void test_record_write_seek();
+void test_record_recovery();
+
+// Déclarations des tests ui.c
+void test_ui_coalesce(void);
+
+// Déclarations des tests analysis.c
+void test_analysis_restart();
+
+// Déclarations des tests mapfile.c
+void test_map_file();
 
 
 
@@ -76,12 +179,13 @@ void test_minimaxIA_basic();
  * \fn int main()
  * \brief Point d’entrée du programme de tests.
  *
- * \details Initialise GTK, exécute tous les tests unitaires et affiche le résultat.
+ * \details Initialise GTK et la table de transposition, exécute tous les tests unitaires et affiche le résultat.
  *
  * \return 0 si tous les tests passent avec succès, code d’erreur sinon.
  */
 int main() {
     gtk_init();
+    tt_init(0);
 
     printf("\n  === Debut des tests ===\n");
 
@@ -101,6 +205,7 @@ int main() {
 
     printf("\n  === Lancement des tests drawing.c ===\n");
     test_click_to_cell();
+    test_drawing_board_signature();
     printf("Tous les tests drawing.c sont passes avec succes\n");
 
 
@@ -121,6 +226,18 @@ int main() {
     test_parse_args_server();
     test_parse_args_client();
     test_parse_args_ia();
+    test_parse_args_tt();
+    test_parse_args_time();
+    test_parse_args_threads();
+    test_parse_args_ponder();
+    test_parse_args_verbose();
+    test_parse_args_selfplay();
+    test_parse_args_book();
+    test_parse_args_tb();
+    test_parse_args_serve();
+    test_parse_args_ping();
+    test_parse_args_record();
+    test_parse_args_analyse();
     test_parse_args_invalid();
     printf("Tous les tests args.c sont passes avec succes\n");
 
@@ -128,6 +245,11 @@ int main() {
     test_net_send_message_invalid();
     test_net_send_message_null();
     test_net_send_message_sequence();
+    test_net_recv_buffer();
+    test_net_move_format();
+    test_net_control_frames();
+    test_net_send_queue();
+    test_net_send_message_closed_peer();
     printf("Tous les tests net.c sont passes avec succes\n");
 
     printf("\n === Lancement des tests status.c ===\n");
@@ -138,8 +260,92 @@ int main() {
     test_ai_minimax_basic();
     test_trouverMeilleurCoupIA();
     test_minimaxIA_basic();
+    test_ia_sync_bitboards();
+    test_ia_make_unmake_move();
+    test_ia_iterative_deepening_budget();
+    test_ia_finds_king_capture();
+    test_ia_lazy_smp();
+    test_ia_state_load_store();
+    test_ia_quiescence();
+    test_ia_pvs_reductions();
+    test_ia_repetition();
+    test_ia_search_stats();
+    test_ia_analyse_multipv();
     printf("Tous les tests IA sont passes avec succes\n");
 
+    printf("\n=== Lancement des tests tt.c ===\n");
+    test_tt_store_probe();
+    test_tt_zobrist_incremental();
+    printf("Tous les tests tt.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests ia_job.c ===\n");
+    test_ia_job_start_wait();
+    test_ia_job_cancel();
+    test_ia_job_ponder();
+    printf("Tous les tests ia_job.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests geometry.c ===\n");
+    test_geo_tables();
+    test_geo_slide();
+    printf("Tous les tests geometry.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests selfplay.c ===\n");
+    test_selfplay_parse_engine();
+    test_selfplay_game();
+    printf("Tous les tests selfplay.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests rules.c ===\n");
+    test_rules_play_capture();
+    test_rules_board_make_unmake();
+    test_rules_endings();
+    printf("Tous les tests rules.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests eval_kernel.c ===\n");
+    test_eval_kernel_variants();
+    printf("Tous les tests eval_kernel.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests book.c ===\n");
+    test_book_build_probe();
+    test_book_selfplay_search();
+    printf("Tous les tests book.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests tablebase.c ===\n");
+    test_tb_index_roundtrip();
+    test_tb_generate_kings();
+    test_tb_search();
+    printf("Tous les tests tablebase.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests server.c ===\n");
+    test_server_matches();
+    printf("Tous les tests server.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests log.c ===\n");
+    test_log_ring();
+    test_log_saturation();
+    printf("Tous les tests log.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests sync.c ===\n");
+    test_sync_roundtrip();
+    test_sync_invalid();
+    printf("Tous les tests sync.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests record.c ===\n");
+    test_record_write_seek();
+    test_record_recovery();
+    printf("Tous les tests record.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests ui.c ===\n");
+    test_ui_coalesce();
+    printf("Tous les tests ui.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests analysis.c ===\n");
+    test_analysis_restart();
+    printf("Tous les tests analysis.c sont passes avec succes\n");
+
+    printf("\n=== Lancement des tests mapfile.c ===\n");
+    test_map_file();
+    printf("Tous les tests mapfile.c sont passes avec succes\n");
+
 
     printf("\n  === Tous les tests sont passes avec succes ===\n");
     
@@ -15,8 +15,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
 #include "ia.h"
 #include "game.h"
+#include "rules.h"
 
 /**
  * \fn void test_ai_minimax_basic()
@@ -36,8 +40,8 @@ void test_ai_minimax_basic() {
 
     // Définir quelques pièces manuellement pour le test
     gs.piece_count = 2;
-    gs.pieces[0] = (Piece){ .row = 0, .col = 0, .type = 'K', .color = 'R' };
-    gs.pieces[1] = (Piece){ .row = 8, .col = 8, .type = 'K', .color = 'B' };
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 0), .type = 'K', .color = 'R' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(8, 8), .type = 'K', .color = 'B' };
     gs.current_player = 'R';
 
     // Tester l'évaluation pour Red
@@ -76,10 +80,10 @@ void test_trouverMeilleurCoupIA() {
     // Création d'un GameState minimal
     GameState gs = createGameStateFromCurrent();
     gs.piece_count = 4;
-    gs.pieces[0] = (Piece){ .row = 0, .col = 0, .type = 'K', .color = 'R' };
-    gs.pieces[1] = (Piece){ .row = 1, .col = 0, .type = 'P', .color = 'R' };
-    gs.pieces[2] = (Piece){ .row = 8, .col = 8, .type = 'K', .color = 'B' };
-    gs.pieces[3] = (Piece){ .row = 7, .col = 8, .type = 'P', .color = 'B' };
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 0), .type = 'K', .color = 'R' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(1, 0), .type = 'P', .color = 'R' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(8, 8), .type = 'K', .color = 'B' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(7, 8), .type = 'P', .color = 'B' };
     gs.current_player = 'R';
 
     // Appliquer l'IA pour 1 profondeur
@@ -114,10 +118,10 @@ void test_minimaxIA_basic() {
     // Création d'un GameState minimal
     GameState gs = createGameStateFromCurrent();
     gs.piece_count = 4;
-    gs.pieces[0] = (Piece){ .row = 0, .col = 0, .type = 'K', .color = 'R' };
-    gs.pieces[1] = (Piece){ .row = 1, .col = 0, .type = 'P', .color = 'R' };
-    gs.pieces[2] = (Piece){ .row = 8, .col = 8, .type = 'K', .color = 'B' };
-    gs.pieces[3] = (Piece){ .row = 7, .col = 8, .type = 'P', .color = 'B' };
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 0), .type = 'K', .color = 'R' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(1, 0), .type = 'P', .color = 'R' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(8, 8), .type = 'K', .color = 'B' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(7, 8), .type = 'P', .color = 'B' };
     gs.current_player = 'R';
 
     // Tester minimaxIA profondeur 1
@@ -131,3 +135,492 @@ void test_minimaxIA_basic() {
     printf("test_minimaxIA_basic OK\n");
 }
 
+
+/**
+ * \fn void test_ia_sync_bitboards()
+ * \brief Test de la reconstruction des bitboards de l'IA.
+ *
+ * \details
+ * - Crée un GameState avec deux rois et un pion.  
+ * - Vérifie l'occupation par couleur et les cases des rois.  
+ * - Vérifie qu'un roi manquant est signalé par -1.  
+ */
+void test_ia_sync_bitboards() {
+    GameState gs = createGameStateFromCurrent();
+    gs.piece_count = 3;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(1, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(4, 8), .type = 'P', .color = 'B' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(7, 7), .type = 'K', .color = 'R' };
+    rules_sync(&gs);
+
+    assert(bb_popcount(gs.occ[0]) == 2);
+    assert(bb_popcount(gs.occ[1]) == 1);
+    assert(bb_test(gs.occ[0], BB_SQ(4, 8)));
+    assert(gs.king_sq[0] == BB_SQ(1, 1));
+    assert(gs.king_sq[1] == BB_SQ(7, 7));
+
+    // Un décalage vers l'est ne doit pas déborder sur la rangée suivante
+    assert(bb_east(bb_bit(BB_SQ(4, 8))) == 0);
+
+    gs.piece_count = 2; // roi rouge retiré
+    rules_sync(&gs);
+    assert(gs.king_sq[1] == -1);
+    assert(isGameOver(&gs));
+
+    printf("test_ia_sync_bitboards OK\n");
+}
+
+/**
+ * \fn void test_ia_make_unmake_move()
+ * \brief Test de l'annulation d'un coup avec capture.
+ *
+ * \details
+ * - Place un pion rouge entre deux pions bleus (capture Linca au prochain coup).  
+ * - Vérifie que rules_make_move() retire la pièce et passe la main.  
+ * - Vérifie que rules_unmake_move() restaure pièces, contrôle, bitboards et compteurs.  
+ */
+void test_ia_make_unmake_move() {
+    GameState gs = createGameStateFromCurrent();
+    gs.control[0] = gs.control[1] = 0;
+    gs.piece_count = 5;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(4, 4), .type = 'P', .color = 'R' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(4, 1), .type = 'P', .color = 'B' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(4, 5), .type = 'P', .color = 'B' };
+    gs.pieces[4] = (StatePiece){ .sq = BB_SQ(8, 7), .type = 'K', .color = 'R' };
+    gs.current_player = 'B';
+    gs.turn_number = 10;
+    gs.control[1] = bb_bit(BB_SQ(4, 4));
+    rules_sync(&gs);
+    GameState before = gs;
+
+    Move mv = { .piece_index = 2, .to_row = 4, .to_col = 3 };
+    MoveUndo undo;
+    rules_make_move(&gs, &mv, &undo);
+    assert(gs.piece_count == 4);
+    assert(undo.capture_count == 1);
+    assert(gs.current_player == 'R');
+    assert(gs.turn_number == 11);
+    assert(!bb_test(gs.occ[1], BB_SQ(4, 4)));
+    assert(rules_state_control(&gs, 4, 4) == 0);
+    assert(gs.pawn_count[1] == 0 && gs.pawn_count[0] == 2);
+    assert(bb_popcount(gs.control[0]) == 2 && gs.control[1] == 0);
+
+    rules_unmake_move(&gs, &undo);
+    assert(gs.piece_count == before.piece_count);
+    assert(memcmp(gs.pieces, before.pieces, sizeof(StatePiece) * before.piece_count) == 0);
+    assert(gs.control[0] == before.control[0] && gs.control[1] == before.control[1]);
+    assert(gs.occ[0] == before.occ[0] && gs.occ[1] == before.occ[1]);
+    assert(gs.king_sq[0] == before.king_sq[0] && gs.king_sq[1] == before.king_sq[1]);
+    assert(gs.pawn_count[1] == 1);
+    assert(gs.current_player == 'B' && gs.turn_number == 10);
+
+    printf("test_ia_make_unmake_move OK\n");
+}
+
+/**
+ * \fn void test_ia_iterative_deepening_budget()
+ * \brief Test de l'approfondissement itératif limité en temps.
+ *
+ * \details
+ * - Lance trouverMeilleurCoupIA_Temps() sur la position initiale avec 50 ms.  
+ * - Vérifie qu'un coup valide est rendu et que l'échéance est tenue (marge large).  
+ * - Vérifie que trouverMeilleurCoupIA_Rapide() rend aussi un coup.  
+ */
+void test_ia_iterative_deepening_budget() {
+    game_setup_default();
+    reset_move_history();
+    GameState gs = createGameStateFromCurrent();
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    Move mv;
+    trouverMeilleurCoupIA_Temps(&gs, &mv, 50);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    long elapsed_ms = (t1.tv_sec - t0.tv_sec) * 1000 + (t1.tv_nsec - t0.tv_nsec) / 1000000;
+
+    assert(mv.piece_index >= 0 && mv.piece_index < gs.piece_count);
+    assert(gs.pieces[mv.piece_index].color == gs.current_player);
+    assert(elapsed_ms < 1000);
+
+    Move quick;
+    trouverMeilleurCoupIA_Rapide(&gs, &quick);
+    assert(quick.piece_index >= 0);
+
+    printf("test_ia_iterative_deepening_budget OK (%ld ms)\n", elapsed_ms);
+}
+
+/**
+ * \fn void test_ia_finds_king_capture()
+ * \brief Test de l'ordonnancement : la capture du roi est trouvée en premier.
+ *
+ * \details
+ * - Place le roi rouge entre une case libre et un pion bleu.  
+ * - Vérifie qu'à profondeur 1 l'IA joue le coup qui le prend en sandwich (Linca)
+ *   et que ce coup capture bien le roi.  
+ */
+void test_ia_finds_king_capture() {
+    reset_move_history();
+    GameState gs = createGameStateFromCurrent();
+    gs.control[0] = gs.control[1] = 0;
+    gs.piece_count = 4;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(6, 3), .type = 'P', .color = 'B' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(4, 4), .type = 'K', .color = 'R' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(4, 5), .type = 'P', .color = 'B' };
+    gs.current_player = 'B';
+    rules_sync(&gs);
+
+    Move mv;
+    trouverMeilleurCoupIA(&gs, &mv, 1);
+    assert(mv.to_row == 4 && mv.to_col == 3);
+    MoveUndo undo;
+    rules_make_move(&gs, &mv, &undo);
+    assert(gs.king_sq[1] == -1);
+
+    printf("test_ia_finds_king_capture OK\n");
+}
+
+/**
+ * \fn void test_ia_lazy_smp()
+ * \brief Test de la recherche parallèle (Lazy SMP).
+ *
+ * \details
+ * - Avec 4 threads, vérifie que la recherche à profondeur fixe et la recherche
+ *   en temps limité rendent un coup et laissent la position intacte.  
+ * - Vérifie que la capture du roi est toujours trouvée.  
+ */
+void test_ia_lazy_smp() {
+    ia_set_threads(4);
+    assert(ia_get_threads() == 4);
+
+    reset_move_history();
+    GameState gs = createGameStateFromCurrent();
+    rules_sync(&gs);
+    GameState before = gs;
+    Move mv;
+    trouverMeilleurCoupIA(&gs, &mv, 3);
+    assert(mv.piece_index >= 0);
+    trouverMeilleurCoupIA_Temps(&gs, &mv, 100);
+    assert(mv.piece_index >= 0);
+    assert(memcmp(&gs, &before, sizeof(GameState)) == 0);
+
+    gs.control[0] = gs.control[1] = 0;
+    gs.piece_count = 4;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(6, 3), .type = 'P', .color = 'B' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(4, 4), .type = 'K', .color = 'R' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(4, 5), .type = 'P', .color = 'B' };
+    gs.current_player = 'B';
+    rules_sync(&gs);
+    trouverMeilleurCoupIA(&gs, &mv, 2);
+    assert(mv.to_row == 4 && mv.to_col == 3);
+
+    ia_set_threads(1);
+    reset_move_history();
+    printf("test_ia_lazy_smp OK\n");
+}
+
+/**
+ * \fn void test_ia_state_load_store()
+ * \brief Test des conversions entre GameState et le format de l'interface.
+ *
+ * \details
+ * - Charge la position initiale et un contrôle partiel avec rules_state_load().  
+ * - Vérifie la taille compacte de l'état, l'ordre des pièces et le contrôle.  
+ * - Vérifie que rules_state_store() redonne exactement les tableaux d'origine.  
+ */
+void test_ia_state_load_store() {
+    game_setup_default();
+    int control[9][9] = {{0}};
+    control[0][3] = 1;
+    control[8][4] = 2;
+    GameState gs;
+    rules_state_load(&gs, pieces, piece_count, (const int (*)[9])control, 'R', 7);
+
+    assert(sizeof(GameState) == RULES_STATE_SIZE);
+    for (int i = 0; i < piece_count; ++i) assert(rules_piece_at(&gs, gs.pieces[i].sq) == i);
+    assert(gs.piece_count == piece_count);
+    assert(gs.current_player == 'R' && gs.turn_number == 7);
+    for (int i = 0; i < piece_count; ++i) {
+        Piece p = rules_state_piece(&gs, i);
+        assert(p.row == pieces[i].row && p.col == pieces[i].col);
+        assert(p.color == pieces[i].color && p.type == pieces[i].type);
+    }
+    assert(rules_state_control(&gs, 0, 3) == 1 && rules_state_control(&gs, 8, 4) == 2);
+    assert(rules_state_control(&gs, 4, 4) == 0);
+
+    Piece out[RULES_MAX_PIECES];
+    int out_count = 0, out_control[9][9];
+    rules_state_store(&gs, out, &out_count, out_control);
+    assert(out_count == piece_count);
+    for (int i = 0; i < piece_count; ++i) {
+        assert(out[i].row == pieces[i].row && out[i].col == pieces[i].col);
+        assert(out[i].color == pieces[i].color && out[i].type == pieces[i].type);
+    }
+    assert(memcmp(out_control, control, sizeof(control)) == 0);
+
+    GameState fresh = createGameStateFromCurrent();
+    assert(memcmp(fresh.pieces, gs.pieces, sizeof(StatePiece) * gs.piece_count) == 0);
+    printf("test_ia_state_load_store OK\n");
+}
+
+/**
+ * \fn void test_ia_quiescence()
+ * \brief Test de la recherche de quiescence à l'horizon.
+ *
+ * \details
+ * - Bleu au trait peut capturer un pion rouge par Linca.  
+ * - À profondeur 0, minimaxIA() doit voir la capture (score supérieur d'au
+ *   moins un pion à l'évaluation statique).  
+ * - Avec beta sous l'évaluation statique, le stand-pat coupe immédiatement.  
+ */
+void test_ia_quiescence() {
+    reset_move_history();
+    GameState gs = createGameStateFromCurrent();
+    gs.control[0] = gs.control[1] = 0;
+    gs.piece_count = 6;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(4, 4), .type = 'P', .color = 'R' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(4, 1), .type = 'P', .color = 'B' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(4, 5), .type = 'P', .color = 'B' };
+    gs.pieces[4] = (StatePiece){ .sq = BB_SQ(8, 7), .type = 'K', .color = 'R' };
+    gs.pieces[5] = (StatePiece){ .sq = BB_SQ(8, 0), .type = 'P', .color = 'R' }; // pas d'auto-défaite rouge
+    gs.current_player = 'B';
+    rules_sync(&gs);
+
+    int static_eval = evaluation(&gs, 'B');
+    int q = minimaxIA(&gs, 0, 'B', -100000000, 100000000);
+    assert(q >= static_eval + 90);
+
+    // Le stand-pat borne le score : une fenêtre déjà dépassée coupe aussitôt
+    assert(minimaxIA(&gs, 0, 'B', -100000000, static_eval - 1) == static_eval);
+
+    printf("test_ia_quiescence OK\n");
+}
+
+/**
+ * \fn void test_ia_pvs_reductions()
+ * \brief Test de la recherche avec PVS, réductions et coup nul.
+ *
+ * \details
+ * - À profondeur 5 (coup nul et réductions actifs), la position doit être
+ *   restituée à l'identique et le coup rendu doit être légal.  
+ * - Une capture du roi en un coup doit toujours être trouvée à profondeur 4,
+ *   malgré les coups réduits et le coup nul.  
+ */
+void test_ia_pvs_reductions() {
+    game_setup_default();
+    reset_move_history();
+    GameState gs = createGameStateFromCurrent();
+    GameState before = gs;
+    Move mv;
+    trouverMeilleurCoupIA(&gs, &mv, 5);
+    assert(memcmp(&gs, &before, sizeof(GameState)) == 0);
+    assert(mv.piece_index >= 0 && gs.pieces[mv.piece_index].color == gs.current_player);
+
+    reset_move_history();
+    gs.control[0] = gs.control[1] = 0;
+    gs.piece_count = 6;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(6, 3), .type = 'P', .color = 'B' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(4, 4), .type = 'K', .color = 'R' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(4, 5), .type = 'P', .color = 'B' };
+    gs.pieces[4] = (StatePiece){ .sq = BB_SQ(8, 0), .type = 'P', .color = 'R' };
+    gs.pieces[5] = (StatePiece){ .sq = BB_SQ(8, 2), .type = 'P', .color = 'R' }; // pas d'auto-défaite rouge
+    gs.current_player = 'B';
+    rules_sync(&gs);
+    trouverMeilleurCoupIA(&gs, &mv, 4);
+    assert(mv.to_row == 4 && mv.to_col == 3);
+
+    reset_move_history();
+    printf("test_ia_pvs_reductions OK\n");
+}
+
+/**
+ * \fn void test_ia_repetition()
+ * \brief Test de la détection des répétitions par hachage de position.
+ *
+ * \details
+ * - Un pion bleu et un pion rouge font des allers-retours avec move_piece() :
+ *   la position revient à l'identique (même hachage) toutes les 4 plies.  
+ * - Une position déjà rencontrée dans la partie est évaluée telle quelle par
+ *   la recherche, sans développer l'arbre.  
+ * - À la racine, le coup qui ramènerait une troisième fois la même position
+ *   n'est pas choisi.  
+ * - ia_search_game() voit les répétitions de l'historique qu'on lui passe,
+ *   et non celles de l'interface.  
+ */
+void test_ia_repetition() {
+    extern int ia_active;
+    int saved_active = ia_active;
+    ia_active = 0;
+    game_over = 0;
+    current_turn = 'B';
+    turn_number = 1;
+    game_setup_default();
+
+    uint64_t seen[11];
+    seen[0] = createGameStateFromCurrent().hash;
+    for (int ply = 1; ply <= 10; ++ply) {
+        // Bleu : (3,0) <-> (4,0) ; Rouge : (5,8) <-> (4,8)
+        int blue = (ply % 2) == 1;
+        int out = (ply % 4) == 1 || (ply % 4) == 2;
+        int row = blue ? (out ? 3 : 4) : (out ? 5 : 4);
+        int col = blue ? 0 : 8;
+        int idx = find_piece_at(row, col);
+        assert(idx >= 0);
+        assert(move_piece(idx, blue ? (out ? 4 : 3) : (out ? 4 : 5), col) == 1);
+        seen[ply] = createGameStateFromCurrent().hash;
+    }
+    assert(seen[2] == seen[6] && seen[6] == seen[10]);
+    assert(seen[3] == seen[7] && seen[1] != seen[5]);
+
+    // Position actuelle déjà rencontrée (ply 2 et 6) : évaluation statique
+    GameState gs = createGameStateFromCurrent();
+    int static_eval = evaluation(&gs, 'B');
+    assert(minimaxIA(&gs, 4, 'B', -1000000, 1000000) == static_eval);
+
+    // Revenir en (3,0) recréerait la position des plies 3 et 7
+    Move mv;
+    gs = createGameStateFromCurrent();
+    trouverMeilleurCoupIA(&gs, &mv, 2);
+    assert(mv.piece_index >= 0);
+    assert(!(mv.from_row == 4 && mv.from_col == 0 && mv.to_row == 3 && mv.to_col == 0));
+
+    // Historique propre à la partie : la position où mène le coup préféré y
+    // figure deux fois, il est écarté ; l'historique de l'interface n'y est pour rien
+    gs = createGameStateFromCurrent();
+    ia_reset_history(&gs);
+    IaHistory h;
+    Move first;
+    ia_history_reset(&h, &gs);
+    ia_search_game(&gs, &first, 2, 0, NULL, &h, NULL, max_turn);
+    assert(first.piece_index >= 0);
+    GameState next = gs, other = gs;
+    MoveUndo undo;
+    rules_make_move(&next, &first, &undo);
+    other.hash ^= 1;
+    ia_history_reset(&h, &next);
+    ia_history_record(&h, &other);
+    ia_history_record(&h, &next);
+    ia_history_record(&h, &gs);
+    ia_search_game(&gs, &mv, 2, 0, NULL, &h, NULL, max_turn);
+    assert(mv.piece_index >= 0);
+    assert(!(mv.from_row == first.from_row && mv.from_col == first.from_col &&
+             mv.to_row == first.to_row && mv.to_col == first.to_col));
+    trouverMeilleurCoupIA(&gs, &mv, 2);
+    assert(mv.from_row == first.from_row && mv.from_col == first.from_col &&
+           mv.to_row == first.to_row && mv.to_col == first.to_col);
+
+    game_setup_default();
+    ia_active = saved_active;
+    printf("test_ia_repetition OK\n");
+}
+
+/**
+ * \fn void test_ia_search_stats()
+ * \brief Test des statistiques rendues par ia_get_search_stats().
+ *
+ * \details
+ * - Après une recherche à profondeur 4, la profondeur, les compteurs et leur
+ *   cohérence (quiescence, coupures, table) sont vérifiés.  
+ * - La variante commence par le coup rendu et ne contient que des coups
+ *   légaux, rejoués depuis la position de départ.  
+ */
+void test_ia_search_stats() {
+    game_setup_default();
+    GameState gs = createGameStateFromCurrent();
+    Move mv;
+    trouverMeilleurCoupIA(&gs, &mv, 4);
+
+    IaSearchStats st;
+    ia_get_search_stats(&st);
+    assert(st.depth == 4 && st.threads == ia_get_threads());
+    assert(st.nodes > 0 && st.qnodes > 0 && st.qnodes <= st.nodes);
+    assert(st.cutoffs > 0 && st.first_cutoffs <= st.cutoffs);
+    assert(st.tt_probes > 0 && st.tt_hits <= st.tt_probes);
+    assert(st.elapsed_us >= 0);
+    assert(st.pv_length >= 1 && st.pv_length <= 4);
+    assert(memcmp(&st.pv[0], &mv, sizeof(Move)) == 0);
+
+    GameState replay = createGameStateFromCurrent();
+    for (int i = 0; i < st.pv_length; ++i) {
+        Move legal[RULES_MAX_MOVES];
+        int n = rules_legal_moves(&replay, legal), found = 0;
+        for (int k = 0; k < n && !found; ++k) found = memcmp(&legal[k], &st.pv[i], sizeof(Move)) == 0;
+        assert(found);
+        MoveUndo undo;
+        rules_make_move(&replay, &st.pv[i], &undo);
+    }
+    ia_print_search_stats(&st);
+    printf("test_ia_search_stats OK\n");
+}
+
+/** @brief Résultats reçus par test_ia_analyse_multipv() */
+typedef struct {
+    IaAnalysis depth[8];
+    int calls;
+} AnalyseRecord;
+
+/**
+ * \fn static void analyse_record_cb(const IaAnalysis* an, void* user_data)
+ * \brief Garde chaque profondeur rendue par ia_analyse().
+ */
+static void analyse_record_cb(const IaAnalysis* an, void* user_data) {
+    AnalyseRecord* rec = user_data;
+    assert(rec->calls < 8);
+    rec->depth[rec->calls++] = *an;
+}
+
+/**
+ * \fn void test_ia_analyse_multipv()
+ * \brief Test de l'analyse à plusieurs variantes.
+ *
+ * \details
+ * - Chaque profondeur de 1 à 4 est rendue une fois, dans l'ordre, avec trois
+ *   lignes de coups de la racine distincts, triées par score.  
+ * - Chaque variante ne contient que des coups légaux.  
+ * - Les statistiques de la dernière recherche ne changent pas ; une analyse
+ *   déjà arrêtée ne rend rien.  
+ */
+void test_ia_analyse_multipv() {
+    game_setup_default();
+    GameState gs = createGameStateFromCurrent();
+    IaSearchStats before, after;
+    ia_get_search_stats(&before);
+
+    AnalyseRecord rec = { .calls = 0 };
+    ia_analyse(&gs, 3, 4, NULL, analyse_record_cb, &rec);
+    assert(rec.calls == 4);
+    for (int d = 0; d < rec.calls; ++d) {
+        const IaAnalysis* an = &rec.depth[d];
+        assert(an->depth == d + 1 && an->count == 3 && an->hash == gs.hash);
+        assert(d == 0 || an->nodes >= rec.depth[d - 1].nodes);
+        for (int i = 0; i < an->count; ++i) {
+            const IaAnalysisLine* line = &an->lines[i];
+            assert(line->pv_length >= 1 && line->pv_length <= an->depth);
+            assert(i == 0 || line->score <= an->lines[i - 1].score);
+            for (int j = 0; j < i; ++j)
+                assert(memcmp(&line->pv[0], &an->lines[j].pv[0], sizeof(Move)) != 0);
+
+            GameState replay = gs;
+            for (int k = 0; k < line->pv_length; ++k) {
+                Move legal[RULES_MAX_MOVES];
+                int n = rules_legal_moves(&replay, legal), found = 0;
+                for (int m = 0; m < n && !found; ++m) found = memcmp(&legal[m], &line->pv[k], sizeof(Move)) == 0;
+                assert(found);
+                MoveUndo undo;
+                rules_make_move(&replay, &line->pv[k], &undo);
+            }
+        }
+    }
+    ia_get_search_stats(&after);
+    assert(memcmp(&before, &after, sizeof(before)) == 0);
+
+    int stop = 1;
+    rec.calls = 0;
+    ia_analyse(&gs, 3, 4, &stop, analyse_record_cb, &rec);
+    assert(rec.calls == 0);
+    printf("test_ia_analyse_multipv OK\n");
+}
@@ -0,0 +1,73 @@
+/**
+ * \file TestAnalysis.c
+ * \brief Tests unitaires du mode analyse (thread d'analyse et relance sur changement de position).
+ *
+ * \details
+ * Sans boucle GTK, les résultats du thread sont récupérés par analysis_poll()
+ * comme le ferait le rappel programmé.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "analysis.h"
+#include "game.h"
+#include "ui.h"
+
+/**
+ * \fn static int analysis_wait_for(uint64_t hash, int min_depth, IaAnalysis *out)
+ * \brief Récupère les résultats jusqu'à une profondeur donnée pour une position (5 s au plus).
+ *
+ * \return 1 si atteinte, 0 sinon.
+ */
+static int analysis_wait_for(uint64_t hash, int min_depth, IaAnalysis *out) {
+    struct timespec pause = { 0, 5 * 1000000L };
+    for (int i = 0; i < 1000; ++i) {
+        analysis_poll();
+        if (analysis_get(out) && out->hash == hash && out->depth >= min_depth) return 1;
+        nanosleep(&pause, NULL);
+    }
+    return 0;
+}
+
+/**
+ * \fn void test_analysis_restart()
+ * \brief Le thread d'analyse suit la position et n'en montre jamais une ancienne.
+ *
+ * \details
+ * - Sur la position initiale, deux lignes arrivent jusqu'à la profondeur 3.  
+ * - Après le meilleur coup, les lignes précédentes disparaissent aussitôt,
+ *   puis celles de la nouvelle position arrivent.  
+ * - Sans position (partie finie), plus aucune ligne ; l'arrêt attend le thread.  
+ */
+void test_analysis_restart() {
+    game_setup_default();
+    GameState gs = createGameStateFromCurrent();
+    assert(analysis_start(2) == 0 && analysis_running());
+
+    analysis_set_position(&gs);
+    IaAnalysis an;
+    assert(analysis_wait_for(gs.hash, 3, &an));
+    assert(an.count == 2);
+    assert(memcmp(&an.lines[0].pv[0], &an.lines[1].pv[0], sizeof(Move)) != 0);
+
+    GameState next = gs;
+    MoveUndo undo;
+    rules_make_move(&next, &an.lines[0].pv[0], &undo);
+    analysis_set_position(&next);
+    assert(!analysis_get(&an));
+    assert(analysis_wait_for(next.hash, 1, &an));
+    assert(an.count == 2 && an.hash == next.hash);
+    assert(next.pieces[an.lines[0].pv[0].piece_index].color == next.current_player);
+
+    analysis_set_position(NULL);
+    assert(!analysis_get(&an));
+    analysis_shutdown();
+    assert(!analysis_running() && !analysis_get(&an));
+    ui_flush();
+    printf("test_analysis_restart OK\n");
+}
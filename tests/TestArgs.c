@@ -103,6 +103,389 @@ void test_parse_args_ia() {
     printf("test_parse_args_ia OK\n");
 }
 
+/**
+ * \fn void test_parse_args_tt()
+ * \brief Test du parsing de la taille de la table de transposition.
+ *
+ * \details
+ * - Simule l'appel avec `-l -tt 64` et vérifie la taille lue.  
+ * - Vérifie qu'une taille manquante ou nulle est refusée.  
+ */
+void test_parse_args_tt() {
+    char *argv[] = {"program", "-l", "-tt", "64"};
+    args_t args = parse_args(4, argv);
+    assert(!args.error);
+    assert(args.tt_mb == 64);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-l", "-tt"};
+    args_t args2 = parse_args(3, argv2);
+    assert(args2.error);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-l", "--tt", "0"};
+    args_t args3 = parse_args(4, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    printf("test_parse_args_tt OK\n");
+}
+
+/**
+ * \fn void test_parse_args_time()
+ * \brief Test du parsing du temps de réflexion de l'IA.
+ *
+ * \details
+ * - Simule l'appel avec `-s -ia -t 250 5555` et vérifie le temps et le port.  
+ * - Vérifie qu'une valeur non numérique est refusée.  
+ */
+void test_parse_args_time() {
+    char *argv[] = {"program", "-s", "-ia", "-t", "250", "5555"};
+    args_t args = parse_args(6, argv);
+    assert(!args.error);
+    assert(args.time_ms == 250);
+    assert(args.port == 5555);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-l", "--time", "vite"};
+    args_t args2 = parse_args(4, argv2);
+    assert(args2.error);
+    free_args(&args2);
+
+    printf("test_parse_args_time OK\n");
+}
+
+/**
+ * \fn void test_parse_args_threads()
+ * \brief Test du parsing du nombre de threads de l'IA.
+ *
+ * \details
+ * - Simule l'appel avec `-l -ia -j 4` et vérifie le nombre lu.  
+ * - Vérifie qu'un nombre hors bornes est refusé.  
+ */
+void test_parse_args_threads() {
+    char *argv[] = {"program", "-l", "-ia", "-j", "4"};
+    args_t args = parse_args(5, argv);
+    assert(!args.error);
+    assert(args.threads == 4);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-l", "--threads", "1000"};
+    args_t args2 = parse_args(4, argv2);
+    assert(args2.error);
+    free_args(&args2);
+
+    printf("test_parse_args_threads OK\n");
+}
+
+/**
+ * \fn void test_parse_args_ponder()
+ * \brief Test du parsing de l'option de réflexion anticipée.
+ *
+ * \details
+ * - Simule l'appel avec `-c -ia -p 127.0.0.1:5555` et vérifie les champs.  
+ * - Vérifie que l'option est désactivée par défaut.  
+ */
+void test_parse_args_ponder() {
+    char *argv[] = {"program", "-c", "-ia", "-p", "127.0.0.1:5555"};
+    args_t args = parse_args(5, argv);
+    assert(!args.error);
+    assert(args.ponder == 1);
+    assert(args.mode == MODE_CLIENT && args.port == 5555);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-l", "-ia"};
+    args_t args2 = parse_args(3, argv2);
+    assert(!args2.error);
+    assert(args2.ponder == 0);
+    free_args(&args2);
+
+    printf("test_parse_args_ponder OK\n");
+}
+
+/**
+ * \fn void test_parse_args_verbose()
+ * \brief Test du parsing de l'option des statistiques de recherche.
+ *
+ * \details
+ * - Simule l'appel avec `-l -ia --verbose` puis `-l -ia -v` et vérifie le champ.  
+ * - Vérifie que l'option est désactivée par défaut.  
+ */
+void test_parse_args_verbose() {
+    char *argv[] = {"program", "-l", "-ia", "--verbose"};
+    args_t args = parse_args(4, argv);
+    assert(!args.error);
+    assert(args.verbose == 1 && args.is_ia);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-l", "-ia", "-v"};
+    args_t args2 = parse_args(4, argv2);
+    assert(!args2.error && args2.verbose == 1);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-l"};
+    args_t args3 = parse_args(2, argv3);
+    assert(!args3.error && args3.verbose == 0);
+    free_args(&args3);
+
+    printf("test_parse_args_verbose OK\n");
+}
+
+/**
+ * \fn void test_parse_args_selfplay()
+ * \brief Test du parsing des options du mode selfplay.
+ *
+ * \details
+ * - Simule l'appel avec `--selfplay 10 --engine-a d3 --engine-b t50 --workers 2 --out r.json`.  
+ * - Vérifie les valeurs par défaut (t100, 1 processus, stdout) et le refus d'un moteur invalide.  
+ */
+void test_parse_args_selfplay() {
+    char *argv[] = {"program", "--selfplay", "10", "--engine-a", "d3", "--engine-b", "t50",
+                    "--workers", "2", "--out", "r.json"};
+    args_t args = parse_args(11, argv);
+    assert(!args.error && args.mode == MODE_SELFPLAY && args.games == 10);
+    assert(args.engine_a.depth == 3 && args.engine_a.time_ms == 0);
+    assert(args.engine_b.depth == 0 && args.engine_b.time_ms == 50);
+    assert(args.workers == 2 && args.out && strcmp(args.out, "r.json") == 0);
+    free_args(&args);
+    assert(args.out == NULL);
+
+    char *argv2[] = {"program", "--selfplay", "4"};
+    args_t args2 = parse_args(3, argv2);
+    assert(!args2.error && args2.games == 4 && args2.workers == 0 && args2.out == NULL);
+    assert(args2.engine_a.depth == 0 && args2.engine_a.time_ms == 100);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "--selfplay", "4", "--engine-a", "x3"};
+    args_t args3 = parse_args(5, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    printf("test_parse_args_selfplay OK\n");
+}
+
+/**
+ * \fn void test_parse_args_book()
+ * \brief Test du parsing des options du livre d'ouverture.
+ *
+ * \details
+ * - `--book` est accepté dans tous les modes, `--book-out` seulement avec `--selfplay`.  
+ * - Une option donnée deux fois ou sans fichier est refusée.  
+ */
+void test_parse_args_book() {
+    char *argv[] = {"program", "-l", "-ia", "--book", "k.book"};
+    args_t args = parse_args(5, argv);
+    assert(!args.error && args.book && strcmp(args.book, "k.book") == 0 && args.book_out == NULL);
+    free_args(&args);
+    assert(args.book == NULL);
+
+    char *argv2[] = {"program", "--selfplay", "8", "--book-out", "n.book", "--book", "k.book"};
+    args_t args2 = parse_args(7, argv2);
+    assert(!args2.error && strcmp(args2.book_out, "n.book") == 0 && strcmp(args2.book, "k.book") == 0);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-l", "--book-out", "n.book"};
+    args_t args3 = parse_args(4, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    char *argv4[] = {"program", "-l", "--book", "a", "--book", "b"};
+    args_t args4 = parse_args(6, argv4);
+    assert(args4.error);
+    free_args(&args4);
+
+    char *argv5[] = {"program", "-l", "--book"};
+    args_t args5 = parse_args(3, argv5);
+    assert(args5.error);
+    free_args(&args5);
+
+    printf("test_parse_args_book OK\n");
+}
+
+/**
+ * \fn void test_parse_args_tb()
+ * \brief Test du parsing des options de la table de finales.
+ *
+ * \details
+ * - `--tb` est accepté dans tous les modes ; `--tb-gen` choisit le mode de génération.  
+ * - `--tb-pawns` est borné à TB_GEN_MAX_PAWNS (3 refusé) et refusé hors génération.  
+ */
+void test_parse_args_tb() {
+    char *argv[] = {"program", "-l", "-ia", "--tb", "k.tb"};
+    args_t args = parse_args(5, argv);
+    assert(!args.error && args.mode == MODE_LOCAL && strcmp(args.tb, "k.tb") == 0 && args.tb_gen == NULL);
+    free_args(&args);
+    assert(args.tb == NULL);
+
+    char *argv2[] = {"program", "--tb-gen", "n.tb", "--tb-pawns", "2"};
+    args_t args2 = parse_args(5, argv2);
+    assert(!args2.error && args2.mode == MODE_TBGEN && strcmp(args2.tb_gen, "n.tb") == 0 && args2.tb_pawns == 2);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "--tb-gen", "n.tb", "--tb-pawns", "3"};
+    args_t args3 = parse_args(5, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    char *argv4[] = {"program", "-l", "--tb-pawns", "2"};
+    args_t args4 = parse_args(4, argv4);
+    assert(args4.error);
+    free_args(&args4);
+
+    printf("test_parse_args_tb OK\n");
+}
+
+/**
+ * \fn void test_parse_args_serve()
+ * \brief Test du parsing du serveur de parties sans interface.
+ *
+ * \details
+ * - `--serve PORT` choisit le mode MODE_SERVE ; `--max-matches` et `--search-workers` sont lus.  
+ * - `--workers` (processus de --selfplay) est refusé avec `--serve`, `--search-workers` avec `--selfplay`.  
+ * - `--serve` sans port valide, et `--max-matches` hors `--serve` ou au-delà de SERVER_MAX_MATCHES, sont refusés.  
+ */
+void test_parse_args_serve() {
+    char *argv[] = {"program", "--serve", "5555", "--max-matches", "8", "--search-workers", "3", "-t", "200"};
+    args_t args = parse_args(9, argv);
+    assert(!args.error && args.mode == MODE_SERVE && args.port == 5555);
+    assert(args.max_matches == 8 && args.search_workers == 3 && args.workers == 0 && args.time_ms == 200);
+    free_args(&args);
+
+    char *argv2[] = {"program", "--serve", "abc"};
+    args_t args2 = parse_args(3, argv2);
+    assert(args2.error);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-s", "5555", "--max-matches", "8"};
+    args_t args3 = parse_args(5, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    char *argv4[] = {"program", "--serve", "5555", "--max-matches", "100000"};
+    args_t args4 = parse_args(5, argv4);
+    assert(args4.error);
+    free_args(&args4);
+
+    char *argv5[] = {"program", "--serve", "5555", "--workers", "3"};
+    args_t args5 = parse_args(5, argv5);
+    assert(args5.error);
+    free_args(&args5);
+
+    char *argv6[] = {"program", "--selfplay", "4", "--search-workers", "3"};
+    args_t args6 = parse_args(5, argv6);
+    assert(args6.error);
+    free_args(&args6);
+
+    printf("test_parse_args_serve OK\n");
+}
+
+/**
+ * \fn void test_parse_args_ping()
+ * \brief Test du parsing des options du canal de contrôle réseau.
+ *
+ * \details
+ * - `--ping-interval MS` est lu, `--no-ping` donne -1, rien : 0 (défaut).  
+ * - Un intervalle nul ou au-delà de ARGS_MAX_PING_MS est refusé.  
+ */
+void test_parse_args_ping() {
+    char *argv[] = {"program", "-c", "127.0.0.1:5555", "--ping-interval", "500"};
+    args_t args = parse_args(5, argv);
+    assert(!args.error && args.ping_ms == 500);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-s", "5555", "--no-ping"};
+    args_t args2 = parse_args(4, argv2);
+    assert(!args2.error && args2.ping_ms == -1);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-s", "5555", "--ping-interval", "0"};
+    args_t args3 = parse_args(5, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    char *argv4[] = {"program", "-s", "5555", "--ping-interval", "60001"};
+    args_t args4 = parse_args(5, argv4);
+    assert(args4.error);
+    free_args(&args4);
+
+    printf("test_parse_args_ping OK\n");
+}
+
+/**
+ * \fn void test_parse_args_record()
+ * \brief Test du parsing des options d'enregistrement des parties.
+ *
+ * \details
+ * - `--record` et `--record-every` sont acceptés avec `--selfplay` et `--serve` seulement.  
+ * - `--record-every` sans `--record`, nul ou au-delà de RECORD_MAX_SNAP_EVERY est refusé.  
+ */
+void test_parse_args_record() {
+    char *argv[] = {"program", "--selfplay", "8", "--record", "p.krec", "--record-every", "8"};
+    args_t args = parse_args(7, argv);
+    assert(!args.error && strcmp(args.record, "p.krec") == 0 && args.record_every == 8);
+    free_args(&args);
+    assert(args.record == NULL);
+
+    char *argv2[] = {"program", "--serve", "5555", "--record", "s.krec"};
+    args_t args2 = parse_args(5, argv2);
+    assert(!args2.error && strcmp(args2.record, "s.krec") == 0 && args2.record_every == 0);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-l", "--record", "p.krec"};
+    args_t args3 = parse_args(4, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    char *argv4[] = {"program", "--selfplay", "8", "--record-every", "8"};
+    args_t args4 = parse_args(5, argv4);
+    assert(args4.error);
+    free_args(&args4);
+
+    char *argv5[] = {"program", "--selfplay", "8", "--record", "p.krec", "--record-every", "257"};
+    args_t args5 = parse_args(7, argv5);
+    assert(args5.error);
+    free_args(&args5);
+
+    printf("test_parse_args_record OK\n");
+}
+
+/**
+ * \fn void test_parse_args_analyse()
+ * \brief Test du parsing de l'option `--analyse`.
+ *
+ * \details
+ * - `--analyse N` est accepté avec l'interface (local, serveur, client).  
+ * - Refusé sans nombre, nul, au-delà de ARGS_MAX_ANALYSE et dans les modes sans fenêtre.  
+ */
+void test_parse_args_analyse() {
+    char *argv[] = {"program", "-l", "--analyse", "3"};
+    args_t args = parse_args(4, argv);
+    assert(!args.error && args.analyse == 3);
+    free_args(&args);
+
+    char *argv2[] = {"program", "-s", "5555", "--analyse", "1"};
+    args_t args2 = parse_args(5, argv2);
+    assert(!args2.error && args2.analyse == 1);
+    free_args(&args2);
+
+    char *argv3[] = {"program", "-l", "--analyse", "9"};
+    args_t args3 = parse_args(4, argv3);
+    assert(args3.error);
+    free_args(&args3);
+
+    char *argv4[] = {"program", "-l", "--analyse"};
+    args_t args4 = parse_args(3, argv4);
+    assert(args4.error);
+    free_args(&args4);
+
+    char *argv5[] = {"program", "--selfplay", "8", "--analyse", "2"};
+    args_t args5 = parse_args(5, argv5);
+    assert(args5.error);
+    free_args(&args5);
+
+    printf("test_parse_args_analyse OK\n");
+}
+
 /**
  * \fn void test_parse_args_invalid()
  * \brief Test du parsing des arguments pour des cas invalides.
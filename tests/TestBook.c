@@ -0,0 +1,155 @@
+/**
+ * \file TestBook.c
+ * \brief Tests unitaires du livre d'ouverture.
+ *
+ * \details
+ * Vérifie l'écriture d'un livre (fusion des doublons, ordre des poids), sa
+ * projection en mémoire et sa consultation, le refus d'un fichier invalide,
+ * la construction depuis des parties selfplay et le coup rendu par l'IA
+ * sans recherche.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "book.h"
+#include "game.h"
+#include "ia.h"
+#include "selfplay.h"
+#include "tt.h"
+#include "TestUtil.h"
+
+/**
+ * \fn void test_book_build_probe()
+ * \brief Un livre écrit puis projeté rend ses coups, par poids décroissant.
+ *
+ * \details
+ * - Deux coups de la position de départ, l'un ajouté deux fois : poids fusionnés.
+ * - Un coup inconnu des règles (pièce adverse) est écarté à la consultation.
+ * - Le tirage pondéré rend toujours un des coups du livre, et le même pour un même
+ *   état de tirage ; une autre position n'y est pas.
+ * - Un fichier tronqué ou d'une autre signature est refusé et ferme le livre.
+ */
+void test_book_build_probe() {
+    GameState s = game_start_state();
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(&s, moves);
+    assert(n >= 2);
+
+    BookBuilder b;
+    book_builder_init(&b);
+    assert(book_builder_add(&b, &s, &moves[0], 1) == 0);
+    assert(book_builder_add(&b, &s, &moves[1], 2) == 0);
+    assert(book_builder_add(&b, &s, &moves[0], 2) == 0);
+    assert(book_builder_add(&b, &s, &moves[1], 0) == 0);
+    Move foreign = { -1, 8, 8, 7, 8 };  // case de départ rouge, trait aux bleus
+    assert(book_builder_add(&b, &s, &foreign, 5) == 0);
+    char path[64];
+    test_temp_path("book", path, sizeof(path));
+    assert(book_builder_write(&b, path) == 3);
+    book_builder_free(&b);
+
+    assert(book_open(path) == 0 && book_size() == 3);
+    Move got[BOOK_MAX_MOVES];
+    int w[BOOK_MAX_MOVES];
+    assert(book_probe_moves(&s, got, w, BOOK_MAX_MOVES) == 2);
+    assert(w[0] == 3 && w[1] == 2);
+    assert(memcmp(&got[0], &moves[0], sizeof(Move)) == 0);
+    assert(memcmp(&got[1], &moves[1], sizeof(Move)) == 0);
+
+    // Tirages propres à l'appelant : une même graine rejoue les mêmes coups
+    uint64_t rng = 7, replay = 7;
+    for (int i = 0; i < 20; ++i) {
+        Move mv, again;
+        assert(book_probe(&s, &rng, &mv));
+        assert(memcmp(&mv, &moves[0], sizeof(Move)) == 0 || memcmp(&mv, &moves[1], sizeof(Move)) == 0);
+        assert(book_probe(&s, &replay, &again) && memcmp(&mv, &again, sizeof(Move)) == 0);
+    }
+    assert(rng == replay && rng != 7);
+    MoveUndo undo;
+    rules_make_move(&s, &moves[0], &undo);
+    Move none;
+    assert(!book_probe(&s, &rng, &none));
+
+    // Fichier tronqué : refusé
+    FILE *f = fopen(path, "r+b");
+    assert(f);
+    assert(ftruncate(fileno(f), sizeof(BookHeader) + sizeof(BookEntry)) == 0);
+    fclose(f);
+    assert(book_open(path) != 0 && book_size() == 0);
+    f = fopen(path, "wb");
+    assert(f);
+    fputs("pas un livre d'ouverture", f);
+    fclose(f);
+    assert(book_open(path) != 0);
+    assert(book_open("/nonexistent/krojanty.book") != 0);
+    remove(path);
+
+    printf("test_book_build_probe OK\n");
+}
+
+/**
+ * \fn void test_book_selfplay_search()
+ * \brief Un livre construit depuis des parties selfplay est joué par l'IA sans recherche.
+ *
+ * \details
+ * - Deux parties à profondeur 1 ; le premier coup d'une partie non perdue par les bleus est au livre.
+ * - trouverMeilleurCoupIA() à profondeur 6 rend un coup du livre, sans nœud, marqué `book`.
+ * - Livre fermé : la même position est cherchée normalement.
+ */
+void test_book_selfplay_search() {
+    SelfPlayConfig cfg = { .games = 2, .workers = 1,
+                           .engine = { { .depth = 1 }, { .depth = 1 } } };
+    SelfPlayResult r[2];
+    selfplay_play_game(&cfg, 0, &r[0]);
+    selfplay_play_game(&cfg, 1, &r[1]);
+    assert(r[0].opening_len > 0 && r[0].opening_len <= SELFPLAY_OPENING_PLIES);
+
+    char path[64];
+    test_temp_path("book", path, sizeof(path));
+    long entries = selfplay_write_book(path, r, 2);
+    assert(entries >= 1);
+    assert(book_open(path) == 0 && (long)book_size() == entries);
+
+    GameState s = game_start_state();
+    Move got[BOOK_MAX_MOVES];
+    int w[BOOK_MAX_MOVES];
+    int n = book_probe_moves(&s, got, w, BOOK_MAX_MOVES);
+    int blue_scores = 0;
+    for (int g = 0; g < 2; ++g) {
+        char blue = (r[g].a_color == 'B') ? 'A' : 'B';
+        if (r[g].winner != 'D' && r[g].winner != blue) continue;
+        ++blue_scores;
+        int found = 0;
+        for (int i = 0; i < n; ++i)
+            found |= got[i].from_row * 9 + got[i].from_col == r[g].opening[0][0] &&
+                     got[i].to_row * 9 + got[i].to_col == r[g].opening[0][1];
+        assert(found);
+    }
+    assert(n <= blue_scores);
+
+    if (n > 0) {
+        Move mv;
+        tt_clear();
+        trouverMeilleurCoupIA(&s, &mv, 6);
+        IaSearchStats st;
+        ia_get_search_stats(&st);
+        assert(st.book == 1 && st.nodes == 0 && st.pv_length == 1);
+        assert(memcmp(&mv, &st.pv[0], sizeof(Move)) == 0);
+        assert(rules_can_move(&s, mv.piece_index, mv.to_row, mv.to_col));
+    }
+
+    book_close();
+    remove(path);
+    Move mv;
+    trouverMeilleurCoupIA(&s, &mv, 1);
+    IaSearchStats st;
+    ia_get_search_stats(&st);
+    assert(st.book == 0 && st.nodes > 0 && mv.piece_index >= 0);
+
+    printf("test_book_selfplay_search OK (%ld entrees, %d coups de depart)\n", entries, n);
+}
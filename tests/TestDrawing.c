@@ -20,7 +20,11 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include "drawing.h"
+#include "game.h"
+
+void reset_game_state(void);
 
 /** \fn void click_to_cell_pure(double x, double y, int width, int height, int *row, int *col)
  * \brief Convertit les coordonnées de la souris en indices de cellule du plateau.
@@ -73,3 +77,59 @@ void test_click_to_cell() {
 }
 
 
+
+/** \fn void test_drawing_board_signature()
+ * \brief Teste les signatures de cases qui décident des cases redessinées.
+ *
+ * \details
+ *   - Sélectionner une pièce ne change que sa case.
+ *   - Un déplacement change la case quittée et la case atteinte ; les cases
+ *     sans pièce ni changement de contrôle gardent leur signature.
+ *   - Un point jouable change la signature de sa case.
+ */
+void test_drawing_board_signature() {
+    Piece saved_pieces[20];
+    int saved_control[9][9];
+    int saved_count = piece_count, saved_turn = turn_number, saved_over = game_over;
+    char saved_player = current_turn;
+    memcpy(saved_pieces, pieces, sizeof(saved_pieces));
+    memcpy(saved_control, cell_control, sizeof(saved_control));
+
+    reset_game_state();
+    memset(highlight_moves, 0, sizeof(highlight_moves));
+    turn_number = 1;
+    pieces[piece_count++] = (Piece){.row=4, .col=4, .color='B', .type='P'};
+    pieces[piece_count++] = (Piece){.row=1, .col=7, .color='R', .type='P'};
+    current_turn = 'B';
+
+    uint16_t before[81], after[81];
+    drawing_board_signature(before);
+    assert(before[4 * 9 + 4] != 0 && before[1 * 9 + 7] != before[4 * 9 + 4] && before[0] == 0);
+
+    selected_piece = 0;
+    drawing_board_signature(after);
+    for (int sq = 0; sq < 81; ++sq) assert((after[sq] != before[sq]) == (sq == 4 * 9 + 4));
+    selected_piece = -1;
+
+    drawing_board_signature(before);
+    assert(move_piece(0, 4, 6));
+    drawing_board_signature(after);
+    assert(after[4 * 9 + 4] != before[4 * 9 + 4] && after[4 * 9 + 6] != before[4 * 9 + 6]);
+    assert(after[1 * 9 + 7] == before[1 * 9 + 7]);
+    for (int sq = 0; sq < 81; ++sq)
+        if (sq != 4 * 9 + 4 && sq != 4 * 9 + 6) assert((after[sq] & ~3u) == (before[sq] & ~3u)); // contrôle seul
+
+    memcpy(before, after, sizeof(before));
+    highlight_moves[2][2] = 1;
+    drawing_board_signature(after);
+    assert(after[2 * 9 + 2] != before[2 * 9 + 2]);
+    highlight_moves[2][2] = 0;
+
+    memcpy(pieces, saved_pieces, sizeof(saved_pieces));
+    memcpy(cell_control, saved_control, sizeof(saved_control));
+    piece_count = saved_count;
+    turn_number = saved_turn;
+    game_over = saved_over;
+    current_turn = saved_player;
+    printf("test_drawing_board_signature OK\n");
+}
@@ -0,0 +1,119 @@
+/**
+ * \file TestEvalKernel.c
+ * \brief Tests unitaires des variantes du noyau d'évaluation.
+ *
+ * \details
+ * Chaque variante disponible sur la machine de test doit rendre les mêmes
+ * termes que le calcul de référence (bb_popcount(), bb_rook_mobility()),
+ * position par position comme en lot.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "eval_kernel.h"
+
+/** \brief Nombre de positions comparées (impair : reste du lot AVX2). */
+#define EVAL_TEST_POSITIONS 61
+
+/**
+ * \fn static void eval_reference(const GameState* s, EvalFeatures* f)
+ * \brief Termes calculés avec les fonctions de bitboard.h.
+ */
+static void eval_reference(const GameState* s, EvalFeatures* f) {
+    Bitboard empty = ~rules_occupied(s) & BB_FULL;
+    for (int c = 0; c < 2; ++c) {
+        f->pieces[c] = bb_popcount(s->occ[c]);
+        f->control[c] = bb_popcount(s->control[c]);
+        f->mobility[c] = bb_rook_mobility(s->occ[c], empty);
+    }
+}
+
+/**
+ * \fn void test_eval_kernel_variants()
+ * \brief Toutes les variantes disponibles concordent avec la référence.
+ *
+ * \details
+ * - Positions : une partie jouée depuis la position de départ, plus des pièces
+ *   aux bords (colonnes A et I, rangées 1 et 9) qui testent les passages de ligne
+ *   et de mot de 64 bits.
+ * - Appels unitaires et en lot (taille impaire) pour chaque variante.
+ * - La variante automatique est rétablie à la fin.
+ */
+void test_eval_kernel_variants() {
+    static GameState pos[EVAL_TEST_POSITIONS];
+    const StatePiece start[] = {
+        { BB_SQ(1, 1), 'B', 'K' }, { BB_SQ(2, 0), 'B', 'P' }, { BB_SQ(3, 0), 'B', 'P' },
+        { BB_SQ(2, 1), 'B', 'P' }, { BB_SQ(3, 1), 'B', 'P' }, { BB_SQ(0, 2), 'B', 'P' },
+        { BB_SQ(1, 2), 'B', 'P' }, { BB_SQ(2, 2), 'B', 'P' }, { BB_SQ(0, 3), 'B', 'P' },
+        { BB_SQ(1, 3), 'B', 'P' }, { BB_SQ(7, 7), 'R', 'K' }, { BB_SQ(7, 5), 'R', 'P' },
+        { BB_SQ(8, 5), 'R', 'P' }, { BB_SQ(6, 6), 'R', 'P' }, { BB_SQ(7, 6), 'R', 'P' },
+        { BB_SQ(8, 6), 'R', 'P' }, { BB_SQ(5, 7), 'R', 'P' }, { BB_SQ(6, 7), 'R', 'P' },
+        { BB_SQ(5, 8), 'R', 'P' }, { BB_SQ(6, 8), 'R', 'P' },
+    };
+    const StatePiece edges[] = {
+        { BB_SQ(0, 8), 'B', 'K' }, { BB_SQ(1, 0), 'B', 'P' }, { BB_SQ(7, 0), 'B', 'P' },
+        { BB_SQ(8, 8), 'B', 'P' }, { BB_SQ(8, 0), 'R', 'K' }, { BB_SQ(0, 0), 'R', 'P' },
+        { BB_SQ(7, 8), 'R', 'P' }, { BB_SQ(3, 8), 'R', 'P' },
+    };
+
+    GameState s;
+    memset(&s, 0, sizeof(s));
+    s.piece_count = 8;
+    memcpy(s.pieces, edges, sizeof(edges));
+    s.current_player = 'B';
+    s.turn_number = 1;
+    rules_sync(&s);
+    s.control[0] = BB_FILE_I | bb_bit(80);
+    s.control[1] = BB_FILE_A;
+    pos[0] = s;
+
+    memset(&s, 0, sizeof(s));
+    s.piece_count = 20;
+    memcpy(s.pieces, start, sizeof(start));
+    s.current_player = 'B';
+    s.turn_number = 1;
+    rules_sync(&s);
+    int npos = 1;
+    while (npos < EVAL_TEST_POSITIONS) {
+        Move moves[RULES_MAX_MOVES];
+        int n = rules_legal_moves(&s, moves);
+        if (n == 0) break;
+        MoveUndo undo;
+        rules_make_move(&s, &moves[(npos * 13) % n], &undo);
+        pos[npos++] = s;
+    }
+    assert(npos > 20);
+
+    EvalFeatures expect[EVAL_TEST_POSITIONS], got[EVAL_TEST_POSITIONS];
+    const GameState* ptr[EVAL_TEST_POSITIONS];
+    for (int i = 0; i < npos; ++i) {
+        eval_reference(&pos[i], &expect[i]);
+        ptr[i] = &pos[i];
+    }
+
+    const EvalKernel kernels[] = { EVAL_KERNEL_SCALAR, EVAL_KERNEL_SSE2, EVAL_KERNEL_AVX2, EVAL_KERNEL_NEON };
+    int tested = 0;
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (eval_set_kernel(kernels[k]) != 0) continue;
+        assert(eval_get_kernel() == kernels[k]);
+        for (int i = 0; i < npos; ++i) {
+            EvalFeatures f;
+            eval_features(&pos[i], &f);
+            assert(memcmp(&f, &expect[i], sizeof(f)) == 0);
+        }
+        memset(got, 0, sizeof(got));
+        eval_features_batch(ptr, npos, got);
+        assert(memcmp(got, expect, npos * sizeof(EvalFeatures)) == 0);
+        printf("  variante %s OK\n", eval_kernel_name(kernels[k]));
+        ++tested;
+    }
+    assert(tested >= 1);
+
+    assert(eval_set_kernel(EVAL_KERNEL_AUTO) == 0);
+    assert(eval_get_kernel() != EVAL_KERNEL_AUTO);
+    printf("test_eval_kernel_variants OK (%d variantes, %d positions)\n", tested, npos);
+}
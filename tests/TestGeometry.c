@@ -0,0 +1,72 @@
+/**
+ * \file TestGeometry.c
+ * \brief Tests unitaires des tables géométriques précalculées.
+ *
+ * \details
+ * Compare les tables générées à la compilation avec un calcul direct par
+ * coordonnées, et vérifie le glissement bloqué par les pièces.
+ *
+ * \author valentin.leray@uha.fr
+ * \date 2025-10-08
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include "geometry.h"
+
+/**
+ * \fn void test_geo_tables()
+ * \brief Les rayons et paires de cases correspondent au calcul par coordonnées.
+ *
+ * \details
+ * - Pour chaque case et direction, recalcule les cases à 1..8 pas.  
+ * - Vérifie geo_ray_sq, geo_ray et geo_pair, y compris les -1 hors plateau.  
+ */
+void test_geo_tables() {
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = { 0, 0,-1, 1};
+    for (int sq = 0; sq < 81; ++sq) {
+        for (int d = 0; d < GEO_DIRS; ++d) {
+            Bitboard ray = 0;
+            for (int k = 1; k <= GEO_RAY_MAX; ++k) {
+                int r = sq / 9 + k * dr[d], c = sq % 9 + k * dc[d];
+                int expect = (r >= 0 && r < 9 && c >= 0 && c < 9) ? r * 9 + c : -1;
+                assert(geo_ray_sq[sq][d][k - 1] == expect);
+                if (expect >= 0) ray |= bb_bit(expect);
+                if (k == 1) assert(geo_pair[sq][d].near == expect);
+                if (k == 2) assert(geo_pair[sq][d].far == expect);
+            }
+            assert(geo_ray[sq][d] == ray);
+        }
+    }
+    printf("test_geo_tables OK\n");
+}
+
+/**
+ * \fn void test_geo_slide()
+ * \brief Glissement arrêté par la première pièce et direction des coups.
+ *
+ * \details
+ * - Depuis E5 avec une pièce en E2 et une en H5, vérifie les cases atteintes.  
+ * - Vérifie geo_dir() sur des coups orthogonaux, diagonaux et nuls.  
+ */
+void test_geo_slide() {
+    int e5 = 4 * 9 + 4;
+    Bitboard occ = bb_bit(e5) | bb_bit(7 * 9 + 4) | bb_bit(4 * 9 + 7);
+
+    Bitboard down = geo_slide(e5, 1, occ);   // bloqué en ligne 7
+    assert(down == (bb_bit(5 * 9 + 4) | bb_bit(6 * 9 + 4)));
+    Bitboard right = geo_slide(e5, 3, occ);  // bloqué en colonne 7
+    assert(right == (bb_bit(4 * 9 + 5) | bb_bit(4 * 9 + 6)));
+    assert(geo_slide(e5, 0, occ) == geo_ray[e5][0]); // rien au-dessus
+    assert(bb_popcount(geo_slide(e5, 2, occ)) == 4);
+
+    assert(geo_dir(e5, 0 * 9 + 4) == 0);
+    assert(geo_dir(e5, 8 * 9 + 4) == 1);
+    assert(geo_dir(e5, 4 * 9 + 0) == 2);
+    assert(geo_dir(e5, 4 * 9 + 8) == 3);
+    assert(geo_dir(e5, 5 * 9 + 5) == -1);
+    assert(geo_dir(e5, e5) == -1);
+    printf("test_geo_slide OK\n");
+}
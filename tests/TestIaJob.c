@@ -0,0 +1,104 @@
+/**
+ * \file TestIaJob.c
+ * \brief Tests unitaires de la recherche de l'IA en arrière-plan.
+ *
+ * \details
+ * Vérifie qu'une tâche lancée par ia_job_start() cherche bien sur son propre
+ * thread sans modifier la position d'origine, et qu'une tâche annulée
+ * s'arrête sans rendre de coup. Couvre aussi la réflexion anticipée.
+ *
+ * \author valentin.leray@uha.fr
+ * \date 2025-10-06
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ia_job.h"
+#include "game.h"
+
+/**
+ * \fn void test_ia_job_start_wait()
+ * \brief Une tâche rend un coup et laisse la position intacte.
+ *
+ * \details
+ * - Lance une recherche de 50 ms sur la position initiale.  
+ * - Attend la fin du thread et vérifie le coup obtenu.  
+ */
+void test_ia_job_start_wait() {
+    game_setup_default();
+    GameState gs = createGameStateFromCurrent();
+    GameState before = gs;
+
+    assert(ia_job_start(&gs, 50, NULL, NULL) == 0);
+    Move mv;
+    assert(ia_job_wait(&mv) == 0);
+    assert(!ia_job_busy());
+    assert(mv.piece_index >= 0 && mv.piece_index < gs.piece_count);
+    assert(gs.pieces[mv.piece_index].color == gs.current_player);
+    assert(memcmp(&gs, &before, sizeof(GameState)) == 0);
+
+    ia_job_shutdown();
+    reset_move_history();
+    printf("test_ia_job_start_wait OK\n");
+}
+
+/**
+ * \fn void test_ia_job_cancel()
+ * \brief Une tâche annulée s'arrête vite et ne rend aucun coup.
+ *
+ * \details
+ * - Lance une recherche de 10 s puis l'annule aussitôt.  
+ * - ia_job_shutdown() doit rendre la main sans attendre le budget.  
+ */
+void test_ia_job_cancel() {
+    game_setup_default();
+    GameState gs = createGameStateFromCurrent();
+
+    assert(ia_job_start(&gs, 10000, NULL, NULL) == 0);
+    assert(ia_job_busy());
+    ia_job_shutdown();
+    assert(!ia_job_busy());
+    assert(ia_job_wait(NULL) == -1);
+
+    reset_move_history();
+    printf("test_ia_job_cancel OK\n");
+}
+
+/**
+ * \fn void test_ia_job_ponder()
+ * \brief La réflexion anticipée tourne jusqu'à son annulation et prépare la table.
+ *
+ * \details
+ * - Lance une réflexion anticipée sur la position issue du coup prévu.  
+ * - Vérifie qu'elle tourne toujours après 50 ms puis qu'elle s'arrête.  
+ * - Vérifie que la table propose ensuite un coup pour cette position.  
+ */
+void test_ia_job_ponder() {
+    game_setup_default();
+    GameState gs = createGameStateFromCurrent();
+    Move mv;
+    trouverMeilleurCoupIA(&gs, &mv, 3);
+    MoveUndo undo;
+    rules_make_move(&gs, &mv, &undo);
+
+    Move reply;
+    assert(ia_predict_reply(&gs, &reply));
+    assert(gs.pieces[reply.piece_index].color == gs.current_player);
+    rules_make_move(&gs, &reply, &undo);
+
+    assert(ia_job_ponder(&gs) == 0);
+    struct timespec ts = { 0, 50 * 1000000L };
+    nanosleep(&ts, NULL);
+    assert(ia_job_busy());
+    ia_job_shutdown();
+    assert(!ia_job_busy());
+
+    Move next;
+    assert(ia_predict_reply(&gs, &next));
+
+    reset_move_history();
+    printf("test_ia_job_ponder OK\n");
+}
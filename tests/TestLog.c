@@ -0,0 +1,143 @@
+/**
+ * \file TestLog.c
+ * \brief Tests unitaires du journal asynchrone.
+ *
+ * \details
+ * Le journal est dirigé vers un fichier temporaire relu après log_stop() :
+ * ordre et format des messages, seuil, échantillonnage, et anneau plein
+ * sous plusieurs écrivains (messages perdus comptés, jamais bloquants).
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "log.h"
+
+/** \brief Messages écrits par chaque thread du test de saturation. */
+#define LOG_TEST_BURST 4000
+/** \brief Threads écrivains du test de saturation. */
+#define LOG_TEST_THREADS 4
+
+/**
+ * \fn static void *log_test_writer(void *arg)
+ * \brief Écrivain du test de saturation : LOG_TEST_BURST messages sans pause.
+ */
+static void *log_test_writer(void *arg) {
+    int id = *(const int *)arg;
+    for (int i = 0; i < LOG_TEST_BURST; ++i) LOG_INFO("thread %d message %d", id, i);
+    return NULL;
+}
+
+/**
+ * \fn static int log_test_lines(FILE *f)
+ * \brief Nombre de lignes du fichier, relu depuis le début.
+ */
+static int log_test_lines(FILE *f) {
+    char line[256];
+    int n = 0;
+    rewind(f);
+    while (fgets(line, sizeof(line), f)) ++n;
+    return n;
+}
+
+/**
+ * \fn void test_log_ring()
+ * \brief Messages écrits dans l'ordre, horodatés, filtrés par niveau et échantillonnés.
+ *
+ * \details
+ * - 200 messages INFO : 200 lignes "[secondes] INFO  message i", dans l'ordre,
+ *   horodatages croissants ; un message trop long est tronqué.
+ * - Seuil WARN : les INFO ne sont pas écrits, les WARN et ERROR le sont.
+ * - Échantillonnage 1 sur 4 : 25 INFO écrits sur 100, tous les WARN.
+ */
+void test_log_ring() {
+    LogLevel lvl;
+    assert(log_parse_level("warn", &lvl) == 0 && lvl == LOG_LEVEL_WARN);
+    assert(log_parse_level("bavard", &lvl) != 0);
+
+    FILE *f = tmpfile();
+    assert(f);
+    log_set_level(LOG_LEVEL_INFO);
+    assert(log_start(f) == 0);
+    for (int i = 0; i < 200; ++i) LOG_INFO("message %d", i);
+    char big[300];
+    memset(big, 'x', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    LOG_INFO("%s", big);
+    log_stop();
+
+    rewind(f);
+    char line[512];
+    double last = -1.0;
+    for (int i = 0; i < 200; ++i) {
+        assert(fgets(line, sizeof(line), f));
+        double t;
+        int k;
+        assert(sscanf(line, "[%lf] INFO  message %d", &t, &k) == 2);
+        assert(k == i && t >= last);
+        last = t;
+    }
+    assert(fgets(line, sizeof(line), f));
+    assert(strlen(strchr(line, 'x')) == LOG_RECORD_TEXT - 1 + 1); // texte tronqué et '\n'
+    assert(!fgets(line, sizeof(line), f));
+    fclose(f);
+
+    f = tmpfile();
+    assert(f);
+    assert(log_start(f) == 0);
+    log_set_level(LOG_LEVEL_WARN);
+    assert(!LOG_ENABLED(LOG_LEVEL_INFO) && LOG_ENABLED(LOG_LEVEL_ERROR));
+    LOG_INFO("coupé");
+    LOG_WARN("gardé");
+    LOG_ERROR("gardé");
+    log_set_level(LOG_LEVEL_INFO);
+    log_set_sampling(4);
+    LogStats before, after;
+    log_get_stats(&before);
+    for (int i = 0; i < 100; ++i) LOG_INFO("échantillon %d", i);
+    LOG_WARN("toujours gardé");
+    log_get_stats(&after);
+    assert(after.sampled - before.sampled == 75);
+    log_set_sampling(1);
+    log_stop();
+    assert(log_test_lines(f) == 2 + 25 + 1);
+    fclose(f);
+
+    printf("test_log_ring OK\n");
+}
+
+/**
+ * \fn void test_log_saturation()
+ * \brief Plusieurs threads saturent l'anneau : aucun blocage, les pertes sont comptées.
+ *
+ * \details
+ * - LOG_TEST_THREADS écrivains, LOG_TEST_BURST messages chacun.
+ * - Écrits + perdus = messages envoyés ; le fichier a une ligne par message
+ *   écrit, plus le bilan des pertes s'il y en a.
+ */
+void test_log_saturation() {
+    FILE *f = tmpfile();
+    assert(f);
+    LogStats before, after;
+    log_get_stats(&before);
+    assert(log_start(f) == 0);
+
+    pthread_t th[LOG_TEST_THREADS];
+    int ids[LOG_TEST_THREADS];
+    for (int i = 0; i < LOG_TEST_THREADS; ++i) {
+        ids[i] = i;
+        assert(pthread_create(&th[i], NULL, log_test_writer, &ids[i]) == 0);
+    }
+    for (int i = 0; i < LOG_TEST_THREADS; ++i) pthread_join(th[i], NULL);
+    log_stop();
+    log_get_stats(&after);
+
+    long written = after.written - before.written, dropped = after.dropped - before.dropped;
+    assert(written + dropped == LOG_TEST_THREADS * LOG_TEST_BURST);
+    assert(written >= LOG_RING_SIZE || dropped == 0);
+    assert(log_test_lines(f) == written + (after.dropped > 0));
+    fclose(f);
+
+    printf("test_log_saturation OK (%ld ecrits, %ld perdus)\n", written, dropped);
+}
@@ -0,0 +1,53 @@
+/**
+ * \file TestMapfile.c
+ * \brief Tests unitaires de la projection de fichiers en lecture seule.
+ *
+ * \details
+ * Vérifie qu'un fichier projeté rend ses octets et sa taille, et que les
+ * fichiers vides ou absents sont refusés sans toucher aux sorties.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "mapfile.h"
+#include "TestUtil.h"
+
+/**
+ * \fn void test_map_file()
+ * \brief Projection d'un fichier, refus d'un fichier vide ou absent.
+ *
+ * \details
+ * - Un fichier de 10 octets est projeté avec sa taille et son contenu.  
+ * - Vide, il est refusé ; supprimé aussi. `data` et `len` restent inchangés.  
+ * - unmap_file() accepte NULL.  
+ */
+void test_map_file() {
+    char path[64];
+    test_temp_path("map", path, sizeof(path));
+    FILE *f = fopen(path, "wb");
+    assert(f && fwrite("0123456789", 1, 10, f) == 10);
+    fclose(f);
+
+    void *data = NULL;
+    size_t len = 0;
+    assert(map_file(path, &data, &len) == 0);
+    assert(data && len == 10 && memcmp(data, "0123456789", 10) == 0);
+    unmap_file(data, len);
+
+    f = fopen(path, "wb");
+    assert(f);
+    fclose(f);
+    data = NULL;
+    len = 7;
+    assert(map_file(path, &data, &len) != 0 && data == NULL && len == 7);
+    remove(path);
+    assert(map_file(path, &data, &len) != 0 && data == NULL && len == 7);
+    assert(map_file(NULL, &data, &len) != 0);
+    unmap_file(NULL, 0);
+
+    printf("test_map_file OK\n");
+}
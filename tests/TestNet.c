@@ -4,11 +4,13 @@
  *
  * \details
  * Ce fichier contient les tests pour le module réseau (net.c), notamment
- * la fonction TCP_Send_Message qui envoie des coups de jeu via TCP.  
+ * la fonction TCP_Send_Message qui envoie des coups de jeu via TCP et le
+ * tampon de réception des coups.  
  * Les tests vérifient :
  *   - Les comportements avec des entrées valides et invalides.
  *   - La robustesse face à des pointeurs NULL ou des chaînes de longueur incorrecte.
  *   - La séquence d'envoi de plusieurs coups.
+ *   - La file d'envoi d'une socket non bloquante.
  *
  * \note Tous les tests utilisent des sockets fictifs (INVALID_SOCKET) pour ne
  * pas dépendre d'une vraie connexion réseau.
@@ -17,6 +19,10 @@
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
 #include "net.h"  // TCP_Send_Message, INVALID_SOCKET
 
 /** 
@@ -89,4 +95,207 @@ void test_net_send_message_sequence() {
     assert(results[4] == -1); // trop long
 
     printf("test_net_send_message_sequence OK\n");
-}
\ No newline at end of file
+}
+/** 
+ * \fn void test_net_recv_buffer()
+ * \brief Test du tampon de réception : coups coupés, regroupés, fermeture.
+ *
+ * \details
+ * - Sur une paire de sockets locale, "A1B2C" puis "3D4E5F6" : trois coups
+ *   complets, le deuxième reconstitué à cheval sur deux lectures.  
+ * - Un reste incomplet n'est pas rendu ; la fermeture du pair est lue comme 0.  
+ * - Hors partie réseau, net_waiting() vaut 0.  
+ */
+void test_net_recv_buffer() {
+    int sv[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    NetRecvBuffer rb;
+    net_recv_reset(&rb);
+    char move[NET_MOVE_LEN + 1];
+
+    assert(write(sv[1], "A1B2C", 5) == 5);
+    assert(net_recv_fill(&rb, sv[0]) == 5);
+    assert(net_recv_next(&rb, move) && strcmp(move, "A1B2") == 0);
+    assert(!net_recv_next(&rb, move));
+
+    assert(write(sv[1], "3D4E5F6", 7) == 7);
+    assert(net_recv_fill(&rb, sv[0]) == 7);
+    assert(rb.start == 0 && rb.len == 8); // reste "C" ramené en tête
+    assert(net_recv_next(&rb, move) && strcmp(move, "C3D4") == 0);
+    assert(net_recv_next(&rb, move) && strcmp(move, "E5F6") == 0);
+    assert(!net_recv_next(&rb, move));
+
+    close(sv[1]);
+    assert(net_recv_fill(&rb, sv[0]) == 0);
+    close(sv[0]);
+    assert(!net_waiting());
+
+    printf("test_net_recv_buffer OK\n");
+}
+
+/**
+ * \fn void test_net_move_format()
+ * \brief Test de l'écriture et de la lecture d'un coup au format réseau.
+ *
+ * \details
+ * - Case (8, 0) en bas à gauche : "A1" ; case (0, 8) en haut à droite : "I9".  
+ * - Aller-retour à l'identique, minuscules acceptées.  
+ * - Colonne 'J' ou rangée '0' : hors du plateau.  
+ */
+void test_net_move_format() {
+    char msg[NET_MOVE_LEN + 1];
+    net_move_encode(8, 0, 0, 8, msg);
+    assert(strcmp(msg, "A1I9") == 0);
+
+    int fr, fc, tr, tc;
+    assert(net_move_decode("c4c7", &fr, &fc, &tr, &tc));
+    assert(fr == 5 && fc == 2 && tr == 2 && tc == 2);
+    net_move_encode(fr, fc, tr, tc, msg);
+    assert(strcmp(msg, "C4C7") == 0);
+
+    assert(!net_move_decode("J1A1", &fr, &fc, &tr, &tc));
+    assert(!net_move_decode("A1A0", &fr, &fc, &tr, &tc));
+    printf("test_net_move_format OK\n");
+}
+
+/**
+ * \fn void test_net_control_frames()
+ * \brief Test du canal de contrôle : trames mêlées aux coups, coupées, trop longues ; percentiles.
+ *
+ * \details
+ * - Un coup, un PING de 8 octets coupé en deux écritures, puis un coup :
+ *   net_recv_frame() rend les trois trames dans l'ordre, net_recv_next()
+ *   saute le PING.  
+ * - Une longueur annoncée au-delà de NET_CTRL_MAX_PAYLOAD est refusée (-1).  
+ * - Cent mesures de 1 à 100 ms : p50 = 50, p90 = 90, p99 = 99 (rang le plus proche).  
+ */
+void test_net_control_frames() {
+    int sv[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    NetRecvBuffer rb;
+    net_recv_reset(&rb);
+    NetFrame f;
+    char move[NET_MOVE_LEN + 1];
+
+    unsigned long long stamp = 0x0102030405060708ULL;
+    assert(write(sv[1], "A1B2", 4) == 4);
+    assert(net_send_control(sv[1], NET_CTRL_PING, &stamp, sizeof(stamp)) == 0);
+    assert(net_recv_fill(&rb, sv[0]) == 4 + NET_CTRL_HEADER + 8);
+    rb.len -= 5; // reste du PING pas encore reçu
+    assert(net_recv_frame(&rb, &f) == 1 && f.type == 0 && strcmp(f.move, "A1B2") == 0);
+    assert(net_recv_frame(&rb, &f) == 0);
+    rb.len += 5;
+    assert(net_recv_frame(&rb, &f) == 1 && f.type == NET_CTRL_PING && f.len == sizeof(stamp));
+    assert(memcmp(f.payload, &stamp, sizeof(stamp)) == 0);
+
+    assert(net_send_control(sv[1], NET_CTRL_PONG, NULL, 0) == 0);
+    assert(write(sv[1], "C3C4", 4) == 4);
+    assert(net_recv_fill(&rb, sv[0]) == NET_CTRL_HEADER + 4);
+    assert(net_recv_next(&rb, move) && strcmp(move, "C3C4") == 0);
+    assert(!net_recv_next(&rb, move));
+
+    unsigned char bad[NET_CTRL_HEADER] = { NET_CTRL_MARK, NET_CTRL_PING, 0xFF, 0x00 };
+    assert(write(sv[1], bad, sizeof(bad)) == (ssize_t)sizeof(bad));
+    assert(net_recv_fill(&rb, sv[0]) == NET_CTRL_HEADER);
+    assert(net_recv_frame(&rb, &f) == -1);
+    assert(net_send_control(sv[1], NET_CTRL_PING, bad, NET_CTRL_MAX_PAYLOAD + 1) == -1);
+    close(sv[0]);
+    close(sv[1]);
+
+    NetRttStats st;
+    net_rtt_reset();
+    net_get_rtt(&st);
+    assert(st.count == 0);
+    for (int i = 100; i >= 1; --i) net_rtt_add((double)i);
+    net_get_rtt(&st);
+    assert(st.count == 100 && st.last_ms == 1.0);
+    assert(st.p50_ms == 50.0 && st.p90_ms == 90.0 && st.p99_ms == 99.0);
+    net_rtt_reset();
+
+    printf("test_net_control_frames OK\n");
+}
+
+/**
+ * \fn void test_net_send_queue()
+ * \brief Test de la file d'envoi d'une socket non bloquante.
+ *
+ * \details
+ * - Un coup et un CHECK en file partent d'un seul net_send_flush() et se
+ *   relisent dans l'ordre.  
+ * - Socket pleine : net_send_flush() rend la main sans bloquer et garde le
+ *   reste, envoyé une fois le pair servi.  
+ * - Une file pleine refuse l'ajout d'un bloc ; un pair fermé donne -1.  
+ */
+void test_net_send_queue() {
+    int sv[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    assert(fcntl(sv[1], F_SETFL, fcntl(sv[1], F_GETFL, 0) | O_NONBLOCK) == 0);
+    NetSendBuffer sb;
+    NetRecvBuffer rb;
+    NetFrame f;
+    net_send_reset(&sb);
+    net_recv_reset(&rb);
+
+    unsigned check = 0xCAFE;
+    assert(net_send_queue(&sb, "A1B2", NET_MOVE_LEN) == 0);
+    assert(net_send_queue_control(&sb, NET_CTRL_CHECK, &check, sizeof(check)) == 0);
+    assert(net_send_flush(&sb, sv[1]) == 0 && sb.len == 0);
+    assert(net_recv_fill(&rb, sv[0]) == NET_MOVE_LEN + NET_CTRL_HEADER + (int)sizeof(check));
+    assert(net_recv_frame(&rb, &f) == 1 && f.type == 0 && strcmp(f.move, "A1B2") == 0);
+    assert(net_recv_frame(&rb, &f) == 1 && f.type == NET_CTRL_CHECK && memcmp(f.payload, &check, sizeof(check)) == 0);
+
+    // Remplit la socket jusqu'au refus
+    char junk[4096];
+    memset(junk, 'x', sizeof(junk));
+    size_t stuffed = 0;
+    for (;;) {
+        ssize_t r = send(sv[1], junk, sizeof(junk), 0);
+        if (r <= 0) break;
+        stuffed += (size_t)r;
+    }
+    assert(stuffed > 0);
+    assert(net_send_queue(&sb, "C3C4", NET_MOVE_LEN) == 0);
+    assert(net_send_flush(&sb, sv[1]) == NET_MOVE_LEN);
+    while (stuffed > 0) {
+        ssize_t r = recv(sv[0], junk, stuffed < sizeof(junk) ? stuffed : sizeof(junk), 0);
+        assert(r > 0);
+        stuffed -= (size_t)r;
+    }
+    assert(net_send_flush(&sb, sv[1]) == 0);
+    net_recv_reset(&rb);
+    assert(net_recv_fill(&rb, sv[0]) == NET_MOVE_LEN);
+    assert(net_recv_frame(&rb, &f) == 1 && strcmp(f.move, "C3C4") == 0);
+
+    unsigned char big[NET_SEND_BUFFER];
+    memset(big, 0, sizeof(big));
+    assert(net_send_queue(&sb, big, sizeof(big)) == 0);
+    assert(net_send_queue(&sb, "D4D5", NET_MOVE_LEN) == -1);
+    assert(sb.len == sizeof(big));
+    net_send_reset(&sb);
+
+    close(sv[0]);
+    assert(net_send_queue(&sb, "E5E6", NET_MOVE_LEN) == 0);
+    assert(net_send_flush(&sb, sv[1]) == -1);
+    close(sv[1]);
+
+    printf("test_net_send_queue OK\n");
+}
+
+/**
+ * \fn void test_net_send_message_closed_peer()
+ * \brief Un coup envoyé à un pair parti échoue (-1) sans SIGPIPE.
+ *
+ * \details
+ * - SIGPIPE remis à son action par défaut, qui tuerait le processus.  
+ * - Un coup vers un pair fermé rend -1 : l'envoi ne lève pas le signal.  
+ */
+void test_net_send_message_closed_peer() {
+    void (*saved)(int) = signal(SIGPIPE, SIG_DFL);
+    int sv[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    close(sv[0]);
+    assert(TCP_Send_Message(sv[1], "A1B2") == -1);
+    close(sv[1]);
+    signal(SIGPIPE, saved);
+    printf("test_net_send_message_closed_peer OK\n");
+}
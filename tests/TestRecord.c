@@ -0,0 +1,194 @@
+/**
+ * \file TestRecord.c
+ * \brief Tests unitaires de l'enregistrement des parties.
+ *
+ * \details
+ * Vérifie l'ajout de parties (y compris après réouverture), la position
+ * rendue par record_seek() à chaque coup, la lecture des coups, et la
+ * reprise d'un fichier dont l'écriture a été interrompue.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "record.h"
+#include "game.h"
+#include "TestUtil.h"
+
+/** \brief Coups au plus d'une partie de test. */
+#define RECORD_TEST_PLIES 40
+
+/** @brief Partie de test : coups et clé de Zobrist après chaque coup */
+typedef struct {
+    uint8_t moves[RECORD_TEST_PLIES][2];
+    uint64_t hash[RECORD_TEST_PLIES + 1];
+    int plies;
+    char winner;
+    RulesEnd end;
+} RecordTestGame;
+
+/**
+ * \fn static void record_test_game(const GameState *start, int seed, int plies, RecordTestGame *out)
+ * \brief Joue au plus `plies` coups choisis d'après `seed` et garde la clé de chaque position.
+ */
+static void record_test_game(const GameState *start, int seed, int plies, RecordTestGame *out) {
+    memset(out, 0, sizeof(*out));
+    GameState s = *start;
+    out->hash[0] = s.hash;
+    while (out->plies < plies) {
+        Move moves[RULES_MAX_MOVES];
+        int n = rules_legal_moves(&s, moves);
+        assert(n > 0);
+        Move mv = moves[(out->plies * 7 + seed) % n];
+        RulesResult res;
+        assert(rules_play(&s, &mv, max_turn, &res));
+        out->moves[out->plies][0] = (uint8_t)(mv.from_row * 9 + mv.from_col);
+        out->moves[out->plies][1] = (uint8_t)(mv.to_row * 9 + mv.to_col);
+        out->hash[++out->plies] = s.hash;
+        if (res.winner) {
+            out->winner = res.winner;
+            out->end = res.end;
+            break;
+        }
+    }
+}
+
+/**
+ * \fn static void record_check_game(const RecordReader *r, size_t game, const RecordTestGame *g)
+ * \brief Chaque coup et chaque position d'une partie relue sont ceux de la partie jouée.
+ */
+static void record_check_game(const RecordReader *r, size_t game, const RecordTestGame *g) {
+    assert(r->index[game].plies == (uint32_t)g->plies);
+    assert(r->index[game].winner == g->winner && r->index[game].end == g->end);
+    for (int p = 0; p <= g->plies; ++p) {
+        GameState s;
+        assert(record_seek(r, game, p, &s) == 0);
+        assert(s.hash == g->hash[p]);
+        if (p < g->plies) {
+            int from, to;
+            assert(record_move(r, game, p, &from, &to) == 0);
+            assert(from == g->moves[p][0] && to == g->moves[p][1]);
+        }
+    }
+    GameState s;
+    int from, to;
+    assert(record_seek(r, game, g->plies + 1, &s) == -1);
+    assert(record_move(r, game, g->plies, &from, &to) == -1);
+}
+
+/**
+ * \fn void test_record_write_seek()
+ * \brief Ajout de parties, réouverture en ajout et position à chaque coup.
+ *
+ * \details
+ * - Trois parties (dont une interrompue sans coup) avec un instantané tous
+ *   les 4 coups, la troisième ajoutée après réouverture : le K du fichier
+ *   est conservé.
+ * - record_seek() rend la position de la partie jouée à chaque coup,
+ *   record_move() ses coups ; hors bornes, les deux échouent.
+ * - Un coup illégal annule l'ajout sans rien écrire.
+ */
+void test_record_write_seek() {
+    char path[64];
+    test_temp_path("record", path, sizeof(path));
+    const GameState start = game_start_state();
+    RecordTestGame games[3];
+    record_test_game(&start, 3, RECORD_TEST_PLIES, &games[0]);
+    record_test_game(&start, 0, 0, &games[1]);
+    record_test_game(&start, 5, 13, &games[2]);
+    assert(games[0].plies > 8 && games[2].plies == 13);
+
+    RecordWriter w;
+    assert(record_writer_open(&w, path, 4) == 0);
+    assert(record_writer_append(&w, &start, games[0].moves, games[0].plies, games[0].winner, games[0].end) == 0);
+    assert(record_writer_append(&w, &start, games[1].moves, 0, 0, RULES_END_NONE) == 0);
+    uint8_t illegal[1][2] = { { 40, 40 } };
+    assert(record_writer_append(&w, &start, illegal, 1, 0, RULES_END_NONE) == -1);
+    assert(record_writer_close(&w) == 0);
+
+    assert(record_writer_open(&w, path, 7) == 0 && w.snap_every == 4 && w.count == 2);
+    assert(record_writer_append(&w, &start, games[2].moves, games[2].plies, games[2].winner, games[2].end) == 0);
+    assert(record_writer_close(&w) == 0);
+
+    RecordReader r;
+    assert(record_reader_open(&r, path) == 0);
+    assert(r.games == 3 && r.snap_every == 4 && r.rebuilt == NULL);
+    for (size_t g = 0; g < 3; ++g) record_check_game(&r, g, &games[g]);
+    GameState s;
+    assert(record_seek(&r, 3, 0, &s) == -1);
+    record_reader_close(&r);
+
+    remove(path);
+    printf("test_record_write_seek OK\n");
+}
+
+/**
+ * \fn void test_record_recovery()
+ * \brief Fichier sans pied, partie tronquée, fichier d'un autre format.
+ *
+ * \details
+ * - Sans pied (écriture interrompue), l'index est reconstruit par parcours.
+ * - Une partie tronquée est ignorée à la lecture et effacée à la
+ *   réouverture en ajout ; le fichier complété a de nouveau un pied.
+ * - Un fichier d'un autre format est refusé sans être écrasé.
+ */
+void test_record_recovery() {
+    char path[64];
+    test_temp_path("record", path, sizeof(path));
+    const GameState start = game_start_state();
+    RecordTestGame games[3];
+    record_test_game(&start, 1, 20, &games[0]);
+    record_test_game(&start, 2, 20, &games[1]);
+    record_test_game(&start, 4, 9, &games[2]);
+
+    RecordWriter w;
+    assert(record_writer_open(&w, path, 5) == 0);
+    assert(record_writer_append(&w, &start, games[0].moves, games[0].plies, games[0].winner, games[0].end) == 0);
+    assert(record_writer_append(&w, &start, games[1].moves, games[1].plies, games[1].winner, games[1].end) == 0);
+    uint64_t second = w.index[1].offset, data_end = w.end;
+    assert(record_writer_close(&w) == 0);
+
+    // Pied perdu : index reconstruit
+    assert(truncate(path, (off_t)data_end + 8) == 0);
+    RecordReader r;
+    assert(record_reader_open(&r, path) == 0);
+    assert(r.games == 2 && r.rebuilt != NULL && r.data_end == data_end);
+    record_check_game(&r, 0, &games[0]);
+    record_check_game(&r, 1, &games[1]);
+    record_reader_close(&r);
+
+    // Deuxième partie tronquée : ignorée, puis effacée par la réouverture
+    assert(truncate(path, (off_t)(second + (data_end - second) / 2)) == 0);
+    assert(record_reader_open(&r, path) == 0);
+    assert(r.games == 1 && r.data_end == second);
+    record_check_game(&r, 0, &games[0]);
+    record_reader_close(&r);
+
+    assert(record_writer_open(&w, path, 0) == 0 && w.count == 1 && w.end == second);
+    assert(record_writer_append(&w, &start, games[2].moves, games[2].plies, games[2].winner, games[2].end) == 0);
+    assert(record_writer_close(&w) == 0);
+    assert(record_reader_open(&r, path) == 0);
+    assert(r.games == 2 && r.rebuilt == NULL);
+    record_check_game(&r, 0, &games[0]);
+    record_check_game(&r, 1, &games[2]);
+    record_reader_close(&r);
+
+    // Autre format : refusé, fichier intact
+    FILE *f = fopen(path, "wb");
+    assert(f);
+    fputs("game,a_color,winner\n", f);
+    fclose(f);
+    assert(record_reader_open(&r, path) == -1);
+    assert(record_writer_open(&w, path, 0) == -1);
+    f = fopen(path, "rb");
+    char line[32] = "";
+    assert(f && fgets(line, sizeof(line), f) && strcmp(line, "game,a_color,winner\n") == 0);
+    fclose(f);
+
+    remove(path);
+    printf("test_record_recovery OK\n");
+}
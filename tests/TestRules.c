@@ -0,0 +1,196 @@
+/**
+ * \file TestRules.c
+ * \brief Tests unitaires du cœur des règles sur un état explicite.
+ *
+ * \details
+ * Vérifie les coups de partie rendus sous forme de données (captures et
+ * issue), la cohérence du plateau case → pièce avec les pièces pendant une
+ * suite de coups joués puis annulés, et les fins de partie.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "rules.h"
+
+/**
+ * \fn static void rules_fixture(GameState* s, const StatePiece* p, int n, char player)
+ * \brief Prépare une position sans contrôle, au tour 1.
+ */
+static void rules_fixture(GameState* s, const StatePiece* p, int n, char player) {
+    memset(s, 0, sizeof(*s));
+    s->piece_count = (uint8_t)n;
+    memcpy(s->pieces, p, n * sizeof(StatePiece));
+    s->current_player = player;
+    s->turn_number = 1;
+    rules_sync(s);
+}
+
+/**
+ * \fn static void assert_board_consistent(const GameState* s)
+ * \brief Le plateau désigne exactement la pièce de chaque case occupée.
+ */
+static void assert_board_consistent(const GameState* s) {
+    int expect[81];
+    for (int sq = 0; sq < 81; ++sq) expect[sq] = -1;
+    for (int i = 0; i < s->piece_count; ++i) expect[s->pieces[i].sq] = i;
+    for (int sq = 0; sq < 81; ++sq) {
+        assert(rules_piece_at(s, sq) == expect[sq]);
+        assert((expect[sq] >= 0) == bb_test(rules_occupied(s), sq));
+    }
+}
+
+/**
+ * \fn void test_rules_play_capture()
+ * \brief Un coup de partie rend ses captures et passe la main.
+ *
+ * \details
+ * - Bleu encadre un pion rouge (Linca) : capture décrite par case, emplacement et règle.
+ * - Le trait, le tour, le plateau et le hachage (comparé à un recalcul complet) suivent.
+ * - Un coup en diagonale est refusé sans toucher à l'état.
+ */
+void test_rules_play_capture() {
+    const StatePiece p[] = {
+        { BB_SQ(0, 1), 'B', 'K' }, { BB_SQ(4, 4), 'R', 'P' }, { BB_SQ(4, 1), 'B', 'P' },
+        { BB_SQ(4, 5), 'B', 'P' }, { BB_SQ(8, 7), 'R', 'K' }, { BB_SQ(8, 0), 'R', 'P' },
+        { BB_SQ(8, 2), 'R', 'P' },
+    };
+    GameState s;
+    rules_fixture(&s, p, 7, 'B');
+
+    GameState before = s;
+    RulesResult res;
+    Move diag = { 2, 4, 1, 5, 2 };
+    assert(!rules_play(&s, &diag, 0, &res));
+    assert(memcmp(s.board, before.board, sizeof(s.board)) == 0 && s.hash == before.hash);
+
+    Move mv = { 2, 4, 1, 4, 3 };
+    assert(rules_play(&s, &mv, 0, &res));
+    assert(res.capture_count == 1 && res.winner == 0 && res.end == RULES_END_NONE);
+    assert(res.captures[0].sq == BB_SQ(4, 4) && res.captures[0].slot == 1);
+    assert(res.captures[0].color == 'R' && res.captures[0].type == 'P' && res.captures[0].rule == 'L');
+    assert(s.current_player == 'R' && s.turn_number == 2 && s.piece_count == 6);
+    assert(rules_piece_at(&s, BB_SQ(4, 3)) == 1 && rules_piece_at(&s, BB_SQ(4, 4)) == -1);
+    assert(rules_state_control(&s, 4, 1) == 1 && rules_state_control(&s, 4, 3) == 1);
+    assert_board_consistent(&s);
+
+    GameState fresh = s;
+    rules_sync(&fresh);
+    assert(fresh.hash == s.hash);
+    int blue, red;
+    rules_scores(&s, &blue, &red);
+    assert(res.score_blue == blue && res.score_red == red);
+
+    printf("test_rules_play_capture OK\n");
+}
+
+/**
+ * \fn void test_rules_board_make_unmake()
+ * \brief Le plateau case → pièce reste exact en jouant puis en annulant une partie.
+ *
+ * \details
+ * - Joue 60 coups depuis la position de départ (le premier coup légal qui capture, sinon un coup fixé).
+ * - Vérifie le plateau après chaque coup, puis après chaque annulation.
+ * - La position de départ est restituée à l'identique (pièces, plateau, hachage).
+ */
+void test_rules_board_make_unmake() {
+    const StatePiece p[] = {
+        { BB_SQ(1, 1), 'B', 'K' }, { BB_SQ(2, 0), 'B', 'P' }, { BB_SQ(3, 0), 'B', 'P' },
+        { BB_SQ(2, 1), 'B', 'P' }, { BB_SQ(3, 1), 'B', 'P' }, { BB_SQ(0, 2), 'B', 'P' },
+        { BB_SQ(1, 2), 'B', 'P' }, { BB_SQ(2, 2), 'B', 'P' }, { BB_SQ(0, 3), 'B', 'P' },
+        { BB_SQ(1, 3), 'B', 'P' }, { BB_SQ(7, 7), 'R', 'K' }, { BB_SQ(7, 5), 'R', 'P' },
+        { BB_SQ(8, 5), 'R', 'P' }, { BB_SQ(6, 6), 'R', 'P' }, { BB_SQ(7, 6), 'R', 'P' },
+        { BB_SQ(8, 6), 'R', 'P' }, { BB_SQ(5, 7), 'R', 'P' }, { BB_SQ(6, 7), 'R', 'P' },
+        { BB_SQ(5, 8), 'R', 'P' }, { BB_SQ(6, 8), 'R', 'P' },
+    };
+    GameState s;
+    rules_fixture(&s, p, 20, 'B');
+    GameState start = s;
+
+    MoveUndo undo[60];
+    int played = 0, captures = 0;
+    for (; played < 60; ++played) {
+        Move moves[RULES_MAX_MOVES];
+        int n = rules_legal_moves(&s, moves);
+        if (n == 0) break;
+        int pick = (played * 7) % n;
+        int count = s.piece_count;
+        rules_make_move(&s, &moves[pick], &undo[played]);
+        captures += count - s.piece_count;
+        assert_board_consistent(&s);
+    }
+    assert(played > 0);
+    while (played-- > 0) {
+        rules_unmake_move(&s, &undo[played]);
+        assert_board_consistent(&s);
+    }
+    assert(s.piece_count == start.piece_count && s.hash == start.hash);
+    assert(memcmp(s.pieces, start.pieces, sizeof(StatePiece) * start.piece_count) == 0);
+    assert(memcmp(s.board, start.board, sizeof(s.board)) == 0);
+
+    printf("test_rules_board_make_unmake OK (%d captures)\n", captures);
+}
+
+/**
+ * \fn void test_rules_endings()
+ * \brief Fins de partie : cité, auto-défaite, roi capturé et limite de tours.
+ *
+ * \details
+ * - Le roi rouge entre dans la cité bleue : victoire, le trait ne change pas, la cité reste neutre.
+ * - Une capture laisse les bleus avec un roi et un soldat : auto-défaite.
+ * - Un roi capturé par Linca arrête le coup : le Seltou du même coup n'a pas lieu.
+ * - À la limite de tours, les scores décident et le coup suivant est refusé.
+ */
+void test_rules_endings() {
+    GameState s;
+    RulesResult res;
+
+    const StatePiece city[] = {
+        { BB_SQ(4, 4), 'B', 'K' }, { BB_SQ(6, 0), 'B', 'P' }, { BB_SQ(6, 2), 'B', 'P' },
+        { BB_SQ(0, 1), 'R', 'K' }, { BB_SQ(7, 4), 'R', 'P' }, { BB_SQ(7, 6), 'R', 'P' },
+    };
+    rules_fixture(&s, city, 6, 'R');
+    Move to_city = { 3, 0, 1, 0, 0 };
+    assert(rules_play(&s, &to_city, 0, &res));
+    assert(res.winner == 'R' && res.end == RULES_END_KING_IN_CITY);
+    assert(s.current_player == 'R' && s.turn_number == 1);
+    assert(rules_state_control(&s, 0, 0) == 0 && rules_state_control(&s, 0, 1) == 2);
+    Move moves[RULES_MAX_MOVES];
+    assert(rules_legal_moves(&s, moves) == 0);
+    assert(!rules_play(&s, &(Move){ 1, 6, 0, 5, 0 }, 0, &res));
+
+    const StatePiece defeat[] = {
+        { BB_SQ(4, 4), 'B', 'K' }, { BB_SQ(2, 2), 'B', 'P' }, { BB_SQ(6, 6), 'B', 'P' },
+        { BB_SQ(7, 7), 'R', 'K' }, { BB_SQ(2, 3), 'R', 'P' }, { BB_SQ(5, 1), 'R', 'P' },
+    };
+    rules_fixture(&s, defeat, 6, 'R');
+    assert(rules_auto_defeat(&s) == 0);
+    assert(rules_play(&s, &(Move){ 5, 5, 1, 2, 1 }, 0, &res));
+    assert(res.capture_count == 1 && res.captures[0].sq == BB_SQ(2, 2));
+    assert(rules_auto_defeat(&s) == 'B');
+    assert(res.winner == 'R' && res.end == RULES_END_AUTO_DEFEAT);
+
+    const StatePiece king[] = {
+        { BB_SQ(1, 7), 'B', 'K' }, { BB_SQ(6, 3), 'B', 'P' }, { BB_SQ(4, 5), 'B', 'P' },
+        { BB_SQ(0, 5), 'B', 'P' }, { BB_SQ(4, 4), 'R', 'K' }, { BB_SQ(3, 3), 'R', 'P' },
+        { BB_SQ(8, 0), 'R', 'P' }, { BB_SQ(8, 2), 'R', 'P' },
+    };
+    rules_fixture(&s, king, 8, 'B');
+    assert(rules_play(&s, &(Move){ 1, 6, 3, 4, 3 }, 0, &res));
+    assert(res.winner == 'B' && res.end == RULES_END_KING_CAPTURED);
+    assert(res.capture_count == 1 && res.captures[0].type == 'K');
+    assert(rules_piece_at(&s, BB_SQ(3, 3)) >= 0 && s.king_sq[1] < 0);
+
+    rules_fixture(&s, city, 6, 'B');
+    s.turn_number = 63;
+    rules_sync(&s);
+    assert(rules_play(&s, &(Move){ 1, 6, 0, 5, 0 }, 64, &res));
+    assert(res.end == RULES_END_TURN_LIMIT && s.turn_number == 64);
+    assert(res.winner == (res.score_blue > res.score_red ? 'B' : res.score_red > res.score_blue ? 'R' : 'D'));
+    assert(!rules_play(&s, &(Move){ 3, 0, 1, 0, 2 }, 64, &res));
+
+    printf("test_rules_endings OK\n");
+}
@@ -0,0 +1,86 @@
+/**
+ * \file TestSelfplay.c
+ * \brief Tests unitaires des parties IA contre IA sans interface.
+ *
+ * \details
+ * Vérifie la lecture des configurations de moteur, le déroulement d'une
+ * partie complète sans widgets et le format des résultats.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "selfplay.h"
+#include "game.h"
+
+/**
+ * \fn void test_selfplay_parse_engine()
+ * \brief Les configurations `dN` et `tMS` sont lues, les autres refusées.
+ */
+void test_selfplay_parse_engine() {
+    EngineConfig e;
+    assert(selfplay_parse_engine("d4", &e) == 0 && e.depth == 4 && e.time_ms == 0);
+    assert(selfplay_parse_engine("t250", &e) == 0 && e.depth == 0 && e.time_ms == 250);
+    assert(selfplay_parse_engine("d", &e) != 0);
+    assert(selfplay_parse_engine("t0", &e) != 0);
+    assert(selfplay_parse_engine("d4x", &e) != 0);
+    assert(selfplay_parse_engine("4", &e) != 0);
+    assert(selfplay_parse_engine("d99", &e) != 0);
+    printf("test_selfplay_parse_engine OK\n");
+}
+
+/**
+ * \fn void test_selfplay_game()
+ * \brief Une partie à profondeur 1 se termine, se rejoue à l'identique et s'écrit en CSV.
+ *
+ * \details
+ * - Joue deux fois la partie 1 (A avec les rouges) : mêmes coups, même résultat.
+ * - Vérifie une issue valide et des scores cohérents.
+ * - Le jeu global reste en cours : la partie se joue sur un état local.
+ * - Écrit le résultat en CSV et en JSON et vérifie l'en-tête et l'échappement.
+ */
+void test_selfplay_game() {
+    SelfPlayConfig cfg = { .games = 2, .workers = 1,
+                           .engine = { { .depth = 1 }, { .depth = 1 } }, .out_path = NULL };
+    SelfPlayResult r1, r2;
+    selfplay_play_game(&cfg, 1, &r1);
+    selfplay_play_game(&cfg, 1, &r2);
+
+    assert(r1.index == 1 && r1.a_color == 'R');
+    assert(r1.winner == 'A' || r1.winner == 'B' || r1.winner == 'D');
+    assert(r1.plies > SELFPLAY_RANDOM_PLIES && r1.plies <= 2 * max_turn);
+    assert(r1.score_blue >= 0 && r1.score_red >= 0);
+    assert(r1.reason[0] != '\0');
+    assert(!game_over);
+    assert(r2.winner == r1.winner && r2.plies == r1.plies);
+    assert(memcmp(r2.moves, r1.moves, sizeof(r1.moves[0]) * (size_t)r1.plies) == 0);
+    assert(r2.score_blue == r1.score_blue && r2.score_red == r1.score_red);
+
+    snprintf(r1.reason, sizeof(r1.reason), "dit \"non\"");
+    char buf[512];
+    FILE *f = tmpfile();
+    assert(f);
+    selfplay_write_csv(f, &r1, 1);
+    rewind(f);
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[len] = '\0';
+    fclose(f);
+    assert(strncmp(buf, "game,a_color,winner,plies,", 26) == 0);
+    assert(strstr(buf, "\n1,R,") != NULL);
+    assert(strstr(buf, ",\"dit \"\"non\"\"\"\n") != NULL);
+
+    f = tmpfile();
+    assert(f);
+    selfplay_write_json(f, &r1, 1);
+    rewind(f);
+    len = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[len] = '\0';
+    fclose(f);
+    assert(buf[0] == '[' && strstr(buf, "\"game\": 1,") != NULL);
+    assert(strstr(buf, "\"reason\": \"dit \\\"non\\\"\"}") != NULL);
+
+    printf("test_selfplay_game OK\n");
+}
@@ -0,0 +1,199 @@
+/**
+ * \file TestServer.c
+ * \brief Tests du serveur de parties sans interface (`--serve`).
+ *
+ * \details
+ * Le serveur et ses clients tournent dans le même processus : les clients
+ * sont des sockets locales bloquantes, la boucle du serveur est avancée par
+ * server_poll() en attendant leurs réponses. Chaque client tient sa propre
+ * copie de la partie et vérifie les coups reçus avec rules_play().
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "server.h"
+#include "net.h"
+#include "game.h"
+#include "tt.h"
+#include "sync.h"
+
+/** \brief Attente maximale d'une réponse du serveur (tours de server_poll()). */
+#define SERVER_TEST_POLLS 2000
+
+/**
+ * \fn static SOCKET server_test_connect(void)
+ * \brief Client connecté au serveur de test.
+ */
+static SOCKET server_test_connect(void) {
+    SOCKET s = socket(AF_INET, SOCK_STREAM, 0);
+    assert(s != INVALID_SOCKET);
+    struct sockaddr_in sin;
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons((uint16_t)server_port());
+    inet_pton(AF_INET, "127.0.0.1", &sin.sin_addr);
+    assert(connect(s, (struct sockaddr *)&sin, sizeof(sin)) == 0);
+    return s;
+}
+
+/**
+ * \fn static int server_test_ready(SOCKET s)
+ * \brief Le client a-t-il quelque chose à lire (coup ou fermeture) ?
+ */
+static int server_test_ready(SOCKET s) {
+    struct pollfd p = { .fd = s, .events = POLLIN, .revents = 0 };
+    return poll(&p, 1, 0) > 0;
+}
+
+/**
+ * \fn static int server_test_reply(SOCKET s, char move[NET_MOVE_LEN + 1])
+ * \brief Fait tourner le serveur jusqu'à la réponse du client `s`.
+ *
+ * \return 1 si un coup a été reçu, 0 si le serveur a fermé la connexion.
+ */
+static int server_test_reply(SOCKET s, char move[NET_MOVE_LEN + 1]) {
+    for (int i = 0; i < SERVER_TEST_POLLS && !server_test_ready(s); ++i) server_poll(5);
+    assert(server_test_ready(s));
+    int r = (int)recv(s, move, NET_MOVE_LEN, MSG_WAITALL);
+    move[r > 0 ? r : 0] = '\0';
+    return r == NET_MOVE_LEN;
+}
+
+/**
+ * \fn static void server_test_wait_active(int active)
+ * \brief Fait tourner le serveur jusqu'à `active` parties en cours.
+ */
+static void server_test_wait_active(int active) {
+    ServerStats st;
+    server_get_stats(&st);
+    for (int i = 0; i < SERVER_TEST_POLLS && st.active != active; ++i) {
+        server_poll(5);
+        server_get_stats(&st);
+    }
+    assert(st.active == active);
+}
+
+/**
+ * \fn static void server_test_send(SOCKET s, GameState *g)
+ * \brief Le client joue son premier coup légal et l'envoie au serveur.
+ */
+static void server_test_send(SOCKET s, GameState *g) {
+    Move moves[RULES_MAX_MOVES];
+    assert(rules_legal_moves(g, moves) > 0);
+    RulesResult res;
+    assert(rules_play(g, &moves[0], max_turn, &res) && !res.winner);
+    char msg[NET_MOVE_LEN + 1];
+    net_move_encode(moves[0].from_row, moves[0].from_col, moves[0].to_row, moves[0].to_col, msg);
+    assert(send(s, msg, NET_MOVE_LEN, 0) == NET_MOVE_LEN);
+}
+
+/**
+ * \fn static void server_test_apply(GameState *g, const char *msg)
+ * \brief Applique un coup reçu du serveur à la copie du client ; il doit être légal.
+ */
+static void server_test_apply(GameState *g, const char *msg) {
+    Move mv;
+    assert(net_move_decode(msg, &mv.from_row, &mv.from_col, &mv.to_row, &mv.to_col));
+    mv.piece_index = rules_piece_at(g, mv.from_row * 9 + mv.from_col);
+    assert(mv.piece_index >= 0 && g->pieces[mv.piece_index].color == 'R');
+    RulesResult res;
+    assert(rules_play(g, &mv, max_turn, &res));
+}
+
+/**
+ * \fn void test_server_matches()
+ * \brief Deux parties simultanées contre l'IA, un client refusé, des coups refusés.
+ *
+ * \details
+ * - Deux clients jouent trois coups chacun, envoyés avant que le serveur
+ *   ne réponde à l'un ou à l'autre : chaque partie reçoit des coups rouges
+ *   légaux dans sa propre position.
+ * - Un SYNC_REQUEST reçoit l'instantané de la partie, un PING son PONG,
+ *   sans toucher à la partie.
+ * - Un troisième client, au-delà de max_matches, est fermé aussitôt.
+ * - Un coup illégal (pièce adverse) ou envoyé pendant le tour de l'IA ferme
+ *   la connexion ; la place libérée sert au client suivant.
+ */
+void test_server_matches() {
+    ServerConfig cfg = { .port = 0, .max_matches = 2, .workers = 2, .engine = { .depth = 2, .time_ms = 0 }, .log = NULL };
+    tt_clear();
+    assert(server_open(&cfg) == 0);
+    assert(server_port() > 0 && server_open(&cfg) != 0);
+
+    SOCKET a = server_test_connect(), b = server_test_connect();
+    server_test_wait_active(2);
+    GameState ga, gb;
+    game_setup_default();
+    ga = gb = createGameStateFromCurrent();
+
+    // SYNC_REQUEST : instantané de la position de départ
+    unsigned char state[NET_CTRL_HEADER + SYNC_STATE_SIZE];
+    assert(net_send_control(a, NET_CTRL_SYNC_REQUEST, NULL, 0) == 0);
+    for (int i = 0; i < SERVER_TEST_POLLS && !server_test_ready(a); ++i) server_poll(5);
+    assert(recv(a, state, sizeof(state), MSG_WAITALL) == (ssize_t)sizeof(state));
+    assert(state[0] == NET_CTRL_MARK && state[1] == NET_CTRL_SYNC_STATE);
+    SyncState snap;
+    GameState synced;
+    memcpy(&snap, state + NET_CTRL_HEADER, sizeof(snap));
+    assert(sync_to_state(&snap, &synced) == 0 && synced.hash == ga.hash);
+
+    // PING du client : PONG à l'identique, la partie continue
+    unsigned char pong[NET_CTRL_HEADER + 2];
+    assert(net_send_control(a, NET_CTRL_PING, "42", 2) == 0);
+    for (int i = 0; i < SERVER_TEST_POLLS && !server_test_ready(a); ++i) server_poll(5);
+    assert(recv(a, pong, sizeof(pong), MSG_WAITALL) == (ssize_t)sizeof(pong));
+    assert(pong[0] == NET_CTRL_MARK && pong[1] == NET_CTRL_PONG && memcmp(pong + NET_CTRL_HEADER, "42", 2) == 0);
+
+    char msg[NET_MOVE_LEN + 1];
+    for (int ply = 0; ply < 3; ++ply) {
+        server_test_send(a, &ga);
+        server_test_send(b, &gb);
+        assert(server_test_reply(b, msg));
+        server_test_apply(&gb, msg);
+        assert(server_test_reply(a, msg));
+        server_test_apply(&ga, msg);
+    }
+
+    // Plus de place : fermé sans coup
+    SOCKET c = server_test_connect();
+    assert(!server_test_reply(c, msg));
+    close(c);
+    ServerStats st;
+    server_get_stats(&st);
+    assert(st.rejected == 1 && st.active == 2 && st.searches == 6);
+
+    // Pièce rouge jouée par le client : partie fermée
+    Move moves[RULES_MAX_MOVES];
+    gb.current_player = 'R';
+    assert(rules_legal_moves(&gb, moves) > 0);
+    net_move_encode(moves[0].from_row, moves[0].from_col, moves[0].to_row, moves[0].to_col, msg);
+    assert(send(b, msg, NET_MOVE_LEN, 0) == NET_MOVE_LEN);
+    assert(!server_test_reply(b, msg));
+    close(b);
+
+    // Deux coups d'affilée : le second arrive pendant la recherche de l'IA
+    SOCKET d = server_test_connect();
+    server_test_wait_active(2);
+    GameState gd = createGameStateFromCurrent();
+    server_test_send(d, &gd);
+    gd.current_player = 'B';
+    server_test_send(d, &gd);
+    assert(!server_test_reply(d, msg));
+    close(d);
+
+    // Déconnexion du client a
+    close(a);
+    server_test_wait_active(0);
+    server_get_stats(&st);
+    assert(st.finished == 3 && st.rejected == 1);
+
+    server_close();
+    assert(server_port() == 0 && server_poll(0) == -1);
+    printf("test_server_matches OK\n");
+}
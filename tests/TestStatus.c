@@ -19,7 +19,9 @@
 void status_register_labels(GtkWidget* score_blue_label,
                             GtkWidget* score_red_label,
                             GtkWidget* game_status_label,
-                            GtkWidget* replay_button);
+                            GtkWidget* replay_button,
+                            GtkWidget* victory_label,
+                            GtkWidget* victory_box);
 void status_on_scores_changed(void);
 void set_draw_message(const char* reason);
 void set_victory_message(gboolean blue_won, const char* reason);
@@ -56,7 +58,7 @@ void test_status_register_and_draw(void) {
     GtkWidget *lS = gtk_label_new(NULL);
     GtkWidget *btn = gtk_button_new();
 
-    status_register_labels(lB, lR, lS, btn);
+    status_register_labels(lB, lR, lS, btn, NULL, NULL);
 
     // draw message - label statut non vide
     set_draw_message("timeout");
@@ -0,0 +1,132 @@
+/**
+ * \file TestSync.c
+ * \brief Tests de l'instantané binaire de la position (SYNC_STATE).
+ *
+ * \details
+ * Vérifie l'aller-retour GameState → instantané → GameState, le passage par
+ * les variables globales de game.c et le refus des instantanés altérés.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "sync.h"
+#include "game.h"
+
+/**
+ * \fn static void sync_test_play(GameState *g, int plies)
+ * \brief Joue `plies` coups (le dernier coup légal de chaque position).
+ */
+static void sync_test_play(GameState *g, int plies) {
+    for (int i = 0; i < plies; ++i) {
+        Move moves[RULES_MAX_MOVES];
+        int n = rules_legal_moves(g, moves);
+        assert(n > 0);
+        RulesResult res;
+        assert(rules_play(g, &moves[n - 1], max_turn, &res));
+    }
+}
+
+/**
+ * \fn static void sync_test_reseal(SyncState *snap)
+ * \brief Recalcule la somme de contrôle d'un instantané modifié à la main.
+ */
+static void sync_test_reseal(SyncState *snap) {
+    snap->checksum = sync_checksum(snap);
+}
+
+/**
+ * \fn void test_sync_roundtrip()
+ * \brief Aller-retour d'une position par l'instantané, depuis un GameState et depuis game.c.
+ *
+ * \details
+ * - L'instantané fait SYNC_STATE_SIZE octets ; relu, il redonne la même
+ *   position (pièces, trait, tour, clé de Zobrist).  
+ * - L'empreinte change avec la position.  
+ * - game_sync_store() de la position de départ donne l'empreinte du
+ *   GameState équivalent ; game_sync_load() d'une position de milieu de partie
+ *   remplace `pieces[]`, `cell_control`, le trait, le tour et les scores.  
+ * - game_sync_load() recalcule `game_over` : vrai à la limite de tours, faux
+ *   sinon, quelle que soit la partie remplacée.
+ */
+void test_sync_roundtrip() {
+    GameState start = game_start_state();
+    GameState g = start;
+    sync_test_play(&g, 7);
+    assert(sync_state_digest(&g) != sync_state_digest(&start));
+
+    SyncState snap;
+    assert(sizeof(snap) == SYNC_STATE_SIZE);
+    sync_from_state(&g, &snap);
+    GameState back;
+    assert(sync_to_state(&snap, &back) == 0);
+    assert(back.hash == g.hash && back.current_player == g.current_player);
+    assert(back.turn_number == g.turn_number && back.piece_count == g.piece_count);
+    assert(memcmp(back.pieces, g.pieces, g.piece_count * sizeof(StatePiece)) == 0);
+    assert(memcmp(back.board, g.board, sizeof(g.board)) == 0);
+
+    SyncState current;
+    game_sync_store(&current);
+    assert(sync_checksum(&current) == sync_state_digest(&start));
+
+    assert(game_sync_load(&snap) == 0);
+    GameState loaded = createGameStateFromCurrent();
+    assert(loaded.hash == g.hash && current_turn == g.current_player && turn_number == g.turn_number);
+    int blue, red;
+    rules_scores(&g, &blue, &red);
+    assert(score_blue == blue && score_red == red && selected_piece == -1);
+
+    // game_over suit l'instantané : partie finie à la limite de tours, puis reprise
+    int saved_max_turn = max_turn;
+    max_turn = g.turn_number;
+    assert(game_sync_load(&snap) == 0 && game_over == 1);
+    max_turn = 0;
+    assert(game_sync_load(&snap) == 0 && game_over == 0);
+    max_turn = saved_max_turn;
+
+    game_start_state();
+    printf("test_sync_roundtrip OK\n");
+}
+
+/**
+ * \fn void test_sync_invalid()
+ * \brief Instantanés refusés : octet altéré, version, case en double, score faux.
+ *
+ * \details
+ * Chaque instantané refusé laisse l'état et la partie courante inchangés.
+ */
+void test_sync_invalid() {
+    GameState start = game_start_state();
+    SyncState good, bad;
+    sync_from_state(&start, &good);
+    GameState out = start;
+    out.turn_number = 42;
+
+    bad = good;
+    bad.control[40] ^= 1; // somme de contrôle fausse
+    assert(sync_to_state(&bad, &out) == -1 && out.turn_number == 42);
+
+    bad = good;
+    bad.version = SYNC_VERSION + 1;
+    sync_test_reseal(&bad);
+    assert(sync_to_state(&bad, &out) == -1);
+
+    bad = good;
+    bad.pieces[1].sq = bad.pieces[0].sq;
+    sync_test_reseal(&bad);
+    assert(sync_to_state(&bad, &out) == -1);
+
+    bad = good;
+    bad.score_red++;
+    sync_test_reseal(&bad);
+    assert(sync_to_state(&bad, &out) == -1);
+
+    bad = good;
+    bad.current_turn = 'X';
+    sync_test_reseal(&bad);
+    assert(sync_to_state(&bad, &out) == -1 && out.turn_number == 42);
+    assert(game_sync_load(&bad) == -1 && turn_number == 1);
+
+    assert(sync_to_state(&good, &out) == 0 && out.hash == start.hash);
+    printf("test_sync_invalid OK\n");
+}
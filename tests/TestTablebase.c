@@ -0,0 +1,223 @@
+/**
+ * \file TestTablebase.c
+ * \brief Tests unitaires de la table de finales.
+ *
+ * \details
+ * Vérifie l'indexation des classes (aller-retour index → position → index),
+ * la génération de la classe roi contre roi contre une recherche exhaustive
+ * à faible profondeur, le refus d'un fichier invalide, et l'usage de la
+ * table par l'IA sous la limite de tours.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "tablebase.h"
+#include "ia.h"
+#include "tt.h"
+#include "TestUtil.h"
+
+/** \brief Profondeur (en coups) de la vérification exhaustive. */
+#define TB_TEST_DEPTH 3
+
+static int tb_loses_within(GameState *s, int d);
+
+/**
+ * \fn static int tb_wins_within(GameState *s, int d)
+ * \brief Le joueur au trait force-t-il le gain en au plus `d` coups ?
+ */
+static int tb_wins_within(GameState *s, int d) {
+    if (d < 1 || rules_winner(s, NULL)) return 0;
+    char me = s->current_player;
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(s, moves), won = 0;
+    for (int i = 0; i < n && !won; ++i) {
+        MoveUndo undo;
+        rules_make_move(s, &moves[i], &undo);
+        char w = rules_winner(s, NULL);
+        won = (w == me) || (!w && tb_loses_within(s, d - 1));
+        rules_unmake_move(s, &undo);
+    }
+    return won;
+}
+
+/**
+ * \fn static int tb_loses_within(GameState *s, int d)
+ * \brief Le joueur au trait perd-il en au plus `d` coups, quoi qu'il joue ?
+ */
+static int tb_loses_within(GameState *s, int d) {
+    char w = rules_winner(s, NULL);
+    if (w) return w != s->current_player;
+    char me = s->current_player;
+    Move moves[RULES_MAX_MOVES];
+    int n = rules_legal_moves(s, moves), lost = n > 0 && d >= 2;
+    for (int i = 0; i < n && lost; ++i) {
+        MoveUndo undo;
+        rules_make_move(s, &moves[i], &undo);
+        char cw = rules_winner(s, NULL);
+        lost = cw ? cw != me : tb_wins_within(s, d - 1);
+        rules_unmake_move(s, &undo);
+    }
+    return lost;
+}
+
+/**
+ * \fn void test_tb_index_roundtrip()
+ * \brief Un index valide redonne la même position, et la position le même index.
+ *
+ * \details
+ * - Tailles : 13122 positions pour roi contre roi, 0 hors limites.
+ * - Pour plusieurs classes, des index pris dans toute la plage : la position
+ *   décodée a le matériel de la classe et se réindexe à l'identique.
+ * - Deux pièces sur une même case : index invalide.
+ */
+void test_tb_index_roundtrip() {
+    assert(tb_class_size(0, 0) == 2 * 81 * 81);
+    assert(tb_class_size(2, 0) == 2ULL * 81 * 81 * 3240);
+    assert(tb_class_size(TB_MAX_PAWNS + 1, 0) == 0 && tb_class_size(0, -1) == 0);
+
+    static const int classes[][2] = { { 0, 0 }, { 2, 0 }, { 0, 2 }, { 2, 3 }, { 3, 3 } };
+    int valid = 0;
+    for (size_t c = 0; c < sizeof(classes) / sizeof(classes[0]); ++c) {
+        int b = classes[c][0], r = classes[c][1];
+        uint64_t size = tb_class_size(b, r), step = size / 997 + 1;
+        for (uint64_t idx = 0; idx < size; idx += step) {
+            GameState s;
+            if (!tb_decode(idx, b, r, &s)) continue;
+            ++valid;
+            assert(s.pawn_count[0] == b && s.pawn_count[1] == r);
+            assert(s.king_sq[0] >= 0 && s.king_sq[1] >= 0);
+            assert(tb_index(&s) == idx);
+        }
+        GameState last;
+        if (tb_decode(size - 1, b, r, &last)) assert(tb_index(&last) == size - 1);
+    }
+    assert(valid > 4000);
+
+    GameState s;
+    assert(!tb_decode(0, 0, 0, &s)); // deux rois sur la case 0
+    assert(tb_decode(1, 0, 0, &s) && s.king_sq[0] == 0 && s.king_sq[1] == 1 && s.current_player == 'B');
+
+    printf("test_tb_index_roundtrip OK (%d positions)\n", valid);
+}
+
+/**
+ * \fn void test_tb_generate_kings()
+ * \brief Classe roi contre roi : résultats conformes à une recherche exhaustive.
+ *
+ * \details
+ * - tb_generate() avec 0 soldat écrit une seule classe, que tb_open() relit.
+ * - Pour une position sur sept, gain (perte) en au plus TB_TEST_DEPTH coups
+ *   selon la table si et seulement si la recherche exhaustive le trouve.
+ * - La table contient des gains plus longs que la vérification.
+ * - Un fichier tronqué ou d'une autre signature est refusé.
+ */
+void test_tb_generate_kings() {
+    char path[64];
+    test_temp_path("tb", path, sizeof(path));
+    assert(tb_generate(path, 0, NULL) == 1);
+    assert(tb_open(path) == 0 && tb_class_count() == 1);
+
+    uint64_t size = tb_class_size(0, 0);
+    int checked = 0, longest = 0;
+    for (uint64_t idx = 0; idx < size; ++idx) {
+        GameState s;
+        if (!tb_decode(idx, 0, 0, &s) || rules_winner(&s, NULL)) continue;
+        int dist = -1;
+        TbResult r = tb_probe(&s, &dist);
+        assert(r == TB_WIN || r == TB_LOSS || r == TB_DRAW);
+        if (r == TB_WIN && dist > longest) longest = dist;
+        if (idx % 7) continue;
+        ++checked;
+        assert((r == TB_WIN && dist <= TB_TEST_DEPTH) == tb_wins_within(&s, TB_TEST_DEPTH));
+        assert((r == TB_LOSS && dist <= TB_TEST_DEPTH) == tb_loses_within(&s, TB_TEST_DEPTH));
+    }
+    assert(checked > 1000 && longest > TB_TEST_DEPTH);
+
+    // Fichier tronqué : refusé
+    FILE *f = fopen(path, "r+b");
+    assert(f);
+    assert(ftruncate(fileno(f), sizeof(TbHeader) + sizeof(TbClass) + 100) == 0);
+    fclose(f);
+    assert(tb_open(path) != 0 && tb_class_count() == 0);
+    f = fopen(path, "wb");
+    assert(f);
+    fputs("pas une table de finales", f);
+    fclose(f);
+    assert(tb_open(path) != 0);
+    assert(tb_open("/nonexistent/krojanty.tb") != 0);
+    remove(path);
+
+    printf("test_tb_generate_kings OK (%d positions verifiees, gain le plus long %d coups)\n", checked, longest);
+}
+
+/**
+ * \fn void test_tb_search()
+ * \brief L'IA joue le gain le plus court de la table, dans la limite de tours.
+ *
+ * \details
+ * - Position roi contre roi gagnée en 3 coups pour les bleus : minimaxIA() rend un
+ *   score de gain, trouverMeilleurCoupIA() un coup qui laisse les rouges perdus en 2.
+ * - À deux tours de max_turn, le gain ne tient plus : score ordinaire.
+ * - ia_search_game() suit la limite de tours qu'on lui passe : 2 tours, la
+ *   table n'est pas retenue ; aucune limite, gain lu dans la table.
+ * - Table fermée : score ordinaire.
+ */
+void test_tb_search() {
+    char path[64];
+    test_temp_path("tb", path, sizeof(path));
+    assert(tb_generate(path, 0, NULL) == 1);
+    assert(tb_open(path) == 0);
+
+    GameState s;
+    int found = 0;
+    for (uint64_t idx = 0; idx < tb_class_size(0, 0) && !found; ++idx) {
+        int dist;
+        found = tb_decode(idx, 0, 0, &s) && s.current_player == 'B' && !rules_winner(&s, NULL) &&
+                tb_probe(&s, &dist) == TB_WIN && dist == 3;
+    }
+    assert(found);
+
+    tt_clear();
+    assert(minimaxIA(&s, 1, 'B', -100000000, 100000000) > 1000000);
+    Move mv;
+    trouverMeilleurCoupIA(&s, &mv, 2);
+    IaSearchStats st;
+    ia_get_search_stats(&st);
+    assert(st.tb_hits > 0 && st.score > 1000000);
+    MoveUndo undo;
+    rules_make_move(&s, &mv, &undo);
+    int dist;
+    assert(tb_probe(&s, &dist) == TB_LOSS && dist == 2);
+    rules_unmake_move(&s, &undo);
+
+    tt_clear();
+    s.turn_number = (uint16_t)(max_turn - 2);
+    int v = minimaxIA(&s, 1, 'B', -100000000, 100000000);
+    assert(v < 1000000 && v > -1000000);
+    s.turn_number = 1;
+
+    // Limite de tours propre à la partie (ia_search_game()), max_turn inchangé
+    IaHistory h;
+    ia_history_reset(&h, &s);
+    tt_clear();
+    ia_search_game(&s, &mv, 2, 0, NULL, &h, NULL, 2);
+    ia_get_search_stats(&st);
+    assert(mv.piece_index >= 0 && st.tb_hits == 0);
+    tt_clear();
+    ia_search_game(&s, &mv, 2, 0, NULL, &h, NULL, 0);
+    ia_get_search_stats(&st);
+    assert(st.tb_hits > 0 && st.score > 1000000);
+
+    tb_close();
+    remove(path);
+    tt_clear();
+    v = minimaxIA(&s, 1, 'B', -100000000, 100000000);
+    assert(v < 1000000 && v > -1000000);
+
+    printf("test_tb_search OK\n");
+}
@@ -0,0 +1,88 @@
+/**
+ * \file TestTt.c
+ * \brief Tests unitaires pour la table de transposition et le hachage de Zobrist.
+ *
+ * \details
+ * Ce fichier vérifie :
+ * - La mémorisation et la relecture d'une entrée de la table.
+ * - La mise à jour incrémentale de la clé de Zobrist par rules_make_move()
+ *   et sa restauration par rules_unmake_move().
+ */
+
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "ia.h"
+#include "tt.h"
+#include "game.h"
+
+/**
+ * \fn void test_tt_store_probe()
+ * \brief Test de l'écriture et de la lecture d'une entrée.
+ *
+ * \details
+ * - tt_init() alloue la table par défaut, puis une petite table y range une entrée.  
+ * - Vérifie que la relecture restitue profondeur, borne, score et coup.  
+ * - Vérifie qu'une clé absente n'est pas trouvée et que tt_clear() vide la table.  
+ */
+void test_tt_store_probe() {
+    assert(tt_init(0) == 0);
+    assert(tt_size_mb() == TT_DEFAULT_MB);
+    assert(tt_resize(1) == 0);
+    assert(tt_size_mb() == 1);
+    assert(tt_resize(0) != 0);
+
+    uint64_t key = 0x0123456789ABCDEFULL;
+    tt_store(key, 5, TT_LOWER, -1234, BB_SQ(2, 3), BB_SQ(2, 7));
+
+    TTEntry e;
+    assert(tt_probe(key, &e));
+    assert(e.depth == 5);
+    assert(tt_entry_bound(&e) == TT_LOWER);
+    assert(e.score == -1234);
+    assert(e.from_sq == BB_SQ(2, 3) && e.to_sq == BB_SQ(2, 7));
+    assert(!tt_probe(key ^ 1, &e));
+
+    tt_clear();
+    assert(!tt_probe(key, &e));
+
+    printf("test_tt_store_probe OK\n");
+}
+
+/**
+ * \fn void test_tt_zobrist_incremental()
+ * \brief Test de la clé de Zobrist incrémentale.
+ *
+ * \details
+ * - Joue un coup avec capture Linca via rules_make_move().  
+ * - Vérifie que la clé incrémentale égale la clé recalculée de zéro.  
+ * - Vérifie que rules_unmake_move() restaure la clé d'origine.  
+ */
+void test_tt_zobrist_incremental() {
+    GameState gs = createGameStateFromCurrent();
+    gs.control[0] = gs.control[1] = 0;
+    gs.piece_count = 5;
+    gs.pieces[0] = (StatePiece){ .sq = BB_SQ(0, 1), .type = 'K', .color = 'B' };
+    gs.pieces[1] = (StatePiece){ .sq = BB_SQ(4, 4), .type = 'P', .color = 'R' };
+    gs.pieces[2] = (StatePiece){ .sq = BB_SQ(4, 1), .type = 'P', .color = 'B' };
+    gs.pieces[3] = (StatePiece){ .sq = BB_SQ(4, 5), .type = 'P', .color = 'B' };
+    gs.pieces[4] = (StatePiece){ .sq = BB_SQ(8, 7), .type = 'K', .color = 'R' };
+    gs.control[1] = bb_bit(BB_SQ(4, 4));
+    gs.current_player = 'B';
+    rules_sync(&gs);
+    uint64_t before = gs.hash;
+
+    Move mv = { .piece_index = 2, .to_row = 4, .to_col = 3 };
+    MoveUndo undo;
+    rules_make_move(&gs, &mv, &undo);
+    assert(gs.hash != before);
+
+    GameState fresh = gs;
+    rules_sync(&fresh);
+    assert(fresh.hash == gs.hash);
+
+    rules_unmake_move(&gs, &undo);
+    assert(gs.hash == before);
+
+    printf("test_tt_zobrist_incremental OK\n");
+}
@@ -0,0 +1,80 @@
+/**
+ * \file TestUi.c
+ * \brief Tests unitaires des mises à jour groupées de l'interface.
+ *
+ * \details
+ * Vérifie que les marques s'accumulent sans toucher aux labels, puis qu'un
+ * seul ui_flush() les applique toutes.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <gtk/gtk.h>
+#include "ui.h"
+#include "game.h"
+#include "status.h"
+
+/**
+ * \fn void test_ui_coalesce(void)
+ * \brief Plusieurs marques, une seule application.
+ *
+ * \details
+ * - update_scores() et ui_mark() cumulent leurs drapeaux : les labels ne
+ *   changent pas avant ui_flush().
+ * - ui_flush() écrit les scores et l'état, compte une application et vide
+ *   le masque ; un second appel sans marque ne fait rien.
+ */
+void test_ui_coalesce(void) {
+    Piece saved_pieces[20];
+    int saved_control[9][9];
+    memcpy(saved_pieces, pieces, sizeof(saved_pieces));
+    memcpy(saved_control, cell_control, sizeof(saved_control));
+    int saved_count = piece_count, saved_turn_number = turn_number, saved_over = game_over;
+    char saved_turn = current_turn;
+
+    current_turn = 'B';
+    turn_number = 1;
+    game_over = 0;
+    game_setup_default();
+    ui_flush();
+    GtkWidget *lB = gtk_label_new("-");
+    GtkWidget *lR = gtk_label_new("-");
+    GtkWidget *lS = gtk_label_new("-");
+    status_register_labels(lB, lR, lS, NULL, NULL, NULL);
+
+    UiStats before, after;
+    ui_get_stats(&before);
+    for (int i = 0; i < 3; ++i) {
+        update_scores();
+        ui_mark(UI_DIRTY_BOARD | UI_DIRTY_STATUS);
+    }
+    assert(ui_pending() == UI_DIRTY_ALL);
+    assert(strcmp(gtk_label_get_text(GTK_LABEL(lB)), "-") == 0);
+    assert(strcmp(gtk_label_get_text(GTK_LABEL(lS)), "-") == 0);
+
+    ui_flush();
+    ui_get_stats(&after);
+    assert(after.marks == before.marks + 6 && after.flushes == before.flushes + 1);
+    assert(ui_pending() == 0);
+    assert(strstr(gtk_label_get_text(GTK_LABEL(lB)), "Score équipe bleue") != NULL);
+    assert(strstr(gtk_label_get_text(GTK_LABEL(lR)), "Score équipe rouge") != NULL);
+    assert(strcmp(gtk_label_get_text(GTK_LABEL(lS)), "-") != 0);
+    ui_flush();
+    ui_get_stats(&after);
+    assert(after.flushes == before.flushes + 1);
+
+    status_register_labels(NULL, NULL, NULL, NULL, NULL, NULL);
+    memcpy(pieces, saved_pieces, sizeof(saved_pieces));
+    piece_count = saved_count;
+    turn_number = saved_turn_number;
+    current_turn = saved_turn;
+    game_over = saved_over;
+    memcpy(cell_control, saved_control, sizeof(saved_control));
+    update_scores();
+    ui_flush();
+    printf("test_ui_coalesce OK\n");
+}
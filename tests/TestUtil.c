@@ -0,0 +1,29 @@
+/**
+ * \file TestUtil.c
+ * \brief Outils communs aux tests unitaires.
+ *
+ * \date 2025-10-14
+ * \version 0.1
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "TestUtil.h"
+
+/**
+ * \fn void test_temp_path(const char *prefix, char *path, size_t size)
+ * \brief Nom d'un fichier temporaire neuf (créé vide).
+ *
+ * \param prefix Partie du nom propre au test.
+ * \param path Nom du fichier (retour).
+ * \param size Taille de `path`.
+ */
+void test_temp_path(const char *prefix, char *path, size_t size) {
+    int n = snprintf(path, size, "/tmp/krojanty_%s_XXXXXX", prefix);
+    assert(n > 0 && (size_t)n < size);
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+}
@@ -0,0 +1,19 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stddef.h>
+
+/**
+ * @file TestUtil.h
+ * @brief Outils communs aux tests unitaires (fichiers temporaires).
+ */
+
+/**
+ * @brief Nom d'un fichier temporaire neuf (créé vide), `/tmp/krojanty_<prefix>_XXXXXX`.
+ * @param prefix partie du nom propre au test (`book`, `record`...)
+ * @param path nom du fichier (retour)
+ * @param size taille de `path`
+ */
+void test_temp_path(const char *prefix, char *path, size_t size);
+
+#endif